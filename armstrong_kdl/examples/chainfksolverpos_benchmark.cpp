@@ -0,0 +1,105 @@
+/**
+ \file   chainfksolverpos_benchmark.cpp
+ \brief  Compares the rotation matrix and the quaternion representation
+         in the forward position kinematics of chains with 6 to 40 joints.
+
+ For every chain length the average time of one call to JntToCart is
+ printed for ChainFkSolverPos_recursive, ChainFkSolverPos_matrix and
+ ChainFkSolverPos_quaternion, together with the deviation from
+ orthonormality of the resulting rotation matrix.
+*/
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <frames_io.hpp>
+#include <chainfksolverpos_recursive.hpp>
+
+using namespace ARMstrongKDL;
+
+// a chain with alternating joint axes and random link offsets :
+Chain RandomChain(unsigned int nrofjoints) {
+    Chain chain;
+    const Joint::JointType types[] = {Joint::RotZ,Joint::RotY,Joint::RotX,Joint::RotY};
+    for (unsigned int i=0;i<nrofjoints;++i) {
+        Vector tip;
+        random(tip);
+        Rotation R;
+        random(R);
+        if (i%5==4) {
+            Vector axis;
+            random(axis);
+            axis.Normalize();
+            chain.addSegment(Segment(Joint(Vector::Zero(),axis,Joint::RotAxis),Frame(R,tip)));
+        } else {
+            chain.addSegment(Segment(Joint(types[i%4]),Frame(R,tip)));
+        }
+    }
+    return chain;
+}
+
+// largest element of R^T R - I :
+double OrthonormalityError(const Rotation& R) {
+    Rotation E = R.Inverse()*R;
+    double err = 0;
+    for (int i=0;i<3;++i)
+        for (int j=0;j<3;++j)
+            err = std::max(err,std::fabs(E(i,j)-(i==j ? 1.0 : 0.0)));
+    return err;
+}
+
+template<class Solver>
+double TimeSolver(Solver& solver,const std::vector<JntArray>& q,int repetitions,Frame& F) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int r=0;r<repetitions;++r)
+        for (size_t i=0;i<q.size();++i)
+            solver.JntToCart(q[i],F);
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double,std::nano>(stop-start).count()/(repetitions*q.size());
+}
+
+int main(int argc,char* argv[]) {
+    const unsigned int dofs[] = {6,10,20,30,40};
+    const int repetitions = 200;
+    std::cout << "dof   recursive(ns)   matrix(ns)   quaternion(ns)   "
+              << "orth.err. matrix   orth.err. quaternion" << std::endl;
+    for (unsigned int d=0;d<sizeof(dofs)/sizeof(dofs[0]);++d) {
+        Chain chain = RandomChain(dofs[d]);
+        ChainFkSolverPos_recursive fk_recursive(chain);
+        ChainFkSolverPos_matrix fk_matrix(chain);
+        ChainFkSolverPos_quaternion fk_quat(chain);
+
+        std::vector<JntArray> q(1000,JntArray(chain.getNrOfJoints()));
+        for (size_t i=0;i<q.size();++i)
+            for (unsigned int j=0;j<chain.getNrOfJoints();++j)
+                random(q[i](j));
+
+        Frame F_recursive,F_matrix,F_quat;
+        double t_recursive = TimeSolver(fk_recursive,q,repetitions,F_recursive);
+        double t_matrix    = TimeSolver(fk_matrix,q,repetitions,F_matrix);
+        double t_quat      = TimeSolver(fk_quat,q,repetitions,F_quat);
+        std::cout << std::setw(3) << dofs[d]
+                  << std::setw(16) << t_recursive
+                  << std::setw(13) << t_matrix
+                  << std::setw(17) << t_quat
+                  << std::setw(19) << OrthonormalityError(F_matrix.M)
+                  << std::setw(23) << OrthonormalityError(F_quat.M) << std::endl;
+    }
+    return 0;
+}
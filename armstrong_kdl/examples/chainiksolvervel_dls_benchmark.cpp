@@ -0,0 +1,89 @@
+/**
+ \file   chainiksolvervel_dls_benchmark.cpp
+ \brief  Compares the damped least squares velocity solver with a LDLT
+         factorization of J*J' against the SVD based solvers.
+
+ For random chains of 6 to 40 revolute joints the average time of one
+ call of CartToJnt is printed for ChainIkSolverVel_dls with the 6x6 LDLT
+ factorization, ChainIkSolverVel_dls with a SVD of the jacobian and
+ ChainIkSolverVel_wdls, together with the largest difference between the
+ two ChainIkSolverVel_dls results.  All solvers use the same damping.
+*/
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <chainiksolvervel_dls.hpp>
+#include <chainiksolvervel_wdls.hpp>
+
+using namespace ARMstrongKDL;
+
+Chain RandomChain(int nj) {
+    Chain chain;
+    const Joint::JointType types[] = {Joint::RotZ,Joint::RotY,Joint::RotX};
+    for (int i=0;i<nj;++i) {
+        Vector tip;
+        random(tip);
+        Rotation R;
+        random(R);
+        chain.addSegment(Segment(Joint(types[i%3]),Frame(R,tip)));
+    }
+    return chain;
+}
+
+template<class F>
+double TimeIt(F f,int repetitions) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int r=0;r<repetitions;++r)
+        f();
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double,std::nano>(stop-start).count()/repetitions;
+}
+
+int main() {
+    const int repetitions = 20000;
+    const double lambda = 0.01;
+    const int sizes[] = {6,7,10,20,40};
+
+    std::cout << std::setw(8) << "joints" << std::setw(14) << "ldlt(ns)"
+              << std::setw(14) << "svd(ns)" << std::setw(14) << "wdls(ns)"
+              << std::setw(16) << "max error" << std::endl;
+    for (int nj : sizes) {
+        Chain chain = RandomChain(nj);
+        JntArray q(nj),qdot_ldlt(nj),qdot_svd(nj),qdot_wdls(nj);
+        for (int i=0;i<nj;++i)
+            random(q(i));
+        Twist v;
+        random(v);
+
+        ChainIkSolverVel_dls dls(chain,lambda);
+        double t_ldlt = TimeIt([&]{ dls.CartToJnt(q,v,qdot_ldlt); },repetitions);
+
+        ChainIkSolverVel_dls dls_svd(chain,lambda);
+        dls_svd.setUseSVD(true);
+        double t_svd = TimeIt([&]{ dls_svd.CartToJnt(q,v,qdot_svd); },repetitions);
+
+        ChainIkSolverVel_wdls wdls(chain,1.0);
+        wdls.setLambda(lambda);
+        double t_wdls = TimeIt([&]{ wdls.CartToJnt(q,v,qdot_wdls); },repetitions);
+
+        std::cout << std::setw(8) << nj << std::setw(14) << t_ldlt
+                  << std::setw(14) << t_svd << std::setw(14) << t_wdls
+                  << std::setw(16) << (qdot_ldlt.data-qdot_svd.data).cwiseAbs().maxCoeff() << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+/**
+ \file   framevel_benchmark.cpp
+ \brief  Compares the written out FrameVel/FrameAcc operators and the
+         recursive velocity and acceleration solvers with the generic
+         composition of the derivative types.
+
+ The generic composition FrameVel(lhs.M*rhs.M,lhs.M*rhs.p+lhs.p) builds
+ every intermediate RotationVel/VectorVel and rotates the same vectors
+ more than once.  The forward kinematics of a 7 joint chain are computed
+ once by composing a FrameVel (FrameAcc) for every segment with these
+ generic operators, and once with ChainFkSolverVel_recursive
+ (ChainFkSolverAcc_recursive).  The average time of one evaluation is
+ printed, together with the largest difference of the results.
+*/
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include <chainfksolvervel_recursive.hpp>
+#include <chainfksolveracc_recursive.hpp>
+
+using namespace ARMstrongKDL;
+
+const int NJ = 7;
+
+Chain RandomChain() {
+    Chain chain;
+    const Joint::JointType types[] = {Joint::RotZ,Joint::RotY,Joint::RotZ,Joint::TransX,Joint::RotZ,Joint::RotY,Joint::RotZ};
+    for (int i=0;i<NJ;++i) {
+        Vector tip;
+        random(tip);
+        Rotation R;
+        random(R);
+        chain.addSegment(Segment(Joint(types[i]),Frame(R,tip)));
+    }
+    return chain;
+}
+
+template<class F>
+double TimeIt(F f,int repetitions) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int r=0;r<repetitions;++r)
+        f();
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double,std::nano>(stop-start).count()/repetitions;
+}
+
+// the generic compositions
+FrameVel Compose(const FrameVel& lhs,const FrameVel& rhs) {
+    return FrameVel(lhs.M*rhs.M,lhs.M*rhs.p+lhs.p);
+}
+
+FrameAcc Compose(const FrameAcc& lhs,const FrameAcc& rhs) {
+    return FrameAcc(lhs.M*rhs.M,lhs.M*rhs.p+lhs.p);
+}
+
+double MaxError(const Twist& a,const Twist& b) {
+    Twist d = a-b;
+    double e = 0.0;
+    for (int i=0;i<6;++i)
+        e = std::max(e,std::abs(d(i)));
+    return e;
+}
+
+int main() {
+    const int repetitions = 100000;
+    Chain chain = RandomChain();
+    JntArrayAcc qacc(NJ);
+    for (int i=0;i<NJ;++i) {
+        random(qacc.q(i));
+        random(qacc.qdot(i));
+        random(qacc.qdotdot(i));
+    }
+    JntArrayVel qvel(qacc.q,qacc.qdot);
+
+    FrameVel fv_generic;
+    double t_vel_generic = TimeIt([&]{
+        fv_generic = FrameVel::Identity();
+        for (int i=0;i<NJ;++i) {
+            const Segment& segment = chain.getSegment(i);
+            fv_generic = Compose(fv_generic,FrameVel(segment.pose(qacc.q(i)),segment.twist(qacc.q(i),qacc.qdot(i))));
+        }
+    },repetitions);
+
+    FrameVel fv;
+    ChainFkSolverVel_recursive fksolvervel(chain);
+    double t_vel = TimeIt([&]{ fksolvervel.JntToCart(qvel,fv); },repetitions);
+
+    FrameAcc fa_generic;
+    double t_acc_generic = TimeIt([&]{
+        fa_generic = FrameAcc::Identity();
+        for (int i=0;i<NJ;++i) {
+            const Segment& segment = chain.getSegment(i);
+            Twist t = segment.twist(qacc.q(i),qacc.qdot(i));
+            Twist dt = segment.twist(qacc.q(i),qacc.qdotdot(i));
+            dt.vel += t.rot*t.vel;
+            fa_generic = Compose(fa_generic,FrameAcc(segment.pose(qacc.q(i)),t,dt));
+        }
+    },repetitions);
+
+    FrameAcc fa;
+    ChainFkSolverAcc_recursive fksolveracc(chain);
+    double t_acc = TimeIt([&]{ fksolveracc.JntToCart(qacc,fa); },repetitions);
+
+    std::cout << std::setw(36) << "method" << std::setw(12) << "time(ns)"
+              << std::setw(16) << "max error" << std::endl;
+    std::cout << std::setw(36) << "generic FrameVel composition" << std::setw(12) << t_vel_generic
+              << std::setw(16) << 0.0 << std::endl;
+    std::cout << std::setw(36) << "ChainFkSolverVel_recursive" << std::setw(12) << t_vel
+              << std::setw(16) << MaxError(fv.GetTwist(),fv_generic.GetTwist()) << std::endl;
+    std::cout << std::setw(36) << "generic FrameAcc composition" << std::setw(12) << t_acc_generic
+              << std::setw(16) << 0.0 << std::endl;
+    std::cout << std::setw(36) << "ChainFkSolverAcc_recursive" << std::setw(12) << t_acc
+              << std::setw(16) << std::max(MaxError(fa.GetTwist(),fa_generic.GetTwist()),
+                                           MaxError(fa.GetAccTwist(),fa_generic.GetAccTwist())) << std::endl;
+    return 0;
+}
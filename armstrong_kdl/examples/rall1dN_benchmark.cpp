@@ -0,0 +1,172 @@
+/**
+ \file   rall1dN_benchmark.cpp
+ \brief  Compares ways of computing the derivatives of the forward position
+         kinematics of a 7 joint chain towards all joints.
+
+ The derivatives of the end effector pose towards all joints are computed
+ with ChainFkSolverPosT and
+   - Rall1d<double> : one evaluation per joint,
+   - nested Rall1d objects as in RallNd : one evaluation with 2^7 scalars
+     per number,
+   - Rall1dN<7> : one evaluation with a flat array of 7 tangents,
+ and compared with the double ChainJntToJacSolver.  The average time of
+ one evaluation of all derivatives is printed, together with the largest
+ difference with the position rows of the jacobian.
+*/
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <chainfksolverpos_scalar.hpp>
+#include <chainjnttojacsolver.hpp>
+#include <utilities/rall1d.h>
+#include <utilities/rall1dN.h>
+
+using namespace ARMstrongKDL;
+
+const int NJ = 7;
+
+// Rall1d nested N times, the first derivatives towards N variables are a
+// part of its 2^N scalars (see RallNd) :
+template <int N>
+class RallNested : public Rall1d<RallNested<N-1>,RallNested<N-1>,double>
+{
+public:
+    typedef Rall1d<RallNested<N-1>,RallNested<N-1>,double> Base;
+    RallNested() {}
+    RallNested(const Base& arg):Base(arg) {}
+    explicit RallNested(double c):Base(RallNested<N-1>(c),RallNested<N-1>(0.0)) {}
+    // variable i of N, i.e. the derivative of nesting level i
+    static RallNested Variable(double c,int i) {
+        if (i==N-1)
+            return RallNested(Base(RallNested<N-1>(c),RallNested<N-1>(1.0)));
+        return RallNested(Base(RallNested<N-1>::Variable(c,i),RallNested<N-1>(0.0)));
+    }
+    // derivative towards variable i
+    double Derivative(int i) const {
+        if (i==N-1)
+            return this->grad.Value();
+        return this->t.Derivative(i);
+    }
+    double Value() const { return this->t.Value(); }
+};
+
+template <>
+class RallNested<1> : public Rall1d<double>
+{
+public:
+    RallNested() {}
+    RallNested(const Rall1d<double>& arg):Rall1d<double>(arg) {}
+    explicit RallNested(double c):Rall1d<double>(c,0.0) {}
+    static RallNested Variable(double c,int) { return RallNested(Rall1d<double>(c,1.0)); }
+    double Derivative(int) const { return grad; }
+    double Value() const { return t; }
+};
+
+Chain RandomChain() {
+    Chain chain;
+    const Joint::JointType types[] = {Joint::RotZ,Joint::RotY,Joint::RotZ,Joint::RotY,Joint::RotZ,Joint::RotY,Joint::RotZ};
+    for (int i=0;i<NJ;++i) {
+        Vector tip;
+        random(tip);
+        Rotation R;
+        random(R);
+        chain.addSegment(Segment(Joint(types[i]),Frame(R,tip)));
+    }
+    return chain;
+}
+
+template<class F>
+double TimeIt(F f,int repetitions) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int r=0;r<repetitions;++r)
+        f();
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double,std::nano>(stop-start).count()/repetitions;
+}
+
+int main() {
+    const int repetitions = 20000;
+    Chain chain = RandomChain();
+    JntArray q(NJ);
+    for (int i=0;i<NJ;++i)
+        random(q(i));
+
+    Jacobian jac(NJ);
+    ChainJntToJacSolver jacsolver(chain);
+    double t_jac = TimeIt([&]{ jacsolver.JntToJac(q,jac); },repetitions);
+
+    // Rall1d : one evaluation for every joint
+    typedef Rall1d<double> doubled;
+    ChainFkSolverPosT<doubled> fk_1(chain);
+    JntArrayT<doubled> q_1(NJ);
+    FrameT<doubled> f_1;
+    Eigen::Matrix<double,3,NJ> d_1;
+    double t_1 = TimeIt([&]{
+        for (int j=0;j<NJ;++j) {
+            for (int i=0;i<NJ;++i)
+                q_1(i) = doubled(q(i),i==j ? 1.0 : 0.0);
+            fk_1.JntToCart(q_1,f_1);
+            for (int r=0;r<3;++r)
+                d_1(r,j) = f_1.p(r).grad;
+        }
+    },repetitions);
+
+    // nested Rall1d : one evaluation
+    typedef RallNested<NJ> doublen;
+    ChainFkSolverPosT<doublen> fk_n(chain);
+    JntArrayT<doublen> q_n(NJ);
+    for (int i=0;i<NJ;++i)
+        q_n(i) = doublen::Variable(q(i),i);
+    FrameT<doublen> f_n;
+    Eigen::Matrix<double,3,NJ> d_n;
+    double t_n = TimeIt([&]{
+        fk_n.JntToCart(q_n,f_n);
+        for (int j=0;j<NJ;++j)
+            for (int r=0;r<3;++r)
+                d_n(r,j) = f_n.p(r).Derivative(j);
+    },repetitions/100);
+
+    // Rall1dN : one evaluation
+    typedef Rall1dN<NJ> doubleN;
+    ChainFkSolverPosT<doubleN> fk_N(chain);
+    JntArrayT<doubleN> q_N(NJ);
+    for (int i=0;i<NJ;++i)
+        q_N(i) = doubleN::Variable(q(i),i);
+    FrameT<doubleN> f_N;
+    Eigen::Matrix<double,3,NJ> d_N;
+    double t_N = TimeIt([&]{
+        fk_N.JntToCart(q_N,f_N);
+        for (int r=0;r<3;++r)
+            d_N.row(r) = f_N.p(r).grad.matrix().transpose();
+    },repetitions);
+
+    Eigen::Matrix<double,3,NJ> J = jac.data.topRows<3>();
+    std::cout << std::setw(24) << "method" << std::setw(12) << "time(ns)"
+              << std::setw(16) << "max error" << std::endl;
+    std::cout << std::setw(24) << "ChainJntToJacSolver" << std::setw(12) << t_jac
+              << std::setw(16) << 0.0 << std::endl;
+    std::cout << std::setw(24) << "Rall1d, 7 passes" << std::setw(12) << t_1
+              << std::setw(16) << (d_1-J).cwiseAbs().maxCoeff() << std::endl;
+    std::cout << std::setw(24) << "nested Rall1d (RallNd)" << std::setw(12) << t_n
+              << std::setw(16) << (d_n-J).cwiseAbs().maxCoeff() << std::endl;
+    std::cout << std::setw(24) << "Rall1dN<7>" << std::setw(12) << t_N
+              << std::setw(16) << (d_N-J).cwiseAbs().maxCoeff() << std::endl;
+    return 0;
+}
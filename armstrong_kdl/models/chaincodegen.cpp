@@ -0,0 +1,57 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+// Writes a header with FK, jacobian and RNE functions specialized for one
+// of the models, see ChainCodeGenerator :
+//
+//   chaincodegen <model> <namespace> <output file> [include prefix]
+//
+// with <model> Puma560 or KukaLWR_DHnew.
+
+#include <chain.hpp>
+#include <chaincodegenerator.hpp>
+#include "models.hpp"
+#include <fstream>
+#include <iostream>
+
+using namespace ARMstrongKDL;
+
+int main(int argc,char** argv){
+    if (argc<4 || argc>5) {
+        std::cerr << "usage: " << argv[0] << " <model> <namespace> <output file> [include prefix]" << std::endl
+                  << "models: Puma560, KukaLWR_DHnew" << std::endl;
+        return 1;
+    }
+    std::string model(argv[1]);
+    Chain chain;
+    if (model=="Puma560")
+        chain = Puma560();
+    else if (model=="KukaLWR_DHnew")
+        chain = KukaLWR_DHnew();
+    else {
+        std::cerr << "unknown model " << model << std::endl;
+        return 1;
+    }
+
+    std::ofstream os(argv[3]);
+    if (!os) {
+        std::cerr << "cannot write " << argv[3] << std::endl;
+        return 1;
+    }
+    ChainCodeGenerator generator(chain);
+    if (argc==5)
+        generator.setIncludePrefix(argv[4]);
+    generator.generate(os,argv[2]);
+    return os ? 0 : 1;
+}
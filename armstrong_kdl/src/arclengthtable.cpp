@@ -0,0 +1,204 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "arclengthtable.hpp"
+#include "binary_io.hpp"
+#include "utilities/error.h"
+#include <algorithm>
+
+namespace ARMstrongKDL {
+
+// 5 point Gauss-Legendre quadrature on [0,1]
+static const double gl_nodes[5] = {
+	0.5-0.5*0.9061798459386640, 0.5-0.5*0.5384693101056831, 0.5,
+	0.5+0.5*0.5384693101056831, 0.5+0.5*0.9061798459386640 };
+static const double gl_weights[5] = {
+	0.5*0.2369268850561891, 0.5*0.4786286704993665, 0.5*0.5688888888888889,
+	0.5*0.4786286704993665, 0.5*0.2369268850561891 };
+
+// Limits the derivatives at both ends of an interval with slope m, such that
+// the cubic Hermite interpolation is monotone (Fritsch-Carlson).
+static inline void Limit(double m,double& d0,double& d1) {
+	if (m <= 0) {
+		d0 = 0;
+		d1 = 0;
+	} else {
+		d0 = std::min(d0,3.0*m);
+		d1 = std::min(d1,3.0*m);
+	}
+}
+
+static inline double Hermite(double t,double h,double y0,double y1,double d0,double d1) {
+	double t2 = t*t;
+	double t3 = t2*t;
+	return y0*(2*t3-3*t2+1) + h*d0*(t3-2*t2+t) + y1*(-2*t3+3*t2) + h*d1*(t3-t2);
+}
+
+ArcLengthTable::ArcLengthTable():
+	s(1,0.0), length(1,0.0), cached_s(0), cached_length(0)
+{
+}
+
+ArcLengthTable::ArcLengthTable(double s0,double length0):
+	s(1,s0), length(1,length0), cached_s(0), cached_length(0)
+{
+}
+
+ArcLengthTable::ArcLengthTable(Path& path,int nrofsamples):
+	s(1,0.0), length(1,0.0), cached_s(0), cached_length(0)
+{
+	Add(path,nrofsamples);
+}
+
+void ArcLengthTable::Add(Path& path,int nrofsamples) {
+	double pathlength = path.PathLength();
+	if (pathlength <= 0 || nrofsamples <= 0)
+		return;
+	double ds     = pathlength/nrofsamples;
+	double s0     = s.back();
+	double speed0 = path.Vel(0,1).vel.Norm();
+	for (int i=0;i<nrofsamples;++i) {
+		double sa = i*ds;
+		double dl = 0;
+		for (int k=0;k<5;++k)
+			dl += gl_weights[k]*path.Vel(sa+gl_nodes[k]*ds,1).vel.Norm();
+		dl *= ds;
+		double speed1 = path.Vel(sa+ds,1).vel.Norm();
+
+		double d0 = speed0;
+		double d1 = speed1;
+		Limit(dl/ds,d0,d1);
+		fd0.push_back(d0);
+		fd1.push_back(d1);
+		// the inverse has an infinite derivative where the path does not
+		// translate, the limiter takes care of that :
+		double m = (dl > 0) ? ds/dl : 0;
+		d0 = (speed0 > 0) ? 1.0/speed0 : 3.0*m;
+		d1 = (speed1 > 0) ? 1.0/speed1 : 3.0*m;
+		Limit(m,d0,d1);
+		id0.push_back(d0);
+		id1.push_back(d1);
+
+		s.push_back(s0+sa+ds);
+		length.push_back(length.back()+dl);
+		speed0 = speed1;
+	}
+	// avoid rounding errors at the end of the path :
+	s.back() = s0+pathlength;
+}
+
+void ArcLengthTable::RemoveBefore(double _s) {
+	unsigned int n=0;
+	while (n+1<s.size() && s[n+1]<=_s)
+		++n;
+	s.erase(s.begin(),s.begin()+n);
+	length.erase(length.begin(),length.begin()+n);
+	fd0.erase(fd0.begin(),fd0.begin()+n);
+	fd1.erase(fd1.begin(),fd1.begin()+n);
+	id0.erase(id0.begin(),id0.begin()+n);
+	id1.erase(id1.begin(),id1.begin()+n);
+	cached_s      = 0;
+	cached_length = 0;
+}
+
+double ArcLengthTable::StartS() const {
+	return s.front();
+}
+
+double ArcLengthTable::ArcLength() const {
+	return length.back();
+}
+
+double ArcLengthTable::PathLength() const {
+	return s.back();
+}
+
+unsigned int ArcLengthTable::LookupS(double _s) const {
+	// try the cached interval and the next one before searching :
+	if (s[cached_s] <= _s && _s <= s[cached_s+1])
+		return cached_s;
+	if (cached_s+2 < s.size() && s[cached_s+1] <= _s && _s <= s[cached_s+2])
+		return ++cached_s;
+	cached_s = std::upper_bound(s.begin(),s.end(),_s) - s.begin();
+	cached_s = std::min<unsigned int>(std::max<unsigned int>(cached_s,1),s.size()-1) - 1;
+	return cached_s;
+}
+
+unsigned int ArcLengthTable::LookupLength(double _length) const {
+	if (length[cached_length] <= _length && _length <= length[cached_length+1])
+		return cached_length;
+	if (cached_length+2 < length.size() && length[cached_length+1] <= _length && _length <= length[cached_length+2])
+		return ++cached_length;
+	cached_length = std::upper_bound(length.begin(),length.end(),_length) - length.begin();
+	cached_length = std::min<unsigned int>(std::max<unsigned int>(cached_length,1),length.size()-1) - 1;
+	return cached_length;
+}
+
+double ArcLengthTable::LengthToS(double _length) const {
+	if (s.size() < 2)
+		return s.front();
+	_length = std::max(length.front(),std::min(_length,length.back()));
+	unsigned int i = LookupLength(_length);
+	double h = length[i+1]-length[i];
+	if (h <= 0)
+		return s[i];
+	return Hermite((_length-length[i])/h,h,s[i],s[i+1],id0[i],id1[i]);
+}
+
+double ArcLengthTable::SToLength(double _s) const {
+	if (s.size() < 2)
+		return length.front();
+	_s = std::max(s.front(),std::min(_s,s.back()));
+	unsigned int i = LookupS(_s);
+	double h = s[i+1]-s[i];
+	return Hermite((_s-s[i])/h,h,length[i],length[i+1],fd0[i],fd1[i]);
+}
+
+static void WriteDoubleVector(BinaryWriter& w,const std::vector<double>& v) {
+	w.WriteUInt(v.size());
+	if (!v.empty())
+		w.WriteDoubles(&v[0],v.size());
+}
+
+static void ReadDoubleVector(BinaryReader& r,std::vector<double>& v) {
+	v.resize(r.ReadCount(8));
+	if (!v.empty())
+		r.ReadDoubles(&v[0],v.size());
+}
+
+void ArcLengthTable::WriteBinary(BinaryWriter& w) const {
+	WriteDoubleVector(w,s);
+	WriteDoubleVector(w,length);
+	WriteDoubleVector(w,fd0);
+	WriteDoubleVector(w,fd1);
+	WriteDoubleVector(w,id0);
+	WriteDoubleVector(w,id1);
+}
+
+ArcLengthTable ArcLengthTable::ReadBinary(BinaryReader& r) {
+	ArcLengthTable table;
+	ReadDoubleVector(r,table.s);
+	ReadDoubleVector(r,table.length);
+	ReadDoubleVector(r,table.fd0);
+	ReadDoubleVector(r,table.fd1);
+	ReadDoubleVector(r,table.id0);
+	ReadDoubleVector(r,table.id1);
+	if (table.s.empty() || table.length.size()!=table.s.size() ||
+		table.fd0.size()+1!=table.s.size() || table.fd1.size()+1!=table.s.size() ||
+		table.id0.size()+1!=table.s.size() || table.id1.size()+1!=table.s.size())
+		throw Error_MotionIO_Binary(3);
+	return table;
+}
+
+}
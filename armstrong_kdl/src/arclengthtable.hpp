@@ -0,0 +1,129 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_MOTION_ARCLENGTHTABLE_H
+#define KDL_MOTION_ARCLENGTHTABLE_H
+
+#include "path.hpp"
+#include <vector>
+
+namespace ARMstrongKDL {
+
+class BinaryWriter;
+class BinaryReader;
+
+/**
+ * A precomputed lookup table between the path parameter s of a Path
+ * and the physical (translational) arc length along that path.
+ *
+ * The arc length is integrated (Gauss-Legendre) at a number of knots,
+ * and interpolated in both directions with a monotone cubic Hermite
+ * spline, using the speed |dp/ds| at the knots.  Lookups cache the last
+ * used interval, such that a sequence of increasing (or slowly varying)
+ * queries costs O(1) per query.
+ *
+ * Several paths can be appended to the same table, e.g. the segments of
+ * a Path_Composite, such that the knots coincide with the segment boundaries.
+ *
+ * \warning a table is not thread safe because of the lookup cache.
+ * @ingroup Motion
+ */
+class ArcLengthTable
+	{
+		std::vector<double> s;          // knots in the path parameter
+		std::vector<double> length;     // arc length at the knots
+		// per interval : derivatives at the start and end of the interval,
+		// for the arc length in function of s and for its inverse
+		std::vector<double> fd0,fd1,id0,id1;
+
+		mutable unsigned int cached_s;
+		mutable unsigned int cached_length;
+
+		unsigned int LookupS(double s) const;
+		unsigned int LookupLength(double length) const;
+	public:
+		/**
+		 * Constructs an empty table.
+		 */
+		ArcLengthTable();
+
+		/**
+		 * Constructs an empty table that starts at path parameter s0 and
+		 * arc length length0.
+		 */
+		ArcLengthTable(double s0,double length0);
+
+		/**
+		 * Constructs the table for path, using nrofsamples intervals that
+		 * are equally spaced in s.
+		 */
+		ArcLengthTable(Path& path,int nrofsamples=100);
+
+		/**
+		 * Appends path to the table, its parameter s starts at the end
+		 * of the already added paths.
+		 * \param path path to add
+		 * \param nrofsamples number of intervals, equally spaced in s, for this path.
+		 */
+		void Add(Path& path,int nrofsamples);
+
+		/**
+		 * Removes the intervals of the table that end before or at s,
+		 * the remaining knots keep their value of s and arc length.
+		 */
+		void RemoveBefore(double s);
+
+		/**
+		 * Returns the arc length at the end of the table.
+		 */
+		double ArcLength() const;
+
+		/**
+		 * Returns the value of the path parameter s at the end of the table.
+		 */
+		double PathLength() const;
+
+		/**
+		 * Returns the value of the path parameter s at the start of the table.
+		 */
+		double StartS() const;
+
+		/**
+		 * Converts a physical length along the path to the path parameter s.
+		 * length is clamped to the range of the table.  If a part of the path does not
+		 * translate, the start of that part is returned.
+		 */
+		double LengthToS(double length) const;
+
+		/**
+		 * Converts the path parameter s to the physical length along the path.
+		 * s is clamped to the range of the table.
+		 */
+		double SToLength(double s) const;
+
+		/**
+		 * Writes the table in the binary format, see BinaryWriter.
+		 */
+		void WriteBinary(BinaryWriter& w) const;
+
+		/**
+		 * Reads a table from the binary format, see BinaryReader.
+		 */
+		static ArcLengthTable ReadBinary(BinaryReader& r);
+	};
+
+}
+
+
+#endif
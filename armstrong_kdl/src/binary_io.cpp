@@ -0,0 +1,175 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "binary_io.hpp"
+#include "utilities/error.h"
+#include <cstring>
+#include <iterator>
+#include <stdint.h>
+
+namespace ARMstrongKDL {
+
+static const char binary_magic[4] = {'K','D','L','B'};
+
+// explicit byte order, such that the format does not depend on the host :
+static inline void EncodeUInt64(uint64_t value,unsigned char* bytes,int n) {
+	for (int i=0;i<n;++i)
+		bytes[i] = static_cast<unsigned char>(value >> (8*i));
+}
+
+static inline uint64_t DecodeUInt64(const unsigned char* bytes,int n) {
+	uint64_t value = 0;
+	for (int i=0;i<n;++i)
+		value |= static_cast<uint64_t>(bytes[i]) << (8*i);
+	return value;
+}
+
+BinaryWriter::BinaryWriter(std::ostream& _os):
+	os(_os)
+{
+	os.write(binary_magic,4);
+	WriteUInt(version);
+}
+
+void BinaryWriter::WriteUInt(unsigned int value) {
+	unsigned char bytes[4];
+	EncodeUInt64(value,bytes,4);
+	os.write(reinterpret_cast<const char*>(bytes),4);
+}
+
+void BinaryWriter::WriteInt(int value) {
+	WriteUInt(static_cast<unsigned int>(value));
+}
+
+void BinaryWriter::WriteBool(bool value) {
+	WriteUInt(value ? 1 : 0);
+}
+
+void BinaryWriter::WriteDouble(double value) {
+	uint64_t bits;
+	memcpy(&bits,&value,8);
+	unsigned char bytes[8];
+	EncodeUInt64(bits,bytes,8);
+	os.write(reinterpret_cast<const char*>(bytes),8);
+}
+
+void BinaryWriter::WriteDoubles(const double* values,unsigned int n) {
+	for (unsigned int i=0;i<n;++i)
+		WriteDouble(values[i]);
+}
+
+void BinaryWriter::WriteVector(const Vector& v) {
+	WriteDoubles(v.data,3);
+}
+
+void BinaryWriter::WriteRotation(const Rotation& R) {
+	WriteDoubles(R.data,9);
+}
+
+void BinaryWriter::WriteFrame(const Frame& F) {
+	WriteRotation(F.M);
+	WriteVector(F.p);
+}
+
+
+BinaryReader::BinaryReader(const void* _data,std::size_t size):
+	data(static_cast<const unsigned char*>(_data)),
+	end(static_cast<const unsigned char*>(_data)+size)
+{
+	Check(4);
+	if (memcmp(data,binary_magic,4)!=0)
+		throw Error_MotionIO_Binary(1);
+	data += 4;
+	if (ReadUInt() > BinaryWriter::version)
+		throw Error_MotionIO_Binary(2);
+}
+
+void BinaryReader::Check(std::size_t nrofbytes) const {
+	if (static_cast<std::size_t>(end-data) < nrofbytes)
+		throw Error_MotionIO_Binary(3);
+}
+
+unsigned int BinaryReader::ReadUInt() {
+	Check(4);
+	unsigned int value = static_cast<unsigned int>(DecodeUInt64(data,4));
+	data += 4;
+	return value;
+}
+
+unsigned int BinaryReader::ReadCount(std::size_t elementsize) {
+	unsigned int n = ReadUInt();
+	if (elementsize>0 && static_cast<std::size_t>(end-data)/elementsize < n)
+		throw Error_MotionIO_Binary(3);
+	return n;
+}
+
+int BinaryReader::ReadInt() {
+	return static_cast<int>(ReadUInt());
+}
+
+bool BinaryReader::ReadBool() {
+	return ReadUInt()!=0;
+}
+
+double BinaryReader::ReadDouble() {
+	Check(8);
+	uint64_t bits = DecodeUInt64(data,8);
+	data += 8;
+	double value;
+	memcpy(&value,&bits,8);
+	return value;
+}
+
+void BinaryReader::ReadDoubles(double* values,unsigned int n) {
+	Check(8*static_cast<std::size_t>(n));
+	for (unsigned int i=0;i<n;++i)
+		values[i] = ReadDouble();
+}
+
+Vector BinaryReader::ReadVector() {
+	Vector v;
+	ReadDoubles(v.data,3);
+	return v;
+}
+
+Rotation BinaryReader::ReadRotation() {
+	Rotation R;
+	ReadDoubles(R.data,9);
+	return R;
+}
+
+Frame BinaryReader::ReadFrame() {
+	Rotation R = ReadRotation();
+	return Frame(R,ReadVector());
+}
+
+void BinaryReader::ExpectTag(unsigned int tag) {
+	if (ReadUInt()!=tag)
+		throw Error_MotionIO_Binary(4);
+}
+
+unsigned int BinaryReader::PeekTag() const {
+	Check(4);
+	return static_cast<unsigned int>(DecodeUInt64(data,4));
+}
+
+bool BinaryReader::AtEnd() const {
+	return data==end;
+}
+
+void ReadBinaryBuffer(std::istream& is,std::vector<char>& buffer) {
+	buffer.assign(std::istreambuf_iterator<char>(is),std::istreambuf_iterator<char>());
+}
+
+}
@@ -0,0 +1,161 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+/**
+ * \file
+ * Binary I/O of the Motion classes (Path, VelocityProfile,
+ * RotationalInterpolation and Trajectory).
+ *
+ * \verbatim
+ * The format is a header followed by any number of objects :
+ *   header  : "KDLB" uint32 version
+ *   object  : uint32 tag, followed by the data of the object
+ *   uint32  : 4 bytes, little-endian
+ *   double  : 8 bytes IEEE-754, little-endian
+ *   Vector  : 3 doubles
+ *   Rotation: 9 doubles, row major
+ *   Frame   : Rotation, Vector
+ * \endverbatim
+ *
+ * Contrary to the text format (Write/Read), the complete state of an
+ * object is stored, e.g. a velocity profile keeps its planned motion.
+ * BinaryReader decodes directly from a memory buffer, such that a file
+ * can be memory-mapped and its objects can be loaded without a parser
+ * or intermediate copies.
+ */
+
+#ifndef KDL_MOTION_BINARY_IO_H
+#define KDL_MOTION_BINARY_IO_H
+
+#include "frames.hpp"
+#include <iostream>
+#include <vector>
+#include <cstddef>
+
+namespace ARMstrongKDL {
+
+/**
+ * Tags that identify the type of an object in the binary format.
+ */
+enum BinaryTag {
+	BIN_PATH_LINE                 = 0x100,
+	BIN_PATH_CIRCLE               = 0x101,
+	BIN_PATH_COMPOSITE            = 0x102,
+	BIN_PATH_ROUNDED_COMPOSITE    = 0x103,
+	BIN_PATH_POINT                = 0x104,
+	BIN_PATH_CYCLIC_CLOSED        = 0x105,
+	BIN_PATH_SPLINE               = 0x106,
+	BIN_VELPROF_DIRAC             = 0x200,
+	BIN_VELPROF_RECTANGULAR       = 0x201,
+	BIN_VELPROF_TRAP              = 0x202,
+	BIN_VELPROF_TRAPHALF          = 0x203,
+	BIN_VELPROF_SPLINE            = 0x204,
+	BIN_VELPROF_JERKLIMITED       = 0x205,
+	BIN_ROTINTERP_SINGLEAXIS      = 0x300,
+	BIN_TRAJ_SEGMENT              = 0x400,
+	BIN_TRAJ_COMPOSITE            = 0x401,
+	BIN_TRAJ_STATIONARY           = 0x402
+};
+
+/**
+ * Writes the binary format to a stream, the header is written
+ * by the constructor.
+ * @ingroup Motion
+ */
+class BinaryWriter
+	{
+		std::ostream& os;
+	public:
+		static const unsigned int version = 1;
+
+		/**
+		 * Writes the header to os, os should be opened in binary mode.
+		 */
+		explicit BinaryWriter(std::ostream& os);
+
+		void WriteUInt(unsigned int value);
+		void WriteInt(int value);
+		void WriteBool(bool value);
+		void WriteDouble(double value);
+		void WriteDoubles(const double* values,unsigned int n);
+		void WriteVector(const Vector& v);
+		void WriteRotation(const Rotation& R);
+		void WriteFrame(const Frame& F);
+	};
+
+/**
+ * Reads the binary format from a memory buffer (e.g. a memory-mapped
+ * file), the header is checked by the constructor.
+ *
+ * The buffer is not copied and should remain valid while reading.
+ * Reading past the end of the buffer, an unknown tag, or a wrong header
+ * or version throws Error_MotionIO_Binary.
+ * @ingroup Motion
+ */
+class BinaryReader
+	{
+		const unsigned char* data;
+		const unsigned char* end;
+
+		void Check(std::size_t nrofbytes) const;
+	public:
+		/**
+		 * \param data start of the buffer
+		 * \param size size of the buffer in bytes
+		 */
+		BinaryReader(const void* data,std::size_t size);
+
+		unsigned int ReadUInt();
+
+		/**
+		 * Reads the number of elements of an array, throws
+		 * Error_MotionIO_Binary if less than that many elements of
+		 * elementsize bytes are left, such that a corrupt count
+		 * cannot allocate more than the size of the buffer.
+		 */
+		unsigned int ReadCount(std::size_t elementsize);
+		int ReadInt();
+		bool ReadBool();
+		double ReadDouble();
+		void ReadDoubles(double* values,unsigned int n);
+		Vector ReadVector();
+		Rotation ReadRotation();
+		Frame ReadFrame();
+
+		/**
+		 * Reads a tag, throws Error_MotionIO_Binary if it is not equal to tag.
+		 */
+		void ExpectTag(unsigned int tag);
+
+		/**
+		 * Returns the next tag without consuming it.
+		 */
+		unsigned int PeekTag() const;
+
+		/**
+		 * Returns true if the end of the buffer is reached.
+		 */
+		bool AtEnd() const;
+	};
+
+/**
+ * Reads a complete stream into buffer, e.g. to use a BinaryReader
+ * on a file that is not memory-mapped.
+ */
+void ReadBinaryBuffer(std::istream& is,std::vector<char>& buffer);
+
+}
+
+
+#endif
@@ -0,0 +1,434 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chaincodegenerator.hpp"
+#include <sstream>
+#include <iomanip>
+#include <cctype>
+#include <vector>
+
+namespace ARMstrongKDL {
+
+    // a double literal that reads back to the same value
+    static std::string Num(double d)
+    {
+        std::ostringstream s;
+        s << std::setprecision(17) << d;
+        std::string str = s.str();
+        if (str.find_first_of(".en") == std::string::npos)
+            str += ".0";
+        return str;
+    }
+
+    static std::string Vec(const Vector& v)
+    {
+        return "Vector("+Num(v.x())+","+Num(v.y())+","+Num(v.z())+")";
+    }
+
+    static std::string Array(const double* d,int n)
+    {
+        std::string str = "{";
+        for (int i=0;i<n;++i)
+            str += (i==0 ? "" : ",")+Num(d[i]);
+        return str+"}";
+    }
+
+    // exact comparisons, also when KDL_USE_EQUAL is defined
+    static bool IsZero(const Vector& v)
+    {
+        return v(0)==0.0 && v(1)==0.0 && v(2)==0.0;
+    }
+
+    static bool IsIdentity(const Rotation& R)
+    {
+        for (int i=0;i<9;++i)
+            if (R.data[i]!=(i%4==0 ? 1.0 : 0.0))
+                return false;
+        return true;
+    }
+
+    static bool IsRotational(const Joint& joint)
+    {
+        switch(joint.getType()){
+        case Joint::RotAxis:
+        case Joint::RotX:
+        case Joint::RotY:
+        case Joint::RotZ:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // axis of the joint, scaled, in the frame before the joint
+    static Vector ScaledAxis(const Joint& joint)
+    {
+        return joint.JointAxis()*joint.getScale();
+    }
+
+    // scale*q(j)+offset
+    static std::string JointValue(const Joint& joint,const std::string& q,unsigned int j)
+    {
+        std::ostringstream s;
+        s << q << "(" << j << ")";
+        std::string str = s.str();
+        if (joint.getScale()!=1.0)
+            str = Num(joint.getScale())+"*"+str;
+        if (joint.getOffset()!=0.0)
+            str = "("+str+"+"+Num(joint.getOffset())+")";
+        return str;
+    }
+
+    static bool HasInertia(const Segment& segment)
+    {
+        const RigidBodyInertia& I = segment.getInertia();
+        if (I.getMass()!=0.0 || !IsZero(I.getSpatialMomentum()))
+            return true;
+        RotationalInertia Ir = I.getRotationalInertia();
+        for (int i=0;i<9;++i)
+            if (Ir.data[i]!=0.0)
+                return true;
+        return false;
+    }
+
+    // statements for F = F*joint.pose(value)
+    static void ApplyJointPose(std::ostream& os,const Joint& joint,const std::string& value,const std::string& F)
+    {
+        switch(joint.getType()){
+        case Joint::RotAxis:
+            if (!IsZero(joint.JointOrigin()))
+                os << "    " << F << ".p += " << F << ".M*" << Vec(joint.JointOrigin()) << ";\n";
+            os << "    " << F << ".M = " << F << ".M*Rotation::Rot2(" << Vec(joint.JointAxis()) << "," << value << ");\n";
+            break;
+        case Joint::RotX:
+            os << "    " << F << ".M.DoRotX(" << value << ");\n";
+            break;
+        case Joint::RotY:
+            os << "    " << F << ".M.DoRotY(" << value << ");\n";
+            break;
+        case Joint::RotZ:
+            os << "    " << F << ".M.DoRotZ(" << value << ");\n";
+            break;
+        case Joint::TransAxis:
+            os << "    " << F << ".p += " << F << ".M*(" << Vec(joint.JointOrigin()) << "+"
+               << Vec(joint.JointAxis()) << "*" << value << ");\n";
+            break;
+        case Joint::TransX:
+            os << "    " << F << ".p += " << F << ".M.UnitX()*" << value << ";\n";
+            break;
+        case Joint::TransY:
+            os << "    " << F << ".p += " << F << ".M.UnitY()*" << value << ";\n";
+            break;
+        case Joint::TransZ:
+            os << "    " << F << ".p += " << F << ".M.UnitZ()*" << value << ";\n";
+            break;
+        default:
+            break;
+        }
+    }
+
+    // statements for F = F*segment.getFrameToTipZero()
+    static void ApplyTip(std::ostream& os,const Segment& segment,unsigned int i,const std::string& F)
+    {
+        Frame tip = segment.getFrameToTipZero();
+        if (IsIdentity(tip.M)) {
+            if (!IsZero(tip.p))
+                os << "    " << F << ".p += " << F << ".M*Vector(params::tip" << i << "[9],params::tip"
+                   << i << "[10],params::tip" << i << "[11]);\n";
+        } else {
+            os << "    " << F << " = " << F << "*Tip(params::tip" << i << ");\n";
+        }
+    }
+
+    static bool IsIdentity(const Frame& F)
+    {
+        return IsIdentity(F.M) && IsZero(F.p);
+    }
+
+    // expression for the pose of the segment, see Segment::pose
+    static std::string SegmentPose(const Segment& segment,unsigned int i,const std::string& value)
+    {
+        const Joint& joint = segment.getJoint();
+        std::string tip;
+        if (!IsIdentity(segment.getFrameToTipZero())) {
+            std::ostringstream s;
+            s << "Tip(params::tip" << i << ")";
+            tip = s.str();
+        }
+        std::string pose;
+        switch(joint.getType()){
+        case Joint::RotAxis:
+            pose = "Frame(Rotation::Rot2("+Vec(joint.JointAxis())+","+value+"),"+Vec(joint.JointOrigin())+")";
+            break;
+        case Joint::RotX:
+            pose = "Frame(Rotation::RotX("+value+"))";
+            break;
+        case Joint::RotY:
+            pose = "Frame(Rotation::RotY("+value+"))";
+            break;
+        case Joint::RotZ:
+            pose = "Frame(Rotation::RotZ("+value+"))";
+            break;
+        case Joint::TransAxis:
+            pose = "Frame("+Vec(joint.JointOrigin())+"+"+Vec(joint.JointAxis())+"*"+value+")";
+            break;
+        case Joint::TransX:
+            pose = "Frame(Vector("+value+",0.0,0.0))";
+            break;
+        case Joint::TransY:
+            pose = "Frame(Vector(0.0,"+value+",0.0))";
+            break;
+        case Joint::TransZ:
+            pose = "Frame(Vector(0.0,0.0,"+value+"))";
+            break;
+        default:
+            break;
+        }
+        if (pose.empty())
+            return tip.empty() ? "Frame::Identity()" : tip;
+        return tip.empty() ? pose : pose+"*"+tip;
+    }
+
+    ChainCodeGenerator::ChainCodeGenerator(const Chain& _chain):
+        chain(_chain)
+    {
+    }
+
+    void ChainCodeGenerator::generate(std::ostream& os,const std::string& name) const
+    {
+        std::string guard = "KDL_GENERATED_";
+        for (size_t i=0;i<name.size();++i)
+            guard += static_cast<char>(std::toupper(static_cast<unsigned char>(name[i])));
+        guard += "_HPP";
+
+        os << "// Generated by ARMstrongKDL::ChainCodeGenerator for a chain with "
+           << chain.getNrOfSegments() << " segments and " << chain.getNrOfJoints() << " joints.\n"
+           << "// Do not edit, generate it again when the chain changes.\n\n"
+           << "#ifndef " << guard << "\n"
+           << "#define " << guard << "\n\n"
+           << "#include <" << include_prefix << "frames.hpp>\n"
+           << "#include <" << include_prefix << "jntarray.hpp>\n"
+           << "#include <" << include_prefix << "jacobian.hpp>\n"
+           << "#include <vector>\n\n"
+           << "namespace " << name << " {\n\n"
+           << "using ARMstrongKDL::Vector;\n"
+           << "using ARMstrongKDL::Rotation;\n"
+           << "using ARMstrongKDL::Frame;\n"
+           << "using ARMstrongKDL::Twist;\n"
+           << "using ARMstrongKDL::Wrench;\n"
+           << "using ARMstrongKDL::JntArray;\n"
+           << "using ARMstrongKDL::Jacobian;\n\n"
+           << "constexpr unsigned int nj = " << chain.getNrOfJoints() << ";\n"
+           << "constexpr unsigned int ns = " << chain.getNrOfSegments() << ";\n\n";
+        generateParams(os);
+        os << "//! frame from a tip array : rotation (row major) and position\n"
+           << "inline Frame Tip(const double* c)\n{\n"
+           << "    return Frame(Rotation(c[0],c[1],c[2],c[3],c[4],c[5],c[6],c[7],c[8]),Vector(c[9],c[10],c[11]));\n}\n\n"
+           << "//! twist from a unit_twist array : velocity and rotational velocity\n"
+           << "inline Twist UnitTwist(const double* c)\n{\n"
+           << "    return Twist(Vector(c[0],c[1],c[2]),Vector(c[3],c[4],c[5]));\n}\n\n"
+           << "//! spatial momentum for an inertia array : m, h=m*cog and I (row major), see RigidBodyInertia\n"
+           << "inline Wrench Momentum(const double* I,const Twist& t)\n{\n"
+           << "    const Vector h(I[1],I[2],I[3]);\n"
+           << "    return Wrench(I[0]*t.vel-h*t.rot,\n"
+           << "                  Vector(I[4]*t.rot(0)+I[5]*t.rot(1)+I[6]*t.rot(2),\n"
+           << "                         I[7]*t.rot(0)+I[8]*t.rot(1)+I[9]*t.rot(2),\n"
+           << "                         I[10]*t.rot(0)+I[11]*t.rot(1)+I[12]*t.rot(2))+h*t.vel);\n}\n\n";
+        generateFk(os);
+        generateJac(os);
+        generateRne(os);
+        os << "}\n\n#endif\n";
+    }
+
+    void ChainCodeGenerator::generateParams(std::ostream& os) const
+    {
+        os << "namespace params {\n";
+        for (unsigned int i=0;i<chain.getNrOfSegments();++i) {
+            const Segment& segment = chain.getSegment(i);
+            const Joint& joint = segment.getJoint();
+            os << "// segment " << i << " \"" << segment.getName() << "\", joint type "
+               << joint.getTypeName() << "\n";
+            Frame tip = segment.getFrameToTipZero();
+            double t[12];
+            for (int k=0;k<9;++k)
+                t[k] = tip.M.data[k];
+            for (int k=0;k<3;++k)
+                t[9+k] = tip.p(k);
+            os << "constexpr double tip" << i << "[12] = " << Array(t,12) << ";\n";
+            if (joint.getType()!=Joint::Fixed) {
+                // the unit twist in the segment frame does not depend on q
+                Twist S = segment.pose(0.0).M.Inverse(segment.twist(0.0,1.0));
+                double s[6] = {S.vel(0),S.vel(1),S.vel(2),S.rot(0),S.rot(1),S.rot(2)};
+                os << "constexpr double unit_twist" << i << "[6] = " << Array(s,6) << ";\n";
+            }
+            if (HasInertia(segment)) {
+                const RigidBodyInertia& I = segment.getInertia();
+                RotationalInertia Ir = I.getRotationalInertia();
+                double in[13];
+                in[0] = I.getMass();
+                for (int k=0;k<3;++k)
+                    in[1+k] = I.getSpatialMomentum()(k);
+                for (int k=0;k<9;++k)
+                    in[4+k] = Ir.data[k];
+                os << "constexpr double inertia" << i << "[13] = " << Array(in,13) << ";\n";
+            }
+        }
+        os << "}\n\n";
+    }
+
+    void ChainCodeGenerator::generateFk(std::ostream& os) const
+    {
+        os << "//! end effector pose, see ChainFkSolverPos_recursive\n"
+           << "inline void JntToCart(const JntArray& q,Frame& p_out)\n{\n"
+           << "    Frame F;\n";
+        unsigned int j=0;
+        for (unsigned int i=0;i<chain.getNrOfSegments();++i) {
+            const Segment& segment = chain.getSegment(i);
+            os << "    // segment " << i << "\n";
+            if (segment.getJoint().getType()!=Joint::Fixed) {
+                ApplyJointPose(os,segment.getJoint(),JointValue(segment.getJoint(),"q",j),"F");
+                j++;
+            }
+            ApplyTip(os,segment,i,"F");
+        }
+        os << "    p_out = F;\n}\n\n";
+    }
+
+    void ChainCodeGenerator::generateJac(std::ostream& os) const
+    {
+        os << "//! jacobian with reference point the end effector and reference frame the base,\n"
+           << "//! see ChainJntToJacSolver.  jac should have nj columns.\n"
+           << "inline void JntToJac(const JntArray& q,Jacobian& jac)\n{\n"
+           << "    Frame F;\n";
+        unsigned int j=0;
+        for (unsigned int i=0;i<chain.getNrOfSegments();++i) {
+            const Segment& segment = chain.getSegment(i);
+            const Joint& joint = segment.getJoint();
+            os << "    // segment " << i << "\n";
+            if (joint.getType()!=Joint::Fixed) {
+                if (IsRotational(joint)) {
+                    // axis and a point on it, in the base
+                    os << "    const Vector w" << j << " = F.M*" << Vec(ScaledAxis(joint)) << ";\n";
+                    if (joint.getType()==Joint::RotAxis && !IsZero(joint.JointOrigin()))
+                        os << "    const Vector p" << j << " = F.p+F.M*" << Vec(joint.JointOrigin()) << ";\n";
+                    else
+                        os << "    const Vector p" << j << " = F.p;\n";
+                } else {
+                    os << "    jac.setColumn(" << j << ",Twist(F.M*" << Vec(ScaledAxis(joint)) << ",Vector::Zero()));\n";
+                }
+                ApplyJointPose(os,joint,JointValue(joint,"q",j),"F");
+                j++;
+            }
+            ApplyTip(os,segment,i,"F");
+        }
+        j=0;
+        for (unsigned int i=0;i<chain.getNrOfSegments();++i) {
+            const Joint& joint = chain.getSegment(i).getJoint();
+            if (joint.getType()==Joint::Fixed)
+                continue;
+            if (IsRotational(joint))
+                os << "    jac.setColumn(" << j << ",Twist(w" << j << "*(F.p-p" << j << "),w" << j << "));\n";
+            j++;
+        }
+        os << "}\n\n";
+    }
+
+    void ChainCodeGenerator::generateRne(std::ostream& os) const
+    {
+        os << "//! joint torques, see ChainIdSolver_RNE.  f_ext should have ns elements.\n"
+           << "inline void CartToJnt(const JntArray& q,const JntArray& q_dot,const JntArray& q_dotdot,\n"
+           << "                      const Vector& grav,const std::vector<Wrench>& f_ext,JntArray& torques)\n{\n";
+        unsigned int ns = chain.getNrOfSegments();
+        // the velocity and acceleration of a segment are only needed up to
+        // the last segment with an inertia, such that the generated code
+        // has no unused variables
+        std::vector<bool> needed(ns+1,false);
+        for (int i=ns-1;i>=0;--i)
+            needed[i] = needed[i+1] || HasInertia(chain.getSegment(i));
+        if (needed[0])
+            os << "    const Twist ag = -Twist(grav,Vector::Zero());\n";
+        if (ns==0) {
+            os << "}\n\n";
+            return;
+        }
+        // sweep from root to leaf, X is left out for fixed joints with
+        // an identity frame
+        std::vector<bool> identity(ns);
+        unsigned int j=0;
+        for (unsigned int i=0;i<ns;++i) {
+            const Segment& segment = chain.getSegment(i);
+            const Joint& joint = segment.getJoint();
+            bool moving = joint.getType()!=Joint::Fixed;
+            identity[i] = !moving && IsIdentity(segment.getFrameToTipZero());
+            os << "    // segment " << i << "\n";
+            // X0 only transforms ag, the others also the wrenches
+            if (!identity[i] && (i!=0 || needed[i]))
+                os << "    const Frame X" << i << " = " << SegmentPose(segment,i,moving ? JointValue(joint,"q",j) : "") << ";\n";
+            if (moving)
+                os << "    const Twist S" << i << " = UnitTwist(params::unit_twist" << i << ");\n";
+            if (!needed[i]) {
+                if (moving)
+                    j++;
+                os << "    Wrench f" << i << " = -f_ext[" << i << "];\n";
+                continue;
+            }
+            // velocity and acceleration of the parent, in this segment
+            std::ostringstream v_in,a_in;
+            if (i==0) {
+                a_in << (identity[i] ? "ag" : "X0.Inverse(ag)");
+            } else if (identity[i]) {
+                v_in << "v" << i-1;
+                a_in << "a" << i-1;
+            } else {
+                v_in << "X" << i << ".Inverse(v" << i-1 << ")";
+                a_in << "X" << i << ".Inverse(a" << i-1 << ")";
+            }
+            if (moving) {
+                os << "    const Twist vj" << i << " = S" << i << "*q_dot(" << j << ");\n"
+                   << "    const Twist v" << i << " = " << (i==0 ? std::string() : v_in.str()+"+") << "vj" << i << ";\n"
+                   << "    const Twist a" << i << " = " << a_in.str() << "+S" << i << "*q_dotdot(" << j << ")+v"
+                   << i << "*vj" << i << ";\n";
+                j++;
+            } else {
+                os << "    const Twist v" << i << " = " << (i==0 ? std::string("Twist::Zero()") : v_in.str()) << ";\n"
+                   << "    const Twist a" << i << " = " << a_in.str() << ";\n";
+            }
+            if (HasInertia(segment))
+                os << "    Wrench f" << i << " = Momentum(params::inertia" << i << ",a" << i << ")+v" << i
+                   << "*Momentum(params::inertia" << i << ",v" << i << ")-f_ext[" << i << "];\n";
+            else
+                os << "    Wrench f" << i << " = -f_ext[" << i << "];\n";
+        }
+        // sweep from leaf to root
+        j=chain.getNrOfJoints();
+        for (int i=ns-1;i>=0;--i) {
+            const Joint& joint = chain.getSegment(i).getJoint();
+            if (joint.getType()!=Joint::Fixed) {
+                --j;
+                os << "    torques(" << j << ") = dot(S" << i << ",f" << i << ")";
+                if (joint.getInertia()!=0.0)
+                    os << "+" << Num(joint.getInertia()) << "*q_dotdot(" << j << ")";
+                os << ";\n";
+            }
+            if (i!=0) {
+                if (identity[i])
+                    os << "    f" << i-1 << " = f" << i-1 << "+f" << i << ";\n";
+                else
+                    os << "    f" << i-1 << " = f" << i-1 << "+X" << i << "*f" << i << ";\n";
+            }
+        }
+        os << "}\n\n";
+    }
+
+}
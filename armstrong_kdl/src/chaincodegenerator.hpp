@@ -0,0 +1,80 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAINCODEGENERATOR_HPP
+#define KDL_CHAINCODEGENERATOR_HPP
+
+#include "chain.hpp"
+#include <ostream>
+#include <string>
+
+namespace ARMstrongKDL {
+
+    /**
+     * \brief Writes a C++ header with kinematics and dynamics functions
+     * that are specialized for one chain.
+     *
+     * The generated header defines, in namespace name :
+     *  - the constants nj and ns, the number of joints and segments,
+     *  - namespace params with the geometry and inertia of every segment
+     *    as constexpr arrays,
+     *  - JntToCart(q,p_out), see ChainFkSolverPos_recursive,
+     *  - JntToJac(q,jac), see ChainJntToJacSolver,
+     *  - CartToJnt(q,q_dot,q_dotdot,grav,f_ext,torques), see
+     *    ChainIdSolver_RNE.
+     *
+     * The loops over the segments are unrolled and the type of every joint
+     * is resolved at generation time, so no Segment or Joint objects are
+     * used at run time.  The generated code only depends on frames.hpp,
+     * jntarray.hpp and jacobian.hpp.  It has to be generated again when
+     * the chain changes.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainCodeGenerator
+    {
+    public:
+        /**
+         * \param chain the chain to generate the functions for, a copy is made.
+         */
+        explicit ChainCodeGenerator(const Chain& chain);
+
+        /**
+         * Prefix of the include directives of the generated header, e.g.
+         * "armstrong_kdl/" for an installed library.  Empty by default.
+         */
+        void setIncludePrefix(const std::string& prefix) { include_prefix = prefix; }
+
+        /**
+         * Writes the header.
+         *
+         * \param os output stream
+         * \param name namespace of the generated functions, has to be a
+         *        valid C++ identifier.  It is also used for the include guard.
+         */
+        void generate(std::ostream& os,const std::string& name) const;
+
+    private:
+        void generateParams(std::ostream& os) const;
+        void generateFk(std::ostream& os) const;
+        void generateJac(std::ostream& os) const;
+        void generateRne(std::ostream& os) const;
+
+        Chain chain;
+        std::string include_prefix;
+    };
+
+}
+
+#endif
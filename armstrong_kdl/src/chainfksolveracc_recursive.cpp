@@ -0,0 +1,128 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainfksolveracc_recursive.hpp"
+
+namespace ARMstrongKDL
+{
+    // F = F*FrameAcc(segment.pose(q),segment.twist(q,qdot),acc), propagated
+    // directly in the base frame.
+    static void ApplySegment(const Segment& segment,double q,double qdot,double qdotdot,FrameAcc& F)
+    {
+        const Joint& joint = segment.getJoint();
+        const Frame& tip = segment.getFrameToTipZero();
+        Frame Fj(F.M.R,F.p.p);
+        joint.applyPose(Fj,q);
+        // velocity and acceleration of the joint origin
+        Vector o = Fj.p-F.p.p;
+        Vector wo = F.M.w*o;
+        Vector v = F.p.v+wo;
+        Vector a = F.p.dv+F.M.dw*o+F.M.w*wo;
+        Vector axis = Fj.M*joint.JointAxis();
+        Vector axis_qd = axis*(joint.getScale()*qdot);
+        Vector axis_qdd = axis*(joint.getScale()*qdotdot);
+        switch(joint.getType()){
+        case Joint::RotAxis:
+        case Joint::RotX:
+        case Joint::RotY:
+        case Joint::RotZ:
+            F.M.dw += F.M.w*axis_qd+axis_qdd;
+            F.M.w += axis_qd;
+            break;
+        case Joint::Fixed:
+            break;
+        default:
+            a += 2.0*(F.M.w*axis_qd)+axis_qdd;
+            v += axis_qd;
+            break;
+        }
+        Vector r = Fj.M*tip.p;
+        Vector wr = F.M.w*r;
+        F.M.R = Fj.M*tip.M;
+        F.p.p = Fj.p+r;
+        F.p.v = v+wr;
+        F.p.dv = a+F.M.dw*r+F.M.w*wr;
+    }
+
+    ChainFkSolverAcc_recursive::ChainFkSolverAcc_recursive(const Chain& _chain):
+        chain(_chain)
+    {
+    }
+
+    ChainFkSolverAcc_recursive::~ChainFkSolverAcc_recursive()
+    {
+    }
+
+    int ChainFkSolverAcc_recursive::JntToCart(const JntArrayAcc& in,FrameAcc& out,int seg_nr)
+    {
+        unsigned int segmentNr;
+        if(seg_nr<0)
+            segmentNr=chain.getNrOfSegments();
+        else
+            segmentNr = seg_nr;
+
+        out=FrameAcc::Identity();
+
+        if(!(in.q.rows()==chain.getNrOfJoints()&&in.qdot.rows()==chain.getNrOfJoints()
+             &&in.qdotdot.rows()==chain.getNrOfJoints()))
+            return (error = E_SIZE_MISMATCH);
+        else if(segmentNr>chain.getNrOfSegments())
+            return (error = E_OUT_OF_RANGE);
+        else{
+            int j=0;
+            for (unsigned int i=0;i<segmentNr;i++) {
+                if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed) {
+                    ApplySegment(chain.getSegment(i),in.q(j),in.qdot(j),in.qdotdot(j),out);
+                    j++;
+                }else{
+                    out=out*chain.getSegment(i).getFrameToTipZero();
+                }
+            }
+            return (error = E_NOERROR);
+        }
+    }
+
+    int ChainFkSolverAcc_recursive::JntToCart(const JntArrayAcc& in,std::vector<FrameAcc>& out,int seg_nr)
+    {
+        unsigned int segmentNr;
+        if(seg_nr<0)
+            segmentNr=chain.getNrOfSegments();
+        else
+            segmentNr = seg_nr;
+
+        if(!(in.q.rows()==chain.getNrOfJoints()&&in.qdot.rows()==chain.getNrOfJoints()
+             &&in.qdotdot.rows()==chain.getNrOfJoints()))
+            return (error = E_SIZE_MISMATCH);
+        else if(segmentNr>chain.getNrOfSegments())
+            return (error = E_OUT_OF_RANGE);
+        else if(out.size()!=segmentNr)
+            return (error = E_SIZE_MISMATCH);
+        else if(segmentNr == 0)
+            return (error = E_OUT_OF_RANGE);
+        else{
+            int j=0;
+            FrameAcc F = FrameAcc::Identity();
+            for (unsigned int i=0;i<segmentNr;i++) {
+                if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed) {
+                    ApplySegment(chain.getSegment(i),in.q(j),in.qdot(j),in.qdotdot(j),F);
+                    j++;
+                }else{
+                    F=F*chain.getSegment(i).getFrameToTipZero();
+                }
+                out[i]=F;
+            }
+            return (error = E_NOERROR);
+        }
+    }
+}
@@ -0,0 +1,48 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAIN_FKSOLVERACC_RECURSIVE_HPP
+#define KDL_CHAIN_FKSOLVERACC_RECURSIVE_HPP
+
+#include "chainfksolver.hpp"
+
+namespace ARMstrongKDL
+{
+    /**
+     * Implementation of a recursive forward position, velocity and
+     * acceleration kinematics algorithm to calculate the position,
+     * velocity and acceleration of the segments of a general kinematic
+     * chain (ARMstrongKDL::Chain), expressed in the base frame.
+     *
+     * Every segment only adds the joint axis terms to the twist and its
+     * derivative of the previous one, instead of composing full FrameAcc
+     * objects.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainFkSolverAcc_recursive : public ChainFkSolverAcc
+    {
+    public:
+        ChainFkSolverAcc_recursive(const Chain& chain);
+        ~ChainFkSolverAcc_recursive();
+
+        virtual int JntToCart(const JntArrayAcc& q_in,FrameAcc& out,int segmentNr=-1);
+        virtual int JntToCart(const JntArrayAcc& q_in,std::vector<FrameAcc>& out,int segmentNr=-1);
+        virtual void updateInternalDataStructures() {};
+    private:
+        const Chain& chain;
+    };
+}
+
+#endif
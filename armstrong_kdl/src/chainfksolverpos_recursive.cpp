@@ -27,8 +27,19 @@
 namespace ARMstrongKDL {
 
     ChainFkSolverPos_recursive::ChainFkSolverPos_recursive(const Chain& _chain):
-        chain(_chain)
+        chain(_chain),
+        mimic(0)
+    {
+    }
+
+    int ChainFkSolverPos_recursive::setMimicMap(const JntMimicMap* map)
     {
+        if(map && map->getNrOfJoints()!=chain.getNrOfJoints())
+            return (error = E_SIZE_MISMATCH);
+        if(map && !map->isValid())
+            return (error = E_OUT_OF_RANGE);
+        mimic = map;
+        return (error = E_NOERROR);
     }
 
     int ChainFkSolverPos_recursive::JntToCart(const JntArray& q_in, Frame& p_out, int seg_nr)    {
@@ -40,7 +51,7 @@ namespace ARMstrongKDL {
 
         p_out = Frame::Identity();
 
-        if(q_in.rows()!=chain.getNrOfJoints())
+        if(q_in.rows()!=nrOfInputs())
             return (error = E_SIZE_MISMATCH);
         else if(segmentNr>chain.getNrOfSegments())
             return (error = E_OUT_OF_RANGE);
@@ -48,10 +59,10 @@ namespace ARMstrongKDL {
             int j=0;
             for(unsigned int i=0;i<segmentNr;i++){
                 if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed) {
-                    p_out = p_out*chain.getSegment(i).pose(q_in(j));
+                    chain.getSegment(i).applyPose(p_out,jointPosition(q_in,j));
                     j++;
                 }else{
-                    p_out = p_out*chain.getSegment(i).pose(0.0);
+                    chain.getSegment(i).applyPose(p_out,0.0);
                 }
             }
             return (error = E_NOERROR);
@@ -64,7 +75,7 @@ namespace ARMstrongKDL {
         else
             segmentNr = seg_nr;
 
-        if(q_in.rows()!=chain.getNrOfJoints())
+        if(q_in.rows()!=nrOfInputs())
             return -1;
         else if(segmentNr>chain.getNrOfSegments())
             return -1;
@@ -76,17 +87,18 @@ namespace ARMstrongKDL {
             int j=0;
             // Initialization
             if(chain.getSegment(0).getJoint().getType()!=Joint::Fixed) {
-                p_out[0] = chain.getSegment(0).pose(q_in(j));
+                p_out[0] = chain.getSegment(0).pose(jointPosition(q_in,j));
                 j++;
             }else
                 p_out[0] = chain.getSegment(0).pose(0.0);
 
             for(unsigned int i=1;i<segmentNr;i++){
+                p_out[i] = p_out[i-1];
                 if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed) {
-                    p_out[i] = p_out[i-1]*chain.getSegment(i).pose(q_in(j));
+                    chain.getSegment(i).applyPose(p_out[i],jointPosition(q_in,j));
                     j++;
                 }else{
-                    p_out[i] = p_out[i-1]*chain.getSegment(i).pose(0.0);
+                    chain.getSegment(i).applyPose(p_out[i],0.0);
                 }
             }
             return 0;
@@ -98,4 +110,153 @@ namespace ARMstrongKDL {
     }
 
 
+
+    // Segment composition and conversions for the representations of
+    // ChainFkSolverPos_representation :
+    static inline void ApplySegment(Frame& p, const Joint& joint, double q, const Frame& f_tip)
+    {
+        joint.applyPose(p,q);
+        p = p*f_tip;
+    }
+
+    static inline void JointPose(const Joint& joint, double q, FrameQuat& out)
+    {
+        double a = joint.getScale()*q+joint.getOffset();
+        switch(joint.getType()){
+        case Joint::RotAxis:
+            out = FrameQuat(Quaternion::Rot2(joint.getAxis(), a), joint.getOrigin());
+            break;
+        case Joint::RotX:
+            out = FrameQuat(Quaternion::RotX(a));
+            break;
+        case Joint::RotY:
+            out = FrameQuat(Quaternion::RotY(a));
+            break;
+        case Joint::RotZ:
+            out = FrameQuat(Quaternion::RotZ(a));
+            break;
+        case Joint::TransAxis:
+            out = FrameQuat(joint.getOrigin() + joint.getAxis()*a);
+            break;
+        case Joint::TransX:
+            out = FrameQuat(Vector(a,0.0,0.0));
+            break;
+        case Joint::TransY:
+            out = FrameQuat(Vector(0.0,a,0.0));
+            break;
+        case Joint::TransZ:
+            out = FrameQuat(Vector(0.0,0.0,a));
+            break;
+        default:
+            out = FrameQuat::Identity();
+        }
+    }
+
+    static inline void ApplySegment(FrameQuat& p, const Joint& joint, double q, const FrameQuat& f_tip)
+    {
+        FrameQuat joint_pose;
+        JointPose(joint,q,joint_pose);
+        p = p*joint_pose*f_tip;
+    }
+
+    static inline void ToRep(const Frame& f, Frame& out) { out = f; }
+    static inline void ToRep(const Frame& f, FrameQuat& out) { out = FrameQuat(f); }
+    static inline Frame ToFrame(const Frame& f) { return f; }
+    static inline Frame ToFrame(const FrameQuat& f) { return f.GetFrame(); }
+    static inline void Renormalize(Frame&) {}
+    static inline void Renormalize(FrameQuat& f) { f.M.Normalize(); }
+
+    template<class FrameRep>
+    ChainFkSolverPos_representation<FrameRep>::ChainFkSolverPos_representation(const Chain& _chain):
+        chain(_chain)
+    {
+        updateInternalDataStructures();
+    }
+
+    template<class FrameRep>
+    void ChainFkSolverPos_representation<FrameRep>::updateInternalDataStructures()
+    {
+        f_tip.resize(chain.getNrOfSegments());
+        for(unsigned int i=0;i<chain.getNrOfSegments();i++)
+            ToRep(chain.getSegment(i).getFrameToTipZero(),f_tip[i]);
+    }
+
+    template<class FrameRep>
+    int ChainFkSolverPos_representation<FrameRep>::JntToCartRep(const JntArray& q_in, FrameRep& p_out, int seg_nr)
+    {
+        unsigned int segmentNr;
+        if(seg_nr<0)
+            segmentNr=chain.getNrOfSegments();
+        else
+            segmentNr = seg_nr;
+
+        p_out = FrameRep::Identity();
+
+        if(f_tip.size()!=chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+        else if(q_in.rows()!=chain.getNrOfJoints())
+            return (error = E_SIZE_MISMATCH);
+        else if(segmentNr>chain.getNrOfSegments())
+            return (error = E_OUT_OF_RANGE);
+
+        int j=0;
+        for(unsigned int i=0;i<segmentNr;i++){
+            const Joint& joint = chain.getSegment(i).getJoint();
+            if(joint.getType()!=Joint::Fixed) {
+                ApplySegment(p_out,joint,q_in(j),f_tip[i]);
+                j++;
+            }else{
+                ApplySegment(p_out,joint,0.0,f_tip[i]);
+            }
+        }
+        Renormalize(p_out);
+        return (error = E_NOERROR);
+    }
+
+    template<class FrameRep>
+    int ChainFkSolverPos_representation<FrameRep>::JntToCart(const JntArray& q_in, Frame& p_out, int seg_nr)
+    {
+        FrameRep p;
+        JntToCartRep(q_in,p,seg_nr);
+        p_out = ToFrame(p);
+        return error;
+    }
+
+    template<class FrameRep>
+    int ChainFkSolverPos_representation<FrameRep>::JntToCart(const JntArray& q_in, std::vector<Frame>& p_out, int seg_nr)
+    {
+        unsigned int segmentNr;
+        if(seg_nr<0)
+            segmentNr=chain.getNrOfSegments();
+        else
+            segmentNr = seg_nr;
+
+        if(f_tip.size()!=chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+        else if(q_in.rows()!=chain.getNrOfJoints())
+            return (error = E_SIZE_MISMATCH);
+        else if(segmentNr>chain.getNrOfSegments() || segmentNr == 0)
+            return (error = E_OUT_OF_RANGE);
+        else if(p_out.size() != segmentNr)
+            return (error = E_SIZE_MISMATCH);
+
+        FrameRep p = FrameRep::Identity();
+        int j=0;
+        for(unsigned int i=0;i<segmentNr;i++){
+            const Joint& joint = chain.getSegment(i).getJoint();
+            if(joint.getType()!=Joint::Fixed) {
+                ApplySegment(p,joint,q_in(j),f_tip[i]);
+                j++;
+            }else{
+                ApplySegment(p,joint,0.0,f_tip[i]);
+            }
+            Renormalize(p);
+            p_out[i] = ToFrame(p);
+        }
+        return (error = E_NOERROR);
+    }
+
+    template class ChainFkSolverPos_representation<Frame>;
+    template class ChainFkSolverPos_representation<FrameQuat>;
+
 }
@@ -23,6 +23,8 @@
 #define KDLCHAINFKSOLVERPOS_RECURSIVE_HPP
 
 #include "chainfksolver.hpp"
+#include "framequat.hpp"
+#include "jntmimicmap.hpp"
 
 namespace ARMstrongKDL {
 
@@ -42,12 +44,70 @@ namespace ARMstrongKDL {
         virtual int JntToCart(const JntArray& q_in, Frame& p_out, int segmentNr=-1);
         virtual int JntToCart(const JntArray& q_in, std::vector<Frame>& p_out, int segmentNr=-1);
 
+        /**
+         * Lets the solver take the reduced coordinates of map as input
+         * instead of all joints of the chain.
+         *
+         * @param map the mimic joints, a pointer is kept, 0 for none
+         * @return E_SIZE_MISMATCH if the map does not match the chain,
+         *         E_OUT_OF_RANGE if the map is not valid
+         */
+        int setMimicMap(const JntMimicMap* map);
+
         virtual void updateInternalDataStructures() {};
 
+    private:
+        double jointPosition(const JntArray& q_in, unsigned int j) const
+        {
+            return mimic ? mimic->position(q_in,j) : q_in(j);
+        }
+        unsigned int nrOfInputs() const
+        {
+            return mimic ? mimic->getNrOfIndependentJoints() : chain.getNrOfJoints();
+        }
+
+        const Chain& chain;
+        const JntMimicMap* mimic;
+    };
+
+    /**
+     * Recursive forward position kinematics with a compile-time choice
+     * of the representation used to compose the segment poses :
+     *  - FrameRep = Frame     : 3x3 rotation matrices, as ChainFkSolverPos_recursive
+     *  - FrameRep = FrameQuat : unit quaternions, cheaper to compose and
+     *                           renormalised once at the end instead of
+     *                           drifting from orthonormality on long chains.
+     *
+     * The tip frames of the segments are converted to FrameRep in
+     * updateInternalDataStructures(), which should be called when the
+     * chain is modified.  The results are always returned as Frame.
+     *
+     * @ingroup KinematicFamily
+     */
+    template<class FrameRep>
+    class ChainFkSolverPos_representation : public ChainFkSolverPos
+    {
+    public:
+        ChainFkSolverPos_representation(const Chain& chain);
+
+        virtual int JntToCart(const JntArray& q_in, Frame& p_out, int segmentNr=-1);
+        virtual int JntToCart(const JntArray& q_in, std::vector<Frame>& p_out, int segmentNr=-1);
+
+        /**
+         * Same as JntToCart, but returns the pose in the internal representation.
+         */
+        int JntToCartRep(const JntArray& q_in, FrameRep& p_out, int segmentNr=-1);
+
+        virtual void updateInternalDataStructures();
+
     private:
         const Chain& chain;
+        std::vector<FrameRep> f_tip;
     };
 
+    typedef ChainFkSolverPos_representation<Frame> ChainFkSolverPos_matrix;
+    typedef ChainFkSolverPos_representation<FrameQuat> ChainFkSolverPos_quaternion;
+
 }
 
 #endif
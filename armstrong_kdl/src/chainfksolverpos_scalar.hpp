@@ -0,0 +1,135 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDLCHAINFKSOLVERPOS_SCALAR_HPP
+#define KDLCHAINFKSOLVERPOS_SCALAR_HPP
+
+#include "chainscalar.hpp"
+#include "solveri.hpp"
+
+namespace ARMstrongKDL {
+
+    /**
+     * Recursive forward position kinematics, see ChainFkSolverPos_recursive,
+     * with scalar type T (e.g. float).
+     *
+     * The chain is converted to T by the constructor and by
+     * updateInternalDataStructures(), which should be called when the
+     * chain is modified.
+     *
+     * @ingroup KinematicFamily
+     */
+    template<typename T>
+    class ChainFkSolverPosT : public SolverI
+    {
+    public:
+        explicit ChainFkSolverPosT(const Chain& chain);
+
+        /**
+         * Calculate forward position kinematics, from joint coordinates
+         * to cartesian pose.
+         *
+         * @param q_in input joint coordinates
+         * @param p_out reference to output cartesian pose
+         * @param segmentNr number of segments to compose, -1 for all
+         *
+         * @return if < 0 something went wrong
+         */
+        int JntToCart(const JntArrayT<T>& q_in, FrameT<T>& p_out, int segmentNr=-1);
+        /**
+         * Same as above, but returns the pose of every segment.
+         */
+        int JntToCart(const JntArrayT<T>& q_in, std::vector<FrameT<T> >& p_out, int segmentNr=-1);
+
+        virtual void updateInternalDataStructures();
+
+    private:
+        const Chain& chain;
+        ChainT<T> chain_t;
+    };
+
+    typedef ChainFkSolverPosT<float> ChainFkSolverPosf;
+
+
+    template<typename T>
+    ChainFkSolverPosT<T>::ChainFkSolverPosT(const Chain& _chain):
+        chain(_chain),chain_t(_chain)
+    {
+    }
+
+    template<typename T>
+    void ChainFkSolverPosT<T>::updateInternalDataStructures()
+    {
+        chain_t.set(chain);
+    }
+
+    template<typename T>
+    int ChainFkSolverPosT<T>::JntToCart(const JntArrayT<T>& q_in, FrameT<T>& p_out, int seg_nr)
+    {
+        unsigned int segmentNr = seg_nr<0 ? chain.getNrOfSegments() : seg_nr;
+
+        p_out = FrameT<T>::Identity();
+
+        if(chain_t.getNrOfSegments()!=chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+        else if(q_in.rows()!=chain.getNrOfJoints())
+            return (error = E_SIZE_MISMATCH);
+        else if(segmentNr>chain.getNrOfSegments())
+            return (error = E_OUT_OF_RANGE);
+
+        int j=0;
+        for(unsigned int i=0;i<segmentNr;i++){
+            const SegmentT<T>& segment = chain_t.segments[i];
+            if(segment.type!=Joint::Fixed) {
+                segment.applyPose(p_out,q_in(j));
+                j++;
+            }else{
+                segment.applyPose(p_out,T(0));
+            }
+        }
+        return (error = E_NOERROR);
+    }
+
+    template<typename T>
+    int ChainFkSolverPosT<T>::JntToCart(const JntArrayT<T>& q_in, std::vector<FrameT<T> >& p_out, int seg_nr)
+    {
+        unsigned int segmentNr = seg_nr<0 ? chain.getNrOfSegments() : seg_nr;
+
+        if(chain_t.getNrOfSegments()!=chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+        else if(q_in.rows()!=chain.getNrOfJoints())
+            return (error = E_SIZE_MISMATCH);
+        else if(segmentNr>chain.getNrOfSegments() || segmentNr==0)
+            return (error = E_OUT_OF_RANGE);
+        else if(p_out.size()!=segmentNr)
+            return (error = E_SIZE_MISMATCH);
+
+        FrameT<T> p;
+        int j=0;
+        for(unsigned int i=0;i<segmentNr;i++){
+            const SegmentT<T>& segment = chain_t.segments[i];
+            if(segment.type!=Joint::Fixed) {
+                segment.applyPose(p,q_in(j));
+                j++;
+            }else{
+                segment.applyPose(p,T(0));
+            }
+            p_out[i] = p;
+        }
+        return (error = E_NOERROR);
+    }
+
+}
+
+#endif
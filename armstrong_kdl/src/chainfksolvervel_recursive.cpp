@@ -25,6 +25,36 @@
 
 namespace ARMstrongKDL
 {
+    // F = F*FrameVel(segment.pose(q),segment.twist(q,qdot)), propagated
+    // directly in the base frame : the joint axis is taken from the rotated
+    // frame and the pose of the joint is computed once.
+    static void ApplySegment(const Segment& segment,double q,double qdot,FrameVel& F)
+    {
+        const Joint& joint = segment.getJoint();
+        const Frame& tip = segment.getFrameToTipZero();
+        Frame Fj(F.M.R,F.p.p);
+        joint.applyPose(Fj,q);
+        // velocity of the joint origin, and of the tip relative to it
+        Vector r = Fj.M*tip.p;
+        Vector v = F.p.v+F.M.w*(Fj.p-F.p.p);
+        switch(joint.getType()){
+        case Joint::RotAxis:
+        case Joint::RotX:
+        case Joint::RotY:
+        case Joint::RotZ:
+            F.M.w += (Fj.M*joint.JointAxis())*(joint.getScale()*qdot);
+            break;
+        case Joint::Fixed:
+            break;
+        default:
+            v += (Fj.M*joint.JointAxis())*(joint.getScale()*qdot);
+            break;
+        }
+        F.M.R = Fj.M*tip.M;
+        F.p.p = Fj.p+r;
+        F.p.v = v+F.M.w*r;
+    }
+
     ChainFkSolverVel_recursive::ChainFkSolverVel_recursive(const Chain& _chain):
         chain(_chain)
     {
@@ -53,12 +83,10 @@ namespace ARMstrongKDL
             for (unsigned int i=0;i<segmentNr;i++) {
                 //Calculate new Frame_base_ee
                 if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed) {
-                    out=out*FrameVel(chain.getSegment(i).pose(in.q(j)),
-                                     chain.getSegment(i).twist(in.q(j),in.qdot(j)));
+                    ApplySegment(chain.getSegment(i),in.q(j),in.qdot(j),out);
                     j++;//Only increase jointnr if the segment has a joint
                 }else{
-                    out=out*FrameVel(chain.getSegment(i).pose(0.0),
-                                     chain.getSegment(i).twist(0.0,0.0));
+                    out=out*chain.getSegment(i).getFrameToTipZero();
                 }
             }
             return (error = E_NOERROR);
@@ -85,25 +113,16 @@ namespace ARMstrongKDL
             return -1;
         else{
             int j=0;
-            // Initialization
-            if(chain.getSegment(0).getJoint().getType()!=Joint::Fixed) {
-                out[0] = FrameVel(chain.getSegment(0).pose(in.q(0)),
-                                     chain.getSegment(0).twist(in.q(0),in.qdot(0)));
-                j++;
-            }else
-                out[0] = FrameVel(chain.getSegment(0).pose(0.0),
-                                     chain.getSegment(0).twist(0.0,0.0));
-
-            for (unsigned int i=1;i<segmentNr;i++) {
+            FrameVel F = FrameVel::Identity();
+            for (unsigned int i=0;i<segmentNr;i++) {
                 //Calculate new Frame_base_ee
                 if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed) {
-                    out[i]=out[i-1]*FrameVel(chain.getSegment(i).pose(in.q(j)),
-                                    chain.getSegment(i).twist(in.q(j),in.qdot(j)));
+                    ApplySegment(chain.getSegment(i),in.q(j),in.qdot(j),F);
                     j++;//Only increase jointnr if the segment has a joint
                 }else{
-                    out[i]=out[i-1]*FrameVel(chain.getSegment(i).pose(0.0),
-                                     chain.getSegment(i).twist(0.0,0.0));
+                    F=F*chain.getSegment(i).getFrameToTipZero();
                 }
+                out[i]=F;
             }
             return 0;
         }
@@ -25,7 +25,7 @@
 namespace ARMstrongKDL{
 
     ChainIdSolver_RNE::ChainIdSolver_RNE(const Chain& chain_,Vector grav):
-        chain(chain_),nj(chain.getNrOfJoints()),ns(chain.getNrOfSegments()),
+        chain(chain_),mimic(0),nj(chain.getNrOfJoints()),ns(chain.getNrOfSegments()),
         X(ns),S(ns),v(ns),a(ns),f(ns)
     {
         ag=-Twist(grav,Vector::Zero());
@@ -41,13 +41,24 @@ namespace ARMstrongKDL{
         f.resize(ns);
     }
 
+    int ChainIdSolver_RNE::setMimicMap(const JntMimicMap* map)
+    {
+        if(map && map->getNrOfJoints()!=chain.getNrOfJoints())
+            return (error = E_SIZE_MISMATCH);
+        if(map && !map->isValid())
+            return (error = E_OUT_OF_RANGE);
+        mimic = map;
+        return (error = E_NOERROR);
+    }
+
     int ChainIdSolver_RNE::CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &q_dotdot, const Wrenches& f_ext,JntArray &torques)
     {
         if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments())
             return (error = E_NOT_UP_TO_DATE);
 
         //Check sizes when in debug mode
-        if(q.rows()!=nj || q_dot.rows()!=nj || q_dotdot.rows()!=nj || torques.rows()!=nj || f_ext.size()!=ns)
+        const unsigned int nq = mimic ? mimic->getNrOfIndependentJoints() : nj;
+        if(q.rows()!=nq || q_dot.rows()!=nq || q_dotdot.rows()!=nq || torques.rows()!=nq || f_ext.size()!=ns)
             return (error = E_SIZE_MISMATCH);
         unsigned int j=0;
 
@@ -55,9 +66,15 @@ namespace ARMstrongKDL{
         for(unsigned int i=0;i<ns;i++){
             double q_,qdot_,qdotdot_;
             if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed) {
-                q_=q(j);
-                qdot_=q_dot(j);
-                qdotdot_=q_dotdot(j);
+                if(mimic) {
+                    q_=mimic->position(q,j);
+                    qdot_=mimic->velocity(q_dot,j);
+                    qdotdot_=mimic->velocity(q_dotdot,j);
+                }else{
+                    q_=q(j);
+                    qdot_=q_dot(j);
+                    qdotdot_=q_dotdot(j);
+                }
                 j++;
             }else
                 q_=qdot_=qdotdot_=0.0;
@@ -85,11 +102,20 @@ namespace ARMstrongKDL{
 	    //std::cout << "a[i]=" << a[i] << "\n f[i]=" << f[i] << "\n S[i]" << S[i] << std::endl;
         }
         //Sweep from leaf to root
+        if(mimic)
+            SetToZero(torques);
         j=nj-1;
         for(int i=ns-1;i>=0;i--){
             if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed) {
-                torques(j)=dot(S[i],f[i]);
-                torques(j)+=chain.getSegment(i).getJoint().getInertia()*q_dotdot(j);  // add torque from joint inertia
+                if(mimic) {
+                    //the torque of a mimic joint acts on the joint it follows
+                    double torque=dot(S[i],f[i]);
+                    torque+=chain.getSegment(i).getJoint().getInertia()*mimic->velocity(q_dotdot,j);
+                    torques(mimic->index(j))+=mimic->multiplier(j)*torque;
+                }else{
+                    torques(j)=dot(S[i],f[i]);
+                    torques(j)+=chain.getSegment(i).getJoint().getInertia()*q_dotdot(j);  // add torque from joint inertia
+                }
                 --j;
             }
             if(i!=0)
@@ -23,6 +23,7 @@
 #define KDL_CHAIN_IKSOLVER_RECURSIVE_NEWTON_EULER_HPP
 
 #include "chainidsolver.hpp"
+#include "jntmimicmap.hpp"
 
 namespace ARMstrongKDL{
     /**
@@ -59,11 +60,23 @@ namespace ARMstrongKDL{
          */
         int CartToJnt(const JntArray &q, const JntArray &q_dot, const JntArray &q_dotdot, const Wrenches& f_ext,JntArray &torques);
 
+        /**
+         * Lets the solver take the reduced coordinates of map as input,
+         * q, q_dot and q_dotdot then only have the independent joints and
+         * the torques are the generalized forces M'*tau on them.
+         *
+         * @param map the mimic joints, a pointer is kept, 0 for none
+         * @return E_SIZE_MISMATCH if the map does not match the chain,
+         *         E_OUT_OF_RANGE if the map is not valid
+         */
+        int setMimicMap(const JntMimicMap* map);
+
         /// @copydoc ARMstrongKDL::SolverI::updateInternalDataStructures
         virtual void updateInternalDataStructures();
 
     private:
         const Chain& chain;
+        const JntMimicMap* mimic;
         unsigned int nj;
         unsigned int ns;
         std::vector<Frame> X;
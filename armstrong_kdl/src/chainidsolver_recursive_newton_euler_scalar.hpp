@@ -0,0 +1,150 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAINIDSOLVER_RECURSIVE_NEWTON_EULER_SCALAR_HPP
+#define KDL_CHAINIDSOLVER_RECURSIVE_NEWTON_EULER_SCALAR_HPP
+
+#include "chainscalar.hpp"
+#include "solveri.hpp"
+
+namespace ARMstrongKDL
+{
+    /**
+     * Recursive newton euler inverse dynamics, see ChainIdSolver_RNE,
+     * with scalar type T.
+     *
+     * With T a dual number such as Rall1d<double> the derivatives of
+     * the torques are obtained together with the torques, e.g. seeding
+     * the gradient of q_dotdot(j) with 1 gives column j of the joint
+     * space inertia matrix, seeding q(j) gives the derivative of the
+     * torques with respect to q(j).
+     *
+     * @ingroup KinematicFamily
+     */
+    template<typename T>
+    class ChainIdSolver_RNE_T : public SolverI
+    {
+    public:
+        typedef std::vector<WrenchT<T> > WrenchesT;
+
+        /**
+         * \param chain The kinematic chain to calculate the inverse dynamics for.
+         * \param grav The gravity vector to use during the calculation.
+         */
+        ChainIdSolver_RNE_T(const Chain& chain,const Vector& grav);
+
+        /**
+         * Calculate the joint torques, see ChainIdSolver_RNE::CartToJnt.
+         *
+         * \param q The current joint positions
+         * \param q_dot The current joint velocities
+         * \param q_dotdot The current joint accelerations
+         * \param f_ext The external forces (no gravity) on the segments
+         * \param torques the resulting torques for the joints
+         *
+         * @return success/error code
+         */
+        int CartToJnt(const JntArrayT<T>& q, const JntArrayT<T>& q_dot, const JntArrayT<T>& q_dotdot,
+                      const WrenchesT& f_ext, JntArrayT<T>& torques);
+
+        virtual void updateInternalDataStructures();
+
+    private:
+        const Chain& chain;
+        ChainT<T> chain_t;
+        std::vector<FrameT<T> > X;
+        std::vector<TwistT<T> > S;
+        std::vector<TwistT<T> > v;
+        std::vector<TwistT<T> > a;
+        WrenchesT f;
+        TwistT<T> ag;
+    };
+
+    typedef ChainIdSolver_RNE_T<float> ChainIdSolver_RNEf;
+
+
+    template<typename T>
+    ChainIdSolver_RNE_T<T>::ChainIdSolver_RNE_T(const Chain& _chain,const Vector& grav):
+        chain(_chain),chain_t(_chain),
+        X(_chain.getNrOfSegments()),S(_chain.getNrOfSegments()),
+        v(_chain.getNrOfSegments()),a(_chain.getNrOfSegments()),f(_chain.getNrOfSegments()),
+        ag(-TwistT<T>(VectorT<T>(grav),VectorT<T>::Zero()))
+    {
+    }
+
+    template<typename T>
+    void ChainIdSolver_RNE_T<T>::updateInternalDataStructures()
+    {
+        chain_t.set(chain);
+        unsigned int ns = chain.getNrOfSegments();
+        X.resize(ns);
+        S.resize(ns);
+        v.resize(ns);
+        a.resize(ns);
+        f.resize(ns);
+    }
+
+    template<typename T>
+    int ChainIdSolver_RNE_T<T>::CartToJnt(const JntArrayT<T>& q, const JntArrayT<T>& q_dot, const JntArrayT<T>& q_dotdot,
+                                          const WrenchesT& f_ext, JntArrayT<T>& torques)
+    {
+        unsigned int nj = chain_t.getNrOfJoints();
+        unsigned int ns = chain_t.getNrOfSegments();
+        if(nj != chain.getNrOfJoints() || ns != chain.getNrOfSegments() || X.size() != ns)
+            return (error = E_NOT_UP_TO_DATE);
+
+        if(q.rows()!=nj || q_dot.rows()!=nj || q_dotdot.rows()!=nj || torques.rows()!=nj || f_ext.size()!=ns)
+            return (error = E_SIZE_MISMATCH);
+
+        //Sweep from root to leaf
+        unsigned int j=0;
+        for(unsigned int i=0;i<ns;i++){
+            const SegmentT<T>& segment = chain_t.segments[i];
+            T q_(0),qdot_(0),qdotdot_(0);
+            if(segment.type!=Joint::Fixed) {
+                q_=q(j);
+                qdot_=q_dot(j);
+                qdotdot_=q_dotdot(j);
+                j++;
+            }
+
+            X[i]=segment.pose(q_);
+            //velocity and unit velocity of the joint in segment coordinates
+            TwistT<T> vj=X[i].M.Inverse(segment.twist(q_,qdot_));
+            S[i]=X[i].M.Inverse(segment.twist(q_,T(1)));
+            if(i==0){
+                v[i]=vj;
+                a[i]=X[i].Inverse(ag)+S[i]*qdotdot_+v[i]*vj;
+            }else{
+                v[i]=X[i].Inverse(v[i-1])+vj;
+                a[i]=X[i].Inverse(a[i-1])+S[i]*qdotdot_+v[i]*vj;
+            }
+            f[i]=segment.I*a[i]+v[i]*(segment.I*v[i])-f_ext[i];
+        }
+        //Sweep from leaf to root
+        j=nj;
+        for(int i=ns-1;i>=0;i--){
+            const SegmentT<T>& segment = chain_t.segments[i];
+            if(segment.type!=Joint::Fixed) {
+                --j;
+                torques(j)=dot(S[i],f[i])+segment.joint_inertia*q_dotdot(j);
+            }
+            if(i!=0)
+                f[i-1]=f[i-1]+X[i]*f[i];
+        }
+        return (error = E_NOERROR);
+    }
+}
+
+#endif
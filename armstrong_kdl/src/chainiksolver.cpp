@@ -0,0 +1,78 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainiksolver.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace ARMstrongKDL
+{
+    namespace
+    {
+        double now()
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+    }
+
+    ChainIkSolverPos::ChainIkSolverPos():
+        time_budget(0.0),
+        check_period(1),
+        start_time(0.0),
+        termination(NOT_STARTED),
+        nr_iterations(0),
+        residual(std::numeric_limits<double>::infinity())
+    {
+    }
+
+    void ChainIkSolverPos::setTimeBudget(double budget, unsigned int _check_period)
+    {
+        time_budget = budget > 0.0 ? budget : 0.0;
+        check_period = _check_period > 0 ? _check_period : 1;
+    }
+
+    void ChainIkSolverPos::startBudget()
+    {
+        termination = FAILED;
+        nr_iterations = 0;
+        residual = std::numeric_limits<double>::infinity();
+        if (time_budget > 0.0)
+            start_time = now();
+    }
+
+    bool ChainIkSolverPos::budgetExceeded(unsigned int iterations_done)
+    {
+        if (time_budget <= 0.0 || iterations_done % check_period != 0)
+            return false;
+        const double elapsed = now()-start_time;
+        // the next check comes after check_period more iterations
+        const double per_iteration = iterations_done > 0 ? elapsed/iterations_done : 0.0;
+        return elapsed+check_period*per_iteration > time_budget;
+    }
+
+    double ChainIkSolverPos::errorNorm(const Twist& delta)
+    {
+        return std::sqrt(dot(delta.vel,delta.vel)+dot(delta.rot,delta.rot));
+    }
+
+    int ChainIkSolverPos::finish(int code, TerminationReason reason, unsigned int iterations, double _residual)
+    {
+        termination = reason;
+        nr_iterations = iterations;
+        residual = _residual;
+        return (error = code);
+    }
+}
@@ -41,6 +41,18 @@ namespace ARMstrongKDL {
      */
     class ChainIkSolverPos : public ARMstrongKDL::SolverI {
     public:
+        /// Why the last CartToJnt() of an iterative solver stopped
+        enum TerminationReason {
+            NOT_STARTED,    //!< CartToJnt() was not called yet
+            CONVERGED,      //!< the pose error is below eps
+            MAX_ITERATIONS, //!< maxiter iterations were done
+            TIME_BUDGET,    //!< the time budget is spent
+            STALLED,        //!< the joint increments or the gradient became too small
+            FAILED          //!< wrong input or a child solver failed
+        };
+
+        ChainIkSolverPos();
+
         /**
          * Calculate inverse position kinematics, from cartesian
          *coordinates to joint coordinates.
@@ -53,8 +65,58 @@ namespace ARMstrongKDL {
          */
         virtual int CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out)=0;
 
+        /**
+         * Limits the time of CartToJnt() of the iterative solvers, they
+         * then return the best iterate found so far with
+         * E_TIME_BUDGET_EXCEEDED.  The monotonic clock is read every
+         * check_period iterations, and a solver stops before the next
+         * check_period iterations at its average rate would overrun the
+         * budget.
+         *
+         * @param budget the time budget in seconds, 0 for none
+         * @param check_period the number of iterations between two
+         *        readings of the clock, default: 1
+         */
+        void setTimeBudget(double budget, unsigned int check_period=1);
+
+        double getTimeBudget() const { return time_budget; }
+
+        /// Why the last CartToJnt() stopped
+        TerminationReason getTerminationReason() const { return termination; }
+
+        /// The number of iterations, i.e. joint increments, of the last CartToJnt()
+        unsigned int getNrOfIterations() const { return nr_iterations; }
+
+        /**
+         * The norm of the pose error of the q_out of the last
+         * CartToJnt(), which is the converged or the best iterate.  Solvers with task space weights
+         * weigh it.  Infinite if no iterate was evaluated.
+         */
+        double getResidual() const { return residual; }
+
         virtual ~ChainIkSolverPos(){};
         virtual void updateInternalDataStructures()=0;
+
+    protected:
+        /// Starts the clock, to call at the start of CartToJnt()
+        void startBudget();
+
+        /// true if the next iterations would overrun the time budget
+        bool budgetExceeded(unsigned int iterations_done);
+
+        /// The euclidean norm of a pose error
+        static double errorNorm(const Twist& delta);
+
+        /// Records how CartToJnt() ended and returns (error = code)
+        int finish(int code, TerminationReason reason, unsigned int iterations, double _residual);
+
+    private:
+        double time_budget;
+        unsigned int check_period;
+        double start_time;
+        TerminationReason termination;
+        unsigned int nr_iterations;
+        double residual;
     };
 
     /**
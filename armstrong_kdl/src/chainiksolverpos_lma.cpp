@@ -57,6 +57,8 @@ ChainIkSolverPos_LMA::ChainIkSolverPos_LMA(
     chain(_chain),
 	nj(chain.getNrOfJoints()),
 	ns(chain.getNrOfSegments()),
+	mimic(0),
+	nq(nj),
 	lastNrOfIter(0),
 	lastDifference(0),
 	lastTransDiff(0),
@@ -90,6 +92,8 @@ ChainIkSolverPos_LMA::ChainIkSolverPos_LMA(
     chain(_chain),
     nj(chain.getNrOfJoints()),
     ns(chain.getNrOfSegments()),
+    mimic(0),
+    nq(nj),
 	lastNrOfIter(0),
 	lastDifference(0),
     lastTransDiff(0),
@@ -122,22 +126,33 @@ ChainIkSolverPos_LMA::ChainIkSolverPos_LMA(
 void ChainIkSolverPos_LMA::updateInternalDataStructures() {
     nj = chain.getNrOfJoints();
     ns = chain.getNrOfSegments();
-    lastSV.conservativeResize(nj>6?6:nj);
-    jac.conservativeResize(Eigen::NoChange, nj);
-    grad.conservativeResize(nj);
+    nq = mimic ? mimic->getNrOfIndependentJoints() : nj;
+    lastSV.conservativeResize(nq>6?6:nq);
+    jac.conservativeResize(Eigen::NoChange, nq);
+    grad.conservativeResize(nq);
     T_base_jointroot.resize(nj);
     T_base_jointtip.resize(nj);
-    q.conservativeResize(nj);
-    A.conservativeResize(nj, nj);
-    ldlt = Eigen::LDLT<MatrixXq>(nj);
-    svd = Eigen::JacobiSVD<MatrixXq>(6, nj,Eigen::ComputeThinU | Eigen::ComputeThinV);
-    diffq.conservativeResize(nj);
-    q_new.conservativeResize(nj);
-    original_Aii.conservativeResize(nj);
+    q.conservativeResize(nq);
+    A.conservativeResize(nq, nq);
+    ldlt = Eigen::LDLT<MatrixXq>(nq);
+    svd = Eigen::JacobiSVD<MatrixXq>(6, nq,Eigen::ComputeThinU | Eigen::ComputeThinV);
+    diffq.conservativeResize(nq);
+    q_new.conservativeResize(nq);
+    original_Aii.conservativeResize(nq);
 }
 
 ChainIkSolverPos_LMA::~ChainIkSolverPos_LMA() {}
 
+int ChainIkSolverPos_LMA::setMimicMap(const JntMimicMap* map) {
+    if (map && map->getNrOfJoints()!=chain.getNrOfJoints())
+        return (error = E_SIZE_MISMATCH);
+    if (map && !map->isValid())
+        return (error = E_OUT_OF_RANGE);
+    mimic = map;
+    updateInternalDataStructures();
+    return (error = E_NOERROR);
+}
+
 void ChainIkSolverPos_LMA::compute_fwdpos(const VectorXq& q) {
 	using namespace ARMstrongKDL;
 	unsigned int jointndx=0;
@@ -146,11 +161,11 @@ void ChainIkSolverPos_LMA::compute_fwdpos(const VectorXq& q) {
 		const Segment& segment = chain.getSegment(i);
         if (segment.getJoint().getType()!=Joint::Fixed) {
 			T_base_jointroot[jointndx] = T_base_head;
-			T_base_head = T_base_head * segment.pose(q(jointndx));
+			segment.applyPose(T_base_head,mimic ? mimic->position(q,jointndx) : q(jointndx));
 			T_base_jointtip[jointndx] = T_base_head;
 			jointndx++;
 		} else {
-			T_base_head = T_base_head * segment.pose(0.0);
+			segment.applyPose(T_base_head,0.0);
 		}
 	}
 }
@@ -158,17 +173,28 @@ void ChainIkSolverPos_LMA::compute_fwdpos(const VectorXq& q) {
 void ChainIkSolverPos_LMA::compute_jacobian(const VectorXq& q) {
 	using namespace ARMstrongKDL;
 	unsigned int jointndx=0;
+	if (mimic)
+		jac.setZero();
 	for (unsigned int i=0;i<chain.getNrOfSegments();i++) {
 		const Segment& segment = chain.getSegment(i);
         if (segment.getJoint().getType()!=Joint::Fixed) {
 			// compute twist of the end effector motion caused by joint [jointndx]; expressed in base frame, with vel. ref. point equal to the end effector
-			ARMstrongKDL::Twist t = ( T_base_jointroot[jointndx].M * segment.twist(q(jointndx),1.0) ).RefPoint( T_base_head.p - T_base_jointtip[jointndx].p);
-			jac(0,jointndx)=t[0];
-			jac(1,jointndx)=t[1];
-			jac(2,jointndx)=t[2];
-			jac(3,jointndx)=t[3];
-			jac(4,jointndx)=t[4];
-			jac(5,jointndx)=t[5];
+			double q_joint = mimic ? mimic->position(q,jointndx) : q(jointndx);
+			ARMstrongKDL::Twist t = ( T_base_jointroot[jointndx].M * segment.twist(q_joint,1.0) ).RefPoint( T_base_head.p - T_base_jointtip[jointndx].p);
+			if (mimic) {
+				// a mimic joint moves with the independent joint it follows
+				unsigned int col = mimic->index(jointndx);
+				double m = mimic->multiplier(jointndx);
+				for (unsigned int r=0;r<6;++r)
+					jac(r,col) += m*t[r];
+			} else {
+				jac(0,jointndx)=t[0];
+				jac(1,jointndx)=t[1];
+				jac(2,jointndx)=t[2];
+				jac(3,jointndx)=t[3];
+				jac(4,jointndx)=t[4];
+				jac(5,jointndx)=t[5];
+			}
 			jointndx++;
 		}
 	}
@@ -185,10 +211,11 @@ void ChainIkSolverPos_LMA::display_jac(const ARMstrongKDL::JntArray& jval) {
 
 
 int ChainIkSolverPos_LMA::CartToJnt(const ARMstrongKDL::JntArray& q_init, const ARMstrongKDL::Frame& T_base_goal, ARMstrongKDL::JntArray& q_out) {
+  startBudget();
   if (nj != chain.getNrOfJoints())
     return (error = E_NOT_UP_TO_DATE);
 
-  if (nj != q_init.rows() || nj != q_out.rows())
+  if (nq != q_init.rows() || nq != q_out.rows())
     return (error = E_SIZE_MISMATCH);
 
 	using namespace ARMstrongKDL;
@@ -217,7 +244,7 @@ int ChainIkSolverPos_LMA::CartToJnt(const ARMstrongKDL::JntArray& q_init, const
 		original_Aii    = svd.singularValues();
 		lastSV          = svd.singularValues();
 		q_out.data      = q.cast<double>();
-		return (error = E_NOERROR);
+		return finish(E_NOERROR,CONVERGED,0,delta_pos_norm);
 	}
 	compute_jacobian(q);
 	jac = L.asDiagonal()*jac;
@@ -225,6 +252,15 @@ int ChainIkSolverPos_LMA::CartToJnt(const ARMstrongKDL::JntArray& q_init, const
 	lambda = tau;
 	double dnorm = 1;
 	for (unsigned int i=0;i<maxiter;++i) {
+		// q is the best iterate, only steps that decrease E are taken
+		if (budgetExceeded(i)) {
+			lastDifference = delta_pos_norm;
+			lastTransDiff  = delta_pos.topRows(3).norm();
+			lastRotDiff    = delta_pos.bottomRows(3).norm();
+			lastNrOfIter   = i;
+			q_out.data     = q.cast<double>();
+			return finish(E_TIME_BUDGET_EXCEEDED,TIME_BUDGET,i,delta_pos_norm);
+		}
 
 		svd.compute(jac);
 		original_Aii = svd.singularValues();
@@ -257,7 +293,7 @@ int ChainIkSolverPos_LMA::CartToJnt(const ARMstrongKDL::JntArray& q_init, const
 				Twist_to_Eigen( diff( T_base_head, T_base_goal), delta_pos );
 				lastTransDiff  = delta_pos.topRows(3).norm();
 				lastRotDiff    = delta_pos.bottomRows(3).norm();
-				return (error = E_INCREMENT_JOINTS_TOO_SMALL);
+				return finish(E_INCREMENT_JOINTS_TOO_SMALL,STALLED,i,lastDifference);
 		}
 
 
@@ -270,7 +306,7 @@ int ChainIkSolverPos_LMA::CartToJnt(const ARMstrongKDL::JntArray& q_init, const
 			lastSV        = svd.singularValues();
 			lastNrOfIter  = i;
 			q_out.data    = q.cast<double>();
-			return (error = E_GRADIENT_JOINTS_TOO_SMALL);
+			return finish(E_GRADIENT_JOINTS_TOO_SMALL,STALLED,i,lastDifference);
 		}
 
 		q_new = q+diffq;
@@ -292,7 +328,7 @@ int ChainIkSolverPos_LMA::CartToJnt(const ARMstrongKDL::JntArray& q_init, const
 				lastSV         = svd.singularValues();
 				lastNrOfIter   = i;
 				q_out.data     = q.cast<double>();
-				return (error = E_NOERROR);
+				return finish(E_NOERROR,CONVERGED,i,lastDifference);
 			}
 			compute_jacobian(q_new);
 			jac = L.asDiagonal()*jac;
@@ -310,7 +346,7 @@ int ChainIkSolverPos_LMA::CartToJnt(const ARMstrongKDL::JntArray& q_init, const
 	lastSV         = svd.singularValues();
 	lastNrOfIter   = maxiter;
 	q_out.data     = q.cast<double>();
-	return (error = E_MAX_ITERATIONS_EXCEEDED);
+	return finish(E_MAX_ITERATIONS_EXCEEDED,MAX_ITERATIONS,maxiter,lastDifference);
 
 }
 
@@ -33,6 +33,7 @@
 
 #include "chainiksolver.hpp"
 #include "chain.hpp"
+#include "jntmimicmap.hpp"
 #include <Eigen/Dense>
 
 namespace ARMstrongKDL
@@ -121,7 +122,9 @@ public:
      * \return E_NOERROR if successful,
      *         E_GRADIENT_JOINTS_TOO_SMALL the gradient of \f$ E \f$ towards the joints is to small,
      *         E_INCREMENT_JOINTS_TOO_SMALL if joint position increments are to small,
-     *         E_MAX_ITER_EXCEEDED if number of iterations is exceeded.
+     *         E_MAX_ITER_EXCEEDED if number of iterations is exceeded,
+     *         E_TIME_BUDGET_EXCEEDED if the time budget is spent, see setTimeBudget().
+     *         Unless successful, q_out is the best iterate, getResidual() is its weighted \f$ \sqrt{E} \f$.
      */
     virtual int CartToJnt(const ARMstrongKDL::JntArray& q_init, const ARMstrongKDL::Frame& T_base_goal, ARMstrongKDL::JntArray& q_out);
 
@@ -150,6 +153,17 @@ public:
      */
     void display_jac(const ARMstrongKDL::JntArray& jval);
 
+    /**
+     * \brief lets the solver work in the reduced coordinates of a map of mimic joints.
+     *
+     * q_init and q_out then only have the independent joints, and the iterations
+     * use the jacobian towards them.
+     * \param map the mimic joints, a pointer is kept, 0 for none.
+     * \return E_SIZE_MISMATCH if the map does not match the chain,
+     *         E_OUT_OF_RANGE if the map is not valid.
+     */
+    int setMimicMap(const JntMimicMap* map);
+
     /// @copydoc ARMstrongKDL::SolverI::updateInternalDataStructures
     void updateInternalDataStructures();
 
@@ -160,6 +174,8 @@ private:
     const ARMstrongKDL::Chain& chain;
     unsigned int nj;
     unsigned int ns;
+    const JntMimicMap* mimic;
+    unsigned int nq;  // size of the joint vectors, nj without mimic map
 
 public:
 
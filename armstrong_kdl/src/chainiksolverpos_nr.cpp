@@ -21,6 +21,8 @@
 
 #include "chainiksolverpos_nr.hpp"
 
+#include <limits>
+
 namespace ARMstrongKDL
 {
     ChainIkSolverPos_NR::ChainIkSolverPos_NR(const Chain& _chain,ChainFkSolverPos& _fksolver,ChainIkSolverVel& _iksolver,
@@ -28,6 +30,7 @@ namespace ARMstrongKDL
         chain(_chain),nj (chain.getNrOfJoints()),
         iksolver(_iksolver),fksolver(_fksolver),
         delta_q(_chain.getNrOfJoints()),
+        q_best(_chain.getNrOfJoints()),
         maxiter(_maxiter),eps(_eps)
     {
     }
@@ -37,10 +40,12 @@ namespace ARMstrongKDL
         iksolver.updateInternalDataStructures();
         fksolver.updateInternalDataStructures();
         delta_q.resize(nj);
+        q_best.resize(nj);
     }
 
     int ChainIkSolverPos_NR::CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out)
     {
+        startBudget();
         if (nj != chain.getNrOfJoints())
             return (error = E_NOT_UP_TO_DATE);
 
@@ -48,23 +53,48 @@ namespace ARMstrongKDL
             return (error = E_SIZE_MISMATCH);
 
         q_out = q_init;
+        q_best = q_init;
+        double best = std::numeric_limits<double>::infinity();
 
+        // the result of the velocity solver for the step to q_out
+        int rc = E_NOERROR;
         unsigned int i;
         for(i=0;i<maxiter;i++){
-            if (E_NOERROR > fksolver.JntToCart(q_out,f) )
-                return (error = E_FKSOLVERPOS_FAILED);
+            if (E_NOERROR > fksolver.JntToCart(q_out,f) ) {
+                q_out = q_best;
+                return finish(E_FKSOLVERPOS_FAILED,FAILED,i,best);
+            }
             delta_twist = diff(f,p_in);
-            const int rc = iksolver.CartToJnt(q_out,delta_twist,delta_q);
-            if (E_NOERROR > rc)
-                return (error = E_IKSOLVER_FAILED);
+            const double e_norm = errorNorm(delta_twist);
+            if (e_norm < best) {
+                best = e_norm;
+                q_best = q_out;
+            }
+            if(Equal(delta_twist,Twist::Zero(),eps))
+                // converged, but possibly with a degraded solution
+                return finish(rc > E_NOERROR ? E_DEGRADED : E_NOERROR,CONVERGED,i,e_norm);
+            if (budgetExceeded(i)) {
+                q_out = q_best;
+                return finish(E_TIME_BUDGET_EXCEEDED,TIME_BUDGET,i,best);
+            }
+            rc = iksolver.CartToJnt(q_out,delta_twist,delta_q);
+            if (E_NOERROR > rc) {
+                q_out = q_best;
+                return finish(E_IKSOLVER_FAILED,FAILED,i,best);
+            }
             // we chose to continue if the child solver returned a positive
             // "error", which may simply indicate a degraded solution
             Add(q_out,delta_q,q_out);
-            if(Equal(delta_twist,Twist::Zero(),eps))
-                // converged, but possibly with a degraded solution
-                return (rc > E_NOERROR ? E_DEGRADED : E_NOERROR);
         }
-        return (error = E_MAX_ITERATIONS_EXCEEDED);        // failed to converge
+        // the last increment was not evaluated yet
+        if (E_NOERROR <= fksolver.JntToCart(q_out,f)) {
+            delta_twist = diff(f,p_in);
+            const double e_norm = errorNorm(delta_twist);
+            if (e_norm < best)
+                return finish(E_MAX_ITERATIONS_EXCEEDED,MAX_ITERATIONS,i,e_norm);
+        }
+        q_out = q_best;
+        return finish(E_MAX_ITERATIONS_EXCEEDED,MAX_ITERATIONS,i,best);        // failed to converge
     }
 
     ChainIkSolverPos_NR::~ChainIkSolverPos_NR()
@@ -70,6 +70,11 @@ namespace ARMstrongKDL {
          *  degraded in quality (e.g. pseudo-inverse in iksolver is singular)
          *  E_IKSOLVER_FAILED=velocity solver failed
          *  E_NO_CONVERGE=solution did not converge (e.g. large displacement, low iterations)
+         *  E_MAX_ITERATIONS_EXCEEDED, E_TIME_BUDGET_EXCEEDED=stopped before
+         *  converging, see setTimeBudget()
+         *
+         * Unless it converged, \a q_out is the iterate with the smallest
+         * pose error, see getResidual().
          */
         virtual int CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out);
 
@@ -85,6 +90,7 @@ namespace ARMstrongKDL {
         ChainIkSolverVel& iksolver;
         ChainFkSolverPos& fksolver;
         JntArray delta_q;
+        JntArray q_best;
         Frame f;
         Twist delta_twist;
 
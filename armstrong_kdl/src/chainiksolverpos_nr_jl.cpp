@@ -33,6 +33,7 @@ namespace ARMstrongKDL
         q_min(_q_min), q_max(_q_max),
         iksolver(_iksolver), fksolver(_fksolver),
         delta_q(_chain.getNrOfJoints()),
+        q_best(_chain.getNrOfJoints()),
         maxiter(_maxiter),eps(_eps)
     {
 
@@ -44,6 +45,7 @@ namespace ARMstrongKDL
          q_min(nj), q_max(nj),
          iksolver(_iksolver), fksolver(_fksolver),
          delta_q(nj),
+         q_best(nj),
          maxiter(_maxiter),eps(_eps)
     {
         q_min.data.setConstant(std::numeric_limits<double>::min());
@@ -57,10 +59,12 @@ namespace ARMstrongKDL
        iksolver.updateInternalDataStructures();
        fksolver.updateInternalDataStructures();
        delta_q.resize(nj);
+       q_best.resize(nj);
     }
 
     int ChainIkSolverPos_NR_JL::CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out)
     {
+        startBudget();
         if(nj != chain.getNrOfJoints())
             return (error = E_NOT_UP_TO_DATE);
 
@@ -68,18 +72,34 @@ namespace ARMstrongKDL
             return (error = E_SIZE_MISMATCH);
 
         q_out = q_init;
+        q_best = q_init;
+        double best = std::numeric_limits<double>::infinity();
 
         unsigned int i;
         for(i=0;i<maxiter;i++){
-            if ( fksolver.JntToCart(q_out,f) < 0)
-                return (error = E_FKSOLVERPOS_FAILED);
+            if ( fksolver.JntToCart(q_out,f) < 0) {
+                q_out = q_best;
+                return finish(E_FKSOLVERPOS_FAILED,FAILED,i,best);
+            }
             delta_twist = diff(f,p_in);
+            const double e_norm = errorNorm(delta_twist);
+            if (e_norm < best) {
+                best = e_norm;
+                q_best = q_out;
+            }
 
             if(Equal(delta_twist,Twist::Zero(),eps))
-                break;
+                return finish(E_NOERROR,CONVERGED,i,e_norm);
+
+            if (budgetExceeded(i)) {
+                q_out = q_best;
+                return finish(E_TIME_BUDGET_EXCEEDED,TIME_BUDGET,i,best);
+            }
 
-            if ( iksolver.CartToJnt(q_out,delta_twist,delta_q) < 0)
-                return (error = E_IKSOLVERVEL_FAILED);
+            if ( iksolver.CartToJnt(q_out,delta_twist,delta_q) < 0) {
+                q_out = q_best;
+                return finish(E_IKSOLVERVEL_FAILED,FAILED,i,best);
+            }
             Add(q_out,delta_q,q_out);
 
             for(unsigned int j=0; j<q_min.rows(); j++) {
@@ -94,10 +114,14 @@ namespace ARMstrongKDL
             }
         }
 
-        if(i!=maxiter)
-            return (error = E_NOERROR);
-        else
-            return (error = E_MAX_ITERATIONS_EXCEEDED);
+        // the last increment was not evaluated yet
+        if (fksolver.JntToCart(q_out,f) >= 0) {
+            const double e_norm = errorNorm(diff(f,p_in));
+            if (e_norm < best)
+                return finish(E_MAX_ITERATIONS_EXCEEDED,MAX_ITERATIONS,i,e_norm);
+        }
+        q_out = q_best;
+        return finish(E_MAX_ITERATIONS_EXCEEDED,MAX_ITERATIONS,i,best);
     }
 
     int ChainIkSolverPos_NR_JL::setJointLimits(const JntArray& q_min_in, const JntArray& q_max_in) {
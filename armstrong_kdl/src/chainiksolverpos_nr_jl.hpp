@@ -87,8 +87,10 @@ namespace ARMstrongKDL {
          * Calculates the joint values that correspond to the input pose given an initial guess.
          * @param q_init Initial guess for the joint values.
          * @param p_in The input pose of the chain tip.
-         * @param q_out The resulting output joint values
+         * @param q_out The resulting output joint values, unless converged the
+         *        iterate with the smallest pose error, see getResidual()
          * @return E_MAX_ITERATIONS_EXCEEDED if the maximum number of iterations was exceeded before a result was found
+         *         E_TIME_BUDGET_EXCEEDED if the time budget was spent before, see setTimeBudget()
          *         E_NOT_UP_TO_DATE if the internal data is not up to date with the chain
          *         E_SIZE_MISMATCH if the size of the input/output data does not match the chain.
          */
@@ -116,6 +118,7 @@ namespace ARMstrongKDL {
         ChainIkSolverVel& iksolver;
         ChainFkSolverPos& fksolver;
         JntArray delta_q;
+        JntArray q_best;
         unsigned int maxiter;
         double eps;
 
@@ -0,0 +1,321 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainiksolverpos_pieper.hpp"
+#include "utilities/ik_geometry.hpp"
+#include <Eigen/Eigenvalues>
+#include <algorithm>
+#include <cmath>
+
+namespace ARMstrongKDL
+{
+    using namespace ik_geometry;
+
+    // real roots of c[0]+c[1]*u+...+c[4]*u^4, the leading coefficients
+    // that are zero compared to the others are removed
+    static int QuarticRoots(const double c[5],double roots[4])
+    {
+        double max = 0.0;
+        for (int i=0;i<5;++i)
+            max = std::max(max,fabs(c[i]));
+        if (max==0.0)
+            return 0;
+        int n = 4;
+        while (n>0 && fabs(c[n])<=1e-12*max)
+            --n;
+        if (n==0)
+            return 0;
+        typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,0,4,4> Companion;
+        Companion C = Companion::Zero(n,n);
+        for (int i=0;i<n;++i)
+            C(0,i) = -c[n-1-i]/c[n];
+        for (int i=1;i<n;++i)
+            C(i,i-1) = 1.0;
+        Eigen::EigenSolver<Companion> eig(C,false);
+        if (eig.info()!=Eigen::Success)
+            return 0;
+        int nr = 0;
+        for (int i=0;i<n;++i) {
+            std::complex<double> z = eig.eigenvalues()(i);
+            if (fabs(z.imag())>1e-6*(1.0+fabs(z.real())))
+                continue;
+            // polish with Newton iterations on the polynomial
+            double u = z.real();
+            for (int it=0;it<3;++it) {
+                double p = c[n],dp = 0.0;
+                for (int k=n-1;k>=0;--k) {
+                    dp = dp*u+p;
+                    p = p*u+c[k];
+                }
+                if (dp==0.0)
+                    break;
+                u -= p/dp;
+            }
+            roots[nr++] = u;
+        }
+        return nr;
+    }
+
+    ChainIkSolverPos_Pieper::ChainIkSolverPos_Pieper(const Chain& _chain,double _eps):
+        chain(_chain),nj(0),ns(0),eps(_eps),supported(false),nr_solutions(0)
+    {
+        updateInternalDataStructures();
+    }
+
+    ChainIkSolverPos_Pieper::~ChainIkSolverPos_Pieper()
+    {
+    }
+
+    void ChainIkSolverPos_Pieper::updateInternalDataStructures()
+    {
+        nj = chain.getNrOfJoints();
+        ns = chain.getNrOfSegments();
+        supported = false;
+        if (nj!=6)
+            return;
+        for (unsigned int i=0;i<max_solutions;++i)
+            solutions[i].resize(nj);
+
+        // axes of the joints with all joint angles zero
+        if (!JointAxesAtZero(chain,axis,point,scale,offset,tip_zero))
+            return;
+
+        // the wrist axes have to intersect in one point, and successive
+        // wrist axes can not be parallel
+        double t_a,t_b;
+        if (!NearestPoints(point[3],axis[3],point[4],axis[4],t_a,t_b))
+            return;
+        if ((axis[4]*axis[5]).Norm()<1e-6)
+            return;
+        wrist = ((point[3]+axis[3]*t_a)+(point[4]+axis[4]*t_b))/2.0;
+        for (int k=3;k<6;++k)
+            if (LineDistance(point[k],axis[k],wrist)>eps)
+                return;
+        wrist_tip = tip_zero.Inverse(wrist);
+
+        if (NearestPoints(point[0],axis[0],point[1],axis[1],t_a,t_b))
+            center2 = point[1]+axis[1]*t_b;
+        else
+            center2 = point[1];
+
+        // the position of the wrist center after rotating about the third
+        // axis, relative to center2 : its squared distance to center2 and
+        // its projection on the second axis are
+        //   m3[i][0]*cos(q3)+m3[i][1]*sin(q3)+d3[i]
+        Vector r = wrist-point[2];
+        Vector r_par = axis[2]*dot(axis[2],r);
+        Vector r_perp = r-r_par;
+        Vector wxr = axis[2]*r;
+        Vector k = point[2]-center2;
+        m3[0][0] = 2.0*dot(k,r_perp);
+        m3[0][1] = 2.0*dot(k,wxr);
+        d3[0] = dot(r,r)+dot(k,k)+2.0*dot(k,r_par);
+        m3[1][0] = dot(axis[1],r_perp);
+        m3[1][1] = dot(axis[1],wxr);
+        d3[1] = dot(axis[1],k+r_par);
+        supported = true;
+    }
+
+    void ChainIkSolverPos_Pieper::addSolution(const JntArray& q_ref,const double theta[6])
+    {
+        if (nr_solutions==max_solutions)
+            return;
+        JntArray& q = solutions[nr_solutions];
+        double distance = 0.0;
+        for (unsigned int j=0;j<6;++j) {
+            double period = 2*PI/fabs(scale[j]);
+            q(j) = (theta[j]-offset[j])/scale[j];
+            q(j) += period*std::floor((q_ref(j)-q(j))/period+0.5);
+            distance += (q(j)-q_ref(j))*(q(j)-q_ref(j));
+        }
+        for (unsigned int i=0;i<nr_solutions;++i)
+            if ((solutions[i].data-q.data).cwiseAbs().maxCoeff()<eps)
+                return;
+        distances[nr_solutions++] = distance;
+    }
+
+    int ChainIkSolverPos_Pieper::solve(const JntArray& q_ref,const Frame& p_in)
+    {
+        nr_solutions = 0;
+        const Vector p = p_in*wrist_tip;
+
+        // the wrist center rotated back about the first axis, relative to
+        // center2 : its squared distance to center2 and its projection on
+        // the second axis are m1[i][0]*cos(q1)+m1[i][1]*sin(q1)+d1[i], and
+        // have to be equal to those of the third joint.
+        Vector d = p-point[0];
+        Vector d_par = axis[0]*dot(axis[0],d);
+        Vector d_perp = d-d_par;
+        Vector wxd = axis[0]*d;
+        Vector e = point[0]-center2;
+        double m1[2][2],d1[2];
+        m1[0][0] = 2.0*dot(e,d_perp);
+        m1[0][1] = -2.0*dot(e,wxd);
+        d1[0] = dot(d,d)+dot(e,e)+2.0*dot(e,d_par);
+        m1[1][0] = dot(axis[1],d_perp);
+        m1[1][1] = -dot(axis[1],wxd);
+        d1[1] = dot(axis[1],e+d_par);
+
+        double norm_a = hypot(m1[0][0],m1[0][1]);
+        double norm_b = hypot(m1[1][0],m1[1][1]);
+        double length = d.Norm()+e.Norm()+1e-12;
+        bool zero_a = norm_a<=1e-9*length*length;
+        bool zero_b = norm_b<=1e-9*length;
+        double det = m1[0][0]*m1[1][1]-m1[0][1]*m1[1][0];
+
+        double q1[max_solutions],q3[max_solutions];
+        unsigned int nr = 0;
+        if (!zero_a && !zero_b && fabs(det)>1e-9*norm_a*norm_b) {
+            // (cos(q1),sin(q1)) = G*(cos(q3),sin(q3))+h has to be a unit
+            // vector, a polynomial of degree four in tan(q3/2)
+            double G[2][2],h[2];
+            for (int c=0;c<2;++c) {
+                G[0][c] = (m1[1][1]*m3[0][c]-m1[0][1]*m3[1][c])/det;
+                G[1][c] = (m1[0][0]*m3[1][c]-m1[1][0]*m3[0][c])/det;
+            }
+            h[0] = (m1[1][1]*(d3[0]-d1[0])-m1[0][1]*(d3[1]-d1[1]))/det;
+            h[1] = (m1[0][0]*(d3[1]-d1[1])-m1[1][0]*(d3[0]-d1[0]))/det;
+            double P11 = G[0][0]*G[0][0]+G[1][0]*G[1][0];
+            double P12 = G[0][0]*G[0][1]+G[1][0]*G[1][1];
+            double P22 = G[0][1]*G[0][1]+G[1][1]*G[1][1];
+            double L1 = 2.0*(G[0][0]*h[0]+G[1][0]*h[1]);
+            double L2 = 2.0*(G[0][1]*h[0]+G[1][1]*h[1]);
+            double K = h[0]*h[0]+h[1]*h[1]-1.0;
+            double coef[5] = {P11+L1+K,4*P12+2*L2,-2*P11+4*P22+2*K,-4*P12+2*L2,P11-L1+K};
+            double u[4];
+            int nr_u = QuarticRoots(coef,u);
+            double angles[5];
+            for (int i=0;i<nr_u;++i)
+                angles[i] = 2.0*atan(u[i]);
+            // tan(q3/2) is infinite for q3 = pi
+            angles[nr_u++] = PI;
+            for (int i=0;i<nr_u;++i) {
+                double c3 = cos(angles[i]),s3 = sin(angles[i]);
+                q3[nr] = angles[i];
+                q1[nr] = atan2(G[1][0]*c3+G[1][1]*s3+h[1],G[0][0]*c3+G[0][1]*s3+h[0]);
+                nr++;
+            }
+        } else {
+            // the equations are dependent (e.g. for intersecting or parallel
+            // first and second axes) : a combination n of them only depends
+            // on q3, the row of m1 with the largest norm gives q1.
+            double n[2];
+            int row;
+            if (zero_a || (!zero_b && norm_b*length>=norm_a)) {
+                row = 1;
+                n[0] = 1.0;
+                n[1] = zero_a ? 0.0 : -(m1[0][0]*m1[1][0]+m1[0][1]*m1[1][1])/(norm_b*norm_b);
+            } else {
+                row = 0;
+                n[0] = zero_b ? 0.0 : -(m1[0][0]*m1[1][0]+m1[0][1]*m1[1][1])/(norm_a*norm_a);
+                n[1] = 1.0;
+            }
+            double angles3[2];
+            int nr3 = SolveCosSin(n[0]*m3[0][0]+n[1]*m3[1][0],n[0]*m3[0][1]+n[1]*m3[1][1],
+                                  n[0]*(d1[0]-d3[0])+n[1]*(d1[1]-d3[1]),angles3);
+            for (int i=0;i<nr3;++i) {
+                double c3 = cos(angles3[i]),s3 = sin(angles3[i]);
+                double r = m3[row][0]*c3+m3[row][1]*s3+d3[row]-d1[row];
+                double angles1[2];
+                int nr1;
+                if ((row==0 && zero_a) || (row==1 && zero_b)) {
+                    // the wrist center is on the first axis, q1 is free
+                    angles1[0] = scale[0]*q_ref(0)+offset[0];
+                    nr1 = 1;
+                } else
+                    nr1 = SolveCosSin(m1[row][0],m1[row][1],r,angles1);
+                for (int k=0;k<nr1;++k) {
+                    q1[nr] = angles1[k];
+                    q3[nr] = angles3[i];
+                    nr++;
+                }
+            }
+        }
+
+        for (unsigned int i=0;i<nr;++i) {
+            double theta[6];
+            theta[0] = q1[i];
+            theta[2] = q3[i];
+            Rotation R1 = Rotation::Rot2(axis[0],theta[0]);
+            Rotation R3 = Rotation::Rot2(axis[2],theta[2]);
+            Vector x3 = R3*(wrist-point[2])+point[2]-center2;
+            Vector x1 = R1.Inverse(d)+point[0]-center2;
+            theta[1] = RotationAngle(axis[1],x3,x1);
+            Rotation R2 = Rotation::Rot2(axis[1],theta[1]);
+            // spurious roots and unreachable positions are removed here
+            if ((R1*(R2*x3+center2-point[0])+point[0]-p).Norm()>eps)
+                continue;
+
+            // R4*R5*R6 = Rw
+            Rotation Rw = (R1*R2*R3).Inverse()*p_in.M*tip_zero.M.Inverse();
+            for (int sign=-1;sign<=1;sign+=2)
+                if (Spherical(axis[3],axis[4],axis[5],Rw,sign,theta+3))
+                    addSolution(q_ref,theta);
+        }
+        if (nr_solutions==0)
+            return (error = E_NO_SOLUTION);
+        return (error = E_NOERROR);
+    }
+
+    int ChainIkSolverPos_Pieper::CartToJnt(const JntArray& q_ref,const Frame& p_in,std::vector<JntArray>& q_out)
+    {
+        if (nj!=chain.getNrOfJoints() || ns!=chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+        if (!supported)
+            return (error = E_NOT_SPHERICAL_WRIST);
+        if (q_ref.rows()!=nj)
+            return (error = E_SIZE_MISMATCH);
+        q_out.clear();
+        if (solve(q_ref,p_in)!=E_NOERROR)
+            return error;
+        // insertion sort of the few solutions by their distance to q_ref
+        unsigned int order[max_solutions];
+        for (unsigned int i=0;i<nr_solutions;++i) {
+            unsigned int j = i;
+            for (;j>0 && distances[order[j-1]]>distances[i];--j)
+                order[j] = order[j-1];
+            order[j] = i;
+        }
+        q_out.reserve(nr_solutions);
+        for (unsigned int i=0;i<nr_solutions;++i)
+            q_out.push_back(solutions[order[i]]);
+        return (error = E_NOERROR);
+    }
+
+    int ChainIkSolverPos_Pieper::CartToJnt(const JntArray& q_init,const Frame& p_in,JntArray& q_out)
+    {
+        if (nj!=chain.getNrOfJoints() || ns!=chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+        if (!supported)
+            return (error = E_NOT_SPHERICAL_WRIST);
+        if (q_init.rows()!=nj || q_out.rows()!=nj)
+            return (error = E_SIZE_MISMATCH);
+        if (solve(q_init,p_in)!=E_NOERROR)
+            return error;
+        unsigned int best = 0;
+        for (unsigned int i=1;i<nr_solutions;++i)
+            if (distances[i]<distances[best])
+                best = i;
+        q_out = solutions[best];
+        return (error = E_NOERROR);
+    }
+
+    const char* ChainIkSolverPos_Pieper::strError(const int error) const
+    {
+        if (E_NOT_SPHERICAL_WRIST == error) return "Chain has no six revolute joints with a spherical wrist";
+        else if (E_NO_SOLUTION == error) return "The pose can not be reached";
+        else return SolverI::strError(error);
+    }
+
+}
@@ -0,0 +1,126 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAINIKSOLVERPOS_PIEPER_HPP
+#define KDL_CHAINIKSOLVERPOS_PIEPER_HPP
+
+#include "chainiksolver.hpp"
+#include <vector>
+
+namespace ARMstrongKDL {
+
+    /**
+     * \brief Closed form inverse position kinematics for chains with six
+     * revolute joints of which the last three axes intersect in one point
+     * (a spherical wrist), e.g. the Puma560.
+     *
+     * The axes of the joints are taken from the chain in the configuration
+     * where all joint angles are zero, and the pose of the tip is written
+     * as a product of exponentials.  The position of the wrist center only
+     * depends on the first three joints, the method of Pieper reduces it to
+     * two equations in the first and third joint:
+     *  - when the first two axes intersect or are parallel (as for most
+     *    industrial arms) each joint follows from one trigonometric equation,
+     *  - otherwise the third joint is a root of a polynomial of degree four.
+     * The second joint and the wrist joints follow from rotations about one
+     * or two axes.  This gives at most eight solutions, without iterations.
+     *
+     * Fixed segments, joint scales and offsets are allowed.  Joint limits
+     * are not taken into account, every joint value is the one nearest to
+     * the reference configuration modulo a full turn.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainIkSolverPos_Pieper : public ChainIkSolverPos
+    {
+    public:
+        static const int E_NOT_SPHERICAL_WRIST = -100; //! Chain is not a 6R chain with a spherical wrist
+        static const int E_NO_SOLUTION = -101; //! Pose can not be reached
+
+        /**
+         * Constructor of the solver.
+         *
+         * @param chain the chain to calculate the inverse position for,
+         *        a reference is kept.
+         * @param eps tolerance on the distance between the wrist axes, and
+         *        on the position of the wrist center of a solution,
+         *        default: 1e-6
+         */
+        explicit ChainIkSolverPos_Pieper(const Chain& chain,double eps=1e-6);
+
+        ~ChainIkSolverPos_Pieper();
+
+        /**
+         * Calculates all joint values that correspond to the input pose.
+         *
+         * @param q_ref reference joint values
+         * @param p_in the input pose of the chain tip
+         * @param q_out all solutions, sorted by increasing distance to q_ref
+         * @return E_NO_SOLUTION if the pose can not be reached
+         *         E_NOT_SPHERICAL_WRIST if the chain is not supported
+         *         E_NOT_UP_TO_DATE if the internal data is not up to date with the chain
+         *         E_SIZE_MISMATCH if the size of q_ref does not match the chain.
+         */
+        int CartToJnt(const JntArray& q_ref, const Frame& p_in, std::vector<JntArray>& q_out);
+
+        /**
+         * Calculates the solution nearest to q_init, see above.
+         */
+        virtual int CartToJnt(const JntArray& q_init, const Frame& p_in, JntArray& q_out);
+
+        /// True if the chain has six revolute joints and a spherical wrist
+        bool isSupported() const { return supported; }
+
+        /// @copydoc ARMstrongKDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+        /// @copydoc ARMstrongKDL::SolverI::strError()
+        const char* strError(const int error) const;
+
+    private:
+        static const unsigned int max_solutions = 8;
+
+        int solve(const JntArray& q_ref, const Frame& p_in);
+        void addSolution(const JntArray& q_ref, const double theta[6]);
+
+        const Chain& chain;
+        unsigned int nj;
+        unsigned int ns;
+        double eps;
+        bool supported;
+
+        // joint axes and a point on them, with all joint angles zero
+        Vector axis[6];
+        Vector point[6];
+        double scale[6];
+        double offset[6];
+        // pose of the tip with all joint angles zero
+        Frame tip_zero;
+        // wrist center, in the base and in the tip frame
+        Vector wrist;
+        Vector wrist_tip;
+        // point on the second axis, nearest to the first
+        Vector center2;
+        // equations of the third joint, see solve()
+        double m3[2][2];
+        double d3[2];
+
+        unsigned int nr_solutions;
+        JntArray solutions[max_solutions];
+        double distances[max_solutions];
+    };
+
+}
+
+#endif
@@ -0,0 +1,425 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainiksolverpos_srs.hpp"
+#include "utilities/ik_geometry.hpp"
+#include <Eigen/Core>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ARMstrongKDL
+{
+    using namespace ik_geometry;
+
+    typedef Eigen::Matrix<double,3,3,Eigen::RowMajor> Matrix3r;
+
+    // rotation that takes a0 to a1 and b0 to b1, the angle between a and b
+    // and their lengths have to be equal
+    static Rotation Triad(const Vector& a0,const Vector& b0,const Vector& a1,const Vector& b1)
+    {
+        Vector x0 = b0/b0.Norm(),x1 = b1/b1.Norm();
+        Vector z0 = b0*a0,z1 = b1*a1;
+        z0.Normalize();
+        z1.Normalize();
+        return Rotation(x1,z1*x1,z1)*Rotation(x0,z0*x0,z0).Inverse();
+    }
+
+    static Eigen::Map<const Eigen::Vector3d> Map(const Vector& v)
+    {
+        return Eigen::Map<const Eigen::Vector3d>(v.data);
+    }
+
+    static Eigen::Map<const Matrix3r> Map(const Rotation& R)
+    {
+        return Eigen::Map<const Matrix3r>(R.data);
+    }
+
+    // R(psi) = A*sin(psi)+B*cos(psi)+C, adds the arm angles for which
+    // x^T*R(psi)*y = r
+    static void AddArmAngles(const Matrix3r M[3],const Vector& x,const Vector& y,double r,
+                             std::vector<double>& psi)
+    {
+        double a = Map(x).dot(M[0]*Map(y));
+        double b = Map(x).dot(M[1]*Map(y));
+        double c = Map(x).dot(M[2]*Map(y));
+        double angles[2];
+        int n = SolveCosSin(b,a,r-c,angles);
+        for (int i=0;i<n;++i)
+            psi.push_back(atan2(sin(angles[i]),cos(angles[i])));
+    }
+
+    // adds the arm angles for which one of the joints of a spherical
+    // decomposition of R(psi) (see Spherical) equals one of the angles th,
+    // or for which the decomposition is singular
+    static void AddArmAngles(const Matrix3r M[3],const Vector& wa,const Vector& wb,const Vector& wc,
+                             const std::vector<double> th[3],std::vector<double>& psi)
+    {
+        for (unsigned int i=0;i<th[0].size();++i)
+            AddArmAngles(M,Rotation::Rot2(wa,th[0][i])*wb,wc,dot(wb,wc),psi);
+        std::vector<double> th1(th[1]);
+        Vector wab = wa*wb;
+        Vector wc_par = wb*dot(wb,wc);
+        double singular[2];
+        int n = SolveCosSin(dot(wab,wc-wc_par),dot(wab,wb*wc),-dot(wab,wc_par),singular);
+        th1.insert(th1.end(),singular,singular+n);
+        for (unsigned int i=0;i<th1.size();++i)
+            AddArmAngles(M,wa,wc,dot(wa,Rotation::Rot2(wb,th1[i])*wc),psi);
+        for (unsigned int i=0;i<th[2].size();++i)
+            AddArmAngles(M,wa,Rotation::Rot2(wc,th[2][i]).Inverse(wb),dot(wa,wb),psi);
+    }
+
+    ChainIkSolverPos_SRS::ChainIkSolverPos_SRS(const Chain& _chain,double _eps):
+        chain(_chain),nj(0),ns(0),eps(_eps),supported(false),nr_elbow(0)
+    {
+        updateInternalDataStructures();
+    }
+
+    ChainIkSolverPos_SRS::ChainIkSolverPos_SRS(const Chain& _chain,const JntArray& _q_min,const JntArray& _q_max,double _eps):
+        chain(_chain),nj(0),ns(0),eps(_eps),supported(false),nr_elbow(0)
+    {
+        updateInternalDataStructures();
+        setJointLimits(_q_min,_q_max);
+    }
+
+    ChainIkSolverPos_SRS::~ChainIkSolverPos_SRS()
+    {
+    }
+
+    void ChainIkSolverPos_SRS::updateInternalDataStructures()
+    {
+        nj = chain.getNrOfJoints();
+        ns = chain.getNrOfSegments();
+        q_min.resize(nj);
+        q_max.resize(nj);
+        q_center.resize(nj);
+        q_tmp.resize(nj);
+        for (unsigned int j=0;j<nj;++j) {
+            q_min(j) = -std::numeric_limits<double>::infinity();
+            q_max(j) = std::numeric_limits<double>::infinity();
+        }
+        supported = false;
+        if (nj!=7)
+            return;
+
+        // axes of the joints with all joint angles zero
+        if (!JointAxesAtZero(chain,axis,point,scale,offset,tip_zero))
+            return;
+
+        // shoulder and wrist, successive axes can not be parallel
+        double t_a,t_b;
+        if (!NearestPoints(point[0],axis[0],point[1],axis[1],t_a,t_b))
+            return;
+        shoulder = ((point[0]+axis[0]*t_a)+(point[1]+axis[1]*t_b))/2.0;
+        if (!NearestPoints(point[4],axis[4],point[5],axis[5],t_a,t_b))
+            return;
+        wrist = ((point[4]+axis[4]*t_a)+(point[5]+axis[5]*t_b))/2.0;
+        if ((axis[1]*axis[2]).Norm()<1e-6 || (axis[5]*axis[6]).Norm()<1e-6)
+            return;
+        for (int k=0;k<3;++k)
+            if (LineDistance(point[k],axis[k],shoulder)>eps || LineDistance(point[k+4],axis[k+4],wrist)>eps)
+                return;
+        Vector d = shoulder-point[3];
+        elbow = point[3]+axis[3]*dot(axis[3],d);
+        if ((elbow-shoulder).Norm()<eps || LineDistance(point[3],axis[3],wrist)<eps)
+            return;
+        wrist_tip = tip_zero.Inverse(wrist);
+        supported = true;
+    }
+
+    int ChainIkSolverPos_SRS::setJointLimits(const JntArray& _q_min,const JntArray& _q_max)
+    {
+        if (_q_min.rows()!=nj || _q_max.rows()!=nj)
+            return (error = E_SIZE_MISMATCH);
+        q_min = _q_min;
+        q_max = _q_max;
+        // solutions are taken nearest to the middle of the limits
+        for (unsigned int j=0;j<nj;++j)
+            q_center(j) = std::isfinite(q_min(j)) && std::isfinite(q_max(j)) ? (q_min(j)+q_max(j))/2.0 : 0.0;
+        return (error = E_NOERROR);
+    }
+
+    int ChainIkSolverPos_SRS::prepare(const Frame& p_in)
+    {
+        if (nj!=chain.getNrOfJoints() || ns!=chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+        if (!supported)
+            return (error = E_NOT_SRS);
+        target = p_in.M*tip_zero.M.Inverse();
+        Vector sw = p_in*wrist_tip-shoulder;
+        double length = sw.Norm();
+        if (length<eps)
+            return (error = E_ARM_SINGULAR);
+        u = sw/length;
+        v0 = axis[0]-u*dot(u,axis[0]);
+        if (v0.Norm()<1e-9) {
+            // SW along the first axis, the reference plane is undefined
+            Vector x = fabs(u.x())<0.5 ? Vector(1,0,0) : Vector(0,1,0);
+            v0 = x-u*dot(u,x);
+        }
+        v0.Normalize();
+
+        // the elbow joint sets the distance between shoulder and wrist
+        Vector r = wrist-elbow;
+        Vector k = elbow-shoulder;
+        Vector r_par = axis[3]*dot(axis[3],r);
+        nr_elbow = SolveCosSin(2.0*dot(k,r-r_par),2.0*dot(k,axis[3]*r),
+                               length*length-dot(r,r)-dot(k,k)-2.0*dot(k,r_par),theta4);
+        if (nr_elbow==0)
+            return (error = E_NO_SOLUTION);
+        for (unsigned int e=0;e<nr_elbow;++e) {
+            Vector a0 = k;
+            Vector b0 = Rotation::Rot2(axis[3],theta4[e])*r+k;
+            Vector n = a0*b0;
+            if (n.Norm()<1e-9*a0.Norm()*b0.Norm())
+                return (error = E_ARM_SINGULAR);
+            // elbow for psi = 0
+            double cos_alpha = dot(a0,b0)/(a0.Norm()*b0.Norm());
+            Vector a1 = (u*cos_alpha+v0*sqrt(std::max(0.0,1.0-cos_alpha*cos_alpha)))*a0.Norm();
+            shoulder_zero[e] = Triad(a0,b0,a1,sw);
+        }
+        return (error = E_NOERROR);
+    }
+
+    bool ChainIkSolverPos_SRS::solveBranch(double psi,unsigned int branch,double theta[7]) const
+    {
+        unsigned int e = branch&1;
+        if (e>=nr_elbow)
+            return false;
+        Rotation Rs = Rotation::Rot2(u,psi)*shoulder_zero[e];
+        if (!Spherical(axis[0],axis[1],axis[2],Rs,branch&2 ? 1 : -1,theta))
+            return false;
+        theta[3] = theta4[e];
+        Rotation Rw = (Rs*Rotation::Rot2(axis[3],theta[3])).Inverse()*target;
+        return Spherical(axis[4],axis[5],axis[6],Rw,branch&4 ? 1 : -1,theta+4);
+    }
+
+    bool ChainIkSolverPos_SRS::toJoints(const double theta[7],const JntArray& q_ref,bool limits,JntArray& q) const
+    {
+        for (unsigned int j=0;j<7;++j) {
+            double period = 2*PI/fabs(scale[j]);
+            q(j) = (theta[j]-offset[j])/scale[j];
+            q(j) += period*std::floor((q_ref(j)-q(j))/period+0.5);
+            if (limits) {
+                while (q(j)>q_max(j))
+                    q(j) -= period;
+                while (q(j)<q_min(j))
+                    q(j) += period;
+                if (q(j)>q_max(j))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    bool ChainIkSolverPos_SRS::withinLimits(double psi,unsigned int branch)
+    {
+        double theta[7];
+        return solveBranch(psi,branch,theta) && toJoints(theta,q_center,true,q_tmp);
+    }
+
+    int ChainIkSolverPos_SRS::CartToJnt(const Frame& p_in,double psi,std::vector<JntArray>& q_out,
+                                        std::vector<unsigned int>* branches)
+    {
+        q_out.clear();
+        if (branches)
+            branches->clear();
+        if (prepare(p_in)!=E_NOERROR)
+            return error;
+        double theta[7];
+        for (unsigned int b=0;b<nr_branches;++b) {
+            if (solveBranch(psi,b,theta) && toJoints(theta,q_center,true,q_tmp)) {
+                q_out.push_back(q_tmp);
+                if (branches)
+                    branches->push_back(b);
+            }
+        }
+        return (error = q_out.empty() ? E_NO_SOLUTION : E_NOERROR);
+    }
+
+    int ChainIkSolverPos_SRS::CartToJnt(const Frame& p_in,double psi,unsigned int branch,JntArray& q_out)
+    {
+        if (q_out.rows()!=nj)
+            return (error = E_SIZE_MISMATCH);
+        if (prepare(p_in)!=E_NOERROR)
+            return error;
+        double theta[7];
+        if (branch>=nr_branches || !solveBranch(psi,branch,theta))
+            return (error = E_NO_SOLUTION);
+        toJoints(theta,q_center,false,q_out);
+        return (error = E_NOERROR);
+    }
+
+    int ChainIkSolverPos_SRS::CartToJnt(const JntArray& q_init,const Frame& p_in,JntArray& q_out)
+    {
+        if (q_init.rows()!=nj || q_out.rows()!=nj)
+            return (error = E_SIZE_MISMATCH);
+        double psi;
+        unsigned int branch;
+        // a stretched arm in q_init has no arm angle, use the reference plane
+        if (getArmAngle(q_init,psi,branch)==E_ARM_SINGULAR)
+            psi = 0.0;
+        else if (error!=E_NOERROR)
+            return error;
+        if (prepare(p_in)!=E_NOERROR)
+            return error;
+        double theta[7];
+        double best = std::numeric_limits<double>::infinity();
+        for (unsigned int b=0;b<nr_branches;++b) {
+            if (solveBranch(psi,b,theta) && toJoints(theta,q_init,true,q_tmp)) {
+                double distance = (q_tmp.data-q_init.data).squaredNorm();
+                if (distance<best) {
+                    best = distance;
+                    q_out = q_tmp;
+                }
+            }
+        }
+        return (error = std::isfinite(best) ? E_NOERROR : E_NO_SOLUTION);
+    }
+
+    int ChainIkSolverPos_SRS::getArmAngle(const JntArray& q,double& psi,unsigned int& branch)
+    {
+        if (nj!=chain.getNrOfJoints() || ns!=chain.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+        if (!supported)
+            return (error = E_NOT_SRS);
+        if (q.rows()!=nj)
+            return (error = E_SIZE_MISMATCH);
+        Rotation R[7];
+        for (unsigned int j=0;j<7;++j)
+            R[j] = Rotation::Rot2(axis[j],scale[j]*q(j)+offset[j]);
+        Rotation Rs = R[0]*R[1]*R[2];
+        Rotation Rse = Rs*R[3];
+        Frame F(Rse*R[4]*R[5]*R[6]*tip_zero.M,shoulder+Rs*(R[3]*(wrist-elbow)+elbow-shoulder)-Rse*R[4]*R[5]*R[6]*(tip_zero.M*wrist_tip));
+        if (prepare(F)!=E_NOERROR)
+            return error;
+
+        Vector e = Rs*(elbow-shoulder);
+        Vector e_perp = e-u*dot(u,e);
+        psi = atan2(dot(u*v0,e_perp),dot(v0,e_perp));
+
+        // the branch : the nearest elbow solution, and the sign used in
+        // Spherical for the shoulder and the wrist
+        double theta = scale[3]*q(3)+offset[3];
+        double d0 = fabs(atan2(sin(theta-theta4[0]),cos(theta-theta4[0])));
+        double d1 = nr_elbow>1 ? fabs(atan2(sin(theta-theta4[1]),cos(theta-theta4[1]))) : d0;
+        branch = d1<d0 ? 1 : 0;
+        if (dot(R[1]*axis[2],axis[0]*axis[1])>0.0)
+            branch |= 2;
+        if (dot(R[5]*axis[6],axis[4]*axis[5])>0.0)
+            branch |= 4;
+        return (error = E_NOERROR);
+    }
+
+    int ChainIkSolverPos_SRS::getFeasibleArmAngles(const Frame& p_in,std::vector<ArmAngleInterval>& intervals)
+    {
+        intervals.clear();
+        if (prepare(p_in)!=E_NOERROR)
+            return error;
+
+        // joint angles at the limits
+        std::vector<double> th_shoulder[3],th_wrist[3];
+        for (unsigned int j=0;j<7;++j) {
+            if (j==3)
+                continue;
+            std::vector<double>& th = j<3 ? th_shoulder[j] : th_wrist[j-4];
+            if (std::isfinite(q_min(j)))
+                th.push_back(scale[j]*q_min(j)+offset[j]);
+            if (std::isfinite(q_max(j)))
+                th.push_back(scale[j]*q_max(j)+offset[j]);
+        }
+
+        for (unsigned int e=0;e<nr_elbow;++e) {
+            // the joints of a branch can only reach a limit, or jump at a
+            // singularity, at these arm angles
+            Matrix3r Ms[3],Mw[3];
+            Eigen::Vector3d ue = Map(u);
+            Matrix3r ux;
+            ux << 0,-ue(2),ue(1), ue(2),0,-ue(0), -ue(1),ue(0),0;
+            Matrix3r R0 = Map(shoulder_zero[e]);
+            Ms[0] = ux*R0;
+            Ms[1] = (Matrix3r::Identity()-ue*ue.transpose())*R0;
+            Ms[2] = ue*ue.transpose()*R0;
+            Matrix3r R4t = Map(Rotation::Rot2(axis[3],theta4[e])).transpose();
+            for (int i=0;i<3;++i)
+                Mw[i] = R4t*Ms[i].transpose()*Map(target);
+            std::vector<double> psi;
+            AddArmAngles(Ms,axis[0],axis[1],axis[2],th_shoulder,psi);
+            AddArmAngles(Mw,axis[4],axis[5],axis[6],th_wrist,psi);
+            std::sort(psi.begin(),psi.end());
+
+            for (unsigned int b=e;b<nr_branches;b+=2) {
+                if (e==1 && nr_elbow==1)
+                    break;
+                if (psi.empty()) {
+                    if (withinLimits(0.0,b)) {
+                        ArmAngleInterval interval = {b,-PI,PI};
+                        intervals.push_back(interval);
+                    }
+                    continue;
+                }
+                // test the middle of the arcs between the candidates
+                unsigned int n = psi.size();
+                std::vector<bool> feasible(n);
+                for (unsigned int i=0;i<n;++i) {
+                    double lower = psi[i];
+                    double upper = i+1<n ? psi[i+1] : psi[0]+2*PI;
+                    feasible[i] = upper-lower>1e-12 && withinLimits((lower+upper)/2.0,b);
+                }
+                unsigned int first = intervals.size();
+                for (unsigned int i=0;i<n;++i) {
+                    if (!feasible[i])
+                        continue;
+                    double upper = i+1<n ? psi[i+1] : psi[0]+2*PI;
+                    if (intervals.size()>first && intervals.back().upper>=psi[i]-1e-12)
+                        intervals.back().upper = upper;
+                    else {
+                        ArmAngleInterval interval = {b,psi[i],upper};
+                        intervals.push_back(interval);
+                    }
+                }
+                // join the interval over PI with the first one
+                if (intervals.size()>first+1 && intervals.back().upper>=intervals[first].lower+2*PI-1e-12) {
+                    intervals[first].lower = intervals.back().lower;
+                    intervals[first].upper += 2*PI;
+                    intervals.pop_back();
+                } else if (intervals.size()==first+1 && intervals[first].upper-intervals[first].lower>=2*PI-1e-12) {
+                    intervals[first].lower = -PI;
+                    intervals[first].upper = PI;
+                }
+                // keep lower in [-PI,PI)
+                for (unsigned int i=first;i<intervals.size();++i) {
+                    if (intervals[i].lower>=PI) {
+                        intervals[i].lower -= 2*PI;
+                        intervals[i].upper -= 2*PI;
+                    }
+                }
+                std::sort(intervals.begin()+first,intervals.end(),
+                          [](const ArmAngleInterval& a,const ArmAngleInterval& b){ return a.lower<b.lower; });
+            }
+        }
+        std::stable_sort(intervals.begin(),intervals.end(),
+                         [](const ArmAngleInterval& a,const ArmAngleInterval& b){ return a.branch<b.branch; });
+        return (error = intervals.empty() ? E_NO_SOLUTION : E_NOERROR);
+    }
+
+    const char* ChainIkSolverPos_SRS::strError(const int error) const
+    {
+        if (E_NOT_SRS == error) return "Chain has no spherical shoulder, elbow and spherical wrist";
+        else if (E_NO_SOLUTION == error) return "The pose can not be reached";
+        else if (E_ARM_SINGULAR == error) return "The arm is stretched, the arm angle is undefined";
+        else return SolverI::strError(error);
+    }
+
+}
@@ -0,0 +1,196 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAINIKSOLVERPOS_SRS_HPP
+#define KDL_CHAINIKSOLVERPOS_SRS_HPP
+
+#include "chainiksolver.hpp"
+#include <vector>
+
+namespace ARMstrongKDL {
+
+    /**
+     * \brief Closed form inverse position kinematics for 7 joint chains
+     * with a spherical shoulder, a revolute elbow and a spherical wrist
+     * (SRS), e.g. the Kuka LWR.
+     *
+     * The first three axes have to intersect in the shoulder point S, the
+     * last three in the wrist point W.  The redundancy is described by the
+     * arm angle psi : the angle of the elbow point E about the line SW,
+     * with psi = 0 when E lies in the plane through SW and the first joint
+     * axis, on the side the first axis points to.  The elbow point is the
+     * point of the fourth axis that is nearest to S.  The reference plane is
+     * undefined when SW is parallel to the first axis.
+     *
+     * For a pose and an arm angle there are at most eight solutions, the
+     * branches, numbered with three bits :
+     *  - bit 0 : the solution for the elbow joint,
+     *  - bit 1 : the solution for the shoulder joints,
+     *  - bit 2 : the solution for the wrist joints.
+     *
+     * With joint limits, every joint angle of a branch only crosses a limit
+     * for arm angles that solve a*sin(psi)+b*cos(psi) = c, so the feasible
+     * arm angles of every branch are found without sampling.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainIkSolverPos_SRS : public ChainIkSolverPos
+    {
+    public:
+        static const int E_NOT_SRS = -100; //! Chain is not a 7R chain with spherical shoulder and wrist
+        static const int E_NO_SOLUTION = -101; //! Pose can not be reached
+        static const int E_ARM_SINGULAR = -102; //! Arm is stretched, the arm angle is undefined
+
+        /// feasible arm angles of one branch, upper may exceed PI when the
+        /// interval contains PI
+        struct ArmAngleInterval
+        {
+            unsigned int branch;
+            double lower;
+            double upper;
+        };
+
+        /**
+         * Constructor of the solver without joint limits.
+         *
+         * @param chain the chain to calculate the inverse position for,
+         *        a reference is kept.
+         * @param eps tolerance on the distance between intersecting axes,
+         *        default: 1e-6
+         */
+        explicit ChainIkSolverPos_SRS(const Chain& chain,double eps=1e-6);
+
+        /**
+         * Constructor of the solver with joint limits.
+         *
+         * @param chain the chain to calculate the inverse position for,
+         *        a reference is kept.
+         * @param q_min the minimum joint positions
+         * @param q_max the maximum joint positions
+         * @param eps tolerance on the distance between intersecting axes,
+         *        default: 1e-6
+         */
+        ChainIkSolverPos_SRS(const Chain& chain,const JntArray& q_min,const JntArray& q_max,double eps=1e-6);
+
+        ~ChainIkSolverPos_SRS();
+
+        /**
+         * Calculates all solutions within the joint limits for a pose and
+         * an arm angle.
+         *
+         * @param p_in the input pose of the chain tip
+         * @param psi the arm angle
+         * @param q_out the solutions
+         * @param branches if not 0, filled with the branch of every solution
+         * @return E_NO_SOLUTION if the pose can not be reached within the limits
+         *         E_ARM_SINGULAR if the arm is stretched
+         *         E_NOT_SRS if the chain is not supported
+         *         E_NOT_UP_TO_DATE if the internal data is not up to date with the chain
+         */
+        int CartToJnt(const Frame& p_in,double psi,std::vector<JntArray>& q_out,
+                      std::vector<unsigned int>* branches=0);
+
+        /**
+         * Calculates the solution of one branch for a pose and an arm angle,
+         * the joint limits are not taken into account.
+         *
+         * @return E_NO_SOLUTION if the branch does not exist for this pose,
+         *         see above for the other errors.
+         */
+        int CartToJnt(const Frame& p_in,double psi,unsigned int branch,JntArray& q_out);
+
+        /**
+         * Calculates the solution within the joint limits nearest to q_init,
+         * with the arm angle of q_init.  This keeps the redundancy
+         * of a sequence of poses constant.
+         */
+        virtual int CartToJnt(const JntArray& q_init,const Frame& p_in,JntArray& q_out);
+
+        /**
+         * Calculates the arm angle and the branch of a configuration.
+         *
+         * @return E_ARM_SINGULAR if the arm is stretched,
+         *         E_SIZE_MISMATCH if the size of q does not match the chain.
+         */
+        int getArmAngle(const JntArray& q,double& psi,unsigned int& branch);
+
+        /**
+         * Calculates the arm angles for which the branches reach the pose
+         * within the joint limits.
+         *
+         * @param p_in the input pose of the chain tip
+         * @param intervals the intervals, sorted on branch and lower
+         * @return E_NO_SOLUTION if no branch reaches the pose, see
+         *         CartToJnt for the other errors
+         */
+        int getFeasibleArmAngles(const Frame& p_in,std::vector<ArmAngleInterval>& intervals);
+
+        /**
+         * Function to set the joint limits.
+         * @param q_min minimum values for the joints
+         * @param q_max maximum values for the joints
+         * @return E_SIZE_MISMATCH if input sizes do not match the chain
+         */
+        int setJointLimits(const JntArray& q_min,const JntArray& q_max);
+
+        /// True if the chain is a SRS chain
+        bool isSupported() const { return supported; }
+
+        /// @copydoc ARMstrongKDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+        /// @copydoc ARMstrongKDL::SolverI::strError()
+        const char* strError(const int error) const;
+
+    private:
+        static const unsigned int nr_branches = 8;
+
+        int prepare(const Frame& p_in);
+        bool solveBranch(double psi,unsigned int branch,double theta[7]) const;
+        bool toJoints(const double theta[7],const JntArray& q_ref,bool limits,JntArray& q) const;
+        bool withinLimits(double psi,unsigned int branch);
+
+        const Chain& chain;
+        unsigned int nj;
+        unsigned int ns;
+        double eps;
+        bool supported;
+        JntArray q_min;
+        JntArray q_max;
+        JntArray q_center;
+
+        // joint axes and a point on them, with all joint angles zero
+        Vector axis[7];
+        Vector point[7];
+        double scale[7];
+        double offset[7];
+        Frame tip_zero;
+        Vector shoulder;
+        Vector elbow;
+        Vector wrist;
+        Vector wrist_tip;
+
+        // data of the last pose, see prepare()
+        Rotation target;
+        Vector u;
+        Vector v0;
+        unsigned int nr_elbow;
+        double theta4[2];
+        Rotation shoulder_zero[2];
+        JntArray q_tmp;
+    };
+
+}
+
+#endif
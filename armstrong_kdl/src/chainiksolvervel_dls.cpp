@@ -0,0 +1,176 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainiksolvervel_dls.hpp"
+#include "utilities/svd_eigen_HH.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ARMstrongKDL
+{
+    ChainIkSolverVel_dls::ChainIkSolverVel_dls(const Chain& _chain,double _lambda,int _maxiter):
+        chain(_chain),
+        jnt2jac(chain),
+        nj(chain.getNrOfJoints()),
+        jac(nj),
+        lambda(_lambda),
+        w0(0.0),
+        use_svd(false),
+        maxiter(_maxiter),
+        lambda_last(_lambda),
+        manipulability(-1.0),
+        svdResult(0),
+        A(Eigen::Matrix<double,6,6>::Zero()),
+        v(Eigen::Matrix<double,6,1>::Zero()),
+        x(Eigen::Matrix<double,6,1>::Zero()),
+        U(Eigen::MatrixXd::Zero(6,nj)),
+        S(Eigen::VectorXd::Zero(nj)),
+        V(Eigen::MatrixXd::Zero(nj,nj)),
+        tmp(Eigen::VectorXd::Zero(nj))
+    {
+    }
+
+    void ChainIkSolverVel_dls::updateInternalDataStructures() {
+        jnt2jac.updateInternalDataStructures();
+        nj = chain.getNrOfJoints();
+        jac.resize(nj);
+        U.conservativeResizeLike(Eigen::MatrixXd::Zero(6,nj));
+        S.conservativeResizeLike(Eigen::VectorXd::Zero(nj));
+        V.conservativeResizeLike(Eigen::MatrixXd::Zero(nj,nj));
+        tmp.conservativeResizeLike(Eigen::VectorXd::Zero(nj));
+    }
+
+    ChainIkSolverVel_dls::~ChainIkSolverVel_dls()
+    {
+    }
+
+    void ChainIkSolverVel_dls::setLambda(const double _lambda)
+    {
+        lambda = _lambda;
+    }
+
+    void ChainIkSolverVel_dls::setManipulabilityThreshold(const double _w0)
+    {
+        w0 = _w0;
+    }
+
+    void ChainIkSolverVel_dls::setUseSVD(const bool _use_svd)
+    {
+        use_svd = _use_svd;
+    }
+
+    double ChainIkSolverVel_dls::damping(double w) const
+    {
+        if (w >= w0)
+            return 0.0;
+        return lambda*(1.0 - w/w0);
+    }
+
+    int ChainIkSolverVel_dls::CartToJnt(const JntArray& q_in, const Twist& v_in, JntArray& qdot_out)
+    {
+        if (nj != chain.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+
+        if (nj != q_in.rows() || nj != qdot_out.rows())
+            return (error = E_SIZE_MISMATCH);
+
+        error = jnt2jac.JntToJac(q_in,jac);
+        if (error < E_NOERROR) return error;
+
+        if (use_svd)
+            return solveSVD(v_in,qdot_out);
+
+        // A = J*J', only the 6x6 matrix is factorized
+        A.noalias() = jac.data*jac.data.transpose();
+        if (w0 > 0.0) {
+            // det(J*J') is the product of the pivots of its LDLT
+            // factorization, the damping follows from it
+            ldlt.compute(A);
+            manipulability = std::sqrt(std::max(0.0,ldlt.vectorD().prod()));
+            lambda_last = damping(manipulability);
+            if (lambda_last > 0.0) {
+                A.diagonal().array() += lambda_last*lambda_last;
+                ldlt.compute(A);
+            }
+        }
+        else {
+            manipulability = -1.0;
+            lambda_last = lambda;
+            A.diagonal().array() += lambda*lambda;
+            ldlt.compute(A);
+        }
+
+        // qdot_out = J'*(J*J' + lambda^2*I)^-1 * v_in
+        for (unsigned int i=0;i<6;i++)
+            v(i) = v_in(i);
+        x = ldlt.solve(v);
+        qdot_out.data.noalias() = jac.data.transpose()*x;
+
+        const double dmax = ldlt.vectorD().cwiseAbs().maxCoeff();
+        if (!(ldlt.vectorD().minCoeff() > std::numeric_limits<double>::epsilon()*dmax))
+            return (error = E_CONVERGE_PINV_SINGULAR);
+        if (w0 > 0.0 && manipulability < w0)
+            return (error = E_DEGRADED);
+        return (error = E_NOERROR);
+    }
+
+    int ChainIkSolverVel_dls::solveSVD(const Twist& v_in, JntArray& qdot_out)
+    {
+        // J = U*S*V', qdot_out = V*S*(S^2 + lambda^2)^-1*U'*v_in
+        svdResult = svd_eigen_HH(jac.data,U,S,V,tmp,maxiter);
+        if (0 != svdResult) {
+            qdot_out.data.setZero();
+            return (error = E_SVD_FAILED);
+        }
+
+        // the singular values are sorted, J*J' has the six largest
+        manipulability = 1.0;
+        if (nj < 6)
+            manipulability = 0.0;
+        else
+            for (unsigned int i=0;i<6;i++)
+                manipulability *= S(i);
+
+        lambda_last = w0 > 0.0 ? damping(manipulability) : lambda;
+        const double lambda2 = lambda_last*lambda_last;
+        const double smax = S.size() > 0 ? S(0) : 0.0;
+        bool singular = nj < 6;
+        tmp.setZero();
+        // only the first six singular directions are in the range of J'
+        for (unsigned int i=0;i<std::min(nj,6u);i++) {
+            double sum = 0.0;
+            for (unsigned int j=0;j<6;j++)
+                sum += U(j,i)*v_in(j);
+            const double den = S(i)*S(i) + lambda2;
+            if (!(den > std::numeric_limits<double>::epsilon()*(smax*smax + lambda2)))
+                singular = true;
+            else
+                tmp(i) = sum*S(i)/den;
+        }
+        qdot_out.data.noalias() = V*tmp;
+
+        if (singular && lambda2 == 0.0)
+            return (error = E_CONVERGE_PINV_SINGULAR);
+        if (w0 > 0.0 && manipulability < w0)
+            return (error = E_DEGRADED);
+        return (error = E_NOERROR);
+    }
+
+    const char* ChainIkSolverVel_dls::strError(const int error) const
+    {
+        if (E_CONVERGE_PINV_SINGULAR == error) return "Converged but the damped least squares matrix is singular.";
+        else return SolverI::strError(error);
+    }
+}
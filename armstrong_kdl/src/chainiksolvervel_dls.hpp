@@ -0,0 +1,169 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAIN_IKSOLVERVEL_DLS_HPP
+#define KDL_CHAIN_IKSOLVERVEL_DLS_HPP
+
+#include "chainiksolver.hpp"
+#include "chainjnttojacsolver.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Cholesky>
+
+namespace ARMstrongKDL
+{
+    /**
+     * Implementation of an inverse velocity kinematics algorithm based
+     * on the damped least squares inverse
+     *
+     *   qdot = J'*(J*J' + lambda^2*I)^-1 * v_in
+     *
+     * The 6x6 matrix J*J' + lambda^2*I is factorized with a fixed size
+     * LDLT decomposition instead of a SVD of the jacobian, which is much
+     * cheaper for chains with many joints.  The singular values are not
+     * computed, use ChainIkSolverVel_wdls when they are needed.
+     *
+     * With setManipulabilityThreshold() the damping is chosen from the
+     * manipulability w = sqrt(det(J*J')), which follows from the same
+     * factorization [Nakamura 86]:
+     *
+     *   lambda^2 = lambda_max^2*(1 - w/w0)^2 if w < w0, 0 otherwise
+     *
+     * [Nakamura 86] Y. Nakamura & H. Hanafusa.
+     * Inverse Kinematic Solutions With Singularity Robustness for Robot
+     * Manipulator Control.
+     * Journal of Dynamic Systems, Measurement, and Control,
+     * vol. 108, no. 3, pages 163-171, 1986.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainIkSolverVel_dls : public ChainIkSolverVel
+    {
+    public:
+        /// solution converged but J*J' + lambda^2*I is singular
+        static const int E_CONVERGE_PINV_SINGULAR = +100;
+
+        /**
+         * Constructor of the solver
+         *
+         * @param chain the chain to calculate the inverse velocity
+         * kinematics for
+         * @param lambda the damping factor, or the maximum damping factor
+         * when a manipulability threshold is set, default: 0.01
+         * @param maxiter maximum iterations for the svd calculation,
+         * only used with setUseSVD(), default: 150
+         */
+        explicit ChainIkSolverVel_dls(const Chain& chain,double lambda=0.01,int maxiter=150);
+        ~ChainIkSolverVel_dls();
+
+        /**
+         * Find an output joint velocity \a qdot_out, given a starting joint pose
+         * \a q_init and a desired cartesian velocity \a v_in
+         *
+         * @return
+         *  E_NOERROR=solution found
+         *  E_DEGRADED=the manipulability is below its threshold, the
+         *  solution is damped
+         *  E_CONVERGE_PINV_SINGULAR=J*J' + lambda^2*I is singular, only
+         *  possible without damping
+         *  E_SVD_FAILED=svd solution failed, only with setUseSVD()
+         *  E_SIZE_MISMATCH, E_NOT_UP_TO_DATE
+         */
+        virtual int CartToJnt(const JntArray& q_in, const Twist& v_in, JntArray& qdot_out);
+        /**
+         * not (yet) implemented.
+         *
+         */
+        virtual int CartToJnt(const JntArray& /*q_init*/, const FrameVel& /*v_in*/, JntArrayVel& /*q_out*/){return (error = E_NOT_IMPLEMENTED);};
+
+        /**
+         * Set the damping factor, or the maximum damping factor when a
+         * manipulability threshold is set.
+         */
+        void setLambda(const double lambda);
+
+        /// The damping factor
+        double getLambda() const {return lambda;};
+
+        /**
+         * Set the manipulability below which the solution is damped, the
+         * damping grows to lambda when the manipulability goes to zero.
+         *
+         * @param w0 the threshold, 0 (default) always damps with lambda
+         */
+        void setManipulabilityThreshold(const double w0);
+
+        /// The manipulability threshold
+        double getManipulabilityThreshold() const {return w0;};
+
+        /**
+         * Use a SVD of the jacobian instead of the LDLT factorization,
+         * the result is the same.
+         */
+        void setUseSVD(const bool use_svd);
+
+        /// True if a SVD of the jacobian is used
+        bool getUseSVD() const {return use_svd;};
+
+        /// The damping factor of the last call of CartToJnt()
+        double getLastLambda() const {return lambda_last;};
+
+        /**
+         * The manipulability of the last call of CartToJnt(), it is only
+         * computed with a manipulability threshold or with setUseSVD(),
+         * -1 otherwise.
+         */
+        double getManipulability() const {return manipulability;};
+
+        /**
+         * Retrieve the latest return code from the SVD algorithm
+         * @return 0 if CartToJnt() not yet called or no SVD is used,
+         * otherwise latest SVD result code.
+         */
+        int getSVDResult() const {return svdResult;};
+
+        /// @copydoc ARMstrongKDL::SolverI::strError()
+        virtual const char* strError(const int error) const;
+
+        /// @copydoc ARMstrongKDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        int solveSVD(const Twist& v_in, JntArray& qdot_out);
+        double damping(double w) const;
+
+        const Chain& chain;
+        ChainJntToJacSolver jnt2jac;
+        unsigned int nj;
+        Jacobian jac;
+        double lambda;
+        double w0;
+        bool use_svd;
+        int maxiter;
+        double lambda_last;
+        double manipulability;
+        int svdResult;
+
+        Eigen::Matrix<double,6,6> A;
+        Eigen::Matrix<double,6,1> v;
+        Eigen::Matrix<double,6,1> x;
+        Eigen::LDLT<Eigen::Matrix<double,6,6> > ldlt;
+
+        Eigen::MatrixXd U;
+        Eigen::VectorXd S;
+        Eigen::MatrixXd V;
+        Eigen::VectorXd tmp;
+    };
+}
+#endif
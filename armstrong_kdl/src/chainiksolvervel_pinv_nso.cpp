@@ -40,7 +40,13 @@ namespace ARMstrongKDL
         svdResult(0),
         alpha(_alpha),
         weights(_weights),
-        opt_pos(_opt_pos)
+        opt_pos(_opt_pos),
+        warm_start(false),
+        svd_valid(false),
+        max_sweeps(10),
+        B(Eigen::MatrixXd::Zero(6,nj)),
+        needs_frames(false),
+        gradient(Eigen::VectorXd::Zero(nj))
     {
     }
 
@@ -58,7 +64,13 @@ namespace ARMstrongKDL
         eps(_eps),
         maxiter(_maxiter),
         svdResult(0),
-        alpha(_alpha)
+        alpha(_alpha),
+        warm_start(false),
+        svd_valid(false),
+        max_sweeps(10),
+        B(Eigen::MatrixXd::Zero(6,nj)),
+        needs_frames(false),
+        gradient(Eigen::VectorXd::Zero(nj))
     {
     }
 
@@ -72,8 +84,13 @@ namespace ARMstrongKDL
         V.conservativeResizeLike(Eigen::MatrixXd::Zero(nj,nj));
         tmp.conservativeResizeLike(Eigen::VectorXd::Zero(nj));
         tmp2.conservativeResizeLike(Eigen::VectorXd::Zero(nj));
-        opt_pos.data.conservativeResizeLike(Eigen::VectorXd::Zero(nj));
-        weights.data.conservativeResizeLike(Eigen::VectorXd::Ones(nj));
+        if (objectives.empty() || 0 != opt_pos.rows() || 0 != weights.rows()) {
+            opt_pos.data.conservativeResizeLike(Eigen::VectorXd::Zero(nj));
+            weights.data.conservativeResizeLike(Eigen::VectorXd::Ones(nj));
+        }
+        B.conservativeResizeLike(Eigen::MatrixXd::Zero(6,nj));
+        gradient.conservativeResizeLike(Eigen::VectorXd::Zero(nj));
+        svd_valid = false;
     }
 
     ChainIkSolverVel_pinv_nso::~ChainIkSolverVel_pinv_nso()
@@ -86,7 +103,11 @@ namespace ARMstrongKDL
         if (nj != chain.getNrOfJoints())
             return (error = E_NOT_UP_TO_DATE);
 
-        if (nj != q_in.rows() || nj != qdot_out.rows() || nj != opt_pos.rows() || nj != weights.rows())
+        if (nj != q_in.rows() || nj != qdot_out.rows())
+            return (error = E_SIZE_MISMATCH);
+        // without objectives the quadratic criterion is required
+        const bool quadratic = (nj == opt_pos.rows() && nj == weights.rows());
+        if (!quadratic && (objectives.empty() || 0 != opt_pos.rows() || 0 != weights.rows()))
             return (error = E_SIZE_MISMATCH);
         //Let the ChainJntToJacSolver calculate the jacobian "jac" for
         //the current joint positions "q_in" 
@@ -95,8 +116,24 @@ namespace ARMstrongKDL
 
         //Do a singular value decomposition of "jac" with maximum
         //iterations "maxiter", put the results in "U", "S" and "V"
-        //jac = U*S*Vt
-        svdResult = svd_eigen_HH(jac.data,U,S,V,tmp,maxiter);
+        //jac = U*S*Vt, starting from the previous "V" if possible
+        svd_stats.decompositions++;
+        svd_stats.last_sweeps = 0;
+        int sweeps = -1;
+        if (warm_start && svd_valid) {
+            sweeps = svd_eigen_Jacobi(jac.data,U,S,V,B,1e-24,max_sweeps);
+            if (sweeps < 0)
+                svd_stats.fallbacks++;
+        }
+        if (sweeps >= 0) {
+            svdResult = 0;
+            svd_stats.warm++;
+            svd_stats.sweeps += sweeps;
+            svd_stats.last_sweeps = sweeps;
+        }
+        else
+            svdResult = svd_eigen_HH(jac.data,U,S,V,tmp,maxiter);
+        svd_valid = (0 == svdResult);
         if (0 != svdResult)
         {
             qdot_out.data.setZero() ;
@@ -139,7 +176,7 @@ namespace ARMstrongKDL
 
         double g = 0; // g(q)
         double A = 0; // normalizing term
-        for (i = 0; i < nj; ++i) {
+        for (i = 0; quadratic && i < nj; ++i) {
             double qd = q_in(i) - opt_pos(i);
             g += 0.5 * qd*qd * weights(i);
             A += qd*qd * weights(i)*weights(i);
@@ -159,10 +196,53 @@ namespace ARMstrongKDL
               qdot_out(i) += -2*alpha*g * (tmp(i) - tmp2(i));
           }
         }
+
+        if (!objectives.empty()) {
+            state.q = &q_in;
+            state.jac = &jac;
+            state.U = &U;
+            state.S = &S;
+            state.V = &V;
+            state.eps = eps;
+            if (needs_frames)
+                state.updateFrames(chain,q_in);
+            gradient.setZero();
+            for (i = 0; i < objectives.size(); ++i) {
+                if (0.0 == objectives[i]->getGain())
+                    continue;
+                int result = objectives[i]->addGradient(state,gradient);
+                if (result < E_NOERROR) {
+                    qdot_out.data.setZero();
+                    return (error = result);
+                }
+            }
+            // (I - J^-1 * J) * gradient = gradient - V*(S^-1*S)*V' * gradient
+            tmp = V.transpose() * gradient;
+            tmp.array() *= Sinv.array() * S.array();
+            qdot_out.data -= alpha * (gradient - V * tmp);
+        }
         //return the return value of the svd decomposition
         return (error = E_NOERROR);
     }
 
+    void ChainIkSolverVel_pinv_nso::setWarmStart(const bool _warm_start, const int _max_sweeps)
+    {
+        warm_start = _warm_start;
+        max_sweeps = _max_sweeps;
+    }
+
+    void ChainIkSolverVel_pinv_nso::addObjective(NullSpaceObjective& objective)
+    {
+        objectives.push_back(&objective);
+        needs_frames = needs_frames || objective.needsFrames();
+    }
+
+    void ChainIkSolverVel_pinv_nso::clearObjectives()
+    {
+        objectives.clear();
+        needs_frames = false;
+    }
+
     int ChainIkSolverVel_pinv_nso::setWeights(const JntArray & _weights)
     {
         if (nj != _weights.rows())
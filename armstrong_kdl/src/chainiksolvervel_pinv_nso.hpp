@@ -24,6 +24,9 @@
 
 #include "chainiksolver.hpp"
 #include "chainjnttojacsolver.hpp"
+#include "nullspaceobjective.hpp"
+#include "utilities/svd_eigen_Macie.hpp"
+#include <vector>
 #include <Eigen/Core>
 
 namespace ARMstrongKDL
@@ -41,6 +44,13 @@ namespace ARMstrongKDL
      * behavior of multibody mechanisms. IEEE Transactions on Systems, Man, and 
      * Cybernetics, 7(12):868–871, 1977
      *
+     * Further costs are added with addObjective(), see NullSpaceObjective.
+     * Their gradients are summed and projected once,
+     * qdot_out -= alpha*(I-J^+*J)*sum(dh/dq), and they share the
+     * jacobian, its SVD and one sweep over the frames of the segments.
+     * With objectives the quadratic criterion above only applies if
+     * opt_pos and weights are set.
+     *
      * @ingroup KinematicFamily
      */
     class ChainIkSolverVel_pinv_nso : public ChainIkSolverVel
@@ -128,12 +138,33 @@ namespace ARMstrongKDL
          */
         virtual int setAlpha(const double alpha);
 
+        /**
+         * Adds a cost to decrease in the null space, the solver keeps a
+         * reference to it.
+         */
+        void addObjective(NullSpaceObjective& objective);
+
+        /// Removes all objectives added with addObjective()
+        void clearObjectives();
+
         /**
          * Retrieve the latest return code from the SVD algorithm
          * @return 0 if CartToJnt() not yet called, otherwise latest SVD result code.
          */
         int getSVDResult()const {return svdResult;};
 
+        /**
+         * Start the SVD of every call from the right singular vectors of
+         * the previous call, see ChainIkSolverVel_wdls::setWarmStart.
+         * Default: off.
+         */
+        void setWarmStart(const bool warm_start,const int max_sweeps=10);
+
+        /**
+         * Request the counters of the warm started SVDs
+         */
+        const SVDWarmStartStats& getSVDStats()const {return svd_stats;};
+
         /// @copydoc ARMstrongKDL::SolverI::updateInternalDataStructures
         virtual void updateInternalDataStructures();
 
@@ -154,6 +185,15 @@ namespace ARMstrongKDL
         double alpha;
         JntArray weights;
         JntArray opt_pos;
+        bool warm_start;
+        bool svd_valid;
+        int max_sweeps;
+        Eigen::MatrixXd B;
+        SVDWarmStartStats svd_stats;
+        std::vector<NullSpaceObjective*> objectives;
+        bool needs_frames;
+        NullSpaceState state;
+        Eigen::VectorXd gradient;
     };
 }
 #endif
@@ -0,0 +1,238 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainiksolvervel_qp.hpp"
+#include <algorithm>
+
+namespace ARMstrongKDL
+{
+    ChainIkSolverVel_qp::ChainIkSolverVel_qp(const Chain& _chain,const JntArray& _q_min,const JntArray& _q_max,
+                                             const JntArray& _v_max,double _dt,double _lambda,int _maxiter):
+        chain(_chain),
+        jnt2jac(chain),
+        nj(chain.getNrOfJoints()),
+        jac(nj),
+        q_min(_q_min),
+        q_max(_q_max),
+        v_max(_v_max),
+        dt(_dt),
+        lambda(_lambda),
+        maxiter(_maxiter),
+        weight_ts(Eigen::MatrixXd::Identity(6,6)),
+        WJ(Eigen::MatrixXd::Zero(6,nj)),
+        H(Eigen::MatrixXd::Zero(nj,nj)),
+        g(Eigen::VectorXd::Zero(nj)),
+        lower(Eigen::VectorXd::Zero(nj)),
+        upper(Eigen::VectorXd::Zero(nj)),
+        x(Eigen::VectorXd::Zero(nj)),
+        grad(Eigen::VectorXd::Zero(nj)),
+        p(Eigen::VectorXd::Zero(nj)),
+        bound(nj,0),
+        H_free(Eigen::MatrixXd::Zero(nj,nj)),
+        rhs(Eigen::VectorXd::Zero(nj)),
+        llt(nj),
+        nr_iterations(0),
+        nr_active(0)
+    {
+        free_joints.reserve(nj);
+    }
+
+    void ChainIkSolverVel_qp::updateInternalDataStructures() {
+        jnt2jac.updateInternalDataStructures();
+        nj = chain.getNrOfJoints();
+        jac.resize(nj);
+        WJ.conservativeResizeLike(Eigen::MatrixXd::Zero(6,nj));
+        H.conservativeResizeLike(Eigen::MatrixXd::Zero(nj,nj));
+        g.conservativeResizeLike(Eigen::VectorXd::Zero(nj));
+        lower.conservativeResizeLike(Eigen::VectorXd::Zero(nj));
+        upper.conservativeResizeLike(Eigen::VectorXd::Zero(nj));
+        x.conservativeResizeLike(Eigen::VectorXd::Zero(nj));
+        grad.conservativeResizeLike(Eigen::VectorXd::Zero(nj));
+        p.conservativeResizeLike(Eigen::VectorXd::Zero(nj));
+        H_free.conservativeResizeLike(Eigen::MatrixXd::Zero(nj,nj));
+        rhs.conservativeResizeLike(Eigen::VectorXd::Zero(nj));
+        bound.resize(nj);
+        free_joints.reserve(nj);
+        resetActiveSet();
+    }
+
+    ChainIkSolverVel_qp::~ChainIkSolverVel_qp()
+    {
+    }
+
+    int ChainIkSolverVel_qp::setJointLimits(const JntArray& q_min_in,const JntArray& q_max_in)
+    {
+        if (q_min_in.rows() != nj || q_max_in.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+        q_min = q_min_in;
+        q_max = q_max_in;
+        return (error = E_NOERROR);
+    }
+
+    int ChainIkSolverVel_qp::setVelocityLimits(const JntArray& v_max_in)
+    {
+        if (v_max_in.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+        v_max = v_max_in;
+        return (error = E_NOERROR);
+    }
+
+    int ChainIkSolverVel_qp::setWeightTS(const Eigen::MatrixXd& Mx)
+    {
+        if (Mx.rows() != 6 || Mx.cols() != 6)
+            return (error = E_SIZE_MISMATCH);
+        weight_ts = Mx;
+        return (error = E_NOERROR);
+    }
+
+    void ChainIkSolverVel_qp::resetActiveSet()
+    {
+        std::fill(bound.begin(),bound.end(),0);
+    }
+
+    int ChainIkSolverVel_qp::CartToJnt(const JntArray& q_in, const Twist& v_in, JntArray& qdot_out)
+    {
+        if (nj != chain.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+
+        if (nj != q_in.rows() || nj != qdot_out.rows() || nj != q_min.rows() ||
+            nj != q_max.rows() || nj != v_max.rows())
+            return (error = E_SIZE_MISMATCH);
+
+        error = jnt2jac.JntToJac(q_in,jac);
+        if (error < E_NOERROR) return error;
+
+        // cost 0.5*x'*H*x + g'*x
+        WJ.noalias() = weight_ts*jac.data;
+        H.noalias() = WJ.transpose()*WJ;
+        H.diagonal().array() += lambda*lambda;
+        Eigen::Matrix<double,6,1> v;
+        for (unsigned int i=0;i<6;i++)
+            v(i) = v_in(i);
+        g.noalias() = -WJ.transpose()*(weight_ts*v);
+
+        // bounds, and a feasible start on the bounds of the previous call
+        unsigned int i,k;
+        for (i=0;i<nj;i++) {
+            lower(i) = std::max(-v_max(i),(q_min(i)-q_in(i))/dt);
+            upper(i) = std::min(v_max(i),(q_max(i)-q_in(i))/dt);
+            if (lower(i) > upper(i)) {
+                // outside the position limits, back at maximum velocity
+                if (q_in(i) < q_min(i))
+                    lower(i) = upper(i);
+                else
+                    upper(i) = lower(i);
+            }
+            if (bound[i] < 0)
+                x(i) = lower(i);
+            else if (bound[i] > 0)
+                x(i) = upper(i);
+            else
+                x(i) = std::min(std::max(0.0,lower(i)),upper(i));
+        }
+
+        const double tolerance = 1e-12*(1.0+H.diagonal().maxCoeff());
+        nr_iterations = 0;
+        bool optimal = false;
+        while (!optimal && nr_iterations < (unsigned int)maxiter) {
+            nr_iterations++;
+            grad.noalias() = H*x;
+            grad += g;
+
+            // Newton step of the free joints
+            free_joints.clear();
+            for (i=0;i<nj;i++)
+                if (bound[i] == 0)
+                    free_joints.push_back(i);
+            const unsigned int nf = free_joints.size();
+            bool stationary = true;
+            if (nf > 0) {
+                for (k=0;k<nf;k++) {
+                    for (unsigned int l=0;l<nf;l++)
+                        H_free(k,l) = H(free_joints[k],free_joints[l]);
+                    rhs(k) = -grad(free_joints[k]);
+                }
+                llt.compute(H_free.topLeftCorner(nf,nf));
+                if (llt.info() != Eigen::Success) {
+                    // H is singular on the free joints, lambda is zero
+                    qdot_out.data = x;
+                    return (error = E_UNDEFINED);
+                }
+                p.head(nf) = llt.solve(rhs.head(nf));
+                // relative to the solution, below that is rounding noise
+                stationary = p.head(nf).lpNorm<Eigen::Infinity>() <=
+                    1e-10*(1.0+x.lpNorm<Eigen::Infinity>());
+            }
+
+            if (!stationary) {
+                // go as far as possible towards the Newton point
+                double alpha = 1.0;
+                int blocking = -1;
+                for (k=0;k<nf;k++) {
+                    i = free_joints[k];
+                    double a;
+                    if (p(k) < 0)
+                        a = (lower(i)-x(i))/p(k);
+                    else if (p(k) > 0)
+                        a = (upper(i)-x(i))/p(k);
+                    else
+                        continue;
+                    if (a < alpha) {
+                        alpha = a;
+                        blocking = i;
+                    }
+                }
+                for (k=0;k<nf;k++)
+                    x(free_joints[k]) += alpha*p(k);
+                if (blocking >= 0) {
+                    // p(k) of the blocking joint decides the bound
+                    for (k=0;free_joints[k]!=(unsigned int)blocking;k++);
+                    bound[blocking] = p(k) < 0 ? -1 : 1;
+                    x(blocking) = p(k) < 0 ? lower(blocking) : upper(blocking);
+                    continue;
+                }
+                // the full step reached the minimum on the free joints
+                grad.noalias() = H*x;
+                grad += g;
+            }
+
+            // stationary on the free joints, release the bound with the
+            // largest wrong multiplier
+            int release = -1;
+            double worst = tolerance;
+            for (i=0;i<nj;i++) {
+                if (bound[i] == 0 || lower(i) == upper(i))
+                    continue;
+                double multiplier = bound[i] < 0 ? -grad(i) : grad(i);
+                if (multiplier > worst) {
+                    worst = multiplier;
+                    release = i;
+                }
+            }
+            if (release < 0)
+                optimal = true;
+            else
+                bound[release] = 0;
+        }
+
+        nr_active = 0;
+        for (i=0;i<nj;i++)
+            if (bound[i] != 0)
+                nr_active++;
+        qdot_out.data = x;
+        if (!optimal)
+            return (error = E_MAX_ITERATIONS_EXCEEDED);
+        return (error = nr_active > 0 ? E_DEGRADED : E_NOERROR);
+    }
+}
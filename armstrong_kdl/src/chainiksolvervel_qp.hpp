@@ -0,0 +1,174 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAIN_IKSOLVERVEL_QP_HPP
+#define KDL_CHAIN_IKSOLVERVEL_QP_HPP
+
+#include "chainiksolver.hpp"
+#include "chainjnttojacsolver.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Cholesky>
+#include <vector>
+
+namespace ARMstrongKDL
+{
+    /**
+     * Implementation of an inverse velocity kinematics algorithm that
+     * respects joint position and velocity limits as hard constraints,
+     * instead of clamping the joint velocities afterwards.
+     *
+     * The joint velocities minimize
+     *
+     *   |M_x*(J*qdot - v_in)|^2 + lambda^2*|qdot|^2
+     *
+     * subject to max(-v_max,(q_min-q)/dt) <= qdot <= min(v_max,(q_max-q)/dt),
+     * i.e. a joint never passes its position limit within one time step dt.
+     * The quadratic program is solved with a primal active set method on
+     * the bounds.  The set of joints at a bound is kept between calls and
+     * is the start of the next call, so in a control loop that hardly
+     * changes between calls only one or two Cholesky factorizations of the
+     * free joints are needed.
+     *
+     * When q is outside its position limits, the joint is moved back with
+     * the maximum velocity.
+     *
+     * @ingroup KinematicFamily
+     */
+    class ChainIkSolverVel_qp : public ChainIkSolverVel
+    {
+    public:
+        /**
+         * Constructor of the solver
+         *
+         * @param chain the chain to calculate the inverse velocity
+         * kinematics for
+         * @param q_min the minimum joint positions
+         * @param q_max the maximum joint positions
+         * @param v_max the maximum absolute joint velocities
+         * @param dt the time step, the time in which the joints may not
+         * pass their position limits
+         * @param lambda the damping factor, it has to be positive for
+         * chains with more than six joints, default: 0.001
+         * @param maxiter the maximum number of active set iterations,
+         * default: 100
+         */
+        ChainIkSolverVel_qp(const Chain& chain,const JntArray& q_min,const JntArray& q_max,
+                            const JntArray& v_max,double dt,double lambda=0.001,int maxiter=100);
+        ~ChainIkSolverVel_qp();
+
+        /**
+         * Find the joint velocities \a qdot_out for the joint positions
+         * \a q_in and the desired Cartesian velocity \a v_in.
+         *
+         * @return E_NOERROR if no limit is active,
+         *         E_DEGRADED if a limit is active, the Cartesian velocity
+         *         may not be reached,
+         *         E_MAX_ITERATIONS_EXCEEDED if the active set did not
+         *         converge, qdot_out is within the limits then,
+         *         E_UNDEFINED if the problem is singular on the free
+         *         joints (lambda zero), qdot_out is within the limits then,
+         *         E_SIZE_MISMATCH, E_NOT_UP_TO_DATE.
+         */
+        virtual int CartToJnt(const JntArray& q_in, const Twist& v_in, JntArray& qdot_out);
+        /**
+         * not (yet) implemented.
+         *
+         */
+        virtual int CartToJnt(const JntArray& /*q_init*/, const FrameVel& /*v_in*/, JntArrayVel& /*q_out*/){return (error = E_NOT_IMPLEMENTED);};
+
+        /**
+         * Set the joint position limits
+         * @return E_SIZE_MISMATCH if the sizes do not match the chain
+         */
+        int setJointLimits(const JntArray& q_min,const JntArray& q_max);
+
+        /**
+         * Set the maximum absolute joint velocities
+         * @return E_SIZE_MISMATCH if the size does not match the chain
+         */
+        int setVelocityLimits(const JntArray& v_max);
+
+        /**
+         * Set the task space weighting matrix M_x, see
+         * ChainIkSolverVel_wdls::setWeightTS, default: identity
+         * @return E_SIZE_MISMATCH if Mx is not 6x6
+         */
+        int setWeightTS(const Eigen::MatrixXd& Mx);
+
+        /**
+         * Set the time step
+         */
+        void setTimeStep(const double dt_in) {dt=dt_in;};
+
+        /**
+         * Set lambda
+         */
+        void setLambda(const double lambda_in) {lambda=lambda_in;};
+
+        /**
+         * Set maxIter
+         */
+        void setMaxIter(const int maxiter_in) {maxiter=maxiter_in;};
+
+        /**
+         * Forget the active set of the previous call, the next call
+         * starts with all joints free.
+         */
+        void resetActiveSet();
+
+        /**
+         * Request the number of active set iterations of the last call
+         */
+        unsigned int getNrIterations()const {return nr_iterations;};
+
+        /**
+         * Request the number of joints at a limit after the last call
+         */
+        unsigned int getNrActiveConstraints()const {return nr_active;};
+
+        /// @copydoc ARMstrongKDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        const Chain& chain;
+        ChainJntToJacSolver jnt2jac;
+        unsigned int nj;
+        Jacobian jac;
+        JntArray q_min;
+        JntArray q_max;
+        JntArray v_max;
+        double dt;
+        double lambda;
+        int maxiter;
+        Eigen::MatrixXd weight_ts;
+        Eigen::MatrixXd WJ;
+        Eigen::MatrixXd H;
+        Eigen::VectorXd g;
+        Eigen::VectorXd lower;
+        Eigen::VectorXd upper;
+        Eigen::VectorXd x;
+        Eigen::VectorXd grad;
+        Eigen::VectorXd p;
+        // -1 at the lower bound, +1 at the upper bound, 0 free
+        std::vector<int> bound;
+        std::vector<unsigned int> free_joints;
+        Eigen::MatrixXd H_free;
+        Eigen::VectorXd rhs;
+        Eigen::LLT<Eigen::MatrixXd> llt;
+        unsigned int nr_iterations;
+        unsigned int nr_active;
+    };
+}
+#endif
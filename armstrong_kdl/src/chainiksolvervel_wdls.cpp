@@ -47,7 +47,15 @@ namespace ARMstrongKDL
         lambda_scaled(0.0),
         nrZeroSigmas(0),
         svdResult(0),
-        sigmaMin(0)
+        sigmaMin(0),
+        damping_mode(SCALED_DAMPING),
+        max_step(PI_4),
+        dq(Eigen::VectorXd::Zero(nj)),
+        rho(Eigen::VectorXd::Zero(nj)),
+        warm_start(false),
+        svd_valid(false),
+        max_sweeps(10),
+        B(Eigen::MatrixXd::Zero(6,nj))
     {
     }
     
@@ -67,6 +75,10 @@ namespace ARMstrongKDL
         tmp_jac_weight2.conservativeResizeLike(z6nj);
         tmp_js.conservativeResizeLike(znjnj);
         weight_js.conservativeResizeLike(Eigen::MatrixXd::Identity(nj,nj));
+        B.conservativeResizeLike(z6nj);
+        dq.conservativeResizeLike(znj);
+        rho.conservativeResizeLike(znj);
+        svd_valid = false;
     }
 
     ChainIkSolverVel_wdls::~ChainIkSolverVel_wdls()
@@ -105,6 +117,12 @@ namespace ARMstrongKDL
         maxiter=maxiter_in;
     }
 
+    void ChainIkSolverVel_wdls::setWarmStart(const bool warm_start_in,const int max_sweeps_in)
+    {
+        warm_start=warm_start_in;
+        max_sweeps=max_sweeps_in;
+    }
+
     int ChainIkSolverVel_wdls::getSigma(Eigen::VectorXd& Sout)
     {
         if (Sout.size() != S.size())
@@ -142,8 +160,25 @@ namespace ARMstrongKDL
         tmp_jac_weight1 = jac.data.lazyProduct(weight_js);
         tmp_jac_weight2 = weight_ts.lazyProduct(tmp_jac_weight1);
 
-        // Compute the SVD of the weighted jacobian
-        svdResult = svd_eigen_HH(tmp_jac_weight2,U,S,V,tmp,maxiter);
+        // Compute the SVD of the weighted jacobian, from the previous one
+        // if possible
+        svd_stats.decompositions++;
+        svd_stats.last_sweeps = 0;
+        int sweeps = -1;
+        if (warm_start && svd_valid) {
+            sweeps = svd_eigen_Jacobi(tmp_jac_weight2,U,S,V,B,1e-24,max_sweeps);
+            if (sweeps < 0)
+                svd_stats.fallbacks++;
+        }
+        if (sweeps >= 0) {
+            svdResult = 0;
+            svd_stats.warm++;
+            svd_stats.sweeps += sweeps;
+            svd_stats.last_sweeps = sweeps;
+        }
+        else
+            svdResult = svd_eigen_HH(tmp_jac_weight2,U,S,V,tmp,maxiter);
+        svd_valid = (0 == svdResult);
         if (0 != svdResult)
         {
             qdot_out.data.setZero() ;
@@ -179,7 +214,16 @@ namespace ARMstrongKDL
                 lambda_scaled = sqrt(1.0-(sigmaMin/eps)*(sigmaMin/eps))*lambda ;
             }
             if(fabs(S(i))<eps) {
-                if (i<6) {
+                if (i<6 && damping_mode == ADAPTIVE_DAMPING) {
+                    // Scale lambda to size of this singular value
+                    double lambda_i2 = (1.0-(S(i)/eps)*(S(i)/eps))*lambda*lambda;
+                    tmp(i) = S(i) == 0.0 ? 0.0 : sum*(S(i)/(S(i)*S(i)+lambda_i2));
+                }
+                else if (i<6 && damping_mode == SELECTIVE_DAMPING) {
+                    // limited below
+                    tmp(i) = S(i) == 0.0 ? 0.0 : sum/S(i);
+                }
+                else if (i<6) {
                     // Scale lambda to size of singular value sigmaMin
                     tmp(i) = sum*((S(i)/(S(i)*S(i)+lambda_scaled*lambda_scaled)));
                 }
@@ -204,7 +248,30 @@ namespace ARMstrongKDL
             qdot_out(i)=sum;
         }
         */
-        qdot_out.data=tmp_js.lazyProduct(tmp);
+        if (damping_mode == SELECTIVE_DAMPING) {
+            // rho(j) : how far joint j moves the end effector, N : how
+            // far a unit step along U(i) is, M : how far the joints move
+            // the end effector for it, so the step along V(i) is limited
+            // to max_step*N/M
+            for (j=0;j<jac.columns();j++)
+                rho(j) = tmp_jac_weight2.block(0,j,3,1).norm()+tmp_jac_weight2.block(3,j,3,1).norm();
+            dq.setZero();
+            for (i=0;i<jac.columns() && i<6;i++) {
+                if (tmp(i) == 0.0)
+                    continue;
+                double N = U.block(0,i,3,1).norm()+U.block(3,i,3,1).norm();
+                double M = V.col(i).cwiseAbs().dot(rho)/S(i);
+                double gamma = M > N ? max_step*N/M : max_step;
+                double step = std::abs(tmp(i))*V.col(i).cwiseAbs().maxCoeff();
+                dq += V.col(i)*(step > gamma ? tmp(i)*gamma/step : tmp(i));
+            }
+            double step = dq.cwiseAbs().maxCoeff();
+            if (step > max_step)
+                dq *= max_step/step;
+            qdot_out.data=weight_js.lazyProduct(dq);
+        }
+        else
+            qdot_out.data=tmp_js.lazyProduct(tmp);
 
         // If number of near zero singular values is greater than the full rank
         // of jac, then wdls is active
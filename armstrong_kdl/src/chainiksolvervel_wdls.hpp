@@ -24,6 +24,7 @@
 
 #include "chainiksolver.hpp"
 #include "chainjnttojacsolver.hpp"
+#include "utilities/svd_eigen_Macie.hpp"
 #include <Eigen/Core>
 
 namespace ARMstrongKDL
@@ -57,6 +58,12 @@ namespace ARMstrongKDL
      * The International Journal of Robotics Research,
      * vol. 12, no. 1, pages 1-19, february 1993.
      *
+     * The damping of the singular values below eps is chosen with
+     * setDampingMode(), see DampingMode.  Selective damping follows
+     * 3) [Buss 05] S. R. Buss & J.-S. Kim.
+     * Selectively Damped Least Squares for Inverse Kinematics.
+     * Journal of Graphics Tools, vol. 10, no. 3, pages 37-49, 2005.
+     *
      *
      * @ingroup KinematicFamily
      */
@@ -66,6 +73,22 @@ namespace ARMstrongKDL
         /// solution converged but (pseudo)inverse is singular
         static const int E_CONVERGE_PINV_SINGULAR = +100;
 
+        /// damping of the singular directions of the weighted jacobian
+        enum DampingMode {
+            /// every singular value below eps is damped with lambda, scaled
+            /// with the smallest singular value (default)
+            SCALED_DAMPING,
+            /// every singular value below eps is damped with lambda, scaled
+            /// with that singular value, so the directions far from singular
+            /// are not damped as much as the nearly singular one
+            ADAPTIVE_DAMPING,
+            /// the step along every singular direction is limited to the
+            /// joint step that moves the end effector about as far as the
+            /// task asks [Buss 05], the whole step to getMaxStep(); lambda
+            /// is not used
+            SELECTIVE_DAMPING
+        };
+
         /**
          * Constructor of the solver
          *
@@ -170,6 +193,28 @@ namespace ARMstrongKDL
          */
         void setMaxIter(const int maxiter_in);
 
+        /**
+         * Set the damping mode, default: SCALED_DAMPING
+         */
+        void setDampingMode(const DampingMode mode) {damping_mode=mode;};
+
+        /**
+         * Request the damping mode
+         */
+        DampingMode getDampingMode()const {return damping_mode;};
+
+        /**
+         * Set the largest absolute joint velocity of the selective damping,
+         * the largest joint step when used in a position solver,
+         * default: PI/4
+         */
+        void setMaxStep(const double max_step_in) {max_step=max_step_in;};
+
+        /**
+         * Request the largest absolute joint velocity of the selective damping
+         */
+        double getMaxStep()const {return max_step;};
+
         /**
          * Request the number of singular values of the jacobian that are < eps;
          * if the number of near zero singular values is > jac.col()-jac.row(),
@@ -209,6 +254,21 @@ namespace ARMstrongKDL
          */
         int getSVDResult()const {return svdResult;};
 
+        /**
+         * Start the SVD of every call from the right singular vectors of
+         * the previous call (see svd_eigen_Jacobi), instead of computing
+         * it from scratch.  When the jacobian changes little between calls
+         * this takes one or two sweeps.  If the rotations have not
+         * converged after max_sweeps sweeps, the SVD is computed from
+         * scratch.  Default: off.
+         */
+        void setWarmStart(const bool warm_start,const int max_sweeps=10);
+
+        /**
+         * Request the counters of the warm started SVDs
+         */
+        const SVDWarmStartStats& getSVDStats()const {return svd_stats;};
+
         /// @copydoc ARMstrongKDL::SolverI::strError()
         virtual const char* strError(const int error) const;
 
@@ -238,6 +298,15 @@ namespace ARMstrongKDL
 		unsigned int nrZeroSigmas ;
 		int svdResult;
 		double sigmaMin;
+        DampingMode damping_mode;
+        double max_step;
+        Eigen::VectorXd dq;
+        Eigen::VectorXd rho;
+        bool warm_start;
+        bool svd_valid;
+        int max_sweeps;
+        Eigen::MatrixXd B;
+        SVDWarmStartStats svd_stats;
     };
 }
 #endif
@@ -24,7 +24,7 @@
 namespace ARMstrongKDL
 {
     ChainJntToJacSolver::ChainJntToJacSolver(const Chain& _chain):
-        chain(_chain),locked_joints_(chain.getNrOfJoints(),false)
+        chain(_chain),locked_joints_(chain.getNrOfJoints(),false),mimic(0)
     {
     }
 
@@ -45,6 +45,16 @@ namespace ARMstrongKDL
         return (error = E_NOERROR);
     }
 
+    int ChainJntToJacSolver::setMimicMap(const JntMimicMap* map)
+    {
+        if(map && map->getNrOfJoints()!=chain.getNrOfJoints())
+            return (error = E_SIZE_MISMATCH);
+        if(map && !map->isValid())
+            return (error = E_OUT_OF_RANGE);
+        mimic = map;
+        return (error = E_NOERROR);
+    }
+
     int ChainJntToJacSolver::JntToJac(const JntArray& q_in, Jacobian& jac, int seg_nr)
     {
         if(locked_joints_.size() != chain.getNrOfJoints())
@@ -58,7 +68,8 @@ namespace ARMstrongKDL
         //Initialize Jacobian to zero since only segmentNr columns are computed
         SetToZero(jac) ;
 
-        if( q_in.rows()!=chain.getNrOfJoints() || jac.columns() != chain.getNrOfJoints())
+        const unsigned int nq = mimic ? mimic->getNrOfIndependentJoints() : chain.getNrOfJoints();
+        if( q_in.rows()!=nq || jac.columns() != nq)
             return (error = E_SIZE_MISMATCH);
         else if(segmentNr>chain.getNrOfSegments())
             return (error = E_OUT_OF_RANGE);
@@ -71,12 +82,13 @@ namespace ARMstrongKDL
         for (unsigned int i=0;i<segmentNr;i++) {
             //Calculate new Frame_base_ee
             if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed) {
+                const double q_j = mimic ? mimic->position(q_in,j) : q_in(j);
             	//pose of the new end-point expressed in the base
-                total = T_tmp*chain.getSegment(i).pose(q_in(j));
+                total = T_tmp*chain.getSegment(i).pose(q_j);
                 //changing base of new segment's twist to base frame if it is not locked
                 //t_tmp = T_tmp.M*chain.getSegment(i).twist(1.0);
                 if(!locked_joints_[j])
-                    t_tmp = T_tmp.M*chain.getSegment(i).twist(q_in(j),1.0);
+                    t_tmp = T_tmp.M*chain.getSegment(i).twist(q_j,1.0);
             }else{
                 total = T_tmp*chain.getSegment(i).pose(0.0);
 
@@ -87,8 +99,15 @@ namespace ARMstrongKDL
 
             //Only increase jointnr if the segment has a joint
             if(chain.getSegment(i).getJoint().getType()!=Joint::Fixed) {
-                //Only put the twist inside if it is not locked
-                if(!locked_joints_[j])
+                //Only put the twist inside if it is not locked, a mimic
+                //joint adds it to the column of the joint it follows
+                if(mimic) {
+                    if(!locked_joints_[j]) {
+                        const unsigned int c = mimic->index(j);
+                        jac.setColumn(c,jac.getColumn(c)+mimic->multiplier(j)*t_tmp);
+                    }
+                }
+                else if(!locked_joints_[j])
                     jac.setColumn(k++,t_tmp);
                 j++;
             }
@@ -27,6 +27,7 @@
 #include "jacobian.hpp"
 #include "jntarray.hpp"
 #include "chain.hpp"
+#include "jntmimicmap.hpp"
 
 namespace ARMstrongKDL
 {
@@ -61,6 +62,19 @@ namespace ARMstrongKDL
          */
         int setLockedJoints(const std::vector<bool> locked_joints);
 
+        /**
+         * Lets the solver take the reduced coordinates of map as input
+         * and compute the jacobian J*M towards them, jac then has a
+         * column per independent joint.  The columns of the mimic joints
+         * are added to the column of the joint they follow while the
+         * jacobian is computed.
+         *
+         * @param map the mimic joints, a pointer is kept, 0 for none
+         * @return E_SIZE_MISMATCH if the map does not match the chain,
+         *         E_OUT_OF_RANGE if the map is not valid
+         */
+        int setMimicMap(const JntMimicMap* map);
+
         /// @copydoc ARMstrongKDL::SolverI::updateInternalDataStructures
         virtual void updateInternalDataStructures();
 
@@ -69,6 +83,7 @@ namespace ARMstrongKDL
         Twist t_tmp;
         Frame T_tmp;
         std::vector<bool> locked_joints_;
+        const JntMimicMap* mimic;
     };
 }
 #endif
@@ -0,0 +1,121 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAINJNTTOJACSOLVER_SCALAR_HPP
+#define KDL_CHAINJNTTOJACSOLVER_SCALAR_HPP
+
+#include "chainscalar.hpp"
+#include "solveri.hpp"
+
+namespace ARMstrongKDL
+{
+    /**
+     * Jacobian of a chain, see ChainJntToJacSolver, with scalar type T
+     * (e.g. float).  Locked joints are not supported.
+     *
+     * The reference point is the end of the last segment taken into
+     * account and the reference frame is the base of the chain.  The
+     * columns are computed in one pass and moved to the reference point
+     * afterwards, instead of changing the reference point of all columns
+     * at every segment.
+     *
+     * @ingroup KinematicFamily
+     */
+    template<typename T>
+    class ChainJntToJacSolverT : public SolverI
+    {
+    public:
+        explicit ChainJntToJacSolverT(const Chain& chain);
+
+        /**
+         * Calculate the jacobian expressed in the base frame of the
+         * chain, with reference point at the end effector of the *chain.
+         *
+         * @param q_in input joint positions
+         * @param jac output jacobian, should have getNrOfJoints() columns
+         * @param seg_nr number of segments to take into account, -1 for all
+         *
+         * @return success/error code
+         */
+        int JntToJac(const JntArrayT<T>& q_in, JacobianT<T>& jac, int seg_nr=-1);
+
+        virtual void updateInternalDataStructures();
+
+    private:
+        const Chain& chain;
+        ChainT<T> chain_t;
+        // position of the tip of the segment of every joint :
+        std::vector<VectorT<T> > p_joint;
+    };
+
+    typedef ChainJntToJacSolverT<float> ChainJntToJacSolverf;
+
+
+    template<typename T>
+    ChainJntToJacSolverT<T>::ChainJntToJacSolverT(const Chain& _chain):
+        chain(_chain),chain_t(_chain),p_joint(_chain.getNrOfJoints())
+    {
+    }
+
+    template<typename T>
+    void ChainJntToJacSolverT<T>::updateInternalDataStructures()
+    {
+        chain_t.set(chain);
+        p_joint.resize(chain.getNrOfJoints());
+    }
+
+    template<typename T>
+    int ChainJntToJacSolverT<T>::JntToJac(const JntArrayT<T>& q_in, JacobianT<T>& jac, int seg_nr)
+    {
+        if(chain_t.getNrOfSegments()!=chain.getNrOfSegments() || p_joint.size()!=chain.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+        unsigned int segmentNr = seg_nr<0 ? chain.getNrOfSegments() : seg_nr;
+
+        if(q_in.rows()!=chain.getNrOfJoints() || jac.cols()!=chain.getNrOfJoints())
+            return (error = E_SIZE_MISMATCH);
+        else if(segmentNr>chain.getNrOfSegments())
+            return (error = E_OUT_OF_RANGE);
+
+        jac.setZero();
+        FrameT<T> T_tmp;
+        unsigned int j=0;
+        for (unsigned int i=0;i<segmentNr;i++) {
+            const SegmentT<T>& segment = chain_t.segments[i];
+            if(segment.type!=Joint::Fixed) {
+                // twist of the joint with reference point at the tip of
+                // the segment, expressed in the base :
+                TwistT<T> t = T_tmp.M*segment.twist(q_in(j),T(1));
+                segment.applyPose(T_tmp,q_in(j));
+                for (int r=0;r<3;++r) {
+                    jac(r,j) = t.vel(r);
+                    jac(r+3,j) = t.rot(r);
+                }
+                p_joint[j] = T_tmp.p;
+                j++;
+            }else{
+                segment.applyPose(T_tmp,T(0));
+            }
+        }
+        // change the reference point of all columns to the end effector :
+        for (unsigned int k=0;k<j;k++) {
+            VectorT<T> rot(jac(3,k),jac(4,k),jac(5,k));
+            VectorT<T> dv = rot*(T_tmp.p-p_joint[k]);
+            for (int r=0;r<3;++r)
+                jac(r,k) += dv(r);
+        }
+        return (error = E_NOERROR);
+    }
+}
+
+#endif
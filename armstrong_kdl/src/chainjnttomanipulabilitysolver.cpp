@@ -0,0 +1,143 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "chainjnttomanipulabilitysolver.hpp"
+#include <limits>
+#include <Eigen/Geometry>
+
+namespace ARMstrongKDL
+{
+    ChainJntToManipulabilitySolver::ChainJntToManipulabilitySolver(const Chain& _chain, double _eps):
+        chain(_chain),
+        nj(chain.getNrOfJoints()),
+        eps(_eps),
+        jnt2jac(chain),
+        jac(nj),
+        svd(6,nj,Eigen::ComputeThinU | Eigen::ComputeThinV),
+        dsigma(nj,nj < 6 ? nj : 6),
+        tmp(nj)
+    {
+    }
+
+    void ChainJntToManipulabilitySolver::updateInternalDataStructures() {
+        jnt2jac.updateInternalDataStructures();
+        nj = chain.getNrOfJoints();
+        jac.resize(nj);
+        svd = Eigen::JacobiSVD<Eigen::MatrixXd>(6,nj,Eigen::ComputeThinU | Eigen::ComputeThinV);
+        dsigma.resize(nj,nj < 6 ? nj : 6);
+        tmp.resize(nj);
+    }
+
+    ChainJntToManipulabilitySolver::~ChainJntToManipulabilitySolver()
+    {
+    }
+
+    int ChainJntToManipulabilitySolver::compute(const JntArray& q_in)
+    {
+        if (nj != chain.getNrOfJoints())
+            return (error = E_NOT_UP_TO_DATE);
+        if (q_in.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+        error = jnt2jac.JntToJac(q_in,jac);
+        if (error < E_NOERROR)
+            return error;
+        svd.compute(jac.data);
+        return (error = E_NOERROR);
+    }
+
+    void ChainJntToManipulabilitySolver::singularValueGradient(const Eigen::MatrixXd& J, const Eigen::Ref<const Eigen::VectorXd>& u,
+                                                               const Eigen::Ref<const Eigen::VectorXd>& v, Eigen::VectorXd& grad)
+    {
+        // d(sigma_i)/dq_k = u'*dJ/dq_k*v with
+        //   dJ/dq_k*v = (w_k x L_k + A_k x v_k, w_k x W_k)
+        // L_k, W_k : sum of v_c*(v_c,w_c) over the columns c > k,
+        // A_k      : sum of v_c*w_c over the columns c <= k.
+        const Eigen::Vector3d u_lin = u.head<3>();
+        const Eigen::Vector3d u_rot = u.tail<3>();
+
+        Eigen::Vector3d total_rot = J.bottomRows<3>()*v;
+        Eigen::Vector3d sum_lin = Eigen::Vector3d::Zero();
+        Eigen::Vector3d sum_rot = Eigen::Vector3d::Zero();
+        for (int k=J.cols()-1;k>=0;k--) {
+            const Eigen::Vector3d v_k = J.col(k).head<3>();
+            const Eigen::Vector3d w_k = J.col(k).tail<3>();
+            const Eigen::Vector3d before_rot = total_rot-sum_rot;
+            grad(k) = u_lin.dot(w_k.cross(sum_lin)+before_rot.cross(v_k))+u_rot.dot(w_k.cross(sum_rot));
+            sum_lin += v(k)*v_k;
+            sum_rot += v(k)*w_k;
+        }
+    }
+
+    int ChainJntToManipulabilitySolver::JntToManipulability(const JntArray& q_in, double& manipulability,
+                                                            double& condition_number, double& sigma_min)
+    {
+        if (compute(q_in) < E_NOERROR)
+            return error;
+        const Eigen::VectorXd& S = svd.singularValues();
+        const unsigned int m = S.size();
+        manipulability = S.prod();
+        sigma_min = m > 0 ? S(m-1) : 0.0;
+        // relative to sigma_max, as the SVD of a singular jacobian gives
+        // a sigma_min of the order of the rounding errors, not zero
+        if (m == 0 || !(sigma_min > eps*S(0))) {
+            condition_number = std::numeric_limits<double>::infinity();
+            return (error = E_DEGRADED);
+        }
+        condition_number = S(0)/sigma_min;
+        return (error = E_NOERROR);
+    }
+
+    int ChainJntToManipulabilitySolver::JntToManipulability(const JntArray& q_in,
+                                                            double& manipulability, JntArray& manipulability_gradient,
+                                                            double& condition_number, JntArray& condition_number_gradient,
+                                                            double& sigma_min, JntArray& sigma_min_gradient)
+    {
+        if (manipulability_gradient.rows() != nj || condition_number_gradient.rows() != nj ||
+            sigma_min_gradient.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+        int result = JntToManipulability(q_in,manipulability,condition_number,sigma_min);
+        if (result < E_NOERROR)
+            return result;
+
+        const Eigen::VectorXd& S = svd.singularValues();
+        const unsigned int m = S.size();
+        if (m == 0) {
+            SetToZero(manipulability_gradient);
+            SetToZero(condition_number_gradient);
+            SetToZero(sigma_min_gradient);
+            return (error = result);
+        }
+        for (unsigned int i=0;i<m;i++) {
+            singularValueGradient(jac.data,svd.matrixU().col(i),svd.matrixV().col(i),tmp);
+            dsigma.col(i) = tmp;
+        }
+
+        // dw = sum_i (prod_{j!=i} sigma_j)*d(sigma_i), also when a sigma is zero
+        manipulability_gradient.data.setZero();
+        for (unsigned int i=0;i<m;i++) {
+            double others = 1.0;
+            for (unsigned int j=0;j<m;j++)
+                if (j != i)
+                    others *= S(j);
+            manipulability_gradient.data += others*dsigma.col(i);
+        }
+
+        sigma_min_gradient.data = dsigma.col(m-1);
+        if (result == E_DEGRADED)
+            SetToZero(condition_number_gradient);
+        else
+            condition_number_gradient.data = (dsigma.col(0)*sigma_min-S(0)*dsigma.col(m-1))/(sigma_min*sigma_min);
+        return (error = result);
+    }
+}
@@ -0,0 +1,117 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAINJNTTOMANIPULABILITYSOLVER_HPP
+#define KDL_CHAINJNTTOMANIPULABILITYSOLVER_HPP
+
+#include "solveri.hpp"
+#include "jacobian.hpp"
+#include "jntarray.hpp"
+#include "chain.hpp"
+#include "chainjnttojacsolver.hpp"
+
+#include <Eigen/SVD>
+
+namespace ARMstrongKDL
+{
+    /**
+     * @brief Computes measures of the distance to a singularity of a
+     * ARMstrongKDL::Chain and their gradients towards the joint positions,
+     * from one jacobian and one SVD :
+     *  - the manipulability of Yoshikawa w = sqrt(det(J*J')), the product
+     *    of the singular values (sqrt(det(J'*J)) for less than six joints),
+     *  - the condition number sigma_max/sigma_min,
+     *  - the smallest singular value sigma_min.
+     *
+     * The gradient of a singular value is d(sigma_i)/dq_k = u_i'*dJ/dq_k*v_i.
+     * The partial derivatives of the jacobian (base frame, end effector
+     * reference point) are the ones of ChainJntToJacDotSolver [Bruyninckx 96] :
+     *
+     *   dJ_c/dq_k = (w_k x v_c, w_k x w_c)  for k < c
+     *             = (w_c x v_k, 0)          for k >= c
+     *
+     * with J_c = (v_c, w_c), so dJ/dq_k*v_i only needs sums over the columns
+     * before and after k, and all gradients cost O(n) after the SVD instead
+     * of n extra jacobians and SVDs for finite differences.  The gradient of
+     * a singular value is not defined where it is repeated.
+     *
+     * [Bruyninckx 96] H. Bruyninckx & J. De Schutter.
+     * Symbolic differentiation of the velocity mapping for a serial
+     * kinematic chain.  Mechanism and Machine Theory, vol. 31, no. 2,
+     * pages 135-148, 1996.
+     */
+    class ChainJntToManipulabilitySolver : public SolverI
+    {
+    public:
+        /**
+         * @param chain the chain
+         * @param eps the configuration is singular where sigma_min is
+         *        not above eps*sigma_max, default: 1e-12
+         */
+        explicit ChainJntToManipulabilitySolver(const Chain& chain, double eps=1e-12);
+        virtual ~ChainJntToManipulabilitySolver();
+
+        /**
+         * Calculates the measures at the joint positions q_in.
+         *
+         * @return E_DEGRADED if sigma_min <= eps*sigma_max, the
+         *         condition number is infinite then, E_SIZE_MISMATCH,
+         *         E_NOT_UP_TO_DATE.
+         */
+        int JntToManipulability(const JntArray& q_in, double& manipulability,
+                                double& condition_number, double& sigma_min);
+
+        /**
+         * Calculates the measures and their gradients at the joint
+         * positions q_in.  The gradient of the condition number is zero
+         * where the configuration is singular.
+         *
+         * @return see above
+         */
+        int JntToManipulability(const JntArray& q_in,
+                                double& manipulability, JntArray& manipulability_gradient,
+                                double& condition_number, JntArray& condition_number_gradient,
+                                double& sigma_min, JntArray& sigma_min_gradient);
+
+        /// The singular values of the jacobian of the last call, sorted decreasing
+        const Eigen::VectorXd& getSingularValues() const { return svd.singularValues(); }
+
+        /**
+         * The gradient d(sigma)/dq = u'*dJ/dq*v of the singular value with
+         * the singular vectors u and v of the jacobian J (base frame, end
+         * effector reference point), in O(n).
+         *
+         * @param grad the gradient, of the size of v
+         */
+        static void singularValueGradient(const Eigen::MatrixXd& J, const Eigen::Ref<const Eigen::VectorXd>& u,
+                                          const Eigen::Ref<const Eigen::VectorXd>& v, Eigen::VectorXd& grad);
+
+        /// @copydoc ARMstrongKDL::SolverI::updateInternalDataStructures
+        virtual void updateInternalDataStructures();
+
+    private:
+        int compute(const JntArray& q_in);
+
+        const Chain& chain;
+        unsigned int nj;
+        double eps;
+        ChainJntToJacSolver jnt2jac;
+        Jacobian jac;
+        Eigen::JacobiSVD<Eigen::MatrixXd> svd;
+        Eigen::MatrixXd dsigma;
+        Eigen::VectorXd tmp;
+    };
+}
+
+#endif
@@ -0,0 +1,221 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_CHAINSCALAR_HPP
+#define KDL_CHAINSCALAR_HPP
+
+#include "chain.hpp"
+#include "framescalar.hpp"
+#include <vector>
+
+namespace ARMstrongKDL {
+
+    /**
+     * A RigidBodyInertia with scalar type T : mass m, first moment of
+     * mass h = m*cog and rotational inertia I (row major) around the
+     * reference point.
+     *
+     * @ingroup KinematicFamily
+     */
+    template<typename T>
+    class RigidBodyInertiaT
+    {
+    public:
+        T m;
+        VectorT<T> h;
+        T I[9];
+
+        RigidBodyInertiaT():m(T(0)) { for (int i=0;i<9;++i) I[i]=T(0); }
+        explicit RigidBodyInertiaT(const RigidBodyInertia& rbi):
+            m(T(rbi.getMass())),h(rbi.getSpatialMomentum())
+        {
+            RotationalInertia Ir = rbi.getRotationalInertia();
+            for (int i=0;i<9;++i) I[i]=T(Ir.data[i]);
+        }
+
+        //! Spatial momentum of the body moving with twist t, see RigidBodyInertia
+        WrenchT<T> operator*(const TwistT<T>& t) const {
+            VectorT<T> Iw(I[0]*t.rot(0)+I[1]*t.rot(1)+I[2]*t.rot(2),
+                          I[3]*t.rot(0)+I[4]*t.rot(1)+I[5]*t.rot(2),
+                          I[6]*t.rot(0)+I[7]*t.rot(1)+I[8]*t.rot(2));
+            return WrenchT<T>(t.vel*m-h*t.rot,Iw+h*t.vel);
+        }
+    };
+
+    /**
+     * A copy of a Segment with its geometry converted to scalar type T,
+     * used by the solvers that are templated on the scalar type.
+     *
+     * @ingroup KinematicFamily
+     */
+    template<typename T>
+    class SegmentT
+    {
+    public:
+        Joint::JointType type;
+        T scale;
+        T offset;
+        VectorT<T> axis;
+        VectorT<T> origin;
+        //! pose from the end of the joint to the tip of the segment
+        FrameT<T> f_tip;
+        //! inertia of the segment in its tip frame, see Segment::getInertia
+        RigidBodyInertiaT<T> I;
+        //! inertia of the joint, see Joint::getInertia
+        T joint_inertia;
+
+        SegmentT():type(Joint::Fixed),scale(T(1)),offset(T(0)),joint_inertia(T(0)) {}
+        explicit SegmentT(const Segment& segment);
+
+        //! See Joint::pose
+        FrameT<T> jointPose(const T& q) const;
+        //! See Joint::twist
+        TwistT<T> jointTwist(const T& qdot) const;
+        //! See Segment::pose
+        FrameT<T> pose(const T& q) const { return jointPose(q)*f_tip; }
+        //! See Segment::applyPose : F = F*pose(q)
+        void applyPose(FrameT<T>& F,const T& q) const;
+        //! See Segment::twist
+        TwistT<T> twist(const T& q,const T& qdot) const {
+            return jointTwist(qdot).RefPoint(jointPose(q).M*f_tip.p);
+        }
+    };
+
+    /**
+     * A copy of a Chain with scalar type T, see SegmentT.
+     *
+     * @ingroup KinematicFamily
+     */
+    template<typename T>
+    class ChainT
+    {
+    public:
+        std::vector<SegmentT<T> > segments;
+        unsigned int nrOfJoints;
+
+        ChainT():nrOfJoints(0) {}
+        explicit ChainT(const Chain& chain) { set(chain); }
+
+        //! Converts chain, to be called again when chain is modified
+        void set(const Chain& chain) {
+            segments.resize(chain.getNrOfSegments());
+            for (unsigned int i=0;i<chain.getNrOfSegments();++i)
+                segments[i] = SegmentT<T>(chain.getSegment(i));
+            nrOfJoints = chain.getNrOfJoints();
+        }
+
+        unsigned int getNrOfJoints() const { return nrOfJoints; }
+        unsigned int getNrOfSegments() const { return static_cast<unsigned int>(segments.size()); }
+    };
+
+
+    template<typename T>
+    SegmentT<T>::SegmentT(const Segment& segment):
+        type(segment.getJoint().getType()),
+        scale(T(segment.getJoint().getScale())),
+        offset(T(segment.getJoint().getOffset())),
+        axis(segment.getJoint().getAxis()),
+        origin(segment.getJoint().getOrigin()),
+        f_tip(segment.getFrameToTipZero()),
+        I(segment.getInertia()),
+        joint_inertia(T(segment.getJoint().getInertia()))
+    {
+    }
+
+    template<typename T>
+    FrameT<T> SegmentT<T>::jointPose(const T& q) const
+    {
+        T a = scale*q+offset;
+        switch(type){
+        case Joint::RotAxis:
+            return FrameT<T>(RotationT<T>::Rot2(axis,a),origin);
+        case Joint::RotX:
+            return FrameT<T>(RotationT<T>::RotX(a));
+        case Joint::RotY:
+            return FrameT<T>(RotationT<T>::RotY(a));
+        case Joint::RotZ:
+            return FrameT<T>(RotationT<T>::RotZ(a));
+        case Joint::TransAxis:
+            return FrameT<T>(origin+axis*a);
+        case Joint::TransX:
+            return FrameT<T>(VectorT<T>(a,T(0),T(0)));
+        case Joint::TransY:
+            return FrameT<T>(VectorT<T>(T(0),a,T(0)));
+        case Joint::TransZ:
+            return FrameT<T>(VectorT<T>(T(0),T(0),a));
+        default:
+            return FrameT<T>::Identity();
+        }
+    }
+
+    template<typename T>
+    TwistT<T> SegmentT<T>::jointTwist(const T& qdot) const
+    {
+        T v = scale*qdot;
+        switch(type){
+        case Joint::RotAxis:
+            return TwistT<T>(VectorT<T>::Zero(),axis*v);
+        case Joint::RotX:
+            return TwistT<T>(VectorT<T>::Zero(),VectorT<T>(v,T(0),T(0)));
+        case Joint::RotY:
+            return TwistT<T>(VectorT<T>::Zero(),VectorT<T>(T(0),v,T(0)));
+        case Joint::RotZ:
+            return TwistT<T>(VectorT<T>::Zero(),VectorT<T>(T(0),T(0),v));
+        case Joint::TransAxis:
+            return TwistT<T>(axis*v,VectorT<T>::Zero());
+        case Joint::TransX:
+            return TwistT<T>(VectorT<T>(v,T(0),T(0)),VectorT<T>::Zero());
+        case Joint::TransY:
+            return TwistT<T>(VectorT<T>(T(0),v,T(0)),VectorT<T>::Zero());
+        case Joint::TransZ:
+            return TwistT<T>(VectorT<T>(T(0),T(0),v),VectorT<T>::Zero());
+        default:
+            return TwistT<T>::Zero();
+        }
+    }
+
+    template<typename T>
+    void SegmentT<T>::applyPose(FrameT<T>& F,const T& q) const
+    {
+        T a = scale*q+offset;
+        switch(type){
+        case Joint::RotX:
+            F.M.DoRotX(a);
+            break;
+        case Joint::RotY:
+            F.M.DoRotY(a);
+            break;
+        case Joint::RotZ:
+            F.M.DoRotZ(a);
+            break;
+        case Joint::TransX:
+            F.p += F.M.UnitX()*a;
+            break;
+        case Joint::TransY:
+            F.p += F.M.UnitY()*a;
+            break;
+        case Joint::TransZ:
+            F.p += F.M.UnitZ()*a;
+            break;
+        case Joint::Fixed:
+            break;
+        default:
+            F = F*jointPose(q);
+        }
+        F = F*f_tip;
+    }
+
+}
+
+#endif
@@ -227,17 +227,20 @@ RotationAcc RotationAcc::Inverse() const {
 
 VectorAcc RotationAcc::Inverse(const VectorAcc& arg) const {
     VectorAcc tmp;
+    // d = R*tmp.v
+    Vector d = arg.v - w * arg.p;
     tmp.p  = R.Inverse(arg.p);
-    tmp.v  = R.Inverse(arg.v - w * arg.p);
-    tmp.dv = R.Inverse(arg.dv - dw*arg.p - w*(arg.v+R*tmp.v));
+    tmp.v  = R.Inverse(d);
+    tmp.dv = R.Inverse(arg.dv - dw*arg.p - w*(arg.v+d));
     return tmp;
 }
 
 VectorAcc RotationAcc::Inverse(const Vector& arg) const {
     VectorAcc tmp;
+    Vector d = -w*arg;
     tmp.p  = R.Inverse(arg);
-    tmp.v  = R.Inverse(-w*arg);
-    tmp.dv = R.Inverse(-dw*arg - w*(R*tmp.v));
+    tmp.v  = R.Inverse(d);
+    tmp.dv = R.Inverse(-dw*arg - w*d);
     return tmp;
 }
 
@@ -348,11 +351,26 @@ FrameAcc FrameAcc::Identity() {
 
 FrameAcc operator *(const FrameAcc& lhs,const FrameAcc& rhs)
 {
-    return FrameAcc(lhs.M*rhs.M,lhs.M*rhs.p+lhs.p);
+    // FrameAcc(lhs.M*rhs.M,lhs.M*rhs.p+lhs.p), with the products of
+    // lhs.M.R computed once
+    const Rotation& R = lhs.M.R;
+    const Vector& w = lhs.M.w;
+    Vector Rw = R*rhs.M.w;
+    Vector Rp = R*rhs.p.p;
+    Vector Rv = R*rhs.p.v;
+    Vector wRp = w*Rp;
+    return FrameAcc(Frame(R*rhs.M.R,lhs.p.p+Rp),
+                    Twist(lhs.p.v+wRp+Rv,w+Rw),
+                    Twist(lhs.p.dv+lhs.M.dw*Rp+w*(wRp+2*Rv)+R*rhs.p.dv,lhs.M.dw+w*Rw+R*rhs.M.dw));
 }
 FrameAcc operator *(const FrameAcc& lhs,const Frame& rhs)
 {
-    return FrameAcc(lhs.M*rhs.M,lhs.M*rhs.p+lhs.p);
+    const Vector& w = lhs.M.w;
+    Vector Rp = lhs.M.R*rhs.p;
+    Vector wRp = w*Rp;
+    return FrameAcc(Frame(lhs.M.R*rhs.M,lhs.p.p+Rp),
+                    Twist(lhs.p.v+wRp,w),
+                    Twist(lhs.p.dv+lhs.M.dw*Rp+w*wRp,lhs.M.dw));
 }
 FrameAcc operator *(const Frame& lhs,const FrameAcc& rhs)
 {
@@ -380,7 +398,13 @@ VectorAcc FrameAcc::Inverse(const Vector& arg) const
 
 FrameAcc FrameAcc::Inverse() const
 {
-    return FrameAcc(M.Inverse(),-M.Inverse(p));
+    // FrameAcc(M.Inverse(),-M.Inverse(p))
+    const Vector& w = M.w;
+    Vector wp = w*p.p;
+    Rotation Ri = M.R.Inverse();
+    return FrameAcc(Frame(Ri,-(Ri*p.p)),
+                    Twist(Ri*(wp-p.v),-(Ri*w)),
+                    Twist(Ri*(M.dw*p.p-w*wp+2*(w*p.v)-p.dv),-(Ri*M.dw)));
 }
 
 FrameAcc& FrameAcc::operator =(const Frame & arg)
@@ -450,7 +474,11 @@ TwistAcc TwistAcc::RefPoint(const VectorAcc& v_base_AB)
      // the new point.
      // Complexity : 6M+6A
 {
-    return TwistAcc(this->vel+this->rot*v_base_AB,this->rot);
+    const VectorAcc& r = rot;
+    const VectorAcc& d = v_base_AB;
+    return TwistAcc(VectorAcc(vel.p+r.p*d.p,
+                              vel.v+r.p*d.v+r.v*d.p,
+                              vel.dv+r.dv*d.p+2*(r.v*d.v)+r.p*d.dv),rot);
 }
 
 TwistAcc& TwistAcc::operator-=(const TwistAcc& arg)
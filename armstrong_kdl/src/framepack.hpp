@@ -0,0 +1,327 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+/**
+ * \file
+ *      Structure-of-arrays versions of the classes defined in frames.hpp :
+ *      VectorPack, RotationPack, FramePack, TwistPack and WrenchPack each
+ *      hold DoublePack::size objects, one per lane, and every operation
+ *      is applied to all lanes at once.  This is meant for evaluating many
+ *      configurations together, e.g. batched forward kinematics or sampling.
+ *
+ *      The width of a DoublePack is chosen at compile time from the
+ *      instruction set the code is compiled for :
+ *        - AVX-512 (-mavx512f)          : 8 doubles
+ *        - AVX/AVX2 (-mavx2, with -mfma) : 4 doubles
+ *        - otherwise                    : 4 doubles, plain C++ loops
+ *      All translation units that exchange pack types should therefore be
+ *      compiled with the same flags.  The SIMD types are over-aligned, dynamic
+ *      allocation of packs requires C++17 (aligned new) or an aligned allocator.
+ */
+
+#ifndef KDL_FRAMEPACK_H
+#define KDL_FRAMEPACK_H
+
+#include "frames.hpp"
+
+#if defined(__AVX512F__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace ARMstrongKDL {
+
+/**
+ * A pack of doubles that is processed with one instruction where possible.
+ */
+class DoublePack
+{
+public:
+#if defined(__AVX512F__)
+    static const int size = 8;
+    __m512d v;
+    explicit DoublePack(__m512d _v):v(_v) {}
+#elif defined(__AVX__)
+    static const int size = 4;
+    __m256d v;
+    explicit DoublePack(__m256d _v):v(_v) {}
+#else
+    static const int size = 4;
+    double v[size];
+#endif
+
+    //! Does not initialise the lanes
+    DoublePack() {}
+    //! All lanes equal to a
+    explicit inline DoublePack(double a);
+    //! Loads size doubles from p (no alignment requirements)
+    static inline DoublePack Load(const double* p);
+    //! Stores size doubles to p (no alignment requirements)
+    inline void Store(double* p) const;
+    //! Value of lane i, 0 <= i < size
+    inline double Get(int i) const;
+    //! Sets lane i to a, 0 <= i < size
+    inline void Set(int i,double a);
+
+    inline DoublePack& operator +=(const DoublePack& a);
+    inline DoublePack& operator -=(const DoublePack& a);
+    inline DoublePack& operator *=(const DoublePack& a);
+};
+
+inline DoublePack operator+(const DoublePack& a,const DoublePack& b);
+inline DoublePack operator-(const DoublePack& a,const DoublePack& b);
+inline DoublePack operator*(const DoublePack& a,const DoublePack& b);
+inline DoublePack operator/(const DoublePack& a,const DoublePack& b);
+inline DoublePack operator-(const DoublePack& a);
+//! a*b+c, fused where the instruction set allows it
+inline DoublePack MultiplyAdd(const DoublePack& a,const DoublePack& b,const DoublePack& c);
+inline DoublePack sqrt(const DoublePack& a);
+//! Largest integer value not greater than a, per lane
+inline DoublePack floor(const DoublePack& a);
+
+/**
+ * Computes sn=sin(angle) and cs=cos(angle) for all lanes.
+ *
+ * The angle is reduced to [-pi/4,pi/4] with a three-part
+ * representation of pi/2, followed by the minimax polynomials of the
+ * Cephes library.  For |angle| <= 1e8 the error is below 2 ULP
+ * (1.6 ULP measured on random samples against a long double reference,
+ * for all instruction sets), except close to the nonzero roots of sin
+ * and cos, where the error of the reduction dominates and the absolute
+ * error is below 1e-24*|angle|, see FramesTest::TestSinCosPack.  The
+ * result is not specified for |angle| > 1e8, infinities or NaN.
+ */
+inline void SinCos(const DoublePack& angle,DoublePack& sn,DoublePack& cs);
+
+/**
+ * Batched version of SinCos(double,double&,double&), e.g. to evaluate
+ * the joint angles of a chain at once : sn[i]=sin(angle[i]) and
+ * cs[i]=cos(angle[i]) for 0 <= i < n, with the accuracy of
+ * SinCos(const DoublePack&,DoublePack&,DoublePack&).
+ */
+inline void SinCos(const double* angle,double* sn,double* cs,int n);
+
+
+class VectorPack;
+class RotationPack;
+class FramePack;
+class TwistPack;
+class WrenchPack;
+
+/**
+ * DoublePack::size Vector objects.
+ */
+class VectorPack
+{
+public:
+    DoublePack data[3];
+
+    //! Does not initialise the lanes
+    VectorPack() {}
+    inline VectorPack(const DoublePack& x,const DoublePack& y,const DoublePack& z);
+    //! All lanes equal to v
+    explicit inline VectorPack(const Vector& v);
+
+    //! Vector of lane i
+    inline Vector Get(int i) const;
+    //! Sets lane i to v
+    inline void Set(int i,const Vector& v);
+
+    inline const DoublePack& x() const { return data[0]; }
+    inline const DoublePack& y() const { return data[1]; }
+    inline const DoublePack& z() const { return data[2]; }
+
+    inline VectorPack& operator +=(const VectorPack& a);
+    inline VectorPack& operator -=(const VectorPack& a);
+
+    //! The norm of every lane
+    inline DoublePack Norm() const;
+
+    inline static VectorPack Zero();
+};
+
+inline VectorPack operator+(const VectorPack& a,const VectorPack& b);
+inline VectorPack operator-(const VectorPack& a,const VectorPack& b);
+inline VectorPack operator-(const VectorPack& a);
+inline VectorPack operator*(const VectorPack& a,const DoublePack& b);
+inline VectorPack operator*(const DoublePack& a,const VectorPack& b);
+inline VectorPack operator*(const VectorPack& a,double b);
+inline VectorPack operator*(double a,const VectorPack& b);
+inline VectorPack operator/(const VectorPack& a,const DoublePack& b);
+inline VectorPack operator/(const VectorPack& a,double b);
+//! Cross product
+inline VectorPack operator*(const VectorPack& a,const VectorPack& b);
+inline DoublePack dot(const VectorPack& a,const VectorPack& b);
+
+
+/**
+ * DoublePack::size Rotation objects, data is row major as in Rotation.
+ */
+class RotationPack
+{
+public:
+    DoublePack data[9];
+
+    //! Does not initialise the lanes
+    RotationPack() {}
+    //! All lanes equal to R
+    explicit inline RotationPack(const Rotation& R);
+
+    //! Rotation of lane i
+    inline Rotation Get(int i) const;
+    //! Sets lane i to R
+    inline void Set(int i,const Rotation& R);
+
+    //! The inverse (transpose) of every lane
+    inline RotationPack Inverse() const;
+    //! The inverse rotation applied to v, faster than Inverse()*v
+    inline VectorPack Inverse(const VectorPack& v) const;
+    inline TwistPack Inverse(const TwistPack& arg) const;
+    inline WrenchPack Inverse(const WrenchPack& arg) const;
+
+    inline VectorPack operator*(const VectorPack& v) const;
+    //! Changes the reference frame of the twist, not its reference point
+    inline TwistPack operator*(const TwistPack& arg) const;
+    //! Changes the reference frame of the wrench, not its reference point
+    inline WrenchPack operator*(const WrenchPack& arg) const;
+
+    inline static RotationPack Identity();
+};
+
+inline RotationPack operator*(const RotationPack& lhs,const RotationPack& rhs);
+
+
+/**
+ * DoublePack::size Frame objects.
+ */
+class FramePack
+{
+public:
+    RotationPack M;
+    VectorPack p;
+
+    //! Does not initialise the lanes
+    FramePack() {}
+    inline FramePack(const RotationPack& M,const VectorPack& p);
+    //! All lanes equal to F
+    explicit inline FramePack(const Frame& F);
+
+    //! Frame of lane i
+    inline Frame Get(int i) const;
+    //! Sets lane i to F
+    inline void Set(int i,const Frame& F);
+
+    //! The inverse of every lane
+    inline FramePack Inverse() const;
+    //! The inverse frame applied to v, faster than Inverse()*v
+    inline VectorPack Inverse(const VectorPack& v) const;
+    inline TwistPack Inverse(const TwistPack& arg) const;
+    inline WrenchPack Inverse(const WrenchPack& arg) const;
+
+    inline VectorPack operator*(const VectorPack& v) const;
+    //! Changes both the reference frame and the reference point of the twist
+    inline TwistPack operator*(const TwistPack& arg) const;
+    //! Changes both the reference frame and the reference point of the wrench
+    inline WrenchPack operator*(const WrenchPack& arg) const;
+
+    inline static FramePack Identity();
+};
+
+inline FramePack operator*(const FramePack& lhs,const FramePack& rhs);
+
+
+/**
+ * DoublePack::size Twist objects.
+ */
+class TwistPack
+{
+public:
+    VectorPack vel;
+    VectorPack rot;
+
+    //! Does not initialise the lanes
+    TwistPack() {}
+    inline TwistPack(const VectorPack& vel,const VectorPack& rot);
+    //! All lanes equal to t
+    explicit inline TwistPack(const Twist& t);
+
+    inline Twist Get(int i) const;
+    inline void Set(int i,const Twist& t);
+
+    //! Changes the reference point of the twist, see Twist::RefPoint
+    inline TwistPack RefPoint(const VectorPack& v_base_AB) const;
+
+    inline static TwistPack Zero();
+};
+
+inline TwistPack operator+(const TwistPack& a,const TwistPack& b);
+inline TwistPack operator-(const TwistPack& a,const TwistPack& b);
+inline TwistPack operator*(const TwistPack& a,const DoublePack& b);
+
+
+/**
+ * DoublePack::size Wrench objects.
+ */
+class WrenchPack
+{
+public:
+    VectorPack force;
+    VectorPack torque;
+
+    //! Does not initialise the lanes
+    WrenchPack() {}
+    inline WrenchPack(const VectorPack& force,const VectorPack& torque);
+    //! All lanes equal to w
+    explicit inline WrenchPack(const Wrench& w);
+
+    inline Wrench Get(int i) const;
+    inline void Set(int i,const Wrench& w);
+
+    //! Changes the reference point of the wrench, see Wrench::RefPoint
+    inline WrenchPack RefPoint(const VectorPack& v_base_AB) const;
+
+    inline static WrenchPack Zero();
+};
+
+inline WrenchPack operator+(const WrenchPack& a,const WrenchPack& b);
+inline WrenchPack operator-(const WrenchPack& a,const WrenchPack& b);
+
+
+/**
+ * See diff(const Vector&,const Vector&,double)
+ */
+inline VectorPack diff(const VectorPack& a,const VectorPack& b,double dt=1);
+
+/**
+ * See diff(const Rotation&,const Rotation&,double).  The relative
+ * rotation is computed for all lanes at once, the extraction of the
+ * rotation vector (atan2 and its special cases) is done per lane.
+ */
+inline VectorPack diff(const RotationPack& R_a_b1,const RotationPack& R_a_b2,double dt=1);
+
+/**
+ * See diff(const Frame&,const Frame&,double)
+ */
+inline TwistPack diff(const FramePack& F_a_b1,const FramePack& F_a_b2,double dt=1);
+
+inline bool Equal(const VectorPack& a,const VectorPack& b,double eps=epsilon);
+inline bool Equal(const RotationPack& a,const RotationPack& b,double eps=epsilon);
+inline bool Equal(const FramePack& a,const FramePack& b,double eps=epsilon);
+inline bool Equal(const TwistPack& a,const TwistPack& b,double eps=epsilon);
+inline bool Equal(const WrenchPack& a,const WrenchPack& b,double eps=epsilon);
+
+}
+
+#include "framepack.inl"
+
+#endif
@@ -0,0 +1,525 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+// inline definitions of framepack.hpp
+
+namespace ARMstrongKDL {
+
+/////////////////////////////////////////////////////////////////
+// DoublePack
+/////////////////////////////////////////////////////////////////
+
+#if defined(__AVX512F__)
+
+DoublePack::DoublePack(double a):v(_mm512_set1_pd(a)) {}
+DoublePack DoublePack::Load(const double* p) { return DoublePack(_mm512_loadu_pd(p)); }
+void DoublePack::Store(double* p) const { _mm512_storeu_pd(p,v); }
+DoublePack operator+(const DoublePack& a,const DoublePack& b) { return DoublePack(_mm512_add_pd(a.v,b.v)); }
+DoublePack operator-(const DoublePack& a,const DoublePack& b) { return DoublePack(_mm512_sub_pd(a.v,b.v)); }
+DoublePack operator*(const DoublePack& a,const DoublePack& b) { return DoublePack(_mm512_mul_pd(a.v,b.v)); }
+DoublePack operator/(const DoublePack& a,const DoublePack& b) { return DoublePack(_mm512_div_pd(a.v,b.v)); }
+DoublePack operator-(const DoublePack& a) { return DoublePack(_mm512_sub_pd(_mm512_setzero_pd(),a.v)); }
+DoublePack MultiplyAdd(const DoublePack& a,const DoublePack& b,const DoublePack& c) {
+    return DoublePack(_mm512_fmadd_pd(a.v,b.v,c.v));
+}
+DoublePack sqrt(const DoublePack& a) { return DoublePack(_mm512_sqrt_pd(a.v)); }
+DoublePack floor(const DoublePack& a) { return DoublePack(_mm512_roundscale_pd(a.v,_MM_FROUND_TO_NEG_INF)); }
+
+#elif defined(__AVX__)
+
+DoublePack::DoublePack(double a):v(_mm256_set1_pd(a)) {}
+DoublePack DoublePack::Load(const double* p) { return DoublePack(_mm256_loadu_pd(p)); }
+void DoublePack::Store(double* p) const { _mm256_storeu_pd(p,v); }
+DoublePack operator+(const DoublePack& a,const DoublePack& b) { return DoublePack(_mm256_add_pd(a.v,b.v)); }
+DoublePack operator-(const DoublePack& a,const DoublePack& b) { return DoublePack(_mm256_sub_pd(a.v,b.v)); }
+DoublePack operator*(const DoublePack& a,const DoublePack& b) { return DoublePack(_mm256_mul_pd(a.v,b.v)); }
+DoublePack operator/(const DoublePack& a,const DoublePack& b) { return DoublePack(_mm256_div_pd(a.v,b.v)); }
+DoublePack operator-(const DoublePack& a) { return DoublePack(_mm256_sub_pd(_mm256_setzero_pd(),a.v)); }
+DoublePack MultiplyAdd(const DoublePack& a,const DoublePack& b,const DoublePack& c) {
+#if defined(__FMA__)
+    return DoublePack(_mm256_fmadd_pd(a.v,b.v,c.v));
+#else
+    return DoublePack(_mm256_add_pd(_mm256_mul_pd(a.v,b.v),c.v));
+#endif
+}
+DoublePack sqrt(const DoublePack& a) { return DoublePack(_mm256_sqrt_pd(a.v)); }
+DoublePack floor(const DoublePack& a) { return DoublePack(_mm256_floor_pd(a.v)); }
+
+#else
+
+DoublePack::DoublePack(double a) { for (int i=0;i<size;++i) v[i]=a; }
+DoublePack DoublePack::Load(const double* p) {
+    DoublePack res;
+    for (int i=0;i<size;++i) res.v[i]=p[i];
+    return res;
+}
+void DoublePack::Store(double* p) const { for (int i=0;i<size;++i) p[i]=v[i]; }
+DoublePack operator+(const DoublePack& a,const DoublePack& b) {
+    DoublePack res;
+    for (int i=0;i<DoublePack::size;++i) res.v[i]=a.v[i]+b.v[i];
+    return res;
+}
+DoublePack operator-(const DoublePack& a,const DoublePack& b) {
+    DoublePack res;
+    for (int i=0;i<DoublePack::size;++i) res.v[i]=a.v[i]-b.v[i];
+    return res;
+}
+DoublePack operator*(const DoublePack& a,const DoublePack& b) {
+    DoublePack res;
+    for (int i=0;i<DoublePack::size;++i) res.v[i]=a.v[i]*b.v[i];
+    return res;
+}
+DoublePack operator/(const DoublePack& a,const DoublePack& b) {
+    DoublePack res;
+    for (int i=0;i<DoublePack::size;++i) res.v[i]=a.v[i]/b.v[i];
+    return res;
+}
+DoublePack operator-(const DoublePack& a) {
+    DoublePack res;
+    for (int i=0;i<DoublePack::size;++i) res.v[i]=-a.v[i];
+    return res;
+}
+DoublePack MultiplyAdd(const DoublePack& a,const DoublePack& b,const DoublePack& c) {
+    DoublePack res;
+    for (int i=0;i<DoublePack::size;++i) res.v[i]=a.v[i]*b.v[i]+c.v[i];
+    return res;
+}
+DoublePack sqrt(const DoublePack& a) {
+    DoublePack res;
+    for (int i=0;i<DoublePack::size;++i) res.v[i]=::sqrt(a.v[i]);
+    return res;
+}
+DoublePack floor(const DoublePack& a) {
+    DoublePack res;
+    for (int i=0;i<DoublePack::size;++i) res.v[i]=::floor(a.v[i]);
+    return res;
+}
+
+#endif
+
+double DoublePack::Get(int i) const {
+    double tmp[size];
+    Store(tmp);
+    return tmp[i];
+}
+
+void DoublePack::Set(int i,double a) {
+    double tmp[size];
+    Store(tmp);
+    tmp[i] = a;
+    *this = Load(tmp);
+}
+
+DoublePack& DoublePack::operator +=(const DoublePack& a) { return *this = *this+a; }
+DoublePack& DoublePack::operator -=(const DoublePack& a) { return *this = *this-a; }
+DoublePack& DoublePack::operator *=(const DoublePack& a) { return *this = *this*a; }
+
+void SinCos(const DoublePack& angle,DoublePack& sn,DoublePack& cs) {
+    // quadrant j = round(angle/(pi/2)) and r = angle - j*pi/2 in [-pi/4,pi/4],
+    // pi/2 = DP1+DP2+DP3 where j*DP1 and j*DP2 are exact :
+    const DoublePack DP1(1.57079625129699707031E+00);
+    const DoublePack DP2(7.54978941586159635336E-08);
+    const DoublePack DP3(5.39030285815811905290E-15);
+    DoublePack j = floor(MultiplyAdd(angle,DoublePack(6.36619772367581343076E-1),DoublePack(0.5)));
+    DoublePack r = MultiplyAdd(-j,DP3,MultiplyAdd(-j,DP2,MultiplyAdd(-j,DP1,angle)));
+    DoublePack z = r*r;
+
+    // sin(r) and cos(r) on [-pi/4,pi/4] (Cephes sin.c) :
+    DoublePack ps = MultiplyAdd(DoublePack(1.58962301576546568060E-10),z,DoublePack(-2.50507477628578072866E-8));
+    ps = MultiplyAdd(ps,z,DoublePack(2.75573136213857245213E-6));
+    ps = MultiplyAdd(ps,z,DoublePack(-1.98412698295895385996E-4));
+    ps = MultiplyAdd(ps,z,DoublePack(8.33333333332211858878E-3));
+    ps = MultiplyAdd(ps,z,DoublePack(-1.66666666666666307295E-1));
+    DoublePack sr = MultiplyAdd(r*z,ps,r);
+    DoublePack pc = MultiplyAdd(DoublePack(-1.13585365213876817300E-11),z,DoublePack(2.08757008419747316778E-9));
+    pc = MultiplyAdd(pc,z,DoublePack(-2.75573141792967388112E-7));
+    pc = MultiplyAdd(pc,z,DoublePack(2.48015872888517045348E-5));
+    pc = MultiplyAdd(pc,z,DoublePack(-1.38888888888730564116E-3));
+    pc = MultiplyAdd(pc,z,DoublePack(4.16666666666665929218E-2));
+    DoublePack cr = MultiplyAdd(z*z,pc,MultiplyAdd(DoublePack(-0.5),z,DoublePack(1.0)));
+
+    // quadrant q = j mod 4 : swap sin and cos for odd q, negate for q >= 2,
+    // the selection is done with exact multiplications by 0, 1 or -1 :
+    DoublePack q = MultiplyAdd(DoublePack(-4.0),floor(j*DoublePack(0.25)),j);
+    DoublePack half = floor(q*DoublePack(0.5));
+    DoublePack swap = MultiplyAdd(DoublePack(-2.0),half,q);
+    DoublePack keep = DoublePack(1.0)-swap;
+    DoublePack sign = MultiplyAdd(DoublePack(-2.0),half,DoublePack(1.0));
+    sn = sign*MultiplyAdd(keep,sr,swap*cr);
+    cs = sign*(keep*cr-swap*sr);
+}
+
+void SinCos(const double* angle,double* sn,double* cs,int n) {
+    DoublePack s,c;
+    int i=0;
+    for (;i+DoublePack::size<=n;i+=DoublePack::size) {
+        SinCos(DoublePack::Load(angle+i),s,c);
+        s.Store(sn+i);
+        c.Store(cs+i);
+    }
+    int rest = n-i;
+    if (rest>0 && rest<DoublePack::size) {
+        double tmp[DoublePack::size]={0};
+        for (int k=0;k<rest;++k) tmp[k]=angle[i+k];
+        SinCos(DoublePack::Load(tmp),s,c);
+        for (int k=0;k<rest;++k) {
+            sn[i+k]=s.Get(k);
+            cs[i+k]=c.Get(k);
+        }
+    }
+}
+
+
+/////////////////////////////////////////////////////////////////
+// VectorPack
+/////////////////////////////////////////////////////////////////
+
+VectorPack::VectorPack(const DoublePack& x,const DoublePack& y,const DoublePack& z) {
+    data[0]=x;data[1]=y;data[2]=z;
+}
+
+VectorPack::VectorPack(const Vector& v) {
+    data[0]=DoublePack(v(0));data[1]=DoublePack(v(1));data[2]=DoublePack(v(2));
+}
+
+Vector VectorPack::Get(int i) const {
+    return Vector(data[0].Get(i),data[1].Get(i),data[2].Get(i));
+}
+
+void VectorPack::Set(int i,const Vector& v) {
+    data[0].Set(i,v(0));data[1].Set(i,v(1));data[2].Set(i,v(2));
+}
+
+VectorPack& VectorPack::operator +=(const VectorPack& a) {
+    data[0]+=a.data[0];data[1]+=a.data[1];data[2]+=a.data[2];
+    return *this;
+}
+
+VectorPack& VectorPack::operator -=(const VectorPack& a) {
+    data[0]-=a.data[0];data[1]-=a.data[1];data[2]-=a.data[2];
+    return *this;
+}
+
+DoublePack VectorPack::Norm() const {
+    return sqrt(dot(*this,*this));
+}
+
+VectorPack VectorPack::Zero() {
+    return VectorPack(DoublePack(0.0),DoublePack(0.0),DoublePack(0.0));
+}
+
+VectorPack operator+(const VectorPack& a,const VectorPack& b) {
+    return VectorPack(a.data[0]+b.data[0],a.data[1]+b.data[1],a.data[2]+b.data[2]);
+}
+
+VectorPack operator-(const VectorPack& a,const VectorPack& b) {
+    return VectorPack(a.data[0]-b.data[0],a.data[1]-b.data[1],a.data[2]-b.data[2]);
+}
+
+VectorPack operator-(const VectorPack& a) {
+    return VectorPack(-a.data[0],-a.data[1],-a.data[2]);
+}
+
+VectorPack operator*(const VectorPack& a,const DoublePack& b) {
+    return VectorPack(a.data[0]*b,a.data[1]*b,a.data[2]*b);
+}
+
+VectorPack operator*(const DoublePack& a,const VectorPack& b) {
+    return b*a;
+}
+
+VectorPack operator*(const VectorPack& a,double b) {
+    return a*DoublePack(b);
+}
+
+VectorPack operator*(double a,const VectorPack& b) {
+    return b*DoublePack(a);
+}
+
+VectorPack operator/(const VectorPack& a,const DoublePack& b) {
+    return VectorPack(a.data[0]/b,a.data[1]/b,a.data[2]/b);
+}
+
+VectorPack operator/(const VectorPack& a,double b) {
+    return a*DoublePack(1.0/b);
+}
+
+VectorPack operator*(const VectorPack& lhs,const VectorPack& rhs) {
+    return VectorPack(
+        lhs.data[1]*rhs.data[2]-lhs.data[2]*rhs.data[1],
+        lhs.data[2]*rhs.data[0]-lhs.data[0]*rhs.data[2],
+        lhs.data[0]*rhs.data[1]-lhs.data[1]*rhs.data[0]);
+}
+
+DoublePack dot(const VectorPack& a,const VectorPack& b) {
+    return MultiplyAdd(a.data[0],b.data[0],MultiplyAdd(a.data[1],b.data[1],a.data[2]*b.data[2]));
+}
+
+
+/////////////////////////////////////////////////////////////////
+// RotationPack
+/////////////////////////////////////////////////////////////////
+
+RotationPack::RotationPack(const Rotation& R) {
+    for (int k=0;k<9;++k)
+        data[k] = DoublePack(R.data[k]);
+}
+
+Rotation RotationPack::Get(int i) const {
+    Rotation R;
+    for (int k=0;k<9;++k)
+        R.data[k] = data[k].Get(i);
+    return R;
+}
+
+void RotationPack::Set(int i,const Rotation& R) {
+    for (int k=0;k<9;++k)
+        data[k].Set(i,R.data[k]);
+}
+
+RotationPack RotationPack::Inverse() const {
+    RotationPack res;
+    res.data[0]=data[0];res.data[1]=data[3];res.data[2]=data[6];
+    res.data[3]=data[1];res.data[4]=data[4];res.data[5]=data[7];
+    res.data[6]=data[2];res.data[7]=data[5];res.data[8]=data[8];
+    return res;
+}
+
+VectorPack RotationPack::Inverse(const VectorPack& v) const {
+    return VectorPack(
+        MultiplyAdd(data[0],v.data[0],MultiplyAdd(data[3],v.data[1],data[6]*v.data[2])),
+        MultiplyAdd(data[1],v.data[0],MultiplyAdd(data[4],v.data[1],data[7]*v.data[2])),
+        MultiplyAdd(data[2],v.data[0],MultiplyAdd(data[5],v.data[1],data[8]*v.data[2])));
+}
+
+TwistPack RotationPack::Inverse(const TwistPack& arg) const {
+    return TwistPack(Inverse(arg.vel),Inverse(arg.rot));
+}
+
+WrenchPack RotationPack::Inverse(const WrenchPack& arg) const {
+    return WrenchPack(Inverse(arg.force),Inverse(arg.torque));
+}
+
+VectorPack RotationPack::operator*(const VectorPack& v) const {
+    return VectorPack(
+        MultiplyAdd(data[0],v.data[0],MultiplyAdd(data[1],v.data[1],data[2]*v.data[2])),
+        MultiplyAdd(data[3],v.data[0],MultiplyAdd(data[4],v.data[1],data[5]*v.data[2])),
+        MultiplyAdd(data[6],v.data[0],MultiplyAdd(data[7],v.data[1],data[8]*v.data[2])));
+}
+
+TwistPack RotationPack::operator*(const TwistPack& arg) const {
+    return TwistPack((*this)*arg.vel,(*this)*arg.rot);
+}
+
+WrenchPack RotationPack::operator*(const WrenchPack& arg) const {
+    return WrenchPack((*this)*arg.force,(*this)*arg.torque);
+}
+
+RotationPack RotationPack::Identity() {
+    return RotationPack(Rotation::Identity());
+}
+
+RotationPack operator*(const RotationPack& lhs,const RotationPack& rhs) {
+    RotationPack res;
+    for (int r=0;r<3;++r) {
+        for (int c=0;c<3;++c) {
+            res.data[3*r+c] = MultiplyAdd(lhs.data[3*r],rhs.data[c],
+                              MultiplyAdd(lhs.data[3*r+1],rhs.data[3+c],
+                                          lhs.data[3*r+2]*rhs.data[6+c]));
+        }
+    }
+    return res;
+}
+
+
+/////////////////////////////////////////////////////////////////
+// FramePack
+/////////////////////////////////////////////////////////////////
+
+FramePack::FramePack(const RotationPack& _M,const VectorPack& _p):M(_M),p(_p) {}
+
+FramePack::FramePack(const Frame& F):M(F.M),p(F.p) {}
+
+Frame FramePack::Get(int i) const {
+    return Frame(M.Get(i),p.Get(i));
+}
+
+void FramePack::Set(int i,const Frame& F) {
+    M.Set(i,F.M);
+    p.Set(i,F.p);
+}
+
+FramePack FramePack::Inverse() const {
+    return FramePack(M.Inverse(),-M.Inverse(p));
+}
+
+VectorPack FramePack::Inverse(const VectorPack& v) const {
+    return M.Inverse(v-p);
+}
+
+TwistPack FramePack::Inverse(const TwistPack& arg) const {
+    TwistPack tmp;
+    tmp.rot = M.Inverse(arg.rot);
+    tmp.vel = M.Inverse(arg.vel-p*arg.rot);
+    return tmp;
+}
+
+WrenchPack FramePack::Inverse(const WrenchPack& arg) const {
+    WrenchPack tmp;
+    tmp.force  = M.Inverse(arg.force);
+    tmp.torque = M.Inverse(arg.torque-p*arg.force);
+    return tmp;
+}
+
+VectorPack FramePack::operator*(const VectorPack& v) const {
+    return M*v+p;
+}
+
+TwistPack FramePack::operator*(const TwistPack& arg) const {
+    TwistPack tmp;
+    tmp.rot = M*arg.rot;
+    tmp.vel = M*arg.vel+p*tmp.rot;
+    return tmp;
+}
+
+WrenchPack FramePack::operator*(const WrenchPack& arg) const {
+    WrenchPack tmp;
+    tmp.force  = M*arg.force;
+    tmp.torque = M*arg.torque+p*tmp.force;
+    return tmp;
+}
+
+FramePack FramePack::Identity() {
+    return FramePack(Frame::Identity());
+}
+
+FramePack operator*(const FramePack& lhs,const FramePack& rhs) {
+    return FramePack(lhs.M*rhs.M,lhs.M*rhs.p+lhs.p);
+}
+
+
+/////////////////////////////////////////////////////////////////
+// TwistPack and WrenchPack
+/////////////////////////////////////////////////////////////////
+
+TwistPack::TwistPack(const VectorPack& _vel,const VectorPack& _rot):vel(_vel),rot(_rot) {}
+
+TwistPack::TwistPack(const Twist& t):vel(t.vel),rot(t.rot) {}
+
+Twist TwistPack::Get(int i) const {
+    return Twist(vel.Get(i),rot.Get(i));
+}
+
+void TwistPack::Set(int i,const Twist& t) {
+    vel.Set(i,t.vel);
+    rot.Set(i,t.rot);
+}
+
+TwistPack TwistPack::RefPoint(const VectorPack& v_base_AB) const {
+    return TwistPack(vel+rot*v_base_AB,rot);
+}
+
+TwistPack TwistPack::Zero() {
+    return TwistPack(VectorPack::Zero(),VectorPack::Zero());
+}
+
+TwistPack operator+(const TwistPack& a,const TwistPack& b) {
+    return TwistPack(a.vel+b.vel,a.rot+b.rot);
+}
+
+TwistPack operator-(const TwistPack& a,const TwistPack& b) {
+    return TwistPack(a.vel-b.vel,a.rot-b.rot);
+}
+
+TwistPack operator*(const TwistPack& a,const DoublePack& b) {
+    return TwistPack(a.vel*b,a.rot*b);
+}
+
+WrenchPack::WrenchPack(const VectorPack& _force,const VectorPack& _torque):force(_force),torque(_torque) {}
+
+WrenchPack::WrenchPack(const Wrench& w):force(w.force),torque(w.torque) {}
+
+Wrench WrenchPack::Get(int i) const {
+    return Wrench(force.Get(i),torque.Get(i));
+}
+
+void WrenchPack::Set(int i,const Wrench& w) {
+    force.Set(i,w.force);
+    torque.Set(i,w.torque);
+}
+
+WrenchPack WrenchPack::RefPoint(const VectorPack& v_base_AB) const {
+    return WrenchPack(force,torque+force*v_base_AB);
+}
+
+WrenchPack WrenchPack::Zero() {
+    return WrenchPack(VectorPack::Zero(),VectorPack::Zero());
+}
+
+WrenchPack operator+(const WrenchPack& a,const WrenchPack& b) {
+    return WrenchPack(a.force+b.force,a.torque+b.torque);
+}
+
+WrenchPack operator-(const WrenchPack& a,const WrenchPack& b) {
+    return WrenchPack(a.force-b.force,a.torque-b.torque);
+}
+
+
+/////////////////////////////////////////////////////////////////
+// diff and Equal
+/////////////////////////////////////////////////////////////////
+
+VectorPack diff(const VectorPack& a,const VectorPack& b,double dt) {
+    return (b-a)/dt;
+}
+
+VectorPack diff(const RotationPack& R_a_b1,const RotationPack& R_a_b2,double dt) {
+    RotationPack R_b1_b2(R_a_b1.Inverse()*R_a_b2);
+    VectorPack rot;
+    for (int i=0;i<DoublePack::size;++i)
+        rot.Set(i,R_b1_b2.Get(i).GetRot());
+    return R_a_b1*rot/dt;
+}
+
+TwistPack diff(const FramePack& F_a_b1,const FramePack& F_a_b2,double dt) {
+    return TwistPack(diff(F_a_b1.p,F_a_b2.p,dt),diff(F_a_b1.M,F_a_b2.M,dt));
+}
+
+bool Equal(const VectorPack& a,const VectorPack& b,double eps) {
+    for (int i=0;i<DoublePack::size;++i)
+        if (!Equal(a.Get(i),b.Get(i),eps))
+            return false;
+    return true;
+}
+
+bool Equal(const RotationPack& a,const RotationPack& b,double eps) {
+    for (int i=0;i<DoublePack::size;++i)
+        if (!Equal(a.Get(i),b.Get(i),eps))
+            return false;
+    return true;
+}
+
+bool Equal(const FramePack& a,const FramePack& b,double eps) {
+    return Equal(a.M,b.M,eps) && Equal(a.p,b.p,eps);
+}
+
+bool Equal(const TwistPack& a,const TwistPack& b,double eps) {
+    return Equal(a.vel,b.vel,eps) && Equal(a.rot,b.rot,eps);
+}
+
+bool Equal(const WrenchPack& a,const WrenchPack& b,double eps) {
+    return Equal(a.force,b.force,eps) && Equal(a.torque,b.torque,eps);
+}
+
+}
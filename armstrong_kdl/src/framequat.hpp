@@ -0,0 +1,121 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+/**
+ * \file
+ *      Unit quaternion representation of rotations and frames :
+ *        - Quaternion : a unit quaternion, the counterpart of Rotation
+ *        - FrameQuat  : a Quaternion and a Vector, the counterpart of Frame
+ *
+ *      Composing two quaternions takes 16 multiplications and 12 additions
+ *      instead of the 27 and 18 of a Rotation product, and the result can be
+ *      brought back to the unit sphere with one normalisation instead of a
+ *      re-orthogonalisation.  Applying a quaternion to a vector is more
+ *      expensive than applying a Rotation, so FrameQuat is meant for long
+ *      compositions (e.g. forward kinematics) that are converted to a Frame
+ *      at the end.
+ */
+
+#ifndef KDL_FRAMEQUAT_H
+#define KDL_FRAMEQUAT_H
+
+#include "frames.hpp"
+
+namespace ARMstrongKDL {
+
+/**
+ * A rotation represented by a unit quaternion x*i+y*j+z*k+w.
+ *
+ * q and -q represent the same rotation.  The operations do not
+ * normalise their result, use Normalize() after a large number of
+ * compositions.
+ */
+class Quaternion
+{
+public:
+    double x,y,z,w;
+
+    //! Identity
+    inline Quaternion():x(0),y(0),z(0),w(1) {}
+    inline Quaternion(double _x,double _y,double _z,double _w):x(_x),y(_y),z(_z),w(_w) {}
+    //! Conversion from a rotation matrix, see Rotation::GetQuaternion
+    explicit Quaternion(const Rotation& R);
+
+    //! Conversion to a rotation matrix
+    inline Rotation GetRotation() const;
+
+    inline static Quaternion Identity();
+    //! Rotation around the unit vector axis, see Rotation::Rot2
+    inline static Quaternion Rot2(const Vector& axis,double angle);
+    inline static Quaternion RotX(double angle);
+    inline static Quaternion RotY(double angle);
+    inline static Quaternion RotZ(double angle);
+
+    //! The conjugate, which is the inverse for a unit quaternion
+    inline Quaternion Inverse() const;
+    //! The inverse rotation applied to v, faster than Inverse()*v
+    inline Vector Inverse(const Vector& v) const;
+    //! Rotates v, 15 multiplications and 15 additions
+    inline Vector operator*(const Vector& v) const;
+
+    inline double Norm() const;
+    //! Scales to unit norm, returns the norm before scaling
+    inline double Normalize();
+};
+
+//! Composition of rotations, lhs*rhs corresponds to lhs.GetRotation()*rhs.GetRotation()
+inline Quaternion operator*(const Quaternion& lhs,const Quaternion& rhs);
+
+//! True if a and b represent the same rotation (q and -q are equal)
+inline bool Equal(const Quaternion& a,const Quaternion& b,double eps=epsilon);
+
+
+/**
+ * A frame with its orientation represented by a unit Quaternion,
+ * with the same semantics as Frame.
+ */
+class FrameQuat
+{
+public:
+    Quaternion M;
+    Vector p;
+
+    //! Identity
+    inline FrameQuat():M(),p(Vector::Zero()) {}
+    inline FrameQuat(const Quaternion& _M,const Vector& _p):M(_M),p(_p) {}
+    explicit inline FrameQuat(const Quaternion& _M):M(_M),p(Vector::Zero()) {}
+    explicit inline FrameQuat(const Vector& _p):M(),p(_p) {}
+    explicit inline FrameQuat(const Frame& F);
+
+    //! Conversion to a Frame
+    inline Frame GetFrame() const;
+
+    inline static FrameQuat Identity();
+
+    inline FrameQuat Inverse() const;
+    //! The inverse frame applied to v, faster than Inverse()*v
+    inline Vector Inverse(const Vector& v) const;
+    inline Vector operator*(const Vector& v) const;
+};
+
+//! Composition of frames, see operator*(const Frame&,const Frame&)
+inline FrameQuat operator*(const FrameQuat& lhs,const FrameQuat& rhs);
+
+inline bool Equal(const FrameQuat& a,const FrameQuat& b,double eps=epsilon);
+
+}
+
+#include "framequat.inl"
+
+#endif
@@ -0,0 +1,136 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+namespace ARMstrongKDL {
+
+inline Rotation Quaternion::GetRotation() const {
+    double x2=x+x, y2=y+y, z2=z+z;
+    double xx=x*x2, yy=y*y2, zz=z*z2;
+    double xy=x*y2, xz=x*z2, yz=y*z2;
+    double wx=w*x2, wy=w*y2, wz=w*z2;
+    return Rotation(1-yy-zz, xy-wz,   xz+wy,
+                    xy+wz,   1-xx-zz, yz-wx,
+                    xz-wy,   yz+wx,   1-xx-yy);
+}
+
+inline Quaternion Quaternion::Identity() {
+    return Quaternion(0,0,0,1);
+}
+
+inline Quaternion Quaternion::Rot2(const Vector& axis,double angle) {
+    double s,c;
+    SinCos(angle/2,s,c);
+    return Quaternion(axis(0)*s,axis(1)*s,axis(2)*s,c);
+}
+
+inline Quaternion Quaternion::RotX(double angle) {
+    double s,c;
+    SinCos(angle/2,s,c);
+    return Quaternion(s,0,0,c);
+}
+
+inline Quaternion Quaternion::RotY(double angle) {
+    double s,c;
+    SinCos(angle/2,s,c);
+    return Quaternion(0,s,0,c);
+}
+
+inline Quaternion Quaternion::RotZ(double angle) {
+    double s,c;
+    SinCos(angle/2,s,c);
+    return Quaternion(0,0,s,c);
+}
+
+inline Quaternion Quaternion::Inverse() const {
+    return Quaternion(-x,-y,-z,w);
+}
+
+inline Vector Quaternion::operator*(const Vector& v) const {
+    // v + 2w (u x v) + 2 u x (u x v), with u the vector part :
+    double tx = 2*(y*v(2)-z*v(1));
+    double ty = 2*(z*v(0)-x*v(2));
+    double tz = 2*(x*v(1)-y*v(0));
+    return Vector(v(0)+w*tx+y*tz-z*ty,
+                  v(1)+w*ty+z*tx-x*tz,
+                  v(2)+w*tz+x*ty-y*tx);
+}
+
+inline Vector Quaternion::Inverse(const Vector& v) const {
+    double tx = 2*(y*v(2)-z*v(1));
+    double ty = 2*(z*v(0)-x*v(2));
+    double tz = 2*(x*v(1)-y*v(0));
+    return Vector(v(0)-w*tx+y*tz-z*ty,
+                  v(1)-w*ty+z*tx-x*tz,
+                  v(2)-w*tz+x*ty-y*tx);
+}
+
+inline double Quaternion::Norm() const {
+    return sqrt(x*x+y*y+z*z+w*w);
+}
+
+inline double Quaternion::Normalize() {
+    double n = Norm();
+    double f = 1/n;
+    x*=f; y*=f; z*=f; w*=f;
+    return n;
+}
+
+inline Quaternion operator*(const Quaternion& a,const Quaternion& b) {
+    return Quaternion(a.w*b.x + a.x*b.w + a.y*b.z - a.z*b.y,
+                      a.w*b.y - a.x*b.z + a.y*b.w + a.z*b.x,
+                      a.w*b.z + a.x*b.y - a.y*b.x + a.z*b.w,
+                      a.w*b.w - a.x*b.x - a.y*b.y - a.z*b.z);
+}
+
+inline bool Equal(const Quaternion& a,const Quaternion& b,double eps) {
+    if (a.x*b.x+a.y*b.y+a.z*b.z+a.w*b.w < 0)
+        return Equal(a.x,-b.x,eps) && Equal(a.y,-b.y,eps) && Equal(a.z,-b.z,eps) && Equal(a.w,-b.w,eps);
+    return Equal(a.x,b.x,eps) && Equal(a.y,b.y,eps) && Equal(a.z,b.z,eps) && Equal(a.w,b.w,eps);
+}
+
+
+inline FrameQuat::FrameQuat(const Frame& F):
+    M(F.M),p(F.p)
+{
+}
+
+inline Frame FrameQuat::GetFrame() const {
+    return Frame(M.GetRotation(),p);
+}
+
+inline FrameQuat FrameQuat::Identity() {
+    return FrameQuat();
+}
+
+inline FrameQuat FrameQuat::Inverse() const {
+    return FrameQuat(M.Inverse(),-M.Inverse(p));
+}
+
+inline Vector FrameQuat::Inverse(const Vector& v) const {
+    return M.Inverse(v-p);
+}
+
+inline Vector FrameQuat::operator*(const Vector& v) const {
+    return M*v+p;
+}
+
+inline FrameQuat operator*(const FrameQuat& lhs,const FrameQuat& rhs) {
+    return FrameQuat(lhs.M*rhs.M,lhs.M*rhs.p+lhs.p);
+}
+
+inline bool Equal(const FrameQuat& a,const FrameQuat& b,double eps) {
+    return Equal(a.M,b.M,eps) && Equal(a.p,b.p,eps);
+}
+
+}
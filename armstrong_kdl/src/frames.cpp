@@ -306,8 +306,8 @@ Rotation Rotation::Rot2(const Vector& rotvec,double angle) {
     // V.(V.tr) + st*[V x] + ct*(I-V.(V.tr))
     // can be found by multiplying it with an arbitrary vector p
     // and noting that this vector is rotated.
-    double ct = cos(angle);
-    double st = sin(angle);
+    double st,ct;
+    SinCos(angle,st,ct);
     double vt = 1-ct;
     double m_vt_0=vt*rotvec(0);
     double m_vt_1=vt*rotvec(1);
@@ -555,8 +555,8 @@ Rotation Rotation::Identity() {
 // *this = *this * ROT(X,angle)
 void Rotation::DoRotX(double angle)
 {
-    double cs = cos(angle);
-    double sn = sin(angle);
+    double sn,cs;
+    SinCos(angle,sn,cs);
     double x1,x2,x3;
     x1  = cs* (*this)(0,1) + sn* (*this)(0,2);
     x2  = cs* (*this)(1,1) + sn* (*this)(1,2);
@@ -571,8 +571,8 @@ void Rotation::DoRotX(double angle)
 
 void Rotation::DoRotY(double angle)
 {
-    double cs = cos(angle);
-    double sn = sin(angle);
+    double sn,cs;
+    SinCos(angle,sn,cs);
     double x1,x2,x3;
     x1  = cs* (*this)(0,0) - sn* (*this)(0,2);
     x2  = cs* (*this)(1,0) - sn* (*this)(1,2);
@@ -587,8 +587,8 @@ void Rotation::DoRotY(double angle)
 
 void Rotation::DoRotZ(double angle)
 {
-    double cs = cos(angle);
-    double sn = sin(angle);
+    double sn,cs;
+    SinCos(angle,sn,cs);
     double x1,x2,x3;
     x1  = cs* (*this)(0,0) + sn* (*this)(0,1);
     x2  = cs* (*this)(1,0) + sn* (*this)(1,1);
@@ -603,18 +603,18 @@ void Rotation::DoRotZ(double angle)
 
 
 Rotation Rotation::RotX(double angle) {
-    double cs=cos(angle);
-    double sn=sin(angle);
+    double sn,cs;
+    SinCos(angle,sn,cs);
     return Rotation(1,0,0,0,cs,-sn,0,sn,cs);
 }
 Rotation Rotation::RotY(double angle) {
-    double cs=cos(angle);
-    double sn=sin(angle);
+    double sn,cs;
+    SinCos(angle,sn,cs);
     return Rotation(cs,0,sn,0,1,0,-sn,0,cs);
 }
 Rotation Rotation::RotZ(double angle) {
-    double cs=cos(angle);
-    double sn=sin(angle);
+    double sn,cs;
+    SinCos(angle,sn,cs);
     return Rotation(cs,-sn,0,sn,cs,0,0,0,1);
 }
 
@@ -894,11 +894,13 @@ IMETHOD void Rotation2::SetIdentity()
 }
 
 IMETHOD void Rotation2::SetRot(double angle) {
-    c=cos(angle);s=sin(angle);
+    SinCos(angle,s,c);
 }
 
 IMETHOD Rotation2 Rotation2::Rot(double angle) {
-    return Rotation2(cos(angle),sin(angle));
+    double sn,cs;
+    SinCos(angle,sn,cs);
+    return Rotation2(cs,sn);
 }
 
 IMETHOD double Rotation2::GetRot() const {
@@ -1111,8 +1113,8 @@ IMETHOD Rotation Rot(const Vector& axis_a_b) {
     // and noting that this vector is rotated.
 	Vector rotvec = axis_a_b;
 	double angle = rotvec.Normalize(1E-10);
-    double ct = ::cos(angle);
-    double st = ::sin(angle);
+    double st,ct;
+    SinCos(angle,st,ct);
     double vt = 1-ct;
     return Rotation(
         ct            +  vt*rotvec(0)*rotvec(0), 
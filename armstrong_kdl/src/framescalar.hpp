@@ -0,0 +1,286 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+/**
+ * \file
+ *      Versions of the classes of frames.hpp that are templated on the
+ *      scalar type :
+ *        - VectorT<T>, RotationT<T>, FrameT<T>, TwistT<T>, WrenchT<T>
+ *        - JntArrayT<T> and JacobianT<T>, Eigen types with T elements
+ *
+ *      They have the same memory layout and semantics as their double
+ *      counterparts.  T can be float (e.g. to halve the memory traffic of
+ *      sampling-based planners), double, or any type that provides the
+ *      arithmetic operators, sin, cos and sqrt (e.g. Rall1d for automatic
+ *      differentiation).  The double classes of frames.hpp are left as they
+ *      are : they are exported by the library, and turning them into
+ *      aliases of the templates would change their mangled names.
+ *      VectorT<double> etc. convert explicitly from and to them.
+ *
+ *      The typedefs Vectorf, Rotationf, Framef, Twistf, Wrenchf, JntArrayf
+ *      and Jacobianf name the float versions.
+ */
+
+#ifndef KDL_FRAMESCALAR_H
+#define KDL_FRAMESCALAR_H
+
+#include "frames.hpp"
+#include <Eigen/Core>
+#include <cmath>
+
+namespace ARMstrongKDL {
+
+template<typename T> class VectorT;
+template<typename T> class RotationT;
+template<typename T> class FrameT;
+template<typename T> class TwistT;
+template<typename T> class WrenchT;
+
+/**
+ * Joint positions with scalar type T, see JntArray.
+ */
+template<typename T>
+using JntArrayT = Eigen::Matrix<T,Eigen::Dynamic,1>;
+
+/**
+ * A Jacobian with scalar type T, see Jacobian : column i is the twist
+ * of joint i, velocity in the first three rows.
+ */
+template<typename T>
+using JacobianT = Eigen::Matrix<T,6,Eigen::Dynamic>;
+
+/**
+ * A vector with scalar type T, see Vector.
+ */
+template<typename T>
+class VectorT
+{
+public:
+    T data[3];
+
+    //! Zero vector
+    inline VectorT();
+    inline VectorT(const T& x,const T& y,const T& z);
+    //! Conversion from a double vector
+    explicit inline VectorT(const Vector& v);
+
+    //! Conversion to a double vector, requires a conversion from T to double
+    inline Vector GetVector() const;
+
+    inline T& operator()(int index) { return data[index]; }
+    inline const T& operator()(int index) const { return data[index]; }
+    inline T& operator[](int index) { return data[index]; }
+    inline const T& operator[](int index) const { return data[index]; }
+
+    inline const T& x() const { return data[0]; }
+    inline const T& y() const { return data[1]; }
+    inline const T& z() const { return data[2]; }
+
+    inline VectorT& operator +=(const VectorT& arg);
+    inline VectorT& operator -=(const VectorT& arg);
+
+    inline T Norm() const;
+
+    inline static VectorT Zero();
+};
+
+template<typename T> inline VectorT<T> operator+(const VectorT<T>& lhs,const VectorT<T>& rhs);
+template<typename T> inline VectorT<T> operator-(const VectorT<T>& lhs,const VectorT<T>& rhs);
+template<typename T> inline VectorT<T> operator-(const VectorT<T>& arg);
+template<typename T> inline VectorT<T> operator*(const VectorT<T>& lhs,const T& rhs);
+template<typename T> inline VectorT<T> operator*(const T& lhs,const VectorT<T>& rhs);
+template<typename T> inline VectorT<T> operator/(const VectorT<T>& lhs,const T& rhs);
+//! Cross product
+template<typename T> inline VectorT<T> operator*(const VectorT<T>& lhs,const VectorT<T>& rhs);
+template<typename T> inline T dot(const VectorT<T>& lhs,const VectorT<T>& rhs);
+
+
+/**
+ * A rotation matrix with scalar type T, row major, see Rotation.
+ */
+template<typename T>
+class RotationT
+{
+public:
+    T data[9];
+
+    //! Identity
+    inline RotationT();
+    inline RotationT(const T& Xx,const T& Yx,const T& Zx,
+                     const T& Xy,const T& Yy,const T& Zy,
+                     const T& Xz,const T& Yz,const T& Zz);
+    //! Conversion from a double rotation
+    explicit inline RotationT(const Rotation& R);
+
+    //! Conversion to a double rotation, requires a conversion from T to double
+    inline Rotation GetRotation() const;
+
+    inline T& operator()(int i,int j) { return data[i*3+j]; }
+    inline const T& operator()(int i,int j) const { return data[i*3+j]; }
+
+    inline VectorT<T> UnitX() const { return VectorT<T>(data[0],data[3],data[6]); }
+    inline VectorT<T> UnitY() const { return VectorT<T>(data[1],data[4],data[7]); }
+    inline VectorT<T> UnitZ() const { return VectorT<T>(data[2],data[5],data[8]); }
+
+    inline RotationT Inverse() const;
+    //! The inverse rotation applied to v, faster than Inverse()*v
+    inline VectorT<T> Inverse(const VectorT<T>& v) const;
+    inline TwistT<T> Inverse(const TwistT<T>& arg) const;
+    inline WrenchT<T> Inverse(const WrenchT<T>& arg) const;
+
+    inline VectorT<T> operator*(const VectorT<T>& v) const;
+    //! Changes the reference frame of the twist, not its reference point
+    inline TwistT<T> operator*(const TwistT<T>& arg) const;
+    //! Changes the reference frame of the wrench, not its reference point
+    inline WrenchT<T> operator*(const WrenchT<T>& arg) const;
+
+    //! *this = *this * RotX(angle), see Rotation::DoRotX
+    inline void DoRotX(const T& angle);
+    inline void DoRotY(const T& angle);
+    inline void DoRotZ(const T& angle);
+
+    inline static RotationT Identity();
+    inline static RotationT RotX(const T& angle);
+    inline static RotationT RotY(const T& angle);
+    inline static RotationT RotZ(const T& angle);
+    //! Rotation around the unit vector rotvec, see Rotation::Rot2
+    inline static RotationT Rot2(const VectorT<T>& rotvec,const T& angle);
+};
+
+template<typename T> inline RotationT<T> operator*(const RotationT<T>& lhs,const RotationT<T>& rhs);
+
+
+/**
+ * A frame with scalar type T, see Frame.
+ */
+template<typename T>
+class FrameT
+{
+public:
+    RotationT<T> M;
+    VectorT<T> p;
+
+    //! Identity
+    inline FrameT() {}
+    inline FrameT(const RotationT<T>& _M,const VectorT<T>& _p):M(_M),p(_p) {}
+    explicit inline FrameT(const RotationT<T>& _M):M(_M) {}
+    explicit inline FrameT(const VectorT<T>& _p):p(_p) {}
+    //! Conversion from a double frame
+    explicit inline FrameT(const Frame& F):M(F.M),p(F.p) {}
+
+    //! Conversion to a double frame, requires a conversion from T to double
+    inline Frame GetFrame() const { return Frame(M.GetRotation(),p.GetVector()); }
+
+    inline FrameT Inverse() const;
+    //! The inverse frame applied to v, faster than Inverse()*v
+    inline VectorT<T> Inverse(const VectorT<T>& v) const;
+    inline TwistT<T> Inverse(const TwistT<T>& arg) const;
+    inline WrenchT<T> Inverse(const WrenchT<T>& arg) const;
+
+    inline VectorT<T> operator*(const VectorT<T>& v) const;
+    //! Changes both the reference frame and the reference point of the twist
+    inline TwistT<T> operator*(const TwistT<T>& arg) const;
+    //! Changes both the reference frame and the reference point of the wrench
+    inline WrenchT<T> operator*(const WrenchT<T>& arg) const;
+
+    inline static FrameT Identity() { return FrameT(); }
+};
+
+template<typename T> inline FrameT<T> operator*(const FrameT<T>& lhs,const FrameT<T>& rhs);
+
+
+/**
+ * A twist with scalar type T, see Twist.
+ */
+template<typename T>
+class TwistT
+{
+public:
+    VectorT<T> vel;
+    VectorT<T> rot;
+
+    //! Zero twist
+    inline TwistT() {}
+    inline TwistT(const VectorT<T>& _vel,const VectorT<T>& _rot):vel(_vel),rot(_rot) {}
+    explicit inline TwistT(const Twist& t):vel(t.vel),rot(t.rot) {}
+
+    inline Twist GetTwist() const { return Twist(vel.GetVector(),rot.GetVector()); }
+
+    inline T& operator()(int i) { return i<3 ? vel(i) : rot(i-3); }
+    inline const T& operator()(int i) const { return i<3 ? vel(i) : rot(i-3); }
+
+    //! Changes the reference point of the twist, see Twist::RefPoint
+    inline TwistT RefPoint(const VectorT<T>& v_base_AB) const;
+
+    inline static TwistT Zero() { return TwistT(); }
+};
+
+template<typename T> inline TwistT<T> operator+(const TwistT<T>& lhs,const TwistT<T>& rhs);
+template<typename T> inline TwistT<T> operator-(const TwistT<T>& lhs,const TwistT<T>& rhs);
+template<typename T> inline TwistT<T> operator-(const TwistT<T>& arg);
+template<typename T> inline TwistT<T> operator*(const TwistT<T>& lhs,const T& rhs);
+
+
+/**
+ * A wrench with scalar type T, see Wrench.
+ */
+template<typename T>
+class WrenchT
+{
+public:
+    VectorT<T> force;
+    VectorT<T> torque;
+
+    //! Zero wrench
+    inline WrenchT() {}
+    inline WrenchT(const VectorT<T>& _force,const VectorT<T>& _torque):force(_force),torque(_torque) {}
+    explicit inline WrenchT(const Wrench& w):force(w.force),torque(w.torque) {}
+
+    inline Wrench GetWrench() const { return Wrench(force.GetVector(),torque.GetVector()); }
+
+    inline T& operator()(int i) { return i<3 ? force(i) : torque(i-3); }
+    inline const T& operator()(int i) const { return i<3 ? force(i) : torque(i-3); }
+
+    //! Changes the reference point of the wrench, see Wrench::RefPoint
+    inline WrenchT RefPoint(const VectorT<T>& v_base_AB) const;
+
+    inline static WrenchT Zero() { return WrenchT(); }
+};
+
+template<typename T> inline WrenchT<T> operator+(const WrenchT<T>& lhs,const WrenchT<T>& rhs);
+template<typename T> inline WrenchT<T> operator-(const WrenchT<T>& lhs,const WrenchT<T>& rhs);
+template<typename T> inline WrenchT<T> operator-(const WrenchT<T>& arg);
+template<typename T> inline WrenchT<T> operator*(const WrenchT<T>& lhs,const T& rhs);
+
+//! Cross product of twists, see operator*(const Twist&,const Twist&)
+template<typename T> inline TwistT<T> operator*(const TwistT<T>& lhs,const TwistT<T>& rhs);
+//! Cross product of a twist and a wrench, see operator*(const Twist&,const Wrench&)
+template<typename T> inline WrenchT<T> operator*(const TwistT<T>& lhs,const WrenchT<T>& rhs);
+//! Power of the wrench along the twist
+template<typename T> inline T dot(const TwistT<T>& lhs,const WrenchT<T>& rhs);
+
+
+typedef VectorT<float> Vectorf;
+typedef RotationT<float> Rotationf;
+typedef FrameT<float> Framef;
+typedef TwistT<float> Twistf;
+typedef WrenchT<float> Wrenchf;
+typedef JntArrayT<float> JntArrayf;
+typedef JacobianT<float> Jacobianf;
+
+}
+
+#include "framescalar.inl"
+
+#endif
@@ -0,0 +1,344 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+// The math functions are called unqualified after a using declaration of
+// the std versions, such that float and double use std:: and other scalar
+// types (e.g. Rall1d) are found by argument dependent lookup.
+
+namespace ARMstrongKDL {
+
+template<typename T> VectorT<T>::VectorT() {
+    data[0]=T(0);data[1]=T(0);data[2]=T(0);
+}
+
+template<typename T> VectorT<T>::VectorT(const T& x,const T& y,const T& z) {
+    data[0]=x;data[1]=y;data[2]=z;
+}
+
+template<typename T> VectorT<T>::VectorT(const Vector& v) {
+    data[0]=T(v(0));data[1]=T(v(1));data[2]=T(v(2));
+}
+
+template<typename T> Vector VectorT<T>::GetVector() const {
+    return Vector(static_cast<double>(data[0]),static_cast<double>(data[1]),static_cast<double>(data[2]));
+}
+
+template<typename T> VectorT<T>& VectorT<T>::operator +=(const VectorT<T>& arg) {
+    data[0]+=arg.data[0];data[1]+=arg.data[1];data[2]+=arg.data[2];
+    return *this;
+}
+
+template<typename T> VectorT<T>& VectorT<T>::operator -=(const VectorT<T>& arg) {
+    data[0]-=arg.data[0];data[1]-=arg.data[1];data[2]-=arg.data[2];
+    return *this;
+}
+
+template<typename T> T VectorT<T>::Norm() const {
+    using std::sqrt;
+    return sqrt(data[0]*data[0]+data[1]*data[1]+data[2]*data[2]);
+}
+
+template<typename T> VectorT<T> VectorT<T>::Zero() {
+    return VectorT<T>();
+}
+
+template<typename T> VectorT<T> operator+(const VectorT<T>& lhs,const VectorT<T>& rhs) {
+    return VectorT<T>(lhs(0)+rhs(0),lhs(1)+rhs(1),lhs(2)+rhs(2));
+}
+
+template<typename T> VectorT<T> operator-(const VectorT<T>& lhs,const VectorT<T>& rhs) {
+    return VectorT<T>(lhs(0)-rhs(0),lhs(1)-rhs(1),lhs(2)-rhs(2));
+}
+
+template<typename T> VectorT<T> operator-(const VectorT<T>& arg) {
+    return VectorT<T>(-arg(0),-arg(1),-arg(2));
+}
+
+template<typename T> VectorT<T> operator*(const VectorT<T>& lhs,const T& rhs) {
+    return VectorT<T>(lhs(0)*rhs,lhs(1)*rhs,lhs(2)*rhs);
+}
+
+template<typename T> VectorT<T> operator*(const T& lhs,const VectorT<T>& rhs) {
+    return VectorT<T>(lhs*rhs(0),lhs*rhs(1),lhs*rhs(2));
+}
+
+template<typename T> VectorT<T> operator/(const VectorT<T>& lhs,const T& rhs) {
+    return VectorT<T>(lhs(0)/rhs,lhs(1)/rhs,lhs(2)/rhs);
+}
+
+template<typename T> VectorT<T> operator*(const VectorT<T>& lhs,const VectorT<T>& rhs) {
+    return VectorT<T>(lhs(1)*rhs(2)-lhs(2)*rhs(1),
+                      lhs(2)*rhs(0)-lhs(0)*rhs(2),
+                      lhs(0)*rhs(1)-lhs(1)*rhs(0));
+}
+
+template<typename T> T dot(const VectorT<T>& lhs,const VectorT<T>& rhs) {
+    return lhs(0)*rhs(0)+lhs(1)*rhs(1)+lhs(2)*rhs(2);
+}
+
+
+template<typename T> RotationT<T>::RotationT() {
+    *this = Identity();
+}
+
+template<typename T> RotationT<T>::RotationT(const T& Xx,const T& Yx,const T& Zx,
+                                             const T& Xy,const T& Yy,const T& Zy,
+                                             const T& Xz,const T& Yz,const T& Zz) {
+    data[0]=Xx;data[1]=Yx;data[2]=Zx;
+    data[3]=Xy;data[4]=Yy;data[5]=Zy;
+    data[6]=Xz;data[7]=Yz;data[8]=Zz;
+}
+
+template<typename T> RotationT<T>::RotationT(const Rotation& R) {
+    for (int i=0;i<9;++i)
+        data[i]=T(R.data[i]);
+}
+
+template<typename T> Rotation RotationT<T>::GetRotation() const {
+    Rotation R;
+    for (int i=0;i<9;++i)
+        R.data[i]=static_cast<double>(data[i]);
+    return R;
+}
+
+template<typename T> RotationT<T> RotationT<T>::Inverse() const {
+    return RotationT<T>(data[0],data[3],data[6],
+                        data[1],data[4],data[7],
+                        data[2],data[5],data[8]);
+}
+
+template<typename T> VectorT<T> RotationT<T>::Inverse(const VectorT<T>& v) const {
+    return VectorT<T>(data[0]*v(0)+data[3]*v(1)+data[6]*v(2),
+                      data[1]*v(0)+data[4]*v(1)+data[7]*v(2),
+                      data[2]*v(0)+data[5]*v(1)+data[8]*v(2));
+}
+
+template<typename T> TwistT<T> RotationT<T>::Inverse(const TwistT<T>& arg) const {
+    return TwistT<T>(Inverse(arg.vel),Inverse(arg.rot));
+}
+
+template<typename T> WrenchT<T> RotationT<T>::Inverse(const WrenchT<T>& arg) const {
+    return WrenchT<T>(Inverse(arg.force),Inverse(arg.torque));
+}
+
+template<typename T> VectorT<T> RotationT<T>::operator*(const VectorT<T>& v) const {
+    return VectorT<T>(data[0]*v(0)+data[1]*v(1)+data[2]*v(2),
+                      data[3]*v(0)+data[4]*v(1)+data[5]*v(2),
+                      data[6]*v(0)+data[7]*v(1)+data[8]*v(2));
+}
+
+template<typename T> TwistT<T> RotationT<T>::operator*(const TwistT<T>& arg) const {
+    return TwistT<T>((*this)*arg.vel,(*this)*arg.rot);
+}
+
+template<typename T> WrenchT<T> RotationT<T>::operator*(const WrenchT<T>& arg) const {
+    return WrenchT<T>((*this)*arg.force,(*this)*arg.torque);
+}
+
+template<typename T> void RotationT<T>::DoRotX(const T& angle) {
+    using std::sin; using std::cos;
+    T cs = cos(angle);
+    T sn = sin(angle);
+    for (int i=0;i<3;++i) {
+        T y = data[3*i+1];
+        T z = data[3*i+2];
+        data[3*i+1] = cs*y+sn*z;
+        data[3*i+2] = cs*z-sn*y;
+    }
+}
+
+template<typename T> void RotationT<T>::DoRotY(const T& angle) {
+    using std::sin; using std::cos;
+    T cs = cos(angle);
+    T sn = sin(angle);
+    for (int i=0;i<3;++i) {
+        T x = data[3*i];
+        T z = data[3*i+2];
+        data[3*i]   = cs*x-sn*z;
+        data[3*i+2] = sn*x+cs*z;
+    }
+}
+
+template<typename T> void RotationT<T>::DoRotZ(const T& angle) {
+    using std::sin; using std::cos;
+    T cs = cos(angle);
+    T sn = sin(angle);
+    for (int i=0;i<3;++i) {
+        T x = data[3*i];
+        T y = data[3*i+1];
+        data[3*i]   = cs*x+sn*y;
+        data[3*i+1] = cs*y-sn*x;
+    }
+}
+
+template<typename T> RotationT<T> RotationT<T>::Identity() {
+    return RotationT<T>(T(1),T(0),T(0),T(0),T(1),T(0),T(0),T(0),T(1));
+}
+
+template<typename T> RotationT<T> RotationT<T>::RotX(const T& angle) {
+    using std::sin; using std::cos;
+    T cs = cos(angle);
+    T sn = sin(angle);
+    return RotationT<T>(T(1),T(0),T(0),T(0),cs,-sn,T(0),sn,cs);
+}
+
+template<typename T> RotationT<T> RotationT<T>::RotY(const T& angle) {
+    using std::sin; using std::cos;
+    T cs = cos(angle);
+    T sn = sin(angle);
+    return RotationT<T>(cs,T(0),sn,T(0),T(1),T(0),-sn,T(0),cs);
+}
+
+template<typename T> RotationT<T> RotationT<T>::RotZ(const T& angle) {
+    using std::sin; using std::cos;
+    T cs = cos(angle);
+    T sn = sin(angle);
+    return RotationT<T>(cs,-sn,T(0),sn,cs,T(0),T(0),T(0),T(1));
+}
+
+template<typename T> RotationT<T> RotationT<T>::Rot2(const VectorT<T>& rotvec,const T& angle) {
+    using std::sin; using std::cos;
+    T ct = cos(angle);
+    T st = sin(angle);
+    T vt = T(1)-ct;
+    T m_vt_0=vt*rotvec(0);
+    T m_vt_1=vt*rotvec(1);
+    T m_vt_2=vt*rotvec(2);
+    T m_st_0=rotvec(0)*st;
+    T m_st_1=rotvec(1)*st;
+    T m_st_2=rotvec(2)*st;
+    T m_vt_0_1=m_vt_0*rotvec(1);
+    T m_vt_0_2=m_vt_0*rotvec(2);
+    T m_vt_1_2=m_vt_1*rotvec(2);
+    return RotationT<T>(
+        ct      +  m_vt_0*rotvec(0),
+        -m_st_2 +  m_vt_0_1,
+        m_st_1  +  m_vt_0_2,
+        m_st_2  +  m_vt_0_1,
+        ct      +  m_vt_1*rotvec(1),
+        -m_st_0 +  m_vt_1_2,
+        -m_st_1 +  m_vt_0_2,
+        m_st_0  +  m_vt_1_2,
+        ct      +  m_vt_2*rotvec(2));
+}
+
+template<typename T> RotationT<T> operator*(const RotationT<T>& lhs,const RotationT<T>& rhs) {
+    RotationT<T> res;
+    for (int r=0;r<3;++r)
+        for (int c=0;c<3;++c)
+            res.data[3*r+c] = lhs.data[3*r]*rhs.data[c]+lhs.data[3*r+1]*rhs.data[3+c]+lhs.data[3*r+2]*rhs.data[6+c];
+    return res;
+}
+
+
+template<typename T> FrameT<T> FrameT<T>::Inverse() const {
+    return FrameT<T>(M.Inverse(),-M.Inverse(p));
+}
+
+template<typename T> VectorT<T> FrameT<T>::Inverse(const VectorT<T>& v) const {
+    return M.Inverse(v-p);
+}
+
+template<typename T> TwistT<T> FrameT<T>::Inverse(const TwistT<T>& arg) const {
+    TwistT<T> tmp;
+    tmp.rot = M.Inverse(arg.rot);
+    tmp.vel = M.Inverse(arg.vel-p*arg.rot);
+    return tmp;
+}
+
+template<typename T> WrenchT<T> FrameT<T>::Inverse(const WrenchT<T>& arg) const {
+    WrenchT<T> tmp;
+    tmp.force = M.Inverse(arg.force);
+    tmp.torque = M.Inverse(arg.torque-p*arg.force);
+    return tmp;
+}
+
+template<typename T> VectorT<T> FrameT<T>::operator*(const VectorT<T>& v) const {
+    return M*v+p;
+}
+
+template<typename T> TwistT<T> FrameT<T>::operator*(const TwistT<T>& arg) const {
+    TwistT<T> tmp;
+    tmp.rot = M*arg.rot;
+    tmp.vel = M*arg.vel+p*tmp.rot;
+    return tmp;
+}
+
+template<typename T> WrenchT<T> FrameT<T>::operator*(const WrenchT<T>& arg) const {
+    WrenchT<T> tmp;
+    tmp.force = M*arg.force;
+    tmp.torque = M*arg.torque+p*tmp.force;
+    return tmp;
+}
+
+template<typename T> FrameT<T> operator*(const FrameT<T>& lhs,const FrameT<T>& rhs) {
+    return FrameT<T>(lhs.M*rhs.M,lhs.M*rhs.p+lhs.p);
+}
+
+
+template<typename T> TwistT<T> TwistT<T>::RefPoint(const VectorT<T>& v_base_AB) const {
+    return TwistT<T>(vel+rot*v_base_AB,rot);
+}
+
+template<typename T> TwistT<T> operator+(const TwistT<T>& lhs,const TwistT<T>& rhs) {
+    return TwistT<T>(lhs.vel+rhs.vel,lhs.rot+rhs.rot);
+}
+
+template<typename T> TwistT<T> operator-(const TwistT<T>& lhs,const TwistT<T>& rhs) {
+    return TwistT<T>(lhs.vel-rhs.vel,lhs.rot-rhs.rot);
+}
+
+template<typename T> TwistT<T> operator-(const TwistT<T>& arg) {
+    return TwistT<T>(-arg.vel,-arg.rot);
+}
+
+template<typename T> TwistT<T> operator*(const TwistT<T>& lhs,const T& rhs) {
+    return TwistT<T>(lhs.vel*rhs,lhs.rot*rhs);
+}
+
+
+template<typename T> WrenchT<T> WrenchT<T>::RefPoint(const VectorT<T>& v_base_AB) const {
+    return WrenchT<T>(force,torque+force*v_base_AB);
+}
+
+template<typename T> WrenchT<T> operator+(const WrenchT<T>& lhs,const WrenchT<T>& rhs) {
+    return WrenchT<T>(lhs.force+rhs.force,lhs.torque+rhs.torque);
+}
+
+template<typename T> WrenchT<T> operator-(const WrenchT<T>& lhs,const WrenchT<T>& rhs) {
+    return WrenchT<T>(lhs.force-rhs.force,lhs.torque-rhs.torque);
+}
+
+template<typename T> WrenchT<T> operator-(const WrenchT<T>& arg) {
+    return WrenchT<T>(-arg.force,-arg.torque);
+}
+
+template<typename T> WrenchT<T> operator*(const WrenchT<T>& lhs,const T& rhs) {
+    return WrenchT<T>(lhs.force*rhs,lhs.torque*rhs);
+}
+
+
+template<typename T> TwistT<T> operator*(const TwistT<T>& lhs,const TwistT<T>& rhs) {
+    return TwistT<T>(lhs.rot*rhs.vel+lhs.vel*rhs.rot,lhs.rot*rhs.rot);
+}
+
+template<typename T> WrenchT<T> operator*(const TwistT<T>& lhs,const WrenchT<T>& rhs) {
+    return WrenchT<T>(lhs.rot*rhs.force,lhs.rot*rhs.torque+lhs.vel*rhs.force);
+}
+
+template<typename T> T dot(const TwistT<T>& lhs,const WrenchT<T>& rhs) {
+    return dot(lhs.vel,rhs.force)+dot(lhs.rot,rhs.torque);
+}
+
+}
@@ -18,7 +18,9 @@
 
 
 // Methods and operators related to FrameVelVel
-// They all delegate most of the work to RotationVelVel and VectorVelVel
+// They all delegate most of the work to RotationVelVel and VectorVelVel,
+// except for composition, inverse and RefPoint which are written out
+// so that products shared by the value and its derivative are computed once.
 FrameVel& FrameVel::operator = (const FrameVel& arg) {
     M=arg.M;
     p=arg.p;
@@ -32,11 +34,15 @@ FrameVel FrameVel::Identity() {
 
 FrameVel operator *(const FrameVel& lhs,const FrameVel& rhs)
 {
-    return FrameVel(lhs.M*rhs.M,lhs.M*rhs.p+lhs.p);
+    // FrameVel(lhs.M*rhs.M,lhs.M*rhs.p+lhs.p)
+    Vector Rp = lhs.M.R*rhs.p.p;
+    return FrameVel(Frame(lhs.M.R*rhs.M.R,lhs.p.p+Rp),
+                    Twist(lhs.p.v+lhs.M.w*Rp+lhs.M.R*rhs.p.v,lhs.M.w+lhs.M.R*rhs.M.w));
 }
 FrameVel operator *(const FrameVel& lhs,const Frame& rhs)
 {
-    return FrameVel(lhs.M*rhs.M,lhs.M*rhs.p+lhs.p);
+    Vector Rp = lhs.M.R*rhs.p;
+    return FrameVel(Frame(lhs.M.R*rhs.M,lhs.p.p+Rp),Twist(lhs.p.v+lhs.M.w*Rp,lhs.M.w));
 }
 FrameVel operator *(const Frame& lhs,const FrameVel& rhs)
 {
@@ -45,26 +51,33 @@ FrameVel operator *(const Frame& lhs,const FrameVel& rhs)
 
 VectorVel FrameVel::operator *(const VectorVel & arg) const
 {
-    return M*arg+p;
+    Vector Rp = M.R*arg.p;
+    return VectorVel(p.p+Rp,p.v+M.w*Rp+M.R*arg.v);
 }
 VectorVel FrameVel::operator *(const Vector & arg) const
 {
-    return M*arg+p;
+    Vector Rp = M.R*arg;
+    return VectorVel(p.p+Rp,p.v+M.w*Rp);
 }
 
 VectorVel FrameVel::Inverse(const VectorVel& arg) const
 {
-    return M.Inverse(arg-p);
+    // M.Inverse(arg-p)
+    Vector d = arg.p-p.p;
+    return VectorVel(M.R.Inverse(d),M.R.Inverse(arg.v-p.v-M.w*d));
 }
 
 VectorVel FrameVel::Inverse(const Vector& arg) const
 {
-    return M.Inverse(arg-p);
+    Vector d = arg-p.p;
+    return VectorVel(M.R.Inverse(d),M.R.Inverse(-p.v-M.w*d));
 }
 
 FrameVel FrameVel::Inverse() const
 {
-    return FrameVel(M.Inverse(),-M.Inverse(p));
+    // FrameVel(M.Inverse(),-M.Inverse(p))
+    Rotation Ri = M.R.Inverse();
+    return FrameVel(Frame(Ri,-(Ri*p.p)),Twist(Ri*(M.w*p.p-p.v),-(Ri*M.w)));
 }
 
 FrameVel& FrameVel::operator = (const Frame& arg) {
@@ -521,7 +534,7 @@ TwistVel TwistVel::RefPoint(const VectorVel& v_base_AB)
      // the new point.
      // Complexity : 6M+6A
 {
-    return TwistVel(this->vel+this->rot*v_base_AB,this->rot);
+    return TwistVel(VectorVel(vel.p+rot.p*v_base_AB.p,vel.v+rot.v*v_base_AB.p+rot.p*v_base_AB.v),rot);
 }
 
 TwistVel& TwistVel::operator-=(const TwistVel& arg)
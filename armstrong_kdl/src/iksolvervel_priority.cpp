@@ -0,0 +1,124 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "iksolvervel_priority.hpp"
+
+namespace ARMstrongKDL
+{
+    IkSolverVel_priority::IkSolverVel_priority(unsigned int _nj,double _eps):
+        nj(_nj),
+        eps(_eps),
+        degraded(false),
+        nullity(_nj),
+        qdot(Eigen::VectorXd::Zero(nj)),
+        Z(Eigen::MatrixXd::Identity(nj,nj)),
+        Z_next(Eigen::MatrixXd::Zero(nj,nj)),
+        N(Eigen::MatrixXd::Zero(nj,nj)),
+        y(Eigen::VectorXd::Zero(nj))
+    {
+    }
+
+    IkSolverVel_priority::~IkSolverVel_priority()
+    {
+    }
+
+    void IkSolverVel_priority::setNrOfTasks(unsigned int nr_tasks)
+    {
+        if (cod.size() != nr_tasks) {
+            JZ.resize(nr_tasks);
+            residual.resize(nr_tasks);
+            cod.resize(nr_tasks);
+            ranks.resize(nr_tasks);
+        }
+        qdot.setZero();
+        Z.setIdentity();
+        nullity = nj;
+        degraded = false;
+    }
+
+    void IkSolverVel_priority::solveTask(unsigned int k,const Eigen::Ref<const Eigen::MatrixXd>& J,
+                                         const Eigen::Ref<const Eigen::VectorXd>& x)
+    {
+        const unsigned int m = static_cast<unsigned int>(J.rows());
+        if (nullity == 0 || m == 0) {
+            // no joints left, the task is only solved by accident
+            ranks[k] = 0;
+            degraded = degraded || m > 0;
+            return;
+        }
+        // the task in the null space of the previous ones
+        residual[k].noalias() = x - J*qdot;
+        JZ[k].noalias() = J*Z.leftCols(nullity);
+        // the first pivot is the largest column norm, the threshold of the
+        // decomposition is relative to it
+        const double max_norm = JZ[k].colwise().norm().maxCoeff();
+        if (max_norm <= eps) {
+            ranks[k] = 0;
+            degraded = true;
+            return;
+        }
+        cod[k].setThreshold(eps/max_norm);
+        cod[k].compute(JZ[k]);
+        y.head(nullity).noalias() = cod[k].solve(residual[k]);
+        qdot.noalias() += Z.leftCols(nullity)*y.head(nullity);
+
+        const unsigned int rank = static_cast<unsigned int>(cod[k].rank());
+        ranks[k] = rank;
+        if (rank < m)
+            degraded = true;
+        if (rank == 0)
+            return;
+        // JZ*P = Q*[T 0;0 0]*Z_cod, so the last columns of P*Z_cod' span its
+        // null space
+        N.topLeftCorner(nullity,nullity) = cod[k].colsPermutation()*cod[k].matrixZ().transpose();
+        Z_next.leftCols(nullity-rank).noalias() = Z.leftCols(nullity)*N.block(0,rank,nullity,nullity-rank);
+        nullity -= rank;
+        Z.leftCols(nullity) = Z_next.leftCols(nullity);
+    }
+
+    int IkSolverVel_priority::CartToJnt(const std::vector<Eigen::MatrixXd>& jacobians,
+                                        const std::vector<Eigen::VectorXd>& v_in,JntArray& qdot_out)
+    {
+        if (jacobians.size() != v_in.size() || qdot_out.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+        for (unsigned int k=0;k<jacobians.size();k++)
+            if (jacobians[k].cols() != nj || jacobians[k].rows() != v_in[k].rows())
+                return (error = E_SIZE_MISMATCH);
+
+        setNrOfTasks(static_cast<unsigned int>(jacobians.size()));
+        for (unsigned int k=0;k<jacobians.size();k++)
+            solveTask(k,jacobians[k],v_in[k]);
+        qdot_out.data = qdot;
+        return (error = degraded ? E_DEGRADED : E_NOERROR);
+    }
+
+    int IkSolverVel_priority::CartToJnt(const std::vector<Jacobian>& jacobians,
+                                        const std::vector<Twist>& v_in,JntArray& qdot_out)
+    {
+        if (jacobians.size() != v_in.size() || qdot_out.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+        for (unsigned int k=0;k<jacobians.size();k++)
+            if (jacobians[k].columns() != nj)
+                return (error = E_SIZE_MISMATCH);
+
+        setNrOfTasks(static_cast<unsigned int>(jacobians.size()));
+        for (unsigned int k=0;k<jacobians.size();k++) {
+            for (unsigned int i=0;i<6;i++)
+                twist(i) = v_in[k](i);
+            solveTask(k,jacobians[k].data,twist);
+        }
+        qdot_out.data = qdot;
+        return (error = degraded ? E_DEGRADED : E_NOERROR);
+    }
+}
@@ -0,0 +1,133 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_IKSOLVERVEL_PRIORITY_HPP
+#define KDL_IKSOLVERVEL_PRIORITY_HPP
+
+#include "solveri.hpp"
+#include "jacobian.hpp"
+#include "jntarray.hpp"
+#include "frames.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/QR>
+#include <vector>
+
+namespace ARMstrongKDL
+{
+    /**
+     * \brief Inverse velocity kinematics for an ordered list of tasks
+     * (stack of tasks).
+     *
+     * Every task k is a jacobian J_k and a desired task velocity x_k.  The
+     * joint velocities solve the first task in the least squares sense
+     * with minimal norm, every next task is solved as well as possible
+     * within the null space of all previous ones :
+     *
+     *   qdot_k = qdot_{k-1} + Z_{k-1} pinv(J_k Z_{k-1}) (x_k - J_k qdot_{k-1})
+     *
+     * with Z_{k-1} an orthonormal basis of the null space of J_1 .. J_{k-1}.
+     * Every level takes one complete orthogonal decomposition of J_k Z_{k-1},
+     * which has only as many columns as there are joints left, and gives
+     * both the pseudo inverse and the basis Z_k for the next level.
+     *
+     * The jacobians can come from any solver (ChainJntToJacSolver,
+     * TreeJntToJacSolver, ...), as long as their columns are the same
+     * joints.  The workspaces are kept between calls.
+     *
+     * @ingroup KinematicFamily
+     */
+    class IkSolverVel_priority : public SolverI
+    {
+    public:
+        /**
+         * Constructor of the solver
+         *
+         * @param nj the number of joints, i.e. the number of columns of
+         * the task jacobians
+         * @param eps a pivot of a decomposition (about a singular value of
+         * the task jacobian in the remaining null space) below this value
+         * is taken as zero, default: 0.00001
+         */
+        explicit IkSolverVel_priority(unsigned int nj,double eps=0.00001);
+        ~IkSolverVel_priority();
+
+        /**
+         * Calculates the joint velocities for a list of tasks, in
+         * decreasing priority.
+         *
+         * @param jacobians the task jacobians, every one with nj columns
+         * @param v_in the desired task velocities, with as many rows as
+         * the corresponding jacobian
+         * @param qdot_out the joint velocities
+         * @return E_NOERROR if all tasks are solved exactly,
+         *         E_DEGRADED if a task is singular or conflicts with a
+         *         task of higher priority, see getTaskRank(),
+         *         E_SIZE_MISMATCH if the sizes do not match.
+         */
+        int CartToJnt(const std::vector<Eigen::MatrixXd>& jacobians,
+                      const std::vector<Eigen::VectorXd>& v_in,JntArray& qdot_out);
+
+        /**
+         * Calculates the joint velocities for a list of Cartesian tasks,
+         * in decreasing priority, see above.
+         */
+        int CartToJnt(const std::vector<Jacobian>& jacobians,
+                      const std::vector<Twist>& v_in,JntArray& qdot_out);
+
+        /**
+         * Request the rank of the jacobian of a task within the null space
+         * of the previous ones, for the last call.  It is lower than the
+         * number of rows of the task when the task is not solved exactly.
+         */
+        unsigned int getTaskRank(unsigned int task)const {return ranks[task];};
+
+        /**
+         * Request the number of joint velocities that are left free by
+         * all tasks of the last call.
+         */
+        unsigned int getNullSpaceDimension()const {return nullity;};
+
+        /**
+         * Set eps
+         */
+        void setEps(const double eps_in) {eps=eps_in;};
+
+        /// The number of joints is fixed at construction, nothing to update.
+        virtual void updateInternalDataStructures() {};
+
+    private:
+        void setNrOfTasks(unsigned int nr_tasks);
+        void solveTask(unsigned int task,const Eigen::Ref<const Eigen::MatrixXd>& J,
+                       const Eigen::Ref<const Eigen::VectorXd>& x);
+
+        unsigned int nj;
+        double eps;
+        bool degraded;
+        unsigned int nullity;
+        Eigen::VectorXd qdot;
+        // basis of the null space of the tasks so far, in its first
+        // nullity columns, and the one of the next level
+        Eigen::MatrixXd Z;
+        Eigen::MatrixXd Z_next;
+        Eigen::MatrixXd N;
+        Eigen::VectorXd y;
+        Eigen::Matrix<double,6,1> twist;
+        std::vector<Eigen::MatrixXd> JZ;
+        std::vector<Eigen::VectorXd> residual;
+        std::vector<Eigen::CompleteOrthogonalDecomposition<Eigen::MatrixXd> > cod;
+        std::vector<unsigned int> ranks;
+    };
+}
+#endif
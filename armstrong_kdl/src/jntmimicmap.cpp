@@ -0,0 +1,167 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "jntmimicmap.hpp"
+
+namespace ARMstrongKDL
+{
+    JntMimicMap::JntMimicMap(unsigned int _nj):
+        nj(_nj),
+        nr(_nj),
+        valid(true),
+        source(_nj,-1),
+        index_(_nj,0),
+        multiplier_(_nj,1.0),
+        offset_(_nj,0.0)
+    {
+        build();
+    }
+
+    JntMimicMap::JntMimicMap(const std::vector<JointMimic>& mimic_joints):
+        nj(mimic_joints.size()),
+        nr(0),
+        valid(true),
+        source(nj,-1),
+        index_(nj,0),
+        multiplier_(nj,1.0),
+        offset_(nj,0.0)
+    {
+        // the independent joints first, map_index is their reduced index
+        std::vector<int> joint_of_index(nj,-1);
+        for (unsigned int j=0;j<nj;j++) {
+            if (!mimic_joints[j].active)
+                continue;
+            const unsigned int r = mimic_joints[j].map_index;
+            if (r >= nj || joint_of_index[r] >= 0)
+                valid = false;
+            else
+                joint_of_index[r] = j;
+        }
+        for (unsigned int j=0;valid && j<nj;j++) {
+            if (mimic_joints[j].active)
+                continue;
+            const unsigned int r = mimic_joints[j].map_index;
+            if (r >= nj || joint_of_index[r] < 0) {
+                valid = false;
+                break;
+            }
+            source[j] = joint_of_index[r];
+            multiplier_[j] = mimic_joints[j].multiplier;
+            offset_[j] = mimic_joints[j].offset;
+        }
+        if (!valid) {
+            source.assign(nj,-1);
+            multiplier_.assign(nj,1.0);
+            offset_.assign(nj,0.0);
+        }
+        build();
+        // the reduced order has to match map_index
+        for (unsigned int j=0;valid && j<nj;j++)
+            if (index_[j] != mimic_joints[j].map_index)
+                valid = false;
+    }
+
+    void JntMimicMap::build()
+    {
+        independent.clear();
+        for (unsigned int j=0;j<nj;j++) {
+            if (source[j] < 0) {
+                index_[j] = independent.size();
+                independent.push_back(j);
+            }
+        }
+        nr = independent.size();
+        for (unsigned int j=0;j<nj;j++)
+            if (source[j] >= 0)
+                index_[j] = index_[source[j]];
+
+        jac.setZero(nj,nr);
+        for (unsigned int j=0;j<nj;j++)
+            jac(j,index_[j]) = multiplier_[j];
+    }
+
+    bool JntMimicMap::setMimic(unsigned int joint,unsigned int mimicked,double multiplier,double offset)
+    {
+        if (joint >= nj || mimicked >= nj || joint == mimicked || source[mimicked] >= 0)
+            return false;
+        for (unsigned int j=0;j<nj;j++)
+            if (source[j] == (int)joint)
+                return false;
+        source[joint] = mimicked;
+        multiplier_[joint] = multiplier;
+        offset_[joint] = offset;
+        build();
+        return true;
+    }
+
+    bool JntMimicMap::clearMimic(unsigned int joint)
+    {
+        if (joint >= nj)
+            return false;
+        source[joint] = -1;
+        multiplier_[joint] = 1.0;
+        offset_[joint] = 0.0;
+        build();
+        return true;
+    }
+
+    bool JntMimicMap::toFull(const JntArray& q_r,JntArray& q) const
+    {
+        if (q_r.rows() != nr || q.rows() != nj)
+            return false;
+        for (unsigned int j=0;j<nj;j++)
+            q(j) = position(q_r,j);
+        return true;
+    }
+
+    bool JntMimicMap::velocityToFull(const JntArray& qdot_r,JntArray& qdot) const
+    {
+        if (qdot_r.rows() != nr || qdot.rows() != nj)
+            return false;
+        for (unsigned int j=0;j<nj;j++)
+            qdot(j) = velocity(qdot_r,j);
+        return true;
+    }
+
+    bool JntMimicMap::toReduced(const JntArray& q,JntArray& q_r) const
+    {
+        if (q.rows() != nj || q_r.rows() != nr)
+            return false;
+        for (unsigned int r=0;r<nr;r++) {
+            const unsigned int j = independent[r];
+            q_r(r) = (q(j)-offset_[j])/multiplier_[j];
+        }
+        return true;
+    }
+
+    bool JntMimicMap::reduceJacobian(const Jacobian& jac_full,Jacobian& jac_r) const
+    {
+        if (jac_full.columns() != nj || jac_r.columns() != nr)
+            return false;
+        jac_r.data.setZero();
+        for (unsigned int j=0;j<nj;j++)
+            jac_r.data.col(index_[j]) += multiplier_[j]*jac_full.data.col(j);
+        return true;
+    }
+
+    bool JntMimicMap::reduceTorques(const JntArray& tau,JntArray& tau_r) const
+    {
+        if (tau.rows() != nj || tau_r.rows() != nr)
+            return false;
+        tau_r.data.setZero();
+        for (unsigned int j=0;j<nj;j++)
+            tau_r(index_[j]) += multiplier_[j]*tau(j);
+        return true;
+    }
+}
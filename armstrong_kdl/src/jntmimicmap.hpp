@@ -0,0 +1,147 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_JNTMIMICMAP_HPP
+#define KDL_JNTMIMICMAP_HPP
+
+#include <string>
+#include <vector>
+
+#include "jntarray.hpp"
+#include "jacobian.hpp"
+#include "joint_mimic.hpp"
+
+#include <Eigen/Core>
+
+namespace ARMstrongKDL
+{
+    /**
+     * \brief Map from the independent joints of a chain to all its
+     * joints, for chains with mimic joints.
+     *
+     * Every joint j of the chain either is independent, or follows an
+     * independent joint k linearly :
+     *
+     *   q_j = multiplier_j*q_k + offset_j
+     *
+     * The independent joints, in the order of the chain, are the reduced
+     * coordinates q_r.  The map q = f(q_r) has the constant jacobian
+     * M = df/dq_r, with M(j,index(j)) = multiplier_j, so
+     *  - joint velocities and accelerations map as qdot = M*qdot_r,
+     *  - a jacobian maps as J_r = J*M,
+     *  - joint torques map as tau_r = M'*tau.
+     *
+     * ChainFkSolverPos_recursive, ChainJntToJacSolver, ChainIkSolverPos_LMA
+     * and ChainIdSolver_RNE accept a map with setMimicMap(), they then take
+     * and return reduced coordinates without building the full vectors.
+     */
+    class JntMimicMap
+    {
+    public:
+        /**
+         * Constructs the map of a chain without mimic joints.
+         *
+         * @param nj the number of joints of the chain
+         */
+        explicit JntMimicMap(unsigned int nj=0);
+
+        /**
+         * Constructs the map from a description of every joint, see
+         * ChainIkSolverVelMimicSVD : map_index is the index of the
+         * independent joint in the reduced coordinates, active is true
+         * for the independent joints, which have to be numbered in the
+         * order of the chain.  Use isValid() to check it.
+         */
+        explicit JntMimicMap(const std::vector<JointMimic>& mimic_joints);
+
+        /**
+         * Lets a joint follow another joint.
+         *
+         * @param joint the index of the mimic joint in the chain
+         * @param mimicked the index of the joint it follows in the chain,
+         *        that joint has to be independent
+         * @return false if an index is out of range, if mimicked is a
+         *         mimic joint or if joint is followed by other joints
+         */
+        bool setMimic(unsigned int joint,unsigned int mimicked,double multiplier=1.0,double offset=0.0);
+
+        /// Makes a joint independent again
+        bool clearMimic(unsigned int joint);
+
+        /// false if the description given to the constructor is inconsistent
+        bool isValid() const { return valid; }
+
+        /// The number of joints of the chain
+        unsigned int getNrOfJoints() const { return nj; }
+
+        /// The number of independent joints, the size of the reduced coordinates
+        unsigned int getNrOfIndependentJoints() const { return nr; }
+
+        /// The index in the reduced coordinates of the joint it follows
+        unsigned int index(unsigned int joint) const { return index_[joint]; }
+
+        double multiplier(unsigned int joint) const { return multiplier_[joint]; }
+
+        double offset(unsigned int joint) const { return offset_[joint]; }
+
+        /// The position of a joint of the chain, for reduced coordinates q_r
+        template<class Vec>
+        double position(const Vec& q_r,unsigned int joint) const
+        {
+            return multiplier_[joint]*q_r(index_[joint])+offset_[joint];
+        }
+
+        /// The velocity (or acceleration) of a joint of the chain
+        template<class Vec>
+        double velocity(const Vec& qdot_r,unsigned int joint) const
+        {
+            return multiplier_[joint]*qdot_r(index_[joint]);
+        }
+
+        /// The jacobian M of the map, nj x nr
+        const Eigen::MatrixXd& getJacobian() const { return jac; }
+
+        /// q = f(q_r), false on a size mismatch
+        bool toFull(const JntArray& q_r,JntArray& q) const;
+
+        /// qdot = M*qdot_r, also for accelerations, false on a size mismatch
+        bool velocityToFull(const JntArray& qdot_r,JntArray& qdot) const;
+
+        /// The reduced coordinates of q, from its independent joints
+        bool toReduced(const JntArray& q,JntArray& q_r) const;
+
+        /// J_r = J*M, false on a size mismatch
+        bool reduceJacobian(const Jacobian& jac_full,Jacobian& jac_r) const;
+
+        /// tau_r = M'*tau, false on a size mismatch
+        bool reduceTorques(const JntArray& tau,JntArray& tau_r) const;
+
+    private:
+        void build();
+
+        unsigned int nj;
+        unsigned int nr;
+        bool valid;
+        // per joint of the chain : the joint it follows, -1 if independent
+        std::vector<int> source;
+        std::vector<unsigned int> index_;
+        std::vector<double> multiplier_;
+        std::vector<double> offset_;
+        // per independent joint : its index in the chain
+        std::vector<unsigned int> independent;
+        Eigen::MatrixXd jac;
+    };
+}
+
+#endif
@@ -90,6 +90,40 @@ namespace ARMstrongKDL {
         return Frame::Identity();
     }
 
+    void Joint::applyPose(Frame& F,const double& q)const
+    {
+        double a = scale*q+offset;
+        switch(type){
+        case RotAxis:
+            F.p += F.M*origin;
+            F.M = F.M*Rotation::Rot2(axis, a);
+            return;
+        case RotX:
+            F.M.DoRotX(a);
+            return;
+        case RotY:
+            F.M.DoRotY(a);
+            return;
+        case RotZ:
+            F.M.DoRotZ(a);
+            return;
+        case TransAxis:
+            F.p += F.M*(origin + axis*a);
+            return;
+        case TransX:
+            F.p += F.M.UnitX()*a;
+            return;
+        case TransY:
+            F.p += F.M.UnitY()*a;
+            return;
+        case TransZ:
+            F.p += F.M.UnitZ()*a;
+            return;
+        case Fixed:
+            return;
+        }
+    }
+
     Twist Joint::twist(const double& qdot)const
     {
         switch(type){
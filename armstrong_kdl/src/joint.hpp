@@ -119,6 +119,16 @@ namespace ARMstrongKDL {
          * @return the resulting 6D-pose
          */
         Frame pose(const double& q)const;
+        /**
+         * Multiplies F on the right with the 6D-pose of the joint at
+         * joint position q, i.e. F = F*pose(q).  Rotations around
+         * X, Y or Z are applied to F directly (see Rotation::DoRotX)
+         * without building the intermediate rotation matrix.
+         *
+         * @param F the frame to compose with, replaced by the result
+         * @param q the 1D joint position
+         */
+        void applyPose(Frame& F,const double& q)const;
         /**
          * Request the resulting 6D-velocity with a joint velocity qdot
          *
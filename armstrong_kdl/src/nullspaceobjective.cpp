@@ -0,0 +1,191 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "nullspaceobjective.hpp"
+#include "chainjnttomanipulabilitysolver.hpp"
+#include "solveri.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ARMstrongKDL
+{
+    NullSpaceState::NullSpaceState():
+        q(0),
+        jac(0),
+        U(0),
+        S(0),
+        V(0),
+        eps(0.0)
+    {
+    }
+
+    void NullSpaceState::updateFrames(const Chain& chain, const JntArray& q_in)
+    {
+        const unsigned int ns = chain.getNrOfSegments();
+        frames.resize(ns);
+        joints.resize(ns);
+        Frame T = Frame::Identity();
+        unsigned int j = 0;
+        for (unsigned int s=0;s<ns;s++) {
+            const Segment& segment = chain.getSegment(s);
+            if (segment.getJoint().getType() != Joint::Fixed)
+                T = T*segment.pose(q_in(j++));
+            else
+                T = T*segment.pose(0.0);
+            frames[s] = T;
+            joints[s] = j;
+        }
+    }
+
+    void NullSpaceState::pointJacobian(unsigned int segment, const Vector& p, Eigen::MatrixXd& jac_p) const
+    {
+        // the columns of jac are the twists of the joints at the end
+        // effector, v_p = v_ee + w x (p - p_ee)
+        const Vector r = p-frames.back().p;
+        jac_p.setZero(3,jac->columns());
+        for (unsigned int j=0;j<joints[segment];j++) {
+            const Twist t = jac->getColumn(j).RefPoint(r);
+            jac_p(0,j) = t.vel(0);
+            jac_p(1,j) = t.vel(1);
+            jac_p(2,j) = t.vel(2);
+        }
+    }
+
+    NullSpaceObjective::NullSpaceObjective(double _gain):
+        gain(_gain),
+        cost(0.0)
+    {
+    }
+
+    NullSpaceObjective::~NullSpaceObjective()
+    {
+    }
+
+    JointLimitObjective::JointLimitObjective(const JntArray& _q_min, const JntArray& _q_max, double _gain, double _max_gradient):
+        NullSpaceObjective(_gain),
+        q_min(_q_min),
+        q_max(_q_max),
+        max_gradient(_max_gradient)
+    {
+    }
+
+    int JointLimitObjective::addGradient(const NullSpaceState& state, Eigen::VectorXd& gradient)
+    {
+        const JntArray& q = *state.q;
+        if (q_min.rows() != q.rows() || q_max.rows() != q.rows())
+            return SolverI::E_SIZE_MISMATCH;
+        double h = 0.0;
+        for (unsigned int i=0;i<q.rows();i++) {
+            const double range = q_max(i)-q_min(i);
+            if (range <= 0.0)
+                continue;
+            // outside the limits the barrier pushes back from just inside
+            const double margin = 1e-6*range;
+            const double qi = std::min(std::max(q(i),q_min(i)+margin),q_max(i)-margin);
+            const double to_max = q_max(i)-qi;
+            const double to_min = qi-q_min(i);
+            h += range*range/(4.0*to_max*to_min);
+            const double dh = range*range*(2.0*qi-q_max(i)-q_min(i))/(4.0*to_max*to_max*to_min*to_min);
+            gradient(i) += gain*std::min(std::max(dh,-max_gradient),max_gradient);
+        }
+        cost = gain*h;
+        return SolverI::E_NOERROR;
+    }
+
+    ManipulabilityObjective::ManipulabilityObjective(double _gain):
+        NullSpaceObjective(_gain)
+    {
+    }
+
+    int ManipulabilityObjective::addGradient(const NullSpaceState& state, Eigen::VectorXd& gradient)
+    {
+        // h = -sum log(sigma_i), dh/dq = -sum d(sigma_i)/dq / sigma_i
+        const Eigen::VectorXd& S = *state.S;
+        dsigma.resize(gradient.size());
+        double h = 0.0;
+        for (unsigned int i=0;i<S.size() && i<6;i++) {
+            if (S(i) < state.eps)
+                continue;
+            ChainJntToManipulabilitySolver::singularValueGradient(state.jac->data,state.U->col(i),state.V->col(i),dsigma);
+            h -= std::log(S(i));
+            gradient -= (gain/S(i))*dsigma;
+        }
+        cost = gain*h;
+        return SolverI::E_NOERROR;
+    }
+
+    ObstacleObjective::ObstacleObjective(double activation_distance, double _gain):
+        NullSpaceObjective(_gain),
+        d0(activation_distance),
+        min_distance(std::numeric_limits<double>::infinity())
+    {
+    }
+
+    void ObstacleObjective::addControlPoint(unsigned int segment, const Vector& point, double radius)
+    {
+        segments.push_back(segment);
+        points.push_back(point);
+        point_radii.push_back(radius);
+    }
+
+    void ObstacleObjective::addObstacle(const Vector& center, double radius)
+    {
+        centers.push_back(center);
+        radii.push_back(radius);
+    }
+
+    void ObstacleObjective::setObstacle(unsigned int i, const Vector& center)
+    {
+        if (i < centers.size())
+            centers[i] = center;
+    }
+
+    void ObstacleObjective::clearObstacles()
+    {
+        centers.clear();
+        radii.clear();
+    }
+
+    int ObstacleObjective::addGradient(const NullSpaceState& state, Eigen::VectorXd& gradient)
+    {
+        double h = 0.0;
+        min_distance = std::numeric_limits<double>::infinity();
+        for (unsigned int c=0;c<points.size();c++) {
+            if (segments[c] >= state.frames.size())
+                return SolverI::E_OUT_OF_RANGE;
+            const Vector p = state.frames[segments[c]]*points[c];
+            bool jacobian_valid = false;
+            for (unsigned int o=0;o<centers.size();o++) {
+                Vector n = p-centers[o];
+                const double dist = n.Norm();
+                const double d = dist-radii[o]-point_radii[c];
+                min_distance = std::min(min_distance,d);
+                if (d >= d0 || dist < 1e-12)
+                    continue;
+                if (!jacobian_valid) {
+                    state.pointJacobian(segments[c],p,jac_p);
+                    jacobian_valid = true;
+                }
+                // dh/dq = -(d0-d)*n'*J_p
+                n = n/dist;
+                h += 0.5*(d0-d)*(d0-d);
+                gradient -= gain*(d0-d)*(jac_p.transpose()*Eigen::Vector3d(n(0),n(1),n(2)));
+            }
+        }
+        cost = gain*h;
+        return SolverI::E_NOERROR;
+    }
+}
@@ -0,0 +1,194 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_NULLSPACEOBJECTIVE_HPP
+#define KDL_NULLSPACEOBJECTIVE_HPP
+
+#include "chain.hpp"
+#include "frames.hpp"
+#include "jacobian.hpp"
+#include "jntarray.hpp"
+
+#include <vector>
+#include <Eigen/Core>
+
+namespace ARMstrongKDL
+{
+    /**
+     * \brief What ChainIkSolverVel_pinv_nso computes once per call and
+     * shares with all its null space objectives.
+     */
+    struct NullSpaceState
+    {
+        /// The joint positions
+        const JntArray* q;
+        /// The jacobian of the end effector, base frame, end effector reference point
+        const Jacobian* jac;
+        /// Its SVD jac = U*S*V', the singular values below eps are zero
+        const Eigen::MatrixXd* U;
+        const Eigen::VectorXd* S;
+        const Eigen::MatrixXd* V;
+        double eps;
+        /// The frames of the tips of the segments in the base, only
+        /// filled when an objective needs them
+        std::vector<Frame> frames;
+        /// The number of joints up to and including every segment
+        std::vector<unsigned int> joints;
+
+        NullSpaceState();
+
+        /// Fills frames and joints in one sweep over the chain
+        void updateFrames(const Chain& chain, const JntArray& q_in);
+
+        /**
+         * The jacobian of the translation of a point attached to a
+         * segment, from the jacobian of the end effector and the frames.
+         *
+         * @param segment the index of the segment the point moves with
+         * @param p the point, in the base
+         * @param jac_p the 3 x nj jacobian, zero for the joints after the segment
+         */
+        void pointJacobian(unsigned int segment, const Vector& p, Eigen::MatrixXd& jac_p) const;
+    };
+
+    /**
+     * \brief A cost h(q) that ChainIkSolverVel_pinv_nso decreases in the
+     * null space of the jacobian, moving along -dh/dq.
+     */
+    class NullSpaceObjective
+    {
+    public:
+        explicit NullSpaceObjective(double gain=1.0);
+        virtual ~NullSpaceObjective();
+
+        /**
+         * Adds gain*dh/dq to gradient and stores gain*h.
+         *
+         * @return E_NOERROR, or a negative SolverI error code
+         */
+        virtual int addGradient(const NullSpaceState& state, Eigen::VectorXd& gradient) = 0;
+
+        /// true if the objective uses the frames of the state
+        virtual bool needsFrames() const { return false; }
+
+        /// Objectives with a zero gain are not evaluated
+        void setGain(double _gain) { gain = _gain; }
+        double getGain() const { return gain; }
+
+        /// gain*h of the last evaluation
+        double getCost() const { return cost; }
+
+    protected:
+        double gain;
+        double cost;
+    };
+
+    /**
+     * \brief Keeps the joints away from their limits with the criterion
+     *
+     *   h = sum (q_max-q_min)^2 / (4*(q_max-q)*(q-q_min))
+     *
+     * of T.F. Chan & R.V. Dubey, A weighted least-norm solution based
+     * scheme for avoiding joint limits for redundant joint manipulators,
+     * IEEE Transactions on Robotics and Automation, 11(2):286-292, 1995.
+     * Joints with q_max <= q_min are not limited.
+     *
+     * dh/dq_i grows as range/(4*d^2) at a distance d from a limit, so it
+     * is saturated to +-max_gradient, in 1/rad (1/m for prismatic
+     * joints).  ChainIkSolverVel_pinv_nso then moves a joint with at
+     * most alpha*gain*max_gradient away from its limits, also at or
+     * beyond a limit, and alpha*gain is the joint velocity per unit of
+     * the gradient.
+     */
+    class JointLimitObjective : public NullSpaceObjective
+    {
+    public:
+        JointLimitObjective(const JntArray& q_min, const JntArray& q_max, double gain=1.0, double max_gradient=10.0);
+
+        /// @return E_SIZE_MISMATCH if the limits do not match q
+        virtual int addGradient(const NullSpaceState& state, Eigen::VectorXd& gradient);
+
+        void setMaxGradient(double _max_gradient) { max_gradient = _max_gradient; }
+        double getMaxGradient() const { return max_gradient; }
+
+    private:
+        JntArray q_min;
+        JntArray q_max;
+        double max_gradient;
+    };
+
+    /**
+     * \brief Moves away from singularities, h = -log(w) with w the
+     * manipulability of Yoshikawa of the non zero singular values.  The
+     * gradient comes from the SVD of the solver, see
+     * ChainJntToManipulabilitySolver.
+     */
+    class ManipulabilityObjective : public NullSpaceObjective
+    {
+    public:
+        explicit ManipulabilityObjective(double gain=1.0);
+
+        virtual int addGradient(const NullSpaceState& state, Eigen::VectorXd& gradient);
+
+    private:
+        Eigen::VectorXd dsigma;
+    };
+
+    /**
+     * \brief Keeps spheres attached to the segments away from spherical
+     * obstacles, h = sum 0.5*(d0-d)^2 over the pairs with a distance d
+     * below the activation distance d0.
+     */
+    class ObstacleObjective : public NullSpaceObjective
+    {
+    public:
+        explicit ObstacleObjective(double activation_distance, double gain=1.0);
+
+        /**
+         * Attaches a sphere to a segment.
+         *
+         * @param segment the index of the segment in the chain
+         * @param point the center, in the frame of the tip of the segment
+         */
+        void addControlPoint(unsigned int segment, const Vector& point, double radius=0.0);
+
+        /// Adds an obstacle, center in the base
+        void addObstacle(const Vector& center, double radius);
+
+        /// Moves obstacle i
+        void setObstacle(unsigned int i, const Vector& center);
+
+        void clearObstacles();
+
+        /// The smallest distance between a control point and an obstacle at the last evaluation
+        double getMinimumDistance() const { return min_distance; }
+
+        virtual bool needsFrames() const { return true; }
+
+        /// @return E_OUT_OF_RANGE for a control point on a segment the chain does not have
+        virtual int addGradient(const NullSpaceState& state, Eigen::VectorXd& gradient);
+
+    private:
+        double d0;
+        std::vector<unsigned int> segments;
+        std::vector<Vector> points;
+        std::vector<double> point_radii;
+        std::vector<Vector> centers;
+        std::vector<double> radii;
+        double min_distance;
+        Eigen::MatrixXd jac_p;
+    };
+}
+
+#endif
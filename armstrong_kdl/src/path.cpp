@@ -51,6 +51,8 @@
 #include "path_composite.hpp"
 #include "path_roundedcomposite.hpp"
 #include "path_cyclic_closed.hpp"
+#include "path_spline.hpp"
+#include "binary_io.hpp"
 #include <memory>
 #include <string.h>
 
@@ -135,6 +137,24 @@ Path* Path::Read(std::istream& is) {
 		IOTracePop();
 		IOTracePop();
 		return tr.release();
+	} else if (strcmp(storage,"SPLINE")==0) {
+		IOTrace("SPLINE");
+		double eqradius;
+		is >> eqradius;
+		scoped_ptr<Path_Spline> tr( new Path_Spline(eqradius) );
+		int size;
+		is >> size;
+		int i;
+		for (i=0;i<size;i++) {
+			Frame f;
+			is >> f;
+			tr->Add(f);
+		}
+		tr->Finish();
+		EatEnd(is,']');
+		IOTracePop();
+		IOTracePop();
+		return tr.release();
 	} else if (strcmp(storage,"COMPOSITE")==0) {
 		IOTrace("COMPOSITE");
 		int size;
@@ -163,5 +183,27 @@ Path* Path::Read(std::istream& is) {
 	return NULL; // just to avoid the warning;
 }
 
+Path* Path::ReadBinary(BinaryReader& r) {
+	switch (r.PeekTag()) {
+		case BIN_PATH_POINT:
+			return Path_Point::ReadBinary(r);
+		case BIN_PATH_LINE:
+			return Path_Line::ReadBinary(r);
+		case BIN_PATH_CIRCLE:
+			return Path_Circle::ReadBinary(r);
+		case BIN_PATH_COMPOSITE:
+			return Path_Composite::ReadBinary(r);
+		case BIN_PATH_ROUNDED_COMPOSITE:
+			return Path_RoundedComposite::ReadBinary(r);
+		case BIN_PATH_CYCLIC_CLOSED:
+			return Path_Cyclic_Closed::ReadBinary(r);
+		case BIN_PATH_SPLINE:
+			return Path_Spline::ReadBinary(r);
+		default:
+			throw Error_MotionIO_Binary(4);
+	}
+	return NULL; // just to avoid the warning;
+}
+
 }
 
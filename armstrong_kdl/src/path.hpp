@@ -52,6 +52,9 @@
 
 namespace ARMstrongKDL {
 
+class BinaryWriter;
+class BinaryReader;
+
 /**
  * The specification of the path of a trajectory.
  */
@@ -64,7 +67,8 @@ class Path
 			ID_COMPOSITE=3,
 			ID_ROUNDED_COMPOSITE=4,
 			ID_POINT=5,
-			ID_CYCLIC_CLOSED=6
+			ID_CYCLIC_CLOSED=6,
+			ID_SPLINE=7
 		};
 		/**
 		 * LengthToS() converts a physical length along the trajectory
@@ -74,8 +78,9 @@ class Path
 		 * User should be sure that the lineair distance travelled by this
 		 * path object is NOT zero, when using this method !
 		 * (e.g. the case of only rotational change)
-		 * throws Error_MotionPlanning_Not_Applicable if used on composed
-		 * path objects.
+		 * Composed path objects use an interpolated lookup table
+		 * (see ArcLengthTable), Path_Cyclic_Closed
+		 * throws Error_MotionPlanning_Not_Applicable.
 		 * @ingroup Motion
 		 */
 		virtual double LengthToS(double length)  = 0;
@@ -116,6 +121,20 @@ class Path
 		 */
 		static Path* Read(std::istream& is);
 
+		/**
+		 * Writes the complete state of one of the derived objects in the
+		 * binary format.
+		 * \sa BinaryWriter
+		 */
+		virtual void WriteBinary(BinaryWriter& w) = 0;
+
+		/**
+		 * Reads one of the derived objects from the binary format and returns a pointer
+		 * (factory method)
+		 * \sa BinaryReader
+		 */
+		static Path* ReadBinary(BinaryReader& r);
+
 		/**
 		 * Virtual constructor, constructing by copying,
 		 * Returns a deep copy of this Path Object
@@ -41,6 +41,8 @@
 
 
 #include "path_circle.hpp"
+#include "binary_io.hpp"
+#include "utilities/scoped_ptr.hpp"
 #include "utilities/error.h"
 
 namespace ARMstrongKDL {
@@ -141,9 +143,9 @@ Path* Path_Circle::Clone() {
 	return new Path_Circle(
 		Pos(0),
 		F_base_center.p,
-		F_base_center.M.UnitY(),
+		F_base_center.p+F_base_center.M.UnitY(),
 		orient->Pos(pathlength*scalerot),
-		pathlength*scalelin/radius/deg2rad,
+		pathlength*scalelin/radius,
 		orient->Clone(),
 		eqradius,
         aggregate
@@ -159,7 +161,7 @@ void Path_Circle::Write(std::ostream& os) {
 	os << "CIRCLE[ ";
 	os << "  " << Pos(0) << std::endl;
 	os << "  " << F_base_center.p << std::endl;
-	os << "  " << F_base_center.M.UnitY() << std::endl;
+	os << "  " << F_base_center.p+F_base_center.M.UnitY() << std::endl;
 	os << "  " << orient->Pos(pathlength*scalerot) << std::endl;
 	os << "  " << pathlength*scalelin/radius/deg2rad << std::endl;
 	os << "  ";orient->Write(os);
@@ -167,4 +169,27 @@ void Path_Circle::Write(std::ostream& os) {
 	os << "]"<< std::endl;
 }
 
+void Path_Circle::WriteBinary(BinaryWriter& w) {
+	w.WriteUInt(BIN_PATH_CIRCLE);
+	w.WriteFrame(Pos(0));
+	w.WriteVector(F_base_center.p);
+	w.WriteVector(F_base_center.p+F_base_center.M.UnitY());
+	w.WriteRotation(orient->Pos(pathlength*scalerot));
+	w.WriteDouble(pathlength*scalelin/radius);
+	orient->WriteBinary(w);
+	w.WriteDouble(eqradius);
+}
+
+Path* Path_Circle::ReadBinary(BinaryReader& r) {
+	r.ExpectTag(BIN_PATH_CIRCLE);
+	Frame F_base_start    = r.ReadFrame();
+	Vector V_base_center  = r.ReadVector();
+	Vector V_base_p       = r.ReadVector();
+	Rotation R_base_end   = r.ReadRotation();
+	double alpha          = r.ReadDouble();
+	scoped_ptr<RotationalInterpolation> orient( RotationalInterpolation::ReadBinary(r) );
+	double eqradius       = r.ReadDouble();
+	return new Path_Circle(F_base_start,V_base_center,V_base_p,R_base_end,alpha,orient.release(),eqradius);
+}
+
 }
@@ -101,6 +101,16 @@ class Path_Circle : public Path
 		virtual Path* Clone();
 		virtual void Write(std::ostream& os);
 
+		/**
+		 * Writes the object in the binary format, see BinaryWriter
+		 */
+		virtual void WriteBinary(BinaryWriter& w);
+
+		/**
+		 * Reads an object of this type from the binary format, see BinaryReader
+		 */
+		static Path* ReadBinary(BinaryReader& r);
+
 		/**
 		 * gets an identifier indicating the type of this Path object
 		 */
@@ -41,6 +41,7 @@
 
 
 #include "path_composite.hpp"
+#include "binary_io.hpp"
 #include "utilities/error.h"
 #include "utilities/scoped_ptr.hpp"
 #include <memory>
@@ -54,12 +55,12 @@ namespace ARMstrongKDL {
 // you probably want to use the cached_index variable
 double Path_Composite::Lookup(double s) const
 {
-	assert(s>=-1e-12);
+	assert(s>=startlength-1e-12);
 	assert(s<=pathlength+1e-12);
 	if ( (cached_starts <=s) && ( s <= cached_ends) ) {
 		return s - cached_starts;
 	}
-	double previous_s=0;
+	double previous_s=startlength;
 	for (unsigned int i=0;i<dv.size();++i) {
 		if ((s <= dv[i])||(i == (dv.size()-1) )) {
 			cached_index = i;
@@ -74,20 +75,66 @@ double Path_Composite::Lookup(double s) const
 
 Path_Composite::Path_Composite() {
 	pathlength    = 0;
+	startlength   = 0;
 	cached_starts = 0;
 	cached_ends   = 0;
 	cached_index  = 0;
+	lengthtable   = 0;
+	lengthtable_samples = 0;
 }
 
 void Path_Composite::Add(Path* geom, bool aggregate ) {
 	pathlength += geom->PathLength();
 	dv.insert(dv.end(),pathlength);
 	gv.insert( gv.end(),std::make_pair(geom,aggregate) );
+	if (lengthtable != 0)
+		lengthtable->Add(*geom,lengthtable_samples);
+}
+
+int Path_Composite::RemoveSegmentsBefore(double s) {
+	// keep the arc length of the removed segments :
+	if (lengthtable == 0)
+		BuildArcLengthTable();
+	unsigned int n=0;
+	while (n<dv.size() && dv[n]<=s)
+		++n;
+	if (n==0)
+		return 0;
+	for (unsigned int i=0;i<n;++i) {
+		if (gv[i].second)
+			delete gv[i].first;
+	}
+	startlength = dv[n-1];
+	gv.erase(gv.begin(),gv.begin()+n);
+	dv.erase(dv.begin(),dv.begin()+n);
+	lengthtable->RemoveBefore(startlength);
+	cached_index  = 0;
+	cached_starts = startlength;
+	cached_ends   = dv.empty() ? startlength : dv[0];
+	return static_cast<int>(n);
+}
+
+void Path_Composite::BuildArcLengthTable(int nrofsamples) {
+	// keep the arc length of segments that were removed before :
+	double startarclength = (lengthtable != 0) ? lengthtable->SToLength(startlength) : startlength;
+	delete lengthtable;
+	lengthtable = new ArcLengthTable(startlength,startarclength);
+	lengthtable_samples = nrofsamples;
+	for (unsigned int i=0;i<gv.size();++i) {
+		lengthtable->Add(*gv[i].first,nrofsamples);
+	}
 }
 
 double Path_Composite::LengthToS(double length) {
-	throw Error_MotionPlanning_Not_Applicable();
-	return 0;
+	if (lengthtable == 0)
+		BuildArcLengthTable();
+	return lengthtable->LengthToS(length);
+}
+
+double Path_Composite::SToLength(double s) {
+	if (lengthtable == 0)
+		BuildArcLengthTable();
+	return lengthtable->SToLength(s);
 }
 
 double Path_Composite::PathLength() {
@@ -112,9 +159,17 @@ Twist Path_Composite::Acc(double s,double sd,double sdd) const {
 
 Path* Path_Composite::Clone()  {
 	scoped_ptr<Path_Composite> comp( new Path_Composite() );
+	comp->startlength   = startlength;
+	comp->pathlength    = startlength;
+	comp->cached_starts = startlength;
+	comp->cached_ends   = startlength;
 	for (unsigned int i = 0; i < dv.size(); ++i) {
 		comp->Add(gv[i].first->Clone(), gv[i].second);
 	}
+	if (lengthtable != 0) {
+		comp->lengthtable = new ArcLengthTable(*lengthtable);
+		comp->lengthtable_samples = lengthtable_samples;
+	}
 	return comp.release();
 }
 
@@ -137,6 +192,12 @@ Path* Path_Composite::GetSegment(int i) {
 	return gv[i].first;
 }
 
+double Path_Composite::GetLengthToStartOfSegment(int i) {
+	assert(i>=0);
+	assert(i<static_cast<int>(dv.size()));
+	return (i==0) ? startlength : dv[i-1];
+}
+
 double Path_Composite::GetLengthToEndOfSegment(int i) {
 	assert(i>=0);
 	assert(i<static_cast<int>(dv.size()));
@@ -151,6 +212,7 @@ void Path_Composite::GetCurrentSegmentLocation(double s, int& segment_number,
 }
 
 Path_Composite::~Path_Composite() {
+	delete lengthtable;
 	PathVector::iterator it;
 	for (it=gv.begin();it!=gv.end();++it) {
 		if (it->second)
@@ -158,4 +220,36 @@ Path_Composite::~Path_Composite() {
 	}
 }
 
+void Path_Composite::WriteBinary(BinaryWriter& w) {
+	w.WriteUInt(BIN_PATH_COMPOSITE);
+	w.WriteDouble(startlength);
+	w.WriteUInt(dv.size());
+	for (unsigned int i=0;i<dv.size();++i) {
+		gv[i].first->WriteBinary(w);
+	}
+	w.WriteBool(lengthtable != 0);
+	if (lengthtable != 0) {
+		w.WriteInt(lengthtable_samples);
+		lengthtable->WriteBinary(w);
+	}
+}
+
+Path* Path_Composite::ReadBinary(BinaryReader& r) {
+	r.ExpectTag(BIN_PATH_COMPOSITE);
+	scoped_ptr<Path_Composite> comp( new Path_Composite() );
+	comp->startlength   = r.ReadDouble();
+	comp->pathlength    = comp->startlength;
+	comp->cached_starts = comp->startlength;
+	comp->cached_ends   = comp->startlength;
+	unsigned int size = r.ReadUInt();
+	for (unsigned int i=0;i<size;++i) {
+		comp->Add(Path::ReadBinary(r));
+	}
+	if (r.ReadBool()) {
+		comp->lengthtable_samples = r.ReadInt();
+		comp->lengthtable = new ArcLengthTable(ArcLengthTable::ReadBinary(r));
+	}
+	return comp.release();
+}
+
 } // namespace ARMstrongKDL
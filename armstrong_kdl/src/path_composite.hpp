@@ -47,6 +47,7 @@
 #include "frames.hpp"
 #include "frames_io.hpp"
 #include "path.hpp"
+#include "arclengthtable.hpp"
 #include <vector>
 
 namespace ARMstrongKDL {
@@ -74,12 +75,17 @@ namespace ARMstrongKDL {
 		PathVector gv;
 		DoubleVector   dv;
 		double pathlength;
+		double startlength;
 
 		// lookup mechanism :
 		mutable double cached_starts;
 		mutable double cached_ends;
 		mutable int    cached_index;
 		double Lookup(double s) const;
+
+		// conversion between physical length and s :
+		ArcLengthTable* lengthtable;
+		int lengthtable_samples;
 	public:
 
 
@@ -90,8 +96,41 @@ namespace ARMstrongKDL {
 		 */
 		void Add(Path* geom, bool aggregate=true);
 
+		/**
+		 * Removes the segments that end before or at s, e.g. because they
+		 * are already executed.  The path variable s of the remaining
+		 * segments does not change, Pos(), Vel() and Acc() can be used
+		 * between GetLengthToStartOfSegment(0) and PathLength().
+		 * Together with Add() this can be used as a sliding window over
+		 * a stream of segments.
+		 * \param s path length variable
+		 * \return number of removed segments.
+		 */
+		int RemoveSegmentsBefore(double s);
+
+		/**
+		 * Builds the lookup table used by LengthToS() and SToLength().
+		 * This is done automatically at the first call of LengthToS(),
+		 * SToLength() or RemoveSegmentsBefore(), call this method explicitly to
+		 * avoid that cost at run time.  Once built, the table is extended
+		 * by Add().
+		 * \param nrofsamples number of interpolation intervals for each segment.
+		 */
+		void BuildArcLengthTable(int nrofsamples=20);
 
+		/**
+		 * Converts a physical length along the path to the parameter s,
+		 * using a lookup table that is interpolated with a monotone spline.
+		 * If a part of the path does not translate, the start of that part
+		 * is returned.
+		 */
 		virtual double LengthToS(double length);
+
+		/**
+		 * Converts the parameter s to the physical length along the path,
+		 * the inverse of LengthToS().
+		 */
+		virtual double SToLength(double s);
 		/**
 		 * Returns the total path length of the trajectory
 		 * (has dimension LENGTH)
@@ -124,6 +163,16 @@ namespace ARMstrongKDL {
 		 */
 		virtual void Write(std::ostream& os);
 
+		/**
+		 * Writes the object in the binary format, see BinaryWriter
+		 */
+		virtual void WriteBinary(BinaryWriter& w);
+
+		/**
+		 * Reads an object of this type from the binary format, see BinaryReader
+		 */
+		static Path* ReadBinary(BinaryReader& r);
+
 		/**
 		 * returns the number of underlying segments.
 		 */
@@ -138,6 +187,14 @@ namespace ARMstrongKDL {
 		 */
 		virtual Path* GetSegment(int i);
 
+		/**
+		 * gets the length to the start of the given segment.
+		 * \param i segment number
+		 * \return length to the start of the segment, i.e. the value for s corresponding to the start of
+		 *         this segment.
+		 */
+		virtual double GetLengthToStartOfSegment(int i);
+
 		/**
 		 * gets the length to the end of the given segment.
 		 * \param i segment number
@@ -41,6 +41,8 @@
 
 
 #include "path_cyclic_closed.hpp"
+#include "binary_io.hpp"
+#include "utilities/scoped_ptr.hpp"
 #include "utilities/error.h"
 
 namespace ARMstrongKDL {
@@ -86,5 +88,18 @@ void Path_Cyclic_Closed::Write(std::ostream& os)  {
 	os << "]"  << std::endl;
 }
 
+void Path_Cyclic_Closed::WriteBinary(BinaryWriter& w) {
+	w.WriteUInt(BIN_PATH_CYCLIC_CLOSED);
+	w.WriteInt(times);
+	geom->WriteBinary(w);
+}
+
+Path* Path_Cyclic_Closed::ReadBinary(BinaryReader& r) {
+	r.ExpectTag(BIN_PATH_CYCLIC_CLOSED);
+	int times = r.ReadInt();
+	scoped_ptr<Path> geom( Path::ReadBinary(r) );
+	return new Path_Cyclic_Closed(geom.release(),times);
+}
+
 }
 
@@ -71,6 +71,16 @@ namespace ARMstrongKDL {
 		virtual Twist Acc(double s,double sd,double sdd) const;
 
 		virtual void Write(std::ostream& os);
+
+		/**
+		 * Writes the object in the binary format, see BinaryWriter
+		 */
+		virtual void WriteBinary(BinaryWriter& w);
+
+		/**
+		 * Reads an object of this type from the binary format, see BinaryReader
+		 */
+		static Path* ReadBinary(BinaryReader& r);
 		static Path* Read(std::istream& is);
 		virtual Path* Clone();
 		/**
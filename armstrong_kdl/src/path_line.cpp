@@ -41,6 +41,8 @@
 
 
 #include "path_line.hpp"
+#include "binary_io.hpp"
+#include "utilities/scoped_ptr.hpp"
 
 namespace ARMstrongKDL {
 
@@ -180,5 +182,22 @@ void Path_Line::Write(std::ostream& os)  {
 }
 
 
+void Path_Line::WriteBinary(BinaryWriter& w) {
+	w.WriteUInt(BIN_PATH_LINE);
+	w.WriteFrame(Frame(orient->Pos(0),V_base_start));
+	w.WriteFrame(Frame(orient->Pos(pathlength*scalerot),V_base_end));
+	orient->WriteBinary(w);
+	w.WriteDouble(eqradius);
+}
+
+Path* Path_Line::ReadBinary(BinaryReader& r) {
+	r.ExpectTag(BIN_PATH_LINE);
+	Frame startpos = r.ReadFrame();
+	Frame endpos   = r.ReadFrame();
+	scoped_ptr<RotationalInterpolation> orient( RotationalInterpolation::ReadBinary(r) );
+	double eqradius = r.ReadDouble();
+	return new Path_Line(startpos,endpos,orient.release(),eqradius);
+}
+
 }
 
@@ -120,6 +120,16 @@ class Path_Line : public Path
 		virtual Twist Vel(double s,double sd) const ;
 		virtual Twist Acc(double s,double sd,double sdd) const;
 		virtual void Write(std::ostream& os);
+
+		/**
+		 * Writes the object in the binary format, see BinaryWriter
+		 */
+		virtual void WriteBinary(BinaryWriter& w);
+
+		/**
+		 * Reads an object of this type from the binary format, see BinaryReader
+		 */
+		static Path* ReadBinary(BinaryReader& r);
 		virtual Path* Clone();
 
 		/**
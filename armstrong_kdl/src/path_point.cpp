@@ -41,6 +41,7 @@
 
 
 #include "path_point.hpp"
+#include "binary_io.hpp"
 
 namespace ARMstrongKDL {
 
@@ -79,5 +80,15 @@ void Path_Point::Write(std::ostream& os)  {
 }
 
 
+void Path_Point::WriteBinary(BinaryWriter& w) {
+	w.WriteUInt(BIN_PATH_POINT);
+	w.WriteFrame(F_base_start);
+}
+
+Path* Path_Point::ReadBinary(BinaryReader& r) {
+	r.ExpectTag(BIN_PATH_POINT);
+	return new Path_Point(r.ReadFrame());
+}
+
 }
 
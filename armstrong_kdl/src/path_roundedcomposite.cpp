@@ -43,6 +43,7 @@
 #include "path_roundedcomposite.hpp"
 #include "path_line.hpp"
 #include "path_circle.hpp"
+#include "binary_io.hpp"
 #include "utilities/error.h"
 #include "utilities/scoped_ptr.hpp"
 #include <memory>
@@ -55,11 +56,13 @@ namespace ARMstrongKDL {
 Path_RoundedComposite::Path_RoundedComposite(Path_Composite* _comp,
 		double _radius, double _eqradius, RotationalInterpolation* _orient,
 		bool _aggregate,int _nrofpoints):
-		comp(_comp), radius(_radius), eqradius(_eqradius), orient(_orient), nrofpoints(_nrofpoints), aggregate(_aggregate) {
+		comp(_comp), radius(_radius), eqradius(_eqradius), orient(_orient), nrofpoints(_nrofpoints), aggregate(_aggregate),
+		maxnrofsegments(0) {
 }
 
 Path_RoundedComposite::Path_RoundedComposite(double _radius,double _eqradius,RotationalInterpolation* _orient, bool _aggregate) :
-	comp( new Path_Composite()), radius(_radius),eqradius(_eqradius), orient(_orient), aggregate(_aggregate)
+	comp( new Path_Composite()), radius(_radius),eqradius(_eqradius), orient(_orient), aggregate(_aggregate),
+	maxnrofsegments(0)
 {
 		nrofpoints = 0;
 		if (eqradius<=0) {
@@ -134,6 +137,19 @@ void Path_RoundedComposite::Add(const Frame& F_base_point) {
 	}
 
 	nrofpoints++;
+
+	int nrofsegments = comp->GetNrOfSegments();
+	if (maxnrofsegments > 0 && nrofsegments > maxnrofsegments) {
+		comp->RemoveSegmentsBefore(comp->GetLengthToEndOfSegment(nrofsegments-maxnrofsegments-1));
+	}
+}
+
+int Path_RoundedComposite::RemoveSegmentsBefore(double s) {
+	return comp->RemoveSegmentsBefore(s);
+}
+
+void Path_RoundedComposite::SetMaxNrOfSegments(int _maxnrofsegments) {
+	maxnrofsegments = _maxnrofsegments;
 }
 
 void Path_RoundedComposite::Finish() {
@@ -142,12 +158,17 @@ void Path_RoundedComposite::Finish() {
 				new Path_Line(F_base_start, F_base_via, orient->Clone(),
 						eqradius));
 	}
+	comp->BuildArcLengthTable();
 }
 
 double Path_RoundedComposite::LengthToS(double length) {
 	return comp->LengthToS(length);
 }
 
+double Path_RoundedComposite::SToLength(double s) {
+	return comp->SToLength(s);
+}
+
 
 double Path_RoundedComposite::PathLength() {
 	return comp->PathLength();
@@ -177,6 +198,10 @@ Path* Path_RoundedComposite::GetSegment(int i) {
 	return comp->GetSegment(i);
 }
 
+double Path_RoundedComposite::GetLengthToStartOfSegment(int i) {
+	return comp->GetLengthToStartOfSegment(i);
+}
+
 double Path_RoundedComposite::GetLengthToEndOfSegment(int i) {
 	return comp->GetLengthToEndOfSegment(i);
 }
@@ -196,7 +221,39 @@ Path_RoundedComposite::~Path_RoundedComposite() {
 
 
 Path* Path_RoundedComposite::Clone() {
-	return new Path_RoundedComposite(static_cast<Path_Composite*>(comp->Clone()),radius,eqradius,orient->Clone(), true, nrofpoints);
+	Path_RoundedComposite* res = new Path_RoundedComposite(static_cast<Path_Composite*>(comp->Clone()),radius,eqradius,orient->Clone(), true, nrofpoints);
+	res->maxnrofsegments = maxnrofsegments;
+	return res;
+}
+
+void Path_RoundedComposite::WriteBinary(BinaryWriter& w) {
+	w.WriteUInt(BIN_PATH_ROUNDED_COMPOSITE);
+	w.WriteDouble(radius);
+	w.WriteDouble(eqradius);
+	orient->WriteBinary(w);
+	w.WriteFrame(F_base_start);
+	w.WriteFrame(F_base_via);
+	w.WriteInt(nrofpoints);
+	w.WriteInt(maxnrofsegments);
+	comp->WriteBinary(w);
+}
+
+Path* Path_RoundedComposite::ReadBinary(BinaryReader& r) {
+	r.ExpectTag(BIN_PATH_ROUNDED_COMPOSITE);
+	double radius   = r.ReadDouble();
+	double eqradius = r.ReadDouble();
+	scoped_ptr<RotationalInterpolation> orient( RotationalInterpolation::ReadBinary(r) );
+	Frame F_base_start  = r.ReadFrame();
+	Frame F_base_via    = r.ReadFrame();
+	int nrofpoints      = r.ReadInt();
+	int maxnrofsegments = r.ReadInt();
+	scoped_ptr<Path> comp( Path_Composite::ReadBinary(r) );
+	Path_RoundedComposite* res = new Path_RoundedComposite(static_cast<Path_Composite*>(comp.release()),
+			radius,eqradius,orient.release(),true,nrofpoints);
+	res->F_base_start    = F_base_start;
+	res->F_base_via      = F_base_via;
+	res->maxnrofsegments = maxnrofsegments;
+	return res;
 }
 
 }
@@ -53,6 +53,13 @@ namespace ARMstrongKDL {
 /**
  * The specification of a path, composed of way-points with rounded corners.
  *
+ * The path can be used while way-points are streamed in : as soon as a
+ * way-point is added, the line towards the previous via point and its rounding are
+ * final, and can be evaluated for s up to PathLength().  Segments that are
+ * executed can be removed with RemoveSegmentsBefore(), or the number of segments
+ * can be bounded with SetMaxNrOfSegments(), the path variable s of the
+ * remaining segments does not change.
+ *
  * @ingroup Motion
  */
 class Path_RoundedComposite : public Path
@@ -74,6 +81,9 @@ class Path_RoundedComposite : public Path
 
 		bool aggregate;
 
+		// maximum number of segments kept, <=0 for unlimited :
+		int maxnrofsegments;
+
 		Path_RoundedComposite(Path_Composite* comp,double radius,double eqradius,RotationalInterpolation* orient, bool aggregate, int nrofpoints);
 
 	public:
@@ -108,15 +118,42 @@ class Path_RoundedComposite : public Path
 		 */
 		void Add(const Frame& F_base_point);
 
+		/**
+		 * Removes the segments that end before or at s, e.g. because they
+		 * are already executed.
+		 * \sa Path_Composite::RemoveSegmentsBefore
+		 * \return number of removed segments.
+		 */
+		int RemoveSegmentsBefore(double s);
+
+		/**
+		 * Bounds the number of segments kept in memory : when a way-point is
+		 * added and the number of segments exceeds maxnrofsegments, the
+		 * oldest segments are removed.
+		 * \param maxnrofsegments maximum number of segments, <=0 for unlimited (default).
+		 * \warning the user should not evaluate the path before GetLengthToStartOfSegment(0).
+		 */
+		void SetMaxNrOfSegments(int maxnrofsegments);
+
 		/**
 		 * to be called after the last line is added to finish up
-		 * the work
+		 * the work, this also builds the lookup table for LengthToS().
 		 */
 		void Finish();
 
 
+		/**
+		 * Converts a physical length along the path to the parameter s.
+		 * \sa Path_Composite::LengthToS
+		 */
 		virtual double LengthToS(double length);
 
+		/**
+		 * Converts the parameter s to the physical length along the path.
+		 * \sa Path_Composite::SToLength
+		 */
+		virtual double SToLength(double s);
+
 		/**
 		 * Returns the total path length of the trajectory
 		 * (has dimension LENGTH)
@@ -155,6 +192,16 @@ class Path_RoundedComposite : public Path
 		 */
 		virtual void Write(std::ostream& os);
 
+		/**
+		 * Writes the object in the binary format, see BinaryWriter
+		 */
+		virtual void WriteBinary(BinaryWriter& w);
+
+		/**
+		 * Reads an object of this type from the binary format, see BinaryReader
+		 */
+		static Path* ReadBinary(BinaryReader& r);
+
 		/**
 		 * returns the number of underlying segments.
 		 */
@@ -169,6 +216,14 @@ class Path_RoundedComposite : public Path
 		 */
 		virtual Path* GetSegment(int i);
 
+		/**
+		 * gets the length to the start of the given segment.
+		 * \param i segment number
+		 * \return length to the start of the segment, i.e. the value for s corresponding to the start of
+		 *         this segment.
+		 */
+		virtual double GetLengthToStartOfSegment(int i);
+
 		/**
 		 * gets the length to the end of the given segment.
 		 * \param i segment number
@@ -0,0 +1,310 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "path_spline.hpp"
+#include "binary_io.hpp"
+#include "utilities/error.h"
+#include "utilities/scoped_ptr.hpp"
+#include <algorithm>
+
+namespace ARMstrongKDL {
+
+// number of intervals of the arc length table for each spline segment
+static const int lengthtable_samples = 10;
+
+/**
+ * Coefficients of the (left) Jacobian of the exponential map of SO(3),
+ *   J(v) = I + a [v x] + b [v x]^2
+ * and of its time derivative, a' = ad*theta, b' = bd*theta, with theta = |v|.
+ */
+static void ExpJacobianCoefficients(double theta,double& a,double& b,double& ad,double& bd) {
+	if (theta < 1E-2) {
+		double t2 = theta*theta;
+		a  = 0.5 - t2/24.0;
+		b  = 1.0/6.0 - t2/120.0;
+		ad = -1.0/12.0 + t2/180.0;
+		bd = -1.0/60.0 + t2/1260.0;
+	} else {
+		double ct = cos(theta);
+		double st = sin(theta);
+		double t2 = theta*theta;
+		a  = (1-ct)/t2;
+		b  = (theta-st)/(t2*theta);
+		ad = (theta*st-2*(1-ct))/(t2*t2);
+		bd = ((1-ct)*theta-3*(theta-st))/(t2*t2*theta);
+	}
+}
+
+/**
+ * Exponential map of SO(3), also accurate for small rotation vectors r.
+ */
+static Rotation ExpRotation(const Vector& r) {
+	double theta = r.Norm();
+	double c1,c2;
+	if (theta < 1E-2) {
+		double t2 = theta*theta;
+		c1 = 1.0 - t2/6.0;
+		c2 = 0.5 - t2/24.0;
+	} else {
+		c1 = sin(theta)/theta;
+		c2 = (1-cos(theta))/(theta*theta);
+	}
+	double d = 1.0 - c2*theta*theta;
+	double x = r.x(), y = r.y(), z = r.z();
+	return Rotation(d+c2*x*x,    c2*x*y-c1*z, c2*x*z+c1*y,
+					c2*x*y+c1*z, d+c2*y*y,    c2*y*z-c1*x,
+					c2*x*z-c1*y, c2*y*z+c1*x, d+c2*z*z);
+}
+
+Path_Spline::Path_Spline(double _eqradius):
+	eqradius(_eqradius), cached_index(0)
+{
+	if (eqradius<=0) {
+		throw Error_MotionPlanning_Not_Feasible(1);
+	}
+}
+
+Path_Spline::Path_Spline(const std::vector<Frame>& _points,double _eqradius):
+	eqradius(_eqradius), cached_index(0)
+{
+	if (eqradius<=0) {
+		throw Error_MotionPlanning_Not_Feasible(1);
+	}
+	points.reserve(_points.size());
+	for (unsigned int i=0;i<_points.size();++i)
+		Add(_points[i]);
+	Finish();
+}
+
+void Path_Spline::Add(const Frame& F_base_point) {
+	points.push_back(F_base_point);
+}
+
+void Path_Spline::Finish() {
+	double eps = 1E-7;
+	unsigned int n = points.size();
+	if (n < 2) {
+		throw Error_MotionPlanning_Not_Feasible(7);
+	}
+	sv.resize(n);
+	pv.resize(n);
+	rv.resize(n);
+	pm.assign(n,Vector::Zero());
+	rm.assign(n,Vector::Zero());
+
+	// rotation vectors with respect to the first way-point, chosen
+	// such that they are close to the previous one :
+	R_base_ref = points[0].M;
+	Rotation R_ref_base = R_base_ref.Inverse();
+	rv[0] = Vector::Zero();
+	pv[0] = points[0].p;
+	sv[0] = 0;
+	for (unsigned int i=1;i<n;++i) {
+		Vector axis;
+		double angle = (R_ref_base*points[i].M).GetRotAngle(axis,epsilon);
+		double k = floor((dot(rv[i-1],axis)-angle)/(2*PI)+0.5);
+		rv[i] = axis*(angle+2*PI*k);
+		pv[i] = points[i].p;
+		double h = std::max((pv[i]-pv[i-1]).Norm(),
+						   eqradius*(points[i-1].M.Inverse()*points[i].M).GetRotAngle(axis,epsilon));
+		if (h < eps) {
+			throw Error_MotionPlanning_Not_Feasible(8);
+		}
+		sv[i] = sv[i-1]+h;
+	}
+
+	// natural cubic spline, solve the tridiagonal system for the second
+	// derivatives at the interior knots (Thomas algorithm) :
+	if (n > 2) {
+		std::vector<double> c(n);
+		std::vector<Vector> dp(n),dr(n);
+		for (unsigned int i=1;i<n-1;++i) {
+			double h0 = sv[i]-sv[i-1];
+			double h1 = sv[i+1]-sv[i];
+			Vector ep = 6.0*((pv[i+1]-pv[i])/h1 - (pv[i]-pv[i-1])/h0);
+			Vector er = 6.0*((rv[i+1]-rv[i])/h1 - (rv[i]-rv[i-1])/h0);
+			double diag = 2*(h0+h1);
+			if (i > 1) {
+				diag -= h0*c[i-1];
+				ep   -= h0*dp[i-1];
+				er   -= h0*dr[i-1];
+			}
+			c[i]  = h1/diag;
+			dp[i] = ep/diag;
+			dr[i] = er/diag;
+		}
+		pm[n-2] = dp[n-2];
+		rm[n-2] = dr[n-2];
+		for (unsigned int i=n-2;i-- > 1;) {
+			pm[i] = dp[i]-c[i]*pm[i+1];
+			rm[i] = dr[i]-c[i]*rm[i+1];
+		}
+	}
+	cached_index = 0;
+	lengthtable  = ArcLengthTable(*this,lengthtable_samples*(n-1));
+}
+
+unsigned int Path_Spline::Lookup(double s) const {
+	if (sv[cached_index] <= s && s <= sv[cached_index+1])
+		return cached_index;
+	cached_index = std::upper_bound(sv.begin(),sv.end(),s) - sv.begin();
+	cached_index = std::min<unsigned int>(std::max<unsigned int>(cached_index,1),sv.size()-1) - 1;
+	return cached_index;
+}
+
+double Path_Spline::LengthToS(double length) {
+	return lengthtable.LengthToS(length);
+}
+
+double Path_Spline::PathLength() {
+	return sv.back();
+}
+
+Frame Path_Spline::Pos(double s) const {
+	unsigned int i = Lookup(s);
+	double h  = sv[i+1]-sv[i];
+	double t0 = sv[i+1]-s;
+	double t1 = s-sv[i];
+	Vector p = (pm[i]*(t0*t0*t0) + pm[i+1]*(t1*t1*t1))/(6*h)
+			 + (pv[i]/h - pm[i]*(h/6))*t0 + (pv[i+1]/h - pm[i+1]*(h/6))*t1;
+	Vector r = (rm[i]*(t0*t0*t0) + rm[i+1]*(t1*t1*t1))/(6*h)
+			 + (rv[i]/h - rm[i]*(h/6))*t0 + (rv[i+1]/h - rm[i+1]*(h/6))*t1;
+	return Frame(R_base_ref*ExpRotation(r),p);
+}
+
+Twist Path_Spline::Vel(double s,double sd) const {
+	unsigned int i = Lookup(s);
+	double h  = sv[i+1]-sv[i];
+	double t0 = sv[i+1]-s;
+	double t1 = s-sv[i];
+	Vector dp = (pm[i+1]*(t1*t1) - pm[i]*(t0*t0))/(2*h)
+			  + (pv[i+1]-pv[i])/h - (pm[i+1]-pm[i])*(h/6);
+	Vector r  = (rm[i]*(t0*t0*t0) + rm[i+1]*(t1*t1*t1))/(6*h)
+			  + (rv[i]/h - rm[i]*(h/6))*t0 + (rv[i+1]/h - rm[i+1]*(h/6))*t1;
+	Vector dr = (rm[i+1]*(t1*t1) - rm[i]*(t0*t0))/(2*h)
+			  + (rv[i+1]-rv[i])/h - (rm[i+1]-rm[i])*(h/6);
+	double a,b,ad,bd;
+	ExpJacobianCoefficients(r.Norm(),a,b,ad,bd);
+	Vector rxdr = r*dr;
+	Vector w = dr + a*rxdr + b*(r*rxdr);
+	return Twist(dp*sd,R_base_ref*(w*sd));
+}
+
+Twist Path_Spline::Acc(double s,double sd,double sdd) const {
+	unsigned int i = Lookup(s);
+	double h  = sv[i+1]-sv[i];
+	double t0 = sv[i+1]-s;
+	double t1 = s-sv[i];
+	Vector dp  = (pm[i+1]*(t1*t1) - pm[i]*(t0*t0))/(2*h)
+			   + (pv[i+1]-pv[i])/h - (pm[i+1]-pm[i])*(h/6);
+	Vector ddp = (pm[i]*t0 + pm[i+1]*t1)/h;
+	Vector r   = (rm[i]*(t0*t0*t0) + rm[i+1]*(t1*t1*t1))/(6*h)
+			   + (rv[i]/h - rm[i]*(h/6))*t0 + (rv[i+1]/h - rm[i+1]*(h/6))*t1;
+	Vector dr  = (rm[i+1]*(t1*t1) - rm[i]*(t0*t0))/(2*h)
+			   + (rv[i+1]-rv[i])/h - (rm[i+1]-rm[i])*(h/6);
+	Vector ddr = (rm[i]*t0 + rm[i+1]*t1)/h;
+	// time derivatives of the rotation vector :
+	Vector rd  = dr*sd;
+	Vector rdd = ddr*(sd*sd) + dr*sdd;
+	double a,b,ad,bd;
+	ExpJacobianCoefficients(r.Norm(),a,b,ad,bd);
+	// d/dt ( J(r) rd ) :
+	Vector rxrd   = r*rd;
+	Vector rxrdd  = r*rdd;
+	double rdotrd = dot(r,rd);
+	Vector wd = rdd + a*rxrdd + b*(r*rxrdd)
+			  + (ad*rdotrd)*rxrd + (bd*rdotrd)*(r*rxrd) + b*(rd*rxrd);
+	return Twist(ddp*(sd*sd)+dp*sdd,R_base_ref*wd);
+}
+
+Path* Path_Spline::Clone() {
+	return new Path_Spline(points,eqradius);
+}
+
+void Path_Spline::Write(std::ostream& os) {
+	os << "SPLINE[ ";
+	os << "  " << eqradius << std::endl;
+	os << "  " << points.size() << std::endl;
+	for (unsigned int i=0;i<points.size();++i) {
+		os << "  " << points[i] << std::endl;
+	}
+	os << "]" << std::endl;
+}
+
+int Path_Spline::GetNrOfPoints() const {
+	return static_cast<int>(points.size());
+}
+
+double Path_Spline::GetLengthToPoint(int i) const {
+	assert(i>=0);
+	assert(i<static_cast<int>(sv.size()));
+	return sv[i];
+}
+
+Path_Spline::~Path_Spline() {
+}
+
+static void WriteVectors(BinaryWriter& w,const std::vector<Vector>& v) {
+	for (unsigned int i=0;i<v.size();++i)
+		w.WriteVector(v[i]);
+}
+
+static void ReadVectors(BinaryReader& r,std::vector<Vector>& v,unsigned int n) {
+	v.resize(n);
+	for (unsigned int i=0;i<n;++i)
+		v[i] = r.ReadVector();
+}
+
+void Path_Spline::WriteBinary(BinaryWriter& w) {
+	w.WriteUInt(BIN_PATH_SPLINE);
+	w.WriteDouble(eqradius);
+	w.WriteUInt(points.size());
+	for (unsigned int i=0;i<points.size();++i)
+		w.WriteFrame(points[i]);
+	// the solved spline, such that it is not recomputed when reading :
+	w.WriteUInt(sv.size());
+	if (!sv.empty())
+		w.WriteDoubles(&sv[0],sv.size());
+	WriteVectors(w,pv);
+	WriteVectors(w,pm);
+	WriteVectors(w,rv);
+	WriteVectors(w,rm);
+	w.WriteRotation(R_base_ref);
+	lengthtable.WriteBinary(w);
+}
+
+Path* Path_Spline::ReadBinary(BinaryReader& r) {
+	r.ExpectTag(BIN_PATH_SPLINE);
+	scoped_ptr<Path_Spline> spline( new Path_Spline(r.ReadDouble()) );
+	// a frame is 12 doubles, a knot is a double and 4 vectors :
+	unsigned int n = r.ReadCount(12*8);
+	if (n < 2)
+		throw Error_MotionIO_Binary(3);
+	spline->points.resize(n);
+	for (unsigned int i=0;i<n;++i)
+		spline->points[i] = r.ReadFrame();
+	if (r.ReadCount(13*8) != n)
+		throw Error_MotionIO_Binary(3);
+	spline->sv.resize(n);
+	r.ReadDoubles(&spline->sv[0],n);
+	ReadVectors(r,spline->pv,n);
+	ReadVectors(r,spline->pm,n);
+	ReadVectors(r,spline->rv,n);
+	ReadVectors(r,spline->rm,n);
+	spline->R_base_ref  = r.ReadRotation();
+	spline->lengthtable = ArcLengthTable::ReadBinary(r);
+	return spline.release();
+}
+
+}
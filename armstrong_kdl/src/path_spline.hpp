@@ -0,0 +1,169 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_MOTION_PATHSPLINE_H
+#define KDL_MOTION_PATHSPLINE_H
+
+#include "path.hpp"
+#include "arclengthtable.hpp"
+#include <vector>
+
+namespace ARMstrongKDL {
+
+/**
+ * A path through way-points that is C2 continuous in position and
+ * orientation, i.e. the velocity and acceleration twists are continuous
+ * for a continuous sd and sdd.
+ *
+ * The position is interpolated with a natural cubic spline.  The orientation
+ * is interpolated with a natural cubic spline of the rotation vector
+ * (the logarithm) of the orientation with respect to the first way-point,
+ * which is mapped back on SO(3) with the exponential, such that the result is
+ * always a proper rotation.  The rotation vectors of the way-points are chosen
+ * such that consecutive rotation vectors are as close as possible.
+ *
+ * Contrary to the other paths, the orientation does not use a
+ * RotationalInterpolation : that interface interpolates between the start
+ * and end orientation of one segment, so the angular velocity and
+ * acceleration jump at every way-point.  Continuity needs the rotations of
+ * all way-points at once, which is what the spline of the rotation vectors
+ * does.
+ *
+ * The path variable s is, as for Path_Line, the maximum of the distance and
+ * the rotation angle times eqradius between consecutive way-points, summed
+ * up to the current way-point.  Constructing the spline solves a
+ * tridiagonal system, it takes O(N) for N way-points.
+ *
+ * @ingroup Motion
+ */
+class Path_Spline : public Path
+	{
+		double eqradius;
+		std::vector<Frame> points;
+
+		// knots and the values and second derivatives of the splines at the knots :
+		std::vector<double> sv;
+		std::vector<Vector> pv,pm;      // position
+		std::vector<Vector> rv,rm;      // rotation vector w.r.t. R_base_ref
+		Rotation R_base_ref;
+
+		ArcLengthTable lengthtable;
+
+		// lookup mechanism :
+		mutable unsigned int cached_index;
+		unsigned int Lookup(double s) const;
+	public:
+		/**
+		 * Constructs an empty spline, way-points are added with Add().
+		 * @param eqradius : equivalent radius to compare rotations/velocities
+		 */
+		explicit Path_Spline(double eqradius);
+
+		/**
+		 * Constructs the spline through the given way-points.
+		 * @param points : way-points, at least 2.
+		 * @param eqradius : equivalent radius to compare rotations/velocities
+		 * @warning Can throw Error_MotionPlanning_Not_Feasible object, see Finish().
+		 */
+		Path_Spline(const std::vector<Frame>& points,double eqradius);
+
+		/**
+		 * Adds a way-point to the spline.
+		 */
+		void Add(const Frame& F_base_point);
+
+		/**
+		 * To be called after the last way-point is added, computes the spline.
+		 *
+		 * The Error_MotionPlanning_Not_Feasible has a type (obtained by GetType) of:
+		 * - 3101 if the eq. radius <= 0
+		 * - 3107 if less than 2 way-points were added.
+		 * - 3108 if two consecutive way-points are equal.
+		 */
+		void Finish();
+
+		/**
+		 * Converts a physical length along the path to the parameter s,
+		 * using a lookup table.
+		 * \sa ArcLengthTable
+		 */
+		virtual double LengthToS(double length);
+
+		/**
+		 * Returns the total path length of the trajectory
+		 * (has dimension LENGTH)
+		 * This is not always a physical length , ie when dealing with rotations
+		 * that are dominant.
+		 */
+		virtual double PathLength();
+
+		/**
+		 * Returns the Frame at the current path length s
+		 */
+		virtual Frame Pos(double s) const;
+
+		/**
+		 * Returns the velocity twist at path length s theta and with
+		 * derivative of s == sd
+		 */
+		virtual Twist Vel(double s,double sd) const;
+
+		/**
+		 * Returns the acceleration twist at path length s and with
+		 * derivative of s == sd, and 2nd derivative of s == sdd
+		 */
+		virtual Twist Acc(double s,double sd,double sdd) const;
+
+		virtual Path* Clone();
+
+		/**
+		 * Writes one of the derived objects to the stream
+		 */
+		virtual void Write(std::ostream& os);
+
+		/**
+		 * Writes the object in the binary format, see BinaryWriter
+		 */
+		virtual void WriteBinary(BinaryWriter& w);
+
+		/**
+		 * Reads an object of this type from the binary format, see BinaryReader
+		 */
+		static Path* ReadBinary(BinaryReader& r);
+
+		/**
+		 * returns the number of way-points.
+		 */
+		int GetNrOfPoints() const;
+
+		/**
+		 * gets the path length variable s at the given way-point.
+		 * \param i way-point number
+		 */
+		double GetLengthToPoint(int i) const;
+
+		/**
+		 * gets an identifier indicating the type of this Path object
+		 */
+		virtual IdentifierType getIdentifier() const {
+			return ID_SPLINE;
+		}
+
+		virtual ~Path_Spline();
+	};
+
+}
+
+
+#endif
@@ -43,6 +43,7 @@
 #include "utilities/error_stack.h"
 #include "rotational_interpolation.hpp"
 #include "rotational_interpolation_sa.hpp"
+#include "binary_io.hpp"
 #include <memory>
 #include <cstring>
 
@@ -79,4 +80,14 @@ RotationalInterpolation* RotationalInterpolation::Read(std::istream& is) {
 	return NULL; // just to avoid the warning;
 }
 
+RotationalInterpolation* RotationalInterpolation::ReadBinary(BinaryReader& r) {
+	switch (r.PeekTag()) {
+		case BIN_ROTINTERP_SINGLEAXIS:
+			return RotationalInterpolation_SingleAxis::ReadBinary(r);
+		default:
+			throw Error_MotionIO_Binary(4);
+	}
+	return NULL; // just to avoid the warning;
+}
+
 }
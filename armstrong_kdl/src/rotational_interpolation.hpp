@@ -49,6 +49,9 @@
 
 namespace ARMstrongKDL {
 
+class BinaryWriter;
+class BinaryReader;
+
 /**
  * RotationalInterpolation specifies the rotational part of a geometric trajectory
  * -   The different derived objects specify different methods for interpolating
@@ -104,6 +107,19 @@ class RotationalInterpolation
 		 */
 		static RotationalInterpolation* Read(std::istream& is);
 
+		/**
+		 * Writes one of the derived objects in the binary format
+		 * \sa BinaryWriter
+		 */
+		virtual void WriteBinary(BinaryWriter& w) const = 0;
+
+		/**
+		 * Reads one of the derived objects from the binary format and returns a pointer
+		 * (factory method)
+		 * \sa BinaryReader
+		 */
+		static RotationalInterpolation* ReadBinary(BinaryReader& r);
+
 		/**
 		 * virtual constructor,  construction by copying ..
 		 */
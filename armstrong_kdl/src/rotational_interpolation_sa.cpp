@@ -42,6 +42,7 @@
 
 #include "rotational_interpolation_sa.hpp"
 #include "trajectory.hpp"
+#include "binary_io.hpp"
 
 namespace ARMstrongKDL {
 
@@ -84,5 +85,15 @@ RotationalInterpolation* RotationalInterpolation_SingleAxis::Clone() const {
 	return new RotationalInterpolation_SingleAxis();
 }
 
+// the start and end rotation are not part of the persistent state :
+void RotationalInterpolation_SingleAxis::WriteBinary(BinaryWriter& w) const {
+	w.WriteUInt(BIN_ROTINTERP_SINGLEAXIS);
+}
+
+RotationalInterpolation* RotationalInterpolation_SingleAxis::ReadBinary(BinaryReader& r) {
+	r.ExpectTag(BIN_ROTINTERP_SINGLEAXIS);
+	return new RotationalInterpolation_SingleAxis();
+}
+
 }
 
@@ -74,6 +74,8 @@ class RotationalInterpolation_SingleAxis: public RotationalInterpolation
 		virtual Vector Vel(double th,double thd) const;
 		virtual Vector Acc(double th,double thd,double thdd)   const;
 		virtual void Write(std::ostream& os) const;
+		virtual void WriteBinary(BinaryWriter& w) const;
+		static RotationalInterpolation* ReadBinary(BinaryReader& r);
 		virtual RotationalInterpolation* Clone() const;
 		virtual ~RotationalInterpolation_SingleAxis();
 	};
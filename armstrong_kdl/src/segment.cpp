@@ -59,6 +59,12 @@ namespace ARMstrongKDL {
         return joint.pose(q)*f_tip;
     }
 
+    void Segment::applyPose(Frame& F,const double& q)const
+    {
+        joint.applyPose(F,q);
+        F = F*f_tip;
+    }
+
     Twist Segment::twist(const double& q, const double& qdot)const
     {
         return joint.twist(qdot).RefPoint(joint.pose(q).M * f_tip.p);
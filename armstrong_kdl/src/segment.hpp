@@ -86,6 +86,14 @@ namespace ARMstrongKDL {
          * @return pose from the root to the tip of the segment
          */
         Frame pose(const double& q)const;
+        /**
+         * Multiplies F on the right with the pose of the segment,
+         * i.e. F = F*pose(q), see Joint::applyPose.
+         *
+         * @param F the frame to compose with, replaced by the result
+         * @param q 1D position of the joint
+         */
+        void applyPose(Frame& F,const double& q)const;
         /**
          * Request the 6D-velocity of the tip of the segment, given
          * the joint position q and the joint velocity qdot.
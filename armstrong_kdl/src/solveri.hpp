@@ -104,7 +104,9 @@ public:
     //! Not yet implemented
         E_NOT_IMPLEMENTED = -7,
     //! Internal svd calculation failed
-        E_SVD_FAILED = -8
+        E_SVD_FAILED = -8,
+    //! Time budget exceeded
+        E_TIME_BUDGET_EXCEEDED = -9
     };
 
 	/// Initialize latest error to E_NOERROR
@@ -134,6 +136,7 @@ public:
 		else if (E_OUT_OF_RANGE == error) return "The requested index is out of range";
 		else if (E_NOT_IMPLEMENTED == error) return "The requested function is not yet implemented";
 		else  if (E_SVD_FAILED == error) return "SVD failed";
+		else if (E_TIME_BUDGET_EXCEEDED == error) return "The time budget is exceeded";
 		else return "UNKNOWN ERROR";
 	}
 
@@ -46,6 +46,9 @@
 #include "trajectory.hpp"
 #include "path.hpp"
 #include "trajectory_segment.hpp"
+#include "trajectory_composite.hpp"
+#include "trajectory_stationary.hpp"
+#include "binary_io.hpp"
 
 #include <memory>
 #include <cstring>
@@ -72,4 +75,18 @@ Trajectory* Trajectory::Read(std::istream& is) {
 	return NULL; // just to avoid the warning;
 }
 
+Trajectory* Trajectory::ReadBinary(BinaryReader& r) {
+	switch (r.PeekTag()) {
+		case BIN_TRAJ_SEGMENT:
+			return Trajectory_Segment::ReadBinary(r);
+		case BIN_TRAJ_COMPOSITE:
+			return Trajectory_Composite::ReadBinary(r);
+		case BIN_TRAJ_STATIONARY:
+			return Trajectory_Stationary::ReadBinary(r);
+		default:
+			throw Error_MotionIO_Binary(4);
+	}
+	return NULL; // just to avoid the warning;
+}
+
 }
@@ -66,7 +66,8 @@
 
 namespace ARMstrongKDL {
 
-
+	class BinaryWriter;
+	class BinaryReader;
 
 
 	/**
@@ -92,6 +93,10 @@ namespace ARMstrongKDL {
 		virtual Trajectory* Clone() const = 0;
 		virtual void Write(std::ostream& os) const = 0;
 		static Trajectory* Read(std::istream& is);
+		virtual void WriteBinary(BinaryWriter& w) const = 0;
+		// Writes the complete state of the trajectory in the binary format.
+		static Trajectory* ReadBinary(BinaryReader& r);
+		// Reads a trajectory from the binary format, see BinaryReader.
 		virtual ~Trajectory() {}
 		// note : you cannot declare this destructor abstract
 		// it is always called by the descendant's destructor !
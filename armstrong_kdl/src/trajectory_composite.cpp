@@ -15,6 +15,8 @@
 
 #include "trajectory_composite.hpp"
 #include "path_composite.hpp"
+#include "binary_io.hpp"
+#include "utilities/scoped_ptr.hpp"
 
 namespace ARMstrongKDL {
 
@@ -113,6 +115,24 @@ namespace ARMstrongKDL {
         os << "]" << std::endl;
     }
 
+    void Trajectory_Composite::WriteBinary(BinaryWriter& w) const {
+        w.WriteUInt(BIN_TRAJ_COMPOSITE);
+        w.WriteUInt(vt.size());
+        for (unsigned int i=0;i<vt.size();i++) {
+            vt[i]->WriteBinary(w);
+        }
+    }
+
+    Trajectory* Trajectory_Composite::ReadBinary(BinaryReader& r) {
+        r.ExpectTag(BIN_TRAJ_COMPOSITE);
+        scoped_ptr<Trajectory_Composite> comp( new Trajectory_Composite() );
+        unsigned int size = r.ReadUInt();
+        for (unsigned int i=0;i<size;i++) {
+            comp->Add(Trajectory::ReadBinary(r));
+        }
+        return comp.release();
+    }
+
     Trajectory* Trajectory_Composite::Clone() const{
         Trajectory_Composite* comp = new Trajectory_Composite();
         for (unsigned int i = 0; i < vt.size(); ++i) {
@@ -52,6 +52,8 @@ class Trajectory_Composite: public Trajectory
 
 		virtual void Destroy();
 		virtual void Write(std::ostream& os) const;
+		virtual void WriteBinary(BinaryWriter& w) const;
+		static Trajectory* ReadBinary(BinaryReader& r);
 		virtual Trajectory* Clone() const;
 
 		virtual ~Trajectory_Composite();
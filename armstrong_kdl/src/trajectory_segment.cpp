@@ -41,6 +41,8 @@
 
 
 #include "trajectory_segment.hpp"
+#include "binary_io.hpp"
+#include "utilities/scoped_ptr.hpp"
 
 
 namespace ARMstrongKDL {
@@ -89,6 +91,21 @@ void Trajectory_Segment::Write(std::ostream& os) const
 	os << "]";
 }
 
+void Trajectory_Segment::WriteBinary(BinaryWriter& w) const
+{
+	w.WriteUInt(BIN_TRAJ_SEGMENT);
+	geom->WriteBinary(w);
+	motprof->WriteBinary(w);
+}
+
+Trajectory* Trajectory_Segment::ReadBinary(BinaryReader& r)
+{
+	r.ExpectTag(BIN_TRAJ_SEGMENT);
+	scoped_ptr<Path>            geom(    Path::ReadBinary(r)            );
+	scoped_ptr<VelocityProfile> motprof( VelocityProfile::ReadBinary(r) );
+	return new Trajectory_Segment(geom.release(),motprof.release());
+}
+
 Trajectory_Segment::~Trajectory_Segment()
 {
     if (aggregate)
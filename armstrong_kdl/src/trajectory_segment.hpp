@@ -95,6 +95,8 @@ namespace ARMstrongKDL {
 			}
 
 		virtual void Write(std::ostream& os) const;
+		virtual void WriteBinary(BinaryWriter& w) const;
+		static Trajectory* ReadBinary(BinaryReader& r);
 
 	    virtual Path* GetPath();
 
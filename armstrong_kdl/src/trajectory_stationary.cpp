@@ -15,6 +15,7 @@
 
 
 #include "trajectory_stationary.hpp"
+#include "binary_io.hpp"
 
 namespace ARMstrongKDL {
 
@@ -24,4 +25,16 @@ void Trajectory_Stationary::Write(std::ostream& os) const {
 	os << "]";
 }
 
+void Trajectory_Stationary::WriteBinary(BinaryWriter& w) const {
+    w.WriteUInt(BIN_TRAJ_STATIONARY);
+    w.WriteDouble(duration);
+    w.WriteFrame(pos);
+}
+
+Trajectory* Trajectory_Stationary::ReadBinary(BinaryReader& r) {
+    r.ExpectTag(BIN_TRAJ_STATIONARY);
+    double duration = r.ReadDouble();
+    return new Trajectory_Stationary(duration,r.ReadFrame());
+}
+
 }
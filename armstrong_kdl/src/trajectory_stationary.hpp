@@ -45,6 +45,8 @@ namespace ARMstrongKDL {
 			return Twist::Zero();
 		}
 		virtual void Write(std::ostream& os) const;
+		virtual void WriteBinary(BinaryWriter& w) const;
+		static Trajectory* ReadBinary(BinaryReader& r);
 
 		virtual Trajectory* Clone() const {
 			return new Trajectory_Stationary(duration,pos);
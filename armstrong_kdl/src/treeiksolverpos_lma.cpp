@@ -0,0 +1,287 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "treeiksolverpos_lma.hpp"
+#include <algorithm>
+
+namespace ARMstrongKDL {
+
+    TreeIkSolverPos_LMA::TreeIkSolverPos_LMA(const Tree& _tree, const std::vector<std::string>& _endpoints,
+                                             double _eps, unsigned int _maxiter, double _eps_joints) :
+        tree(_tree),
+        endpoint_names(_endpoints),
+        nj(0),
+        ns(0),
+        eps(_eps),
+        maxiter(_maxiter),
+        eps_joints(_eps_joints),
+        endpoints_valid(false),
+        limits(false),
+        weights(_endpoints.size(),Eigen::Matrix<double,6,1>::Ones()),
+        goals(_endpoints.size(),Frame::Identity()),
+        active(_endpoints.size(),false),
+        nr_iterations(0),
+        difference(0.0)
+    {
+        for (unsigned int k=0;k<endpoint_names.size();k++)
+            endpoint_index[endpoint_names[k]] = k;
+        updateInternalDataStructures();
+    }
+
+    TreeIkSolverPos_LMA::~TreeIkSolverPos_LMA()
+    {
+    }
+
+    void TreeIkSolverPos_LMA::addSegments(SegmentMap::const_iterator it, int parent,
+                                          std::map<std::string,unsigned int>& index)
+    {
+        unsigned int i = segments.size();
+        const Segment& segment = GetTreeElementSegment(it->second);
+        segments.push_back(&segment);
+        parents.push_back(parent);
+        q_nrs.push_back(GetTreeElementQNr(it->second));
+        has_joint.push_back(parent >= 0 && segment.getJoint().getType() != Joint::Fixed);
+        index[it->first] = i;
+        const std::vector<SegmentMap::const_iterator>& children = GetTreeElementChildren(it->second);
+        for (unsigned int c=0;c<children.size();c++)
+            addSegments(children[c],i,index);
+    }
+
+    void TreeIkSolverPos_LMA::updateInternalDataStructures()
+    {
+        nj = tree.getNrOfJoints();
+        ns = tree.getNrOfSegments();
+
+        segments.clear();
+        parents.clear();
+        q_nrs.clear();
+        has_joint.clear();
+        std::map<std::string,unsigned int> index;
+        addSegments(tree.getRootSegment(),-1,index);
+
+        // only the segments on the way to an endpoint are swept
+        const unsigned int nk = endpoint_names.size();
+        std::vector<bool> needed(segments.size(),false);
+        endpoint_segments.assign(nk,0);
+        endpoint_joints.assign(nk,std::vector<unsigned int>());
+        endpoints_valid = true;
+        for (unsigned int k=0;k<nk;k++) {
+            std::map<std::string,unsigned int>::const_iterator it = index.find(endpoint_names[k]);
+            if (it == index.end()) {
+                endpoints_valid = false;
+                continue;
+            }
+            endpoint_segments[k] = it->second;
+            for (int s=it->second;s>0;s=parents[s]) {
+                needed[s] = true;
+                if (has_joint[s])
+                    endpoint_joints[k].push_back(s);
+            }
+        }
+        sweep_order.clear();
+        for (unsigned int s=1;s<segments.size();s++)
+            if (needed[s])
+                sweep_order.push_back(s);
+
+        T_base.assign(segments.size(),Frame::Identity());
+        joint_twists.assign(segments.size(),Twist::Zero());
+
+        jac.setZero(6*nk,nj);
+        e.setZero(6*nk);
+        e_new.setZero(6*nk);
+        q.setZero(nj);
+        q_new.setZero(nj);
+        dq.setZero(nj);
+        grad.setZero(nj);
+        A.setZero(nj,nj);
+        ldlt = Eigen::LDLT<Eigen::MatrixXd>(nj);
+        if (q_min.size() != nj) {
+            limits = false;
+            q_min.resize(nj);
+            q_max.resize(nj);
+        }
+    }
+
+    int TreeIkSolverPos_LMA::setEndpointWeight(const std::string& endpoint, const Eigen::Matrix<double,6,1>& L)
+    {
+        std::map<std::string,unsigned int>::const_iterator it = endpoint_index.find(endpoint);
+        if (it == endpoint_index.end())
+            return (error = E_UNKNOWN_ENDPOINT);
+        weights[it->second] = L;
+        return (error = E_NOERROR);
+    }
+
+    int TreeIkSolverPos_LMA::setJointLimits(const JntArray& _q_min, const JntArray& _q_max)
+    {
+        if (_q_min.rows() != nj || _q_max.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+        q_min = _q_min.data;
+        q_max = _q_max.data;
+        limits = true;
+        return (error = E_NOERROR);
+    }
+
+    void TreeIkSolverPos_LMA::sweep(const Eigen::VectorXd& q_in)
+    {
+        // the parents come before their children
+        for (unsigned int i=0;i<sweep_order.size();i++) {
+            const unsigned int s = sweep_order[i];
+            const Frame& T_parent = T_base[parents[s]];
+            const double q_s = has_joint[s] ? q_in(q_nrs[s]) : 0.0;
+            T_base[s] = T_parent;
+            segments[s]->applyPose(T_base[s],q_s);
+            // twist of the tip of the segment for a unit joint velocity,
+            // expressed in the base
+            if (has_joint[s])
+                joint_twists[s] = T_parent.M*segments[s]->twist(q_s,1.0);
+        }
+    }
+
+    void TreeIkSolverPos_LMA::computeError(Eigen::VectorXd& e_out) const
+    {
+        for (unsigned int k=0;k<endpoint_segments.size();k++) {
+            if (!active[k]) {
+                e_out.segment<6>(6*k).setZero();
+                continue;
+            }
+            Twist d = diff(T_base[endpoint_segments[k]],goals[k]);
+            for (unsigned int r=0;r<6;r++)
+                e_out(6*k+r) = weights[k](r)*d(r);
+        }
+    }
+
+    void TreeIkSolverPos_LMA::computeJacobian()
+    {
+        for (unsigned int k=0;k<endpoint_segments.size();k++) {
+            if (!active[k])
+                continue;
+            const Vector& p_end = T_base[endpoint_segments[k]].p;
+            const std::vector<unsigned int>& joints = endpoint_joints[k];
+            for (unsigned int i=0;i<joints.size();i++) {
+                const unsigned int s = joints[i];
+                Twist t = joint_twists[s].RefPoint(p_end-T_base[s].p);
+                for (unsigned int r=0;r<6;r++)
+                    jac(6*k+r,q_nrs[s]) = weights[k](r)*t(r);
+            }
+        }
+    }
+
+    void TreeIkSolverPos_LMA::clip(Eigen::VectorXd& q_io) const
+    {
+        if (limits)
+            q_io = q_io.cwiseMax(q_min).cwiseMin(q_max);
+    }
+
+    double TreeIkSolverPos_LMA::CartToJnt(const JntArray& q_init, const Frames& p_in, JntArray& q_out)
+    {
+        if (nj != tree.getNrOfJoints() || ns != tree.getNrOfSegments())
+            return (error = E_NOT_UP_TO_DATE);
+        if (q_init.rows() != nj || q_out.rows() != nj)
+            return (error = E_SIZE_MISMATCH);
+        if (!endpoints_valid)
+            return (error = E_UNKNOWN_ENDPOINT);
+
+        std::fill(active.begin(),active.end(),false);
+        for (Frames::const_iterator f_it=p_in.begin();f_it!=p_in.end();++f_it) {
+            std::map<std::string,unsigned int>::const_iterator it = endpoint_index.find(f_it->first);
+            if (it == endpoint_index.end())
+                return (error = E_UNKNOWN_ENDPOINT);
+            goals[it->second] = f_it->second;
+            active[it->second] = true;
+        }
+        // the columns of the joints that do not move an active endpoint
+        // stay zero
+        jac.setZero();
+
+        q = q_init.data;
+        clip(q);
+        sweep(q);
+        computeError(e);
+        double e_norm = e.norm();
+        nr_iterations = 0;
+        if (e_norm < eps) {
+            q_out.data = q;
+            difference = e_norm;
+            error = E_NOERROR;
+            return difference;
+        }
+        computeJacobian();
+
+        double lambda = 10.0;
+        double v = 2.0;
+        for (unsigned int i=0;i<maxiter;i++) {
+            nr_iterations = i+1;
+            // (J'*J + lambda*I)*dq = J'*e
+            grad.noalias() = jac.transpose()*e;
+            A.noalias() = jac.transpose()*jac;
+            A.diagonal().array() += lambda;
+            ldlt.compute(A);
+            dq = ldlt.solve(grad);
+
+            if (grad.squaredNorm() < eps_joints*eps_joints) {
+                q_out.data = q;
+                difference = e_norm;
+                return (error = E_GRADIENT_JOINTS_TOO_SMALL);
+            }
+
+            q_new = q+dq;
+            clip(q_new);
+            dq = q_new-q;
+            if (dq.lpNorm<Eigen::Infinity>() < eps_joints) {
+                q_out.data = q;
+                difference = e_norm;
+                return (error = E_INCREMENT_JOINTS_TOO_SMALL);
+            }
+
+            // decrease of E predicted by the linearization, for the step
+            // after clipping to the joint limits
+            double predicted = 2.0*dq.dot(grad)-(jac*dq).squaredNorm();
+            sweep(q_new);
+            computeError(e_new);
+            double e_new_norm = e_new.norm();
+            double rho = (e_norm*e_norm-e_new_norm*e_new_norm)/predicted;
+            if (predicted > 0.0 && rho > 0.0) {
+                q = q_new;
+                e = e_new;
+                e_norm = e_new_norm;
+                if (e_norm < eps) {
+                    q_out.data = q;
+                    difference = e_norm;
+                    error = E_NOERROR;
+                    return difference;
+                }
+                computeJacobian();
+                double tmp = 2*rho-1;
+                lambda = lambda*std::max(1/3.0,1-tmp*tmp*tmp);
+                v = 2.0;
+            }
+            else {
+                lambda = lambda*v;
+                v = 2*v;
+            }
+        }
+        q_out.data = q;
+        difference = e_norm;
+        return (error = E_MAX_ITERATIONS_EXCEEDED);
+    }
+
+    const char* TreeIkSolverPos_LMA::strError(const int error) const
+    {
+        if (E_GRADIENT_JOINTS_TOO_SMALL == error) return "The gradient of E towards the joints is to small";
+        else if (E_INCREMENT_JOINTS_TOO_SMALL == error) return "The joint position increments are to small";
+        else if (E_UNKNOWN_ENDPOINT == error) return "A goal is not one of the endpoints of the solver";
+        else return SolverI::strError(error);
+    }
+
+}//namespace
@@ -0,0 +1,165 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDLTREEIKSOLVERPOS_LMA_HPP
+#define KDLTREEIKSOLVERPOS_LMA_HPP
+
+#include "treeiksolver.hpp"
+#include "solveri.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Cholesky>
+#include <vector>
+#include <string>
+#include <map>
+
+namespace ARMstrongKDL {
+
+/**
+ * \brief Inverse position kinematics of a ARMstrongKDL::Tree with several
+ * endpoints, solved for all endpoints at once with Levenberg-Marquardt.
+ *
+ * The tree is flattened in the constructor, so an iteration needs no
+ * lookups by name : one sweep from the root computes the frames of all
+ * segments on the way to an endpoint, and the jacobians of all endpoints
+ * are stacked from the joint twists of that sweep.  The solver minimizes
+ *
+ *   E = sum_k |L_k*diff(T_k(q),T_k,goal)|^2
+ *
+ * over the endpoints k that have a goal, with L_k a diagonal weight, see
+ * setEndpointWeight().  The damping is adapted as in ChainIkSolverPos_LMA.
+ * Optional joint limits are applied to every step.
+ *
+ * @ingroup KinematicFamily
+ */
+class TreeIkSolverPos_LMA: public TreeIkSolverPos, public SolverI {
+public:
+    static const int E_GRADIENT_JOINTS_TOO_SMALL = -100;
+    static const int E_INCREMENT_JOINTS_TOO_SMALL = -101;
+    static const int E_UNKNOWN_ENDPOINT = -102;
+
+    /**
+     * Constructor of the solver.
+     *
+     * @param tree the tree to calculate the inverse position for, a
+     * reference is kept.
+     * @param endpoints the segments that can have a goal
+     * @param eps the precision on E, used to end the iterations,
+     * default: 1e-5
+     * @param maxiter the maximum number of iterations, default: 500
+     * @param eps_joints the iterations stop when the joint increments
+     * are smaller, default: 1e-15
+     */
+    TreeIkSolverPos_LMA(const Tree& tree, const std::vector<std::string>& endpoints,
+                        double eps=1e-5, unsigned int maxiter=500, double eps_joints=1e-15);
+    ~TreeIkSolverPos_LMA();
+
+    /**
+     * Calculates the joint positions for which the endpoints in \a p_in
+     * reach their goals, the other endpoints are not taken into account.
+     *
+     * @return the remaining (weighted) distance sqrt(E) if the goals are
+     *         reached, otherwise a negative error code:
+     *         E_MAX_ITERATIONS_EXCEEDED, E_GRADIENT_JOINTS_TOO_SMALL,
+     *         E_INCREMENT_JOINTS_TOO_SMALL, E_UNKNOWN_ENDPOINT if a goal
+     *         is not one of the endpoints, E_SIZE_MISMATCH,
+     *         E_NOT_UP_TO_DATE.
+     */
+    virtual double CartToJnt(const JntArray& q_init, const Frames& p_in, JntArray& q_out);
+
+    /**
+     * Sets the "square root" of the diagonal weight of an endpoint, the
+     * first three elements weigh the translation, the last three the
+     * rotation.  Default: all ones.
+     *
+     * @return E_UNKNOWN_ENDPOINT if endpoint is not one of the endpoints
+     */
+    int setEndpointWeight(const std::string& endpoint, const Eigen::Matrix<double,6,1>& L);
+
+    /**
+     * Sets joint limits, every step is clipped to them.
+     *
+     * @return E_SIZE_MISMATCH if the sizes do not match the tree
+     */
+    int setJointLimits(const JntArray& q_min, const JntArray& q_max);
+
+    /// Number of iterations of the last call of CartToJnt()
+    unsigned int getNrIterations() const { return nr_iterations; }
+
+    /// Remaining (weighted) distance sqrt(E) after the last call of CartToJnt()
+    double getDifference() const { return difference; }
+
+    /// @copydoc ARMstrongKDL::SolverI::updateInternalDataStructures
+    virtual void updateInternalDataStructures();
+
+    /// @copydoc ARMstrongKDL::SolverI::strError()
+    virtual const char* strError(const int error) const;
+
+private:
+    void addSegments(SegmentMap::const_iterator it, int parent, std::map<std::string,unsigned int>& index);
+    void sweep(const Eigen::VectorXd& q_in);
+    void computeError(Eigen::VectorXd& e_out) const;
+    void computeJacobian();
+    void clip(Eigen::VectorXd& q_io) const;
+
+    const Tree& tree;
+    std::vector<std::string> endpoint_names;
+    std::map<std::string,unsigned int> endpoint_index;
+    unsigned int nj;
+    unsigned int ns;
+    double eps;
+    unsigned int maxiter;
+    double eps_joints;
+    bool endpoints_valid;
+    bool limits;
+    Eigen::VectorXd q_min;
+    Eigen::VectorXd q_max;
+
+    // the tree in the order of a depth first sweep, index 0 is the root
+    std::vector<const Segment*> segments;
+    std::vector<int> parents;
+    std::vector<unsigned int> q_nrs;
+    std::vector<bool> has_joint;
+    // the segments on the way to an endpoint, without the root
+    std::vector<unsigned int> sweep_order;
+
+    // per endpoint: its segment, the segments with a joint on its way
+    // from the root, its weight and its goal
+    std::vector<unsigned int> endpoint_segments;
+    std::vector<std::vector<unsigned int> > endpoint_joints;
+    std::vector<Eigen::Matrix<double,6,1> > weights;
+    std::vector<Frame> goals;
+    std::vector<bool> active;
+
+    // state of a sweep
+    std::vector<Frame> T_base;
+    std::vector<Twist> joint_twists;
+
+    Eigen::MatrixXd jac;
+    Eigen::VectorXd e;
+    Eigen::VectorXd e_new;
+    Eigen::VectorXd q;
+    Eigen::VectorXd q_new;
+    Eigen::VectorXd dq;
+    Eigen::VectorXd grad;
+    Eigen::MatrixXd A;
+    Eigen::LDLT<Eigen::MatrixXd> ldlt;
+
+    unsigned int nr_iterations;
+    double difference;
+};
+
+}
+
+#endif
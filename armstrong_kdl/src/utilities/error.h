@@ -158,6 +158,20 @@ public:
     virtual const char* Description() const { return "Trajectory type keyword not known";}
     virtual int GetType() const {return 2002;}
 };
+class Error_MotionIO_Binary : public Error_MotionIO {
+    int reason;
+public:
+    Error_MotionIO_Binary(int _reason):reason(_reason) {}
+    virtual const char* Description() const {
+        switch (reason) {
+            case 1: return "Binary motion data : wrong header";
+            case 2: return "Binary motion data : unsupported version";
+            case 3: return "Binary motion data : unexpected end of data";
+            default: return "Binary motion data : unexpected type tag";
+        }
+    }
+    virtual int GetType() const {return 2010+reason;}
+};
 
 class Error_MotionPlanning : public Error {};
 
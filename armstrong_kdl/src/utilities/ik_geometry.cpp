@@ -0,0 +1,119 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "ik_geometry.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ARMstrongKDL
+{
+    namespace ik_geometry
+    {
+        bool JointAxesAtZero(const Chain& chain,Vector* axis,Vector* point,
+                             double* scale,double* offset,Frame& tip_zero)
+        {
+            Frame T = Frame::Identity();
+            unsigned int j=0;
+            for (unsigned int i=0;i<chain.getNrOfSegments();++i) {
+                const Segment& segment = chain.getSegment(i);
+                const Joint& joint = segment.getJoint();
+                double q = 0.0;
+                switch(joint.getType()){
+                case Joint::RotAxis:
+                case Joint::RotX:
+                case Joint::RotY:
+                case Joint::RotZ:
+                    if (joint.getScale()==0.0)
+                        return false;
+                    scale[j] = joint.getScale();
+                    offset[j] = joint.getOffset();
+                    axis[j] = T.M*joint.JointAxis();
+                    axis[j].Normalize();
+                    point[j] = T*joint.JointOrigin();
+                    q = -offset[j]/scale[j];
+                    j++;
+                    break;
+                case Joint::Fixed:
+                    break;
+                default:
+                    return false;
+                }
+                T = T*segment.pose(q);
+            }
+            tip_zero = T;
+            return true;
+        }
+
+        double RotationAngle(const Vector& w,const Vector& u,const Vector& v)
+        {
+            Vector u_perp = u-w*dot(w,u);
+            Vector v_perp = v-w*dot(w,v);
+            return atan2(dot(w,u_perp*v_perp),dot(u_perp,v_perp));
+        }
+
+        bool NearestPoints(const Vector& c_a,const Vector& w_a,const Vector& c_b,const Vector& w_b,
+                           double& t_a,double& t_b)
+        {
+            Vector d = c_b-c_a;
+            double b = dot(w_a,w_b);
+            double den = 1.0-b*b;
+            if (den<1e-12)
+                return false;
+            t_a = (dot(w_a,d)-b*dot(w_b,d))/den;
+            t_b = (b*dot(w_a,d)-dot(w_b,d))/den;
+            return true;
+        }
+
+        double LineDistance(const Vector& c,const Vector& w,const Vector& x)
+        {
+            Vector d = x-c;
+            return (d-w*dot(w,d)).Norm();
+        }
+
+        int SolveCosSin(double a,double b,double r,double x[2])
+        {
+            double n = sqrt(a*a+b*b);
+            if (n==0.0 || fabs(r)>n*(1.0+1e-12))
+                return 0;
+            double phi = atan2(b,a);
+            double c = std::max(-1.0,std::min(1.0,r/n));
+            double delta = acos(c);
+            x[0] = phi+delta;
+            if (delta<1e-12)
+                return 1;
+            x[1] = phi-delta;
+            return 2;
+        }
+
+        bool Spherical(const Vector& wa,const Vector& wb,const Vector& wc,const Rotation& R,
+                       int sign,double th[3])
+        {
+            Vector t = R*wc;
+            double b = dot(wa,wb);
+            double alpha = (dot(wa,t)-b*dot(wb,wc))/(1.0-b*b);
+            double beta = (dot(wb,wc)-b*dot(wa,t))/(1.0-b*b);
+            Vector wab = wa*wb;
+            double gamma2 = (1.0-alpha*alpha-beta*beta-2.0*alpha*beta*b)/dot(wab,wab);
+            if (gamma2<-1e-9)
+                return false;
+            Vector c = wa*alpha+wb*beta+wab*(sign*sqrt(std::max(gamma2,0.0)));
+            th[1] = RotationAngle(wb,wc,c);
+            th[0] = RotationAngle(wa,c,t);
+            Rotation Rc = (Rotation::Rot2(wa,th[0])*Rotation::Rot2(wb,th[1])).Inverse()*R;
+            Vector v = wb-wc*dot(wb,wc);
+            th[2] = RotationAngle(wc,v,Rc*v);
+            return true;
+        }
+    }
+}
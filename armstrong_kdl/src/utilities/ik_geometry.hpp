@@ -0,0 +1,68 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_IK_GEOMETRY_HPP
+#define KDL_IK_GEOMETRY_HPP
+
+#include "../chain.hpp"
+#include "../frames.hpp"
+
+namespace ARMstrongKDL
+{
+    /**
+     * Geometry shared by the analytical position solvers
+     * ChainIkSolverPos_Pieper and ChainIkSolverPos_SRS.
+     */
+    namespace ik_geometry
+    {
+        /**
+         * The axes of the revolute joints of a chain with all joint
+         * angles zero, in the base.  The arrays should have an element
+         * per joint.
+         *
+         * @return false if the chain has other joints, or joints with a
+         *         zero scale
+         */
+        bool JointAxesAtZero(const Chain& chain,Vector* axis,Vector* point,
+                             double* scale,double* offset,Frame& tip_zero);
+
+        /// Angle of the rotation about the unit axis w that takes u to v,
+        /// only the components of u and v perpendicular to w are used
+        double RotationAngle(const Vector& w,const Vector& u,const Vector& v);
+
+        /// Parameters of the points on two lines that are nearest to each
+        /// other, returns false if the lines are parallel
+        bool NearestPoints(const Vector& c_a,const Vector& w_a,const Vector& c_b,const Vector& w_b,
+                           double& t_a,double& t_b);
+
+        /// Distance of x to the line through c along the unit vector w
+        double LineDistance(const Vector& c,const Vector& w,const Vector& x);
+
+        /// Solutions of a*cos(x)+b*sin(x) = r, one where the solutions
+        /// coincide, @return their number
+        int SolveCosSin(double a,double b,double r,double x[2]);
+
+        /**
+         * R = Rot(wa,th[0])*Rot(wb,th[1])*Rot(wc,th[2]) for unit axes
+         * through one point, successive axes not parallel.  The sign
+         * selects one of the two solutions.
+         *
+         * @return false if R can not be reached
+         */
+        bool Spherical(const Vector& wa,const Vector& wb,const Vector& wc,const Rotation& R,
+                       int sign,double th[3]);
+    }
+}
+
+#endif
@@ -0,0 +1,396 @@
+
+/*****************************************************************************
+ * \file
+ *      class for automatic differentiation on scalar values and their 1st
+ *      derivatives towards N variables at once.
+ *
+ *  \par Note
+ *      Rall1d<double> propagates one directional derivative.  Obtaining
+ *      the derivatives towards N variables with Rall1d requires either N
+ *      evaluations, or nesting Rall1d objects (see RallNd), which gives
+ *      2^N scalars per number.  Rall1dN keeps a flat, fixed size array of
+ *      N tangents, so every operation is one scalar operation plus one
+ *      vectorized operation on the tangents.
+ ****************************************************************************/
+
+#ifndef Rall1DN_H
+#define Rall1DN_H
+#include <Eigen/Core>
+#include "utility.h"
+
+namespace ARMstrongKDL {
+/**
+ * Rall1dN contains a value and its derivatives towards N variables, and
+ * defines the same algebraic structure and mathematical functions as
+ * Rall1d<double>.
+ *
+ * It can be used as the scalar type of the classes of framescalar.hpp and
+ * of the solvers that are templated on the scalar type, e.g. with
+ * q(j) = Rall1dN<N>::Variable(q_j,j) the gradient of the result of
+ * ChainFkSolverPosT<Rall1dN<N> > contains the derivatives towards all
+ * joints.
+ *
+ * \par Class Type
+ * Concrete implementation
+ */
+template <int N>
+class Rall1dN
+    {
+    public:
+        typedef double valuetype;
+        typedef Eigen::Array<double,N,1> gradienttype;
+        typedef double scalartype;
+    public :
+        double t;           //!< value
+        gradienttype grad;  //!< derivatives towards the N variables
+    public :
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        INLINE Rall1dN():t(0.0),grad(gradienttype::Zero()) {}
+
+        explicit INLINE Rall1dN(double c):t(c),grad(gradienttype::Zero()) {}
+
+        INLINE Rall1dN(double tn,const gradienttype& afg):t(tn),grad(afg) {}
+
+        //! variable i of the N variables, with value c
+        INLINE static Rall1dN<N> Variable(double c,int i) {
+            Rall1dN<N> tmp(c);
+            tmp.grad(i) = 1.0;
+            return tmp;
+        }
+
+        double value() const {
+            return t;
+        }
+        const gradienttype& deriv() const {
+            return grad;
+        }
+
+        INLINE double& Value() {
+            return t;
+        }
+
+        INLINE gradienttype& Gradient() {
+            return grad;
+        }
+
+        INLINE static Rall1dN<N> Zero() {
+            return Rall1dN<N>();
+        }
+        INLINE static Rall1dN<N> Identity() {
+            return Rall1dN<N>(1.0);
+        }
+
+        INLINE Rall1dN<N>& operator =(double c)
+            {t=c;grad.setZero();return *this;}
+
+        INLINE Rall1dN<N>& operator /=(const Rall1dN<N>& rhs)
+            {
+            grad = (rhs.t*grad-t*rhs.grad) / (rhs.t*rhs.t);
+            t     /= rhs.t;
+            return *this;
+            }
+
+        INLINE Rall1dN<N>& operator *=(const Rall1dN<N>& rhs)
+            {
+            grad = rhs.t*grad+t*rhs.grad;
+            t *= rhs.t;
+            return *this;
+            }
+
+        INLINE Rall1dN<N>& operator +=(const Rall1dN<N>& rhs)
+            {
+            grad +=rhs.grad;
+            t    +=rhs.t;
+            return *this;
+            }
+
+        INLINE Rall1dN<N>& operator -=(const Rall1dN<N>& rhs)
+            {
+            grad -= rhs.grad;
+            t     -= rhs.t;
+            return *this;
+            }
+
+        INLINE Rall1dN<N>& operator /=(double rhs)
+            {
+            grad /= rhs;
+            t    /= rhs;
+            return *this;
+            }
+
+        INLINE Rall1dN<N>& operator *=(double rhs)
+            {
+            grad *= rhs;
+            t    *= rhs;
+            return *this;
+            }
+
+        INLINE Rall1dN<N>& operator +=(double rhs)
+            {
+            t    += rhs;
+            return *this;
+            }
+
+        INLINE Rall1dN<N>& operator -=(double rhs)
+            {
+            t    -= rhs;
+            return *this;
+            }
+    };
+
+
+template <int N>
+INLINE  Rall1dN<N> operator /(const Rall1dN<N>& lhs,const Rall1dN<N>& rhs)
+    {
+    return Rall1dN<N>(lhs.t/rhs.t,(lhs.grad*rhs.t-lhs.t*rhs.grad)/(rhs.t*rhs.t));
+    }
+
+template <int N>
+INLINE  Rall1dN<N> operator *(const Rall1dN<N>& lhs,const Rall1dN<N>& rhs)
+    {
+    return Rall1dN<N>(lhs.t*rhs.t,rhs.t*lhs.grad+lhs.t*rhs.grad);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> operator +(const Rall1dN<N>& lhs,const Rall1dN<N>& rhs)
+    {
+    return Rall1dN<N>(lhs.t+rhs.t,lhs.grad+rhs.grad);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> operator -(const Rall1dN<N>& lhs,const Rall1dN<N>& rhs)
+    {
+    return Rall1dN<N>(lhs.t-rhs.t,lhs.grad-rhs.grad);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> operator -(const Rall1dN<N>& arg)
+    {
+    return Rall1dN<N>(-arg.t,-arg.grad);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> operator *(double s,const Rall1dN<N>& v)
+    {
+    return Rall1dN<N>(s*v.t,s*v.grad);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> operator *(const Rall1dN<N>& v,double s)
+    {
+    return Rall1dN<N>(v.t*s,v.grad*s);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> operator +(double s,const Rall1dN<N>& v)
+    {
+    return Rall1dN<N>(s+v.t,v.grad);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> operator +(const Rall1dN<N>& v,double s)
+    {
+    return Rall1dN<N>(v.t+s,v.grad);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> operator -(double s,const Rall1dN<N>& v)
+    {
+    return Rall1dN<N>(s-v.t,-v.grad);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> operator -(const Rall1dN<N>& v,double s)
+    {
+    return Rall1dN<N>(v.t-s,v.grad);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> operator /(double s,const Rall1dN<N>& v)
+    {
+    return Rall1dN<N>(s/v.t,(-s/(v.t*v.t))*v.grad);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> operator /(const Rall1dN<N>& v,double s)
+    {
+    return Rall1dN<N>(v.t/s,v.grad/s);
+    }
+
+
+template <int N>
+INLINE  Rall1dN<N> exp(const Rall1dN<N>& arg)
+    {
+    double v = ::exp(arg.t);
+    return Rall1dN<N>(v,v*arg.grad);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> log(const Rall1dN<N>& arg)
+    {
+    return Rall1dN<N>(::log(arg.t),arg.grad/arg.t);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> sin(const Rall1dN<N>& arg)
+    {
+    double sn,cs;
+    SinCos(arg.t,sn,cs);
+    return Rall1dN<N>(sn,cs*arg.grad);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> cos(const Rall1dN<N>& arg)
+    {
+    double sn,cs;
+    SinCos(arg.t,sn,cs);
+    return Rall1dN<N>(cs,-sn*arg.grad);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> tan(const Rall1dN<N>& arg)
+    {
+    double cs = ::cos(arg.t);
+    return Rall1dN<N>(::tan(arg.t),arg.grad/(cs*cs));
+    }
+
+template <int N>
+INLINE  Rall1dN<N> sinh(const Rall1dN<N>& arg)
+    {
+    return Rall1dN<N>(::sinh(arg.t),::cosh(arg.t)*arg.grad);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> cosh(const Rall1dN<N>& arg)
+    {
+    return Rall1dN<N>(::cosh(arg.t),::sinh(arg.t)*arg.grad);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> sqr(const Rall1dN<N>& arg)
+    {
+    return Rall1dN<N>(arg.t*arg.t,(2.0*arg.t)*arg.grad);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> pow(const Rall1dN<N>& arg,double m)
+    {
+    double v = ::pow(arg.t,m);
+    return Rall1dN<N>(v,(m*v/arg.t)*arg.grad);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> sqrt(const Rall1dN<N>& arg)
+    {
+    double v = ::sqrt(arg.t);
+    return Rall1dN<N>(v,(0.5/v)*arg.grad);
+    }
+
+template <int N>
+INLINE  Rall1dN<N> atan(const Rall1dN<N>& x)
+{
+    return Rall1dN<N>(::atan(x.t),x.grad/(1.0+x.t*x.t));
+}
+
+template <int N>
+INLINE  Rall1dN<N> hypot(const Rall1dN<N>& y,const Rall1dN<N>& x)
+{
+    double v = ::hypot(y.t,x.t);
+    return Rall1dN<N>(v,(x.t/v)*x.grad+(y.t/v)*y.grad);
+}
+
+template <int N>
+INLINE  Rall1dN<N> asin(const Rall1dN<N>& x)
+{
+    return Rall1dN<N>(::asin(x.t),x.grad/::sqrt(1.0-x.t*x.t));
+}
+
+template <int N>
+INLINE  Rall1dN<N> acos(const Rall1dN<N>& x)
+{
+    return Rall1dN<N>(::acos(x.t),-x.grad/::sqrt(1.0-x.t*x.t));
+}
+
+template <int N>
+INLINE  Rall1dN<N> abs(const Rall1dN<N>& x)
+{
+    double v = x.t<0.0 ? -1.0 : 1.0;
+    return Rall1dN<N>(v*x.t,v*x.grad);
+}
+
+template <int N>
+INLINE  double Norm(const Rall1dN<N>& value)
+{
+    return Norm(value.t);
+}
+
+template <int N>
+INLINE  Rall1dN<N> tanh(const Rall1dN<N>& arg)
+{
+    double cs = ::cosh(arg.t);
+    return Rall1dN<N>(::tanh(arg.t),arg.grad/(cs*cs));
+}
+
+template <int N>
+INLINE  Rall1dN<N> atan2(const Rall1dN<N>& y,const Rall1dN<N>& x)
+{
+    double v = x.t*x.t+y.t*y.t;
+    return Rall1dN<N>(::atan2(y.t,x.t),(x.t*y.grad-y.t*x.grad)/v);
+}
+
+
+template <int N>
+INLINE  Rall1dN<N> LinComb(double alfa,const Rall1dN<N>& a,
+    double beta,const Rall1dN<N>& b ) {
+        return Rall1dN<N>(alfa*a.t+beta*b.t,alfa*a.grad+beta*b.grad);
+}
+
+template <int N>
+INLINE  void LinCombR(double alfa,const Rall1dN<N>& a,
+    double beta,const Rall1dN<N>& b,Rall1dN<N>& result ) {
+            result.t = alfa*a.t+beta*b.t;
+            result.grad = alfa*a.grad+beta*b.grad;
+}
+
+
+template <int N>
+INLINE  void SetToZero(Rall1dN<N>& value)
+    {
+    value.grad.setZero();
+    value.t = 0.0;
+    }
+template <int N>
+INLINE  void SetToIdentity(Rall1dN<N>& value)
+    {
+    value.t = 1.0;
+    value.grad.setZero();
+    }
+
+template <int N>
+INLINE  bool Equal(const Rall1dN<N>& y,const Rall1dN<N>& x,double eps=epsilon)
+{
+    return Equal(x.t,y.t,eps) && ((x.grad-y.grad).abs()<=eps).all();
+}
+
+template <int N>
+INLINE  bool operator==(const Rall1dN<N>& y,const Rall1dN<N>& x)
+{
+#ifdef KDL_USE_EQUAL
+    return Equal(y, x);
+#else
+    return (x.t == y.t && (x.grad == y.grad).all());
+#endif
+}
+
+template <int N>
+INLINE  bool operator!=(const Rall1dN<N>& y,const Rall1dN<N>& x)
+{
+    return !operator==(y, x);
+}
+
+}
+
+
+
+#endif
@@ -20,6 +20,7 @@
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "svd_eigen_Macie.hpp"
+#include <algorithm>
 
 namespace ARMstrongKDL{
     int svd_eigen_Macie(const Eigen::MatrixXd& A,Eigen::MatrixXd& U,Eigen::VectorXd& S, Eigen::MatrixXd& V,
@@ -159,4 +160,75 @@ namespace ARMstrongKDL{
             return sweeps;
         }
     }
+
+    int svd_eigen_Jacobi(const Eigen::MatrixXd& A,Eigen::MatrixXd& U,Eigen::VectorXd& S,Eigen::MatrixXd& V,
+                         Eigen::MatrixXd& B,double threshold,int maxsweeps)
+    {
+        const int n = static_cast<int>(A.cols());
+        B.noalias() = A*V;
+        // columns below this squared norm are in the null space, rotating
+        // them against each other only turns rounding noise around
+        const double tiny = 1e-30*B.squaredNorm();
+        int sweeps=0;
+        bool rotate=true;
+        while(rotate){
+            if(sweeps==maxsweeps)
+                return -1;
+            rotate=false;
+            for(int i=0;i<n;i++){
+                for(int j=i+1;j<n;j++){
+                    double p = B.col(i).dot(B.col(j));
+                    double qi = B.col(i).squaredNorm();
+                    double qj = B.col(j).squaredNorm();
+                    if(qi<=tiny||qj<=tiny||p*p<threshold*qi*qj)
+                        continue;
+                    //rotation that makes columns i and j orthogonal
+                    double q=qi-qj;
+                    double c = sqrt(4*p*p+q*q);
+                    double cos,sin;
+                    if(q>=0){
+                        cos=sqrt((c+q)/(2*c));
+                        sin=p/(c*cos);
+                    }else{
+                        sin=p<0 ? -sqrt((c-q)/(2*c)) : sqrt((c-q)/(2*c));
+                        cos=p/(c*sin);
+                    }
+                    for(int k=0;k<B.rows();k++){
+                        double bi=B(k,i);
+                        B(k,i)=cos*bi+sin*B(k,j);
+                        B(k,j)=-sin*bi+cos*B(k,j);
+                    }
+                    for(int k=0;k<n;k++){
+                        double vi=V(k,i);
+                        V(k,i)=cos*vi+sin*V(k,j);
+                        V(k,j)=-sin*vi+cos*V(k,j);
+                    }
+                    rotate=true;
+                }
+            }
+            if(rotate)
+                sweeps++;
+        }
+        for(int i=0;i<n;i++)
+            S(i)=B.col(i).norm();
+        //sort on decreasing singular values, the order rarely changes
+        //between calls
+        for(int i=0;i<n;i++){
+            int k;
+            S.tail(n-i).maxCoeff(&k);
+            k+=i;
+            if(k!=i){
+                std::swap(S(i),S(k));
+                B.col(i).swap(B.col(k));
+                V.col(i).swap(V.col(k));
+            }
+        }
+        for(int i=0;i<n;i++){
+            if(S(i)*S(i)<=tiny)
+                U.col(i).setZero();
+            else
+                U.col(i)=B.col(i)/S(i);
+        }
+        return sweeps;
+    }
 } // namespace ARMstrongKDL
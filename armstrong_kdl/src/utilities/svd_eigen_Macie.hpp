@@ -59,6 +59,51 @@ namespace ARMstrongKDL
                         Eigen::MatrixXd& B, Eigen::VectorXd& tempi,
                         double threshold,bool toggle);
 
+	/**
+	 * svd_eigen_Jacobi computes the singular value decomposition of a
+	 * matrix A with one sided Jacobi rotations, started from a given V.
+	 *
+	 * This is the first half of the toggle scheme of svd_eigen_Macie : the
+	 * columns of B=A*V are rotated until they are orthogonal.  When A
+	 * changes little between calls, as the jacobian of a chain between
+	 * control cycles, V of the previous call is nearly right and one or two
+	 * sweeps are enough.  Unlike svd_eigen_Macie, A may have less rows than
+	 * columns, the singular values are sorted in decreasing order as by
+	 * svd_eigen_HH and the number of sweeps is limited.
+	 *
+	 * \param A [INPUT] is an \f$m \times n\f$-matrix.
+	 * \param U [OUTPUT] is an \f$m \times n\f$ matrix, its columns are the
+	 * left singular vectors, or zero for a zero singular value.
+	 * \param S [OUTPUT] is an \f$n\f$-vector with the singular values.
+	 * \param V [INPUT/OUTPUT] is an \f$n \times n\f$ orthonormal matrix,
+	 * the start value and the right singular vectors.
+	 * \param B [TEMPORARY] is an \f$m \times n\f$ matrix.
+	 * \param threshold [INPUT] Threshold to determine orthogonality.
+	 * \param maxsweeps [INPUT] maximum number of sweeps.
+	 * \return number of sweeps, -1 if the columns are not orthogonal
+	 * after maxsweeps sweeps, U and S are not valid then.
+	 */
+    int svd_eigen_Jacobi(const Eigen::MatrixXd& A,Eigen::MatrixXd& U,Eigen::VectorXd& S,Eigen::MatrixXd& V,
+                         Eigen::MatrixXd& B,double threshold=1e-15,int maxsweeps=10);
+
+	/**
+	 * Counters of the warm started decompositions of a solver.
+	 */
+	struct SVDWarmStartStats
+	{
+		SVDWarmStartStats():decompositions(0),warm(0),fallbacks(0),sweeps(0),last_sweeps(0) {}
+		/// number of decompositions
+		unsigned int decompositions;
+		/// decompositions that converged from the V of the previous one
+		unsigned int warm;
+		/// warm starts that did not converge and were redone from scratch
+		unsigned int fallbacks;
+		/// total number of sweeps of the warm decompositions
+		unsigned int sweeps;
+		/// sweeps of the last decomposition, 0 if it was not warm
+		unsigned int last_sweeps;
+	};
+
 
 }
 #endif
@@ -257,6 +257,20 @@ inline double Norm(double arg) {
     return fabs(  (double)arg );
 }
 
+/**
+ * Computes sn=sin(angle) and cs=cos(angle) with one call, such that the
+ * argument reduction is shared.  Uses sincos() of the C library when
+ * it is available.
+ */
+inline void SinCos(double angle,double& sn,double& cs) {
+#if defined(__GLIBC__) && defined(_GNU_SOURCE)
+    ::sincos(angle,&sn,&cs);
+#else
+    sn = sin(angle);
+    cs = cos(angle);
+#endif
+}
+
 #if defined __WIN32__ && !defined __GNUC__
 inline double hypot(double y,double x) { return ::_hypot(y,x);}
 inline double abs(double x) { return ::fabs(x);}
@@ -46,6 +46,9 @@
 #include "velocityprofile_dirac.hpp"
 #include "velocityprofile_trap.hpp"
 #include "velocityprofile_traphalf.hpp"
+#include "velocityprofile_jerklimited.hpp"
+#include "velocityprofile_spline.hpp"
+#include "binary_io.hpp"
 #include <string.h>
 
 namespace ARMstrongKDL {
@@ -86,6 +89,18 @@ VelocityProfile* VelocityProfile::Read(std::istream& is) {
 		Eat(is,']');
 		IOTracePop();
 		return new VelocityProfile_TrapHalf(maxvel,maxacc,starting);
+	} else if (strcmp(storage,"JERKLIMITED")==0) {
+		double maxvel;
+		double maxacc;
+		double maxjerk;
+		is >> maxvel;
+		Eat(is,',');
+		is >> maxacc;
+		Eat(is,',');
+		is >> maxjerk;
+		Eat(is,']');
+		IOTracePop();
+		return new VelocityProfile_JerkLimited(maxvel,maxacc,maxjerk);
 	}
 	else {
 		throw Error_MotionIO_Unexpected_MotProf();
@@ -93,4 +108,24 @@ VelocityProfile* VelocityProfile::Read(std::istream& is) {
     return 0;
 }
 
+VelocityProfile* VelocityProfile::ReadBinary(BinaryReader& r) {
+	switch (r.PeekTag()) {
+		case BIN_VELPROF_DIRAC:
+			return VelocityProfile_Dirac::ReadBinary(r);
+		case BIN_VELPROF_RECTANGULAR:
+			return VelocityProfile_Rectangular::ReadBinary(r);
+		case BIN_VELPROF_TRAP:
+			return VelocityProfile_Trap::ReadBinary(r);
+		case BIN_VELPROF_TRAPHALF:
+			return VelocityProfile_TrapHalf::ReadBinary(r);
+		case BIN_VELPROF_SPLINE:
+			return VelocityProfile_Spline::ReadBinary(r);
+		case BIN_VELPROF_JERKLIMITED:
+			return VelocityProfile_JerkLimited::ReadBinary(r);
+		default:
+			throw Error_MotionIO_Binary(4);
+	}
+	return 0;
+}
+
 }
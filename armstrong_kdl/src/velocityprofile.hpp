@@ -51,6 +51,8 @@
 
 namespace ARMstrongKDL {
 
+class BinaryWriter;
+class BinaryReader;
 
     /**
      * A VelocityProfile stores the velocity profile that
@@ -96,6 +98,13 @@ class VelocityProfile
 		static VelocityProfile* Read(std::istream& is);
 		// reads a VelocityProfile object from the stream and returns it.
 
+		virtual void WriteBinary(BinaryWriter& w) const = 0;
+		// Writes the complete state of the object, including the planned
+		// profile, in the binary format.
+
+		static VelocityProfile* ReadBinary(BinaryReader& r);
+		// reads a VelocityProfile object from the binary format and returns it.
+
 		virtual VelocityProfile* Clone() const = 0;
 		// returns copy of current VelocityProfile object. (virtual constructor)
 
@@ -27,6 +27,8 @@
 
 #include "utilities/error.h"
 #include "velocityprofile_dirac.hpp"
+#include "binary_io.hpp"
+#include "utilities/scoped_ptr.hpp"
 
 namespace ARMstrongKDL {
 
@@ -87,5 +89,21 @@ namespace ARMstrongKDL {
 
 
 
+    void VelocityProfile_Dirac::WriteBinary(BinaryWriter& w) const {
+        w.WriteUInt(BIN_VELPROF_DIRAC);
+        w.WriteDouble(p1);
+        w.WriteDouble(p2);
+        w.WriteDouble(t);
+    }
+
+    VelocityProfile* VelocityProfile_Dirac::ReadBinary(BinaryReader& r) {
+        r.ExpectTag(BIN_VELPROF_DIRAC);
+        scoped_ptr<VelocityProfile_Dirac> res( new VelocityProfile_Dirac() );
+        res->p1 = r.ReadDouble();
+        res->p2 = r.ReadDouble();
+        res->t  = r.ReadDouble();
+        return res.release();
+    }
+
 }
 
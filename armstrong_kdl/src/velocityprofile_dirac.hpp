@@ -56,6 +56,8 @@ namespace ARMstrongKDL {
         virtual double Vel(double time) const;
         virtual double Acc(double time) const;
         virtual void Write(std::ostream& os) const;
+        virtual void WriteBinary(BinaryWriter& w) const;
+        static VelocityProfile* ReadBinary(BinaryReader& r);
         virtual VelocityProfile* Clone() const {
             VelocityProfile_Dirac* res =  new VelocityProfile_Dirac();
             res->SetProfileDuration( p1, p2, t );
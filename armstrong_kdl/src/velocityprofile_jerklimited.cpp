@@ -0,0 +1,368 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#include "velocityprofile_jerklimited.hpp"
+#include "binary_io.hpp"
+#include "utilities/scoped_ptr.hpp"
+#include <algorithm>
+
+namespace ARMstrongKDL {
+
+// relative tolerance and maximum number of iterations of the bisections
+static const double bisection_eps  = 1e-12;
+static const int    bisection_iter = 100;
+
+/**
+ * Computes the 3 segments (durations T, jerks J) that bring a motion with
+ * velocity v0 and acceleration a0 to velocity v1 with zero acceleration,
+ * as fast as possible within amax and jmax.
+ */
+static void PlanVelocityChange(double v0,double a0,double v1,
+							   double amax,double jmax,double* T,double* J) {
+	// velocity reached when the acceleration is brought to zero immediately :
+	double vrest = v0 + a0*fabs(a0)/(2.0*jmax);
+	double s     = (v1 >= vrest) ? 1.0 : -1.0;
+	// from here on, work in the direction of the velocity change :
+	double as    = s*a0;
+	double dv    = s*(v1-v0);
+	double ap,tc;
+	if (as > amax) {
+		ap = amax;
+		tc = (dv - as*as/(2.0*jmax))/amax;
+	} else {
+		double dvmax = (2.0*amax*amax - as*as)/(2.0*jmax);
+		if (dv >= dvmax) {
+			ap = amax;
+			tc = (dv-dvmax)/amax;
+		} else {
+			ap = ::sqrt(std::max(0.0,(2.0*jmax*dv + as*as)/2.0));
+			tc = 0.0;
+		}
+	}
+	T[0] = fabs(ap-as)/jmax;
+	J[0] = (ap >= as) ? s*jmax : -s*jmax;
+	T[1] = std::max(0.0,tc);
+	J[1] = 0.0;
+	T[2] = ap/jmax;
+	J[2] = -s*jmax;
+}
+
+static inline void Propagate(double& p,double& v,double& a,double jerk,double dt) {
+	p += dt*(v + dt*(a/2.0 + dt*jerk/6.0));
+	v += dt*(a + dt*jerk/2.0);
+	a += dt*jerk;
+}
+
+VelocityProfile_JerkLimited::VelocityProfile_JerkLimited(double _maxvel,double _maxacc,double _maxjerk):
+		  startpos(0), endpos(0),
+		  maxvel(_maxvel),maxacc(_maxacc),maxjerk(_maxjerk),velpeak(0)
+{
+	for (int k=0;k<7;++k) {
+		t[k]=p[k]=v[k]=a[k]=j[k]=0;
+	}
+	t[7]=0;
+}
+
+void VelocityProfile_JerkLimited::SetMax(double _maxvel,double _maxacc,double _maxjerk)
+{
+	maxvel = _maxvel; maxacc = _maxacc; maxjerk = _maxjerk;
+}
+
+double VelocityProfile_JerkLimited::Displacement(double vel1,double acc1,double velpeak) const {
+	double T[3],J[3];
+	double ps=0,vs=vel1,as=acc1;
+	PlanVelocityChange(vel1,acc1,velpeak,maxacc,maxjerk,T,J);
+	for (int k=0;k<3;++k)
+		Propagate(ps,vs,as,J[k],T[k]);
+	vs=velpeak;as=0;
+	PlanVelocityChange(velpeak,0.0,0.0,maxacc,maxjerk,T,J);
+	for (int k=0;k<3;++k)
+		Propagate(ps,vs,as,J[k],T[k]);
+	return ps;
+}
+
+double VelocityProfile_JerkLimited::CruiseDuration(double vel1,double acc1,double delta,double velpeak) const {
+	// Displacement() and the durations of its velocity changes, plus the
+	// cruise segment that covers the rest of delta at velpeak :
+	double T[3],J[3];
+	double ps=0,vs=vel1,as=acc1,duration=0;
+	PlanVelocityChange(vel1,acc1,velpeak,maxacc,maxjerk,T,J);
+	for (int k=0;k<3;++k) {
+		Propagate(ps,vs,as,J[k],T[k]);
+		duration += T[k];
+	}
+	vs=velpeak;as=0;
+	PlanVelocityChange(velpeak,0.0,0.0,maxacc,maxjerk,T,J);
+	for (int k=0;k<3;++k) {
+		Propagate(ps,vs,as,J[k],T[k]);
+		duration += T[k];
+	}
+	return duration+(delta-ps)/velpeak;
+}
+
+void VelocityProfile_JerkLimited::PlanProfile(double pos1,double vel1,double acc1,
+											 double pos2,double vellimit) {
+	startpos = pos1;
+	endpos   = pos2;
+	double delta = pos2-pos1;
+	// The displacement without cruise segment increases with the peak velocity,
+	// check whether the velocity limit is reached in either direction :
+	double tcruise=0.0;
+	double dup = Displacement(vel1,acc1,vellimit);
+	if (delta >= dup) {
+		velpeak = vellimit;
+		tcruise = (delta-dup)/vellimit;
+	} else {
+		double ddown = Displacement(vel1,acc1,-vellimit);
+		if (delta <= ddown) {
+			velpeak = -vellimit;
+			tcruise = (ddown-delta)/vellimit;
+		} else {
+			double lo = -vellimit;
+			double hi = vellimit;
+			for (int i=0;i<bisection_iter && hi-lo > bisection_eps*vellimit;++i) {
+				double mid = (lo+hi)/2.0;
+				if (Displacement(vel1,acc1,mid) < delta)
+					lo = mid;
+				else
+					hi = mid;
+			}
+			velpeak = (lo+hi)/2.0;
+		}
+	}
+	double T[7];
+	PlanVelocityChange(vel1,acc1,velpeak,maxacc,maxjerk,T,j);
+	T[3] = tcruise;
+	j[3] = 0.0;
+	PlanVelocityChange(velpeak,0.0,0.0,maxacc,maxjerk,T+4,j+4);
+
+	double ps=pos1,vs=vel1,as=acc1;
+	t[0] = 0.0;
+	for (int k=0;k<7;++k) {
+		p[k]=ps;v[k]=vs;a[k]=as;
+		Propagate(ps,vs,as,j[k],T[k]);
+		t[k+1] = t[k]+T[k];
+	}
+}
+
+void VelocityProfile_JerkLimited::SetProfile(double pos1,double pos2) {
+	PlanProfile(pos1,0.0,0.0,pos2,maxvel);
+}
+
+void VelocityProfile_JerkLimited::SetProfile(double pos1,double vel1,double acc1,double pos2) {
+	PlanProfile(pos1,vel1,acc1,pos2,maxvel);
+}
+
+void VelocityProfile_JerkLimited::SetProfileDuration(
+	double pos1,double pos2,double newduration) {
+	// Fastest :
+	SetProfile(pos1,pos2);
+	// Must be Slower  :
+	double factor = t[7]/newduration;
+	if (factor >= 1)
+		return; // do not exceed max
+	double T[7];
+	for (int k=0;k<7;++k)
+		T[k] = (t[k+1]-t[k])/factor;
+	double ps=pos1,vs=0,as=0;
+	for (int k=0;k<7;++k) {
+		j[k] *= factor*factor*factor;
+		p[k]=ps;v[k]=vs;a[k]=as;
+		Propagate(ps,vs,as,j[k],T[k]);
+		t[k+1] = t[k]+T[k];
+	}
+}
+
+void VelocityProfile_JerkLimited::SetProfileDuration(
+	double pos1,double vel1,double acc1,double pos2,double newduration) {
+	// Fastest :
+	PlanProfile(pos1,vel1,acc1,pos2,maxvel);
+	if (t[7] < newduration)
+		SlowDown(pos1,vel1,acc1,pos2,newduration);
+}
+
+void VelocityProfile_JerkLimited::SlowDown(
+	double pos1,double vel1,double acc1,double pos2,double newduration) {
+	// Lower the peak velocity, the duration increases when it decreases.
+	// Below the time optimal peak velocity the displacement without
+	// cruise segment is smaller than pos2-pos1, so there is a cruise
+	// segment and the duration does not need a complete plan :
+	double delta = pos2-pos1;
+	double s = (velpeak >= 0.0) ? 1.0 : -1.0;
+	double lo = 0.0;
+	double hi = fabs(velpeak);
+	for (int i=0;i<bisection_iter && hi-lo > bisection_eps*maxvel;++i) {
+		double mid = (lo+hi)/2.0;
+		double duration = CruiseDuration(vel1,acc1,delta,s*mid);
+		if (fabs(duration-newduration) <= bisection_eps*newduration) {
+			lo = hi = mid;
+			break;
+		}
+		if (duration < newduration)
+			hi = mid;
+		else
+			lo = mid;
+	}
+	PlanProfile(pos1,vel1,acc1,pos2,(lo > 0.0) ? lo : hi);
+}
+
+int VelocityProfile_JerkLimited::Segment(double time) const {
+	int k=6;
+	while (k>0 && time<t[k])
+		--k;
+	return k;
+}
+
+double VelocityProfile_JerkLimited::Duration() const {
+	return t[7];
+}
+
+double VelocityProfile_JerkLimited::Pos(double time) const {
+	if (time < 0) {
+		return p[0];
+	} else if (time <= t[7]) {
+		int k = Segment(time);
+		double dt = time-t[k];
+		return p[k]+dt*(v[k]+dt*(a[k]/2.0+dt*j[k]/6.0));
+	} else {
+		return endpos;
+	}
+}
+
+double VelocityProfile_JerkLimited::Vel(double time) const {
+	if (time < 0) {
+		return v[0];
+	} else if (time <= t[7]) {
+		int k = Segment(time);
+		double dt = time-t[k];
+		return v[k]+dt*(a[k]+dt*j[k]/2.0);
+	} else {
+		return 0;
+	}
+}
+
+double VelocityProfile_JerkLimited::Acc(double time) const {
+	if (time < 0) {
+		return a[0];
+	} else if (time <= t[7]) {
+		int k = Segment(time);
+		return a[k]+(time-t[k])*j[k];
+	} else {
+		return 0;
+	}
+}
+
+double VelocityProfile_JerkLimited::Jerk(double time) const {
+	if (time < 0 || time > t[7]) {
+		return 0;
+	} else {
+		return j[Segment(time)];
+	}
+}
+
+VelocityProfile* VelocityProfile_JerkLimited::Clone() const {
+	return new VelocityProfile_JerkLimited(*this);
+}
+
+VelocityProfile_JerkLimited::~VelocityProfile_JerkLimited() {}
+
+void VelocityProfile_JerkLimited::Write(std::ostream& os) const {
+	os << "JERKLIMITED[" << maxvel << "," << maxacc << "," << maxjerk << "]";
+}
+
+void VelocityProfile_JerkLimited::WriteBinary(BinaryWriter& w) const {
+	w.WriteUInt(BIN_VELPROF_JERKLIMITED);
+	w.WriteDouble(maxvel);
+	w.WriteDouble(maxacc);
+	w.WriteDouble(maxjerk);
+	w.WriteDouble(startpos);
+	w.WriteDouble(endpos);
+	w.WriteDoubles(t,8);
+	w.WriteDoubles(p,7);
+	w.WriteDoubles(v,7);
+	w.WriteDoubles(a,7);
+	w.WriteDoubles(j,7);
+}
+
+VelocityProfile* VelocityProfile_JerkLimited::ReadBinary(BinaryReader& r) {
+	r.ExpectTag(BIN_VELPROF_JERKLIMITED);
+	double maxvel  = r.ReadDouble();
+	double maxacc  = r.ReadDouble();
+	double maxjerk = r.ReadDouble();
+	scoped_ptr<VelocityProfile_JerkLimited> res( new VelocityProfile_JerkLimited(maxvel,maxacc,maxjerk) );
+	res->startpos = r.ReadDouble();
+	res->endpos   = r.ReadDouble();
+	r.ReadDoubles(res->t,8);
+	r.ReadDoubles(res->p,7);
+	r.ReadDoubles(res->v,7);
+	r.ReadDoubles(res->a,7);
+	r.ReadDoubles(res->j,7);
+	return res.release();
+}
+
+
+VelocityProfile_JerkLimitedSync::VelocityProfile_JerkLimitedSync(
+	const std::vector<double>& maxvel,
+	const std::vector<double>& maxacc,
+	const std::vector<double>& maxjerk):
+	duration(0)
+{
+	for (unsigned int i=0;i<maxvel.size();++i)
+		profiles.push_back(VelocityProfile_JerkLimited(maxvel[i],maxacc[i],maxjerk[i]));
+}
+
+void VelocityProfile_JerkLimitedSync::SetProfile(const std::vector<double>& pos1,
+												 const std::vector<double>& vel1,
+												 const std::vector<double>& acc1,
+												 const std::vector<double>& pos2) {
+	duration = 0;
+	for (unsigned int i=0;i<profiles.size();++i) {
+		profiles[i].SetProfile(pos1[i],vel1[i],acc1[i],pos2[i]);
+		duration = std::max(duration,profiles[i].Duration());
+	}
+	for (unsigned int i=0;i<profiles.size();++i) {
+		// the time optimal profile is planned already
+		if (profiles[i].Duration() < duration)
+			profiles[i].SlowDown(pos1[i],vel1[i],acc1[i],pos2[i],duration);
+	}
+}
+
+unsigned int VelocityProfile_JerkLimitedSync::size() const {
+	return profiles.size();
+}
+
+double VelocityProfile_JerkLimitedSync::Duration() const {
+	return duration;
+}
+
+void VelocityProfile_JerkLimitedSync::Pos(double time,std::vector<double>& pos) const {
+	for (unsigned int i=0;i<profiles.size();++i)
+		pos[i] = profiles[i].Pos(time);
+}
+
+void VelocityProfile_JerkLimitedSync::Vel(double time,std::vector<double>& vel) const {
+	for (unsigned int i=0;i<profiles.size();++i)
+		vel[i] = profiles[i].Vel(time);
+}
+
+void VelocityProfile_JerkLimitedSync::Acc(double time,std::vector<double>& acc) const {
+	for (unsigned int i=0;i<profiles.size();++i)
+		acc[i] = profiles[i].Acc(time);
+}
+
+const VelocityProfile_JerkLimited& VelocityProfile_JerkLimitedSync::Profile(unsigned int i) const {
+	return profiles[i];
+}
+
+}
@@ -0,0 +1,188 @@
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+#ifndef KDL_MOTION_VELOCITYPROFILE_JERKLIMITED_H
+#define KDL_MOTION_VELOCITYPROFILE_JERKLIMITED_H
+
+#include "velocityprofile.hpp"
+#include <vector>
+
+namespace ARMstrongKDL {
+
+	/**
+	 * A jerk limited (S-curve) VelocityProfile.
+	 *
+	 * The profile consists of 7 segments of constant jerk: a velocity change
+	 * from the initial state towards a peak velocity (jerk, constant
+	 * acceleration, jerk), a cruise segment at the peak velocity, and a
+	 * stop at the end position (jerk, constant acceleration, jerk).
+	 * Segments that are not needed have zero duration.
+	 *
+	 * Next to the usual rest-to-rest planning, the profile can be planned
+	 * online from an arbitrary initial position, velocity and acceleration
+	 * (e.g. the current setpoint of a running motion), which makes it
+	 * usable to re-plan every control cycle.  Planning only uses closed
+	 * form expressions and a bounded bisection on the peak velocity, it does
+	 * not allocate memory.
+	 *
+	 * The peak velocity is bounded by maxvel, the acceleration by maxacc
+	 * (unless the initial acceleration already exceeds it, in that case it
+	 * is brought back within the limit as fast as possible) and the jerk by
+	 * maxjerk.  The profile always ends at rest in the end position.
+	 * @ingroup Motion
+	 */
+class VelocityProfile_JerkLimited : public VelocityProfile
+	{
+		// For "running" a motion profile :
+		double t[8];                    // switching times, t[7]==duration
+		double p[7],v[7],a[7],j[7];     // state and jerk at start of each segment
+
+		double startpos;
+		double endpos;
+
+		// specification of the motion profile :
+		double maxvel;
+		double maxacc;
+		double maxjerk;
+
+		// peak velocity of the last plan :
+		double velpeak;
+
+		void PlanProfile(double pos1,double vel1,double acc1,double pos2,double vellimit);
+		double Displacement(double vel1,double acc1,double velpeak) const;
+		double CruiseDuration(double vel1,double acc1,double delta,double velpeak) const;
+		void SlowDown(double pos1,double vel1,double acc1,double pos2,double newduration);
+		friend class VelocityProfile_JerkLimitedSync;
+		int Segment(double time) const;
+	public:
+
+		/**
+		 * \param _maxvel maximal velocity of the motion profile (positive)
+		 * \param _maxacc maximal acceleration of the motion profile (positive)
+		 * \param _maxjerk maximal jerk of the motion profile (positive)
+		 */
+		VelocityProfile_JerkLimited(double _maxvel=0,double _maxacc=0,double _maxjerk=0);
+
+		virtual void SetMax(double _maxvel,double _maxacc,double _maxjerk);
+
+		/**
+		 * Plans the time optimal rest-to-rest profile between pos1 and pos2.
+		 */
+		virtual void SetProfile(double pos1,double pos2);
+
+		/**
+		 * Plans a rest-to-rest profile between pos1 and pos2 that lasts
+		 * newduration seconds, by time scaling the time optimal profile.
+		 * If newduration is shorter than the time optimal duration, the
+		 * time optimal profile is used.
+		 */
+		virtual void SetProfileDuration(
+			double pos1,double pos2,double newduration
+		);
+
+		/**
+		 * Plans the profile online, starting from a moving state.
+		 *
+		 * \param pos1 current position
+		 * \param vel1 current velocity
+		 * \param acc1 current acceleration
+		 * \param pos2 end position, reached at rest
+		 */
+		virtual void SetProfile(double pos1,double vel1,double acc1,double pos2);
+
+		/**
+		 * Plans the profile online, starting from a moving state, such that it
+		 * lasts newduration seconds.  This is done by lowering the peak
+		 * velocity, below the time optimal peak velocity the profile has a
+		 * cruise segment and its duration is a closed form expression of
+		 * the peak velocity, such that the bisection on the peak velocity
+		 * does not plan complete profiles.  If newduration is shorter than the time optimal duration,
+		 * the time optimal profile is used.  If the duration cannot be reached
+		 * by lowering the peak velocity (e.g. a short motion that has to stop
+		 * at its start position), the profile with the longest duration is used.
+		 *
+		 * \param pos1 current position
+		 * \param vel1 current velocity
+		 * \param acc1 current acceleration
+		 * \param pos2 end position, reached at rest
+		 * \param newduration the desired duration
+		 */
+		virtual void SetProfileDuration(
+			double pos1,double vel1,double acc1,double pos2,double newduration
+		);
+
+		virtual double Duration() const;
+		virtual double Pos(double time) const;
+		virtual double Vel(double time) const;
+		virtual double Acc(double time) const;
+		/**
+		 * Returns the jerk at <time>.
+		 */
+		virtual double Jerk(double time) const;
+		virtual void Write(std::ostream& os) const;
+		virtual void WriteBinary(BinaryWriter& w) const;
+		static VelocityProfile* ReadBinary(BinaryReader& r);
+		virtual VelocityProfile* Clone() const;
+		virtual ~VelocityProfile_JerkLimited();
+	};
+
+	/**
+	 * A set of VelocityProfile_JerkLimited for multiple degrees of freedom
+	 * that are planned online and synchronized: all of them
+	 * last as long as the slowest one.
+	 * @ingroup Motion
+	 */
+class VelocityProfile_JerkLimitedSync
+	{
+		std::vector<VelocityProfile_JerkLimited> profiles;
+		double duration;
+	public:
+		/**
+		 * \param maxvel maximal velocity for each degree of freedom
+		 * \param maxacc maximal acceleration for each degree of freedom
+		 * \param maxjerk maximal jerk for each degree of freedom
+		 */
+		VelocityProfile_JerkLimitedSync(const std::vector<double>& maxvel,
+										const std::vector<double>& maxacc,
+										const std::vector<double>& maxjerk);
+
+		/**
+		 * Plans all degrees of freedom from their current state towards
+		 * pos2, such that they all reach their end position at the same time.
+		 * All arguments should have the size given at construction.
+		 */
+		void SetProfile(const std::vector<double>& pos1,
+						const std::vector<double>& vel1,
+						const std::vector<double>& acc1,
+						const std::vector<double>& pos2);
+
+		unsigned int size() const;
+		double Duration() const;
+		/**
+		 * Evaluates all degrees of freedom at <time>, pos/vel/acc
+		 * should have the size given at construction.
+		 */
+		void Pos(double time,std::vector<double>& pos) const;
+		void Vel(double time,std::vector<double>& vel) const;
+		void Acc(double time,std::vector<double>& acc) const;
+		/**
+		 * Returns the profile of degree of freedom i.
+		 */
+		const VelocityProfile_JerkLimited& Profile(unsigned int i) const;
+	};
+
+}
+
+
+#endif
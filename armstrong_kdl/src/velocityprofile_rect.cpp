@@ -42,6 +42,8 @@
 
 #include "utilities/error.h"
 #include "velocityprofile_rect.hpp"
+#include "binary_io.hpp"
+#include "utilities/scoped_ptr.hpp"
 
 namespace ARMstrongKDL {
 
@@ -129,5 +131,22 @@ void VelocityProfile_Rectangular::Write(std::ostream& os) const {
 }
 
 
+void VelocityProfile_Rectangular::WriteBinary(BinaryWriter& w) const {
+	w.WriteUInt(BIN_VELPROF_RECTANGULAR);
+	w.WriteDouble(maxvel);
+	w.WriteDouble(d);
+	w.WriteDouble(p);
+	w.WriteDouble(v);
+}
+
+VelocityProfile* VelocityProfile_Rectangular::ReadBinary(BinaryReader& r) {
+	r.ExpectTag(BIN_VELPROF_RECTANGULAR);
+	scoped_ptr<VelocityProfile_Rectangular> res( new VelocityProfile_Rectangular(r.ReadDouble()) );
+	res->d = r.ReadDouble();
+	res->p = r.ReadDouble();
+	res->v = r.ReadDouble();
+	return res.release();
+}
+
 }
 
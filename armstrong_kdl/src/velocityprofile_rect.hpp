@@ -75,6 +75,8 @@ namespace ARMstrongKDL {
 		virtual double Vel(double time) const;
 		virtual double Acc(double time) const;
 		virtual void Write(std::ostream& os) const;
+		virtual void WriteBinary(BinaryWriter& w) const;
+		static VelocityProfile* ReadBinary(BinaryReader& r);
 		virtual VelocityProfile* Clone() const{
 			VelocityProfile_Rectangular* res =  new VelocityProfile_Rectangular(maxvel);
 			res->SetProfileDuration( p, p+v*d, d );
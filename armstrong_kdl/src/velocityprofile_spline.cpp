@@ -2,6 +2,8 @@
 #include <limits>
 
 #include "velocityprofile_spline.hpp"
+#include "binary_io.hpp"
+#include "utilities/scoped_ptr.hpp"
 
 namespace ARMstrongKDL {
 
@@ -191,4 +193,20 @@ VelocityProfile* VelocityProfile_Spline::Clone() const
 {
   return new VelocityProfile_Spline(*this);
 }
+void VelocityProfile_Spline::WriteBinary(BinaryWriter& w) const
+{
+  w.WriteUInt(BIN_VELPROF_SPLINE);
+  w.WriteDoubles(coeff_,6);
+  w.WriteDouble(duration_);
+}
+
+VelocityProfile* VelocityProfile_Spline::ReadBinary(BinaryReader& r)
+{
+  r.ExpectTag(BIN_VELPROF_SPLINE);
+  scoped_ptr<VelocityProfile_Spline> res( new VelocityProfile_Spline() );
+  r.ReadDoubles(res->coeff_,6);
+  res->duration_ = r.ReadDouble();
+  return res.release();
+}
+
 }
@@ -57,6 +57,8 @@ public:
     virtual double Vel(double time) const;
     virtual double Acc(double time) const;
     virtual void Write(std::ostream& os) const;
+    virtual void WriteBinary(BinaryWriter& w) const;
+    static VelocityProfile* ReadBinary(BinaryReader& r);
     virtual VelocityProfile* Clone() const;
 private:
 
@@ -101,6 +101,8 @@ class VelocityProfile_Trap : public VelocityProfile
 		virtual double Vel(double time) const;
 		virtual double Acc(double time) const;
 		virtual void Write(std::ostream& os) const;
+		virtual void WriteBinary(BinaryWriter& w) const;
+		static VelocityProfile* ReadBinary(BinaryReader& r);
 		virtual VelocityProfile* Clone() const;
 		// returns copy of current VelocityProfile object. (virtual constructor)
 		virtual ~VelocityProfile_Trap();
@@ -42,6 +42,7 @@
 
 //#include "error.h"
 #include "velocityprofile_traphalf.hpp"
+#include "binary_io.hpp"
 #include <algorithm>
 
 namespace ARMstrongKDL {
@@ -199,5 +200,26 @@ void VelocityProfile_TrapHalf::Write(std::ostream& os) const {
 
 
 
+void VelocityProfile_TrapHalf::WriteBinary(BinaryWriter& w) const {
+	w.WriteUInt(BIN_VELPROF_TRAPHALF);
+	const double data[16] = {a1,a2,a3,b1,b2,b3,c1,c2,c3,duration,t1,t2,maxvel,maxacc,startpos,endpos};
+	w.WriteDoubles(data,16);
+	w.WriteBool(starting);
+}
+
+VelocityProfile* VelocityProfile_TrapHalf::ReadBinary(BinaryReader& r) {
+	r.ExpectTag(BIN_VELPROF_TRAPHALF);
+	double data[16];
+	r.ReadDoubles(data,16);
+	VelocityProfile_TrapHalf* res = new VelocityProfile_TrapHalf(data[12],data[13],r.ReadBool());
+	res->a1 = data[0]; res->a2 = data[1]; res->a3 = data[2];
+	res->b1 = data[3]; res->b2 = data[4]; res->b3 = data[5];
+	res->c1 = data[6]; res->c2 = data[7]; res->c3 = data[8];
+	res->duration = data[9];
+	res->t1 = data[10]; res->t2 = data[11];
+	res->startpos = data[14]; res->endpos = data[15];
+	return res;
+}
+
 }
 
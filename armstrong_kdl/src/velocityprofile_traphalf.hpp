@@ -123,6 +123,8 @@ class VelocityProfile_TrapHalf : public VelocityProfile
 		virtual double Vel(double time) const;
 		virtual double Acc(double time) const;
 		virtual void Write(std::ostream& os) const;
+		virtual void WriteBinary(BinaryWriter& w) const;
+		static VelocityProfile* ReadBinary(BinaryReader& r);
 		virtual VelocityProfile* Clone() const;
 
 		virtual ~VelocityProfile_TrapHalf();
@@ -0,0 +1,88 @@
+#include "chaincodegentest.hpp"
+#include "chaincodegentest_chains.hpp"
+#include <models.hpp>
+#include <frames_io.hpp>
+#include <chainfksolverpos_recursive.hpp>
+#include <chainjnttojacsolver.hpp>
+#include <chainidsolver_recursive_newton_euler.hpp>
+#include <puma560_generated.hpp>
+#include <kukalwr_dhnew_generated.hpp>
+#include <alljointtypes_generated.hpp>
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ChainCodeGenTest );
+
+using namespace ARMstrongKDL;
+
+void ChainCodeGenTest::setUp()
+{
+    srand( (unsigned)time( NULL ));
+}
+
+void ChainCodeGenTest::tearDown()
+{
+}
+
+typedef void (*FkFunction)(const JntArray&,Frame&);
+typedef void (*JacFunction)(const JntArray&,Jacobian&);
+typedef void (*RneFunction)(const JntArray&,const JntArray&,const JntArray&,
+                            const Vector&,const std::vector<Wrench>&,JntArray&);
+
+// the generated functions against the recursive solvers for random
+// configurations :
+static void CompareGenerated(const Chain& chain,unsigned int nj,unsigned int ns,
+                             FkFunction fk,JacFunction jac,RneFunction rne)
+{
+    CPPUNIT_ASSERT_EQUAL(chain.getNrOfJoints(),nj);
+    CPPUNIT_ASSERT_EQUAL(chain.getNrOfSegments(),ns);
+    ChainFkSolverPos_recursive fksolver(chain);
+    ChainJntToJacSolver jacsolver(chain);
+    Vector grav(0.0,0.0,-9.81);
+    ChainIdSolver_RNE idsolver(chain,grav);
+
+    JntArray q(nj),qdot(nj),qdotdot(nj),torques(nj),torques_gen(nj);
+    Jacobian J(nj),J_gen(nj);
+    Wrenches f_ext(ns);
+    for (int n=0;n<20;n++) {
+        for (unsigned int i=0;i<nj;i++) {
+            random(q(i));
+            random(qdot(i));
+            random(qdotdot(i));
+        }
+        for (unsigned int i=0;i<ns;i++)
+            random(f_ext[i]);
+
+        Frame F,F_gen;
+        fksolver.JntToCart(q,F);
+        fk(q,F_gen);
+        CPPUNIT_ASSERT(Equal(F,F_gen,1e-12));
+
+        jacsolver.JntToJac(q,J);
+        jac(q,J_gen);
+        CPPUNIT_ASSERT((J.data-J_gen.data).cwiseAbs().maxCoeff()<1e-12);
+
+        idsolver.CartToJnt(q,qdot,qdotdot,f_ext,torques);
+        rne(q,qdot,qdotdot,grav,f_ext,torques_gen);
+        for (unsigned int i=0;i<nj;i++)
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(torques(i),torques_gen(i),1e-10*(1+std::abs(torques(i))));
+    }
+}
+
+void ChainCodeGenTest::TestPuma560()
+{
+    CompareGenerated(Puma560(),puma560_generated::nj,puma560_generated::ns,
+                     &puma560_generated::JntToCart,&puma560_generated::JntToJac,&puma560_generated::CartToJnt);
+}
+
+void ChainCodeGenTest::TestKukaLWR()
+{
+    CompareGenerated(KukaLWR_DHnew(),kukalwr_dhnew_generated::nj,kukalwr_dhnew_generated::ns,
+                     &kukalwr_dhnew_generated::JntToCart,&kukalwr_dhnew_generated::JntToJac,
+                     &kukalwr_dhnew_generated::CartToJnt);
+}
+
+void ChainCodeGenTest::TestAllJointTypes()
+{
+    CompareGenerated(AllJointTypesChain(),alljointtypes_generated::nj,alljointtypes_generated::ns,
+                     &alljointtypes_generated::JntToCart,&alljointtypes_generated::JntToJac,
+                     &alljointtypes_generated::CartToJnt);
+}
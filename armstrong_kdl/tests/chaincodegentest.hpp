@@ -0,0 +1,23 @@
+#ifndef CHAINCODEGEN_TEST_HPP
+#define CHAINCODEGEN_TEST_HPP
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class ChainCodeGenTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE( ChainCodeGenTest);
+    CPPUNIT_TEST(TestPuma560);
+    CPPUNIT_TEST(TestKukaLWR);
+    CPPUNIT_TEST(TestAllJointTypes);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+    void TestPuma560();
+    void TestKukaLWR();
+    void TestAllJointTypes();
+};
+
+#endif
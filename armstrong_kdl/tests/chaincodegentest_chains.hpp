@@ -0,0 +1,27 @@
+#ifndef CHAINCODEGEN_TEST_CHAINS_HPP
+#define CHAINCODEGEN_TEST_CHAINS_HPP
+
+#include <chain.hpp>
+
+// a chain with every joint type, scales, offsets and joint inertia, shared
+// by chaincodegentest_generate and chaincodegentest :
+inline ARMstrongKDL::Chain AllJointTypesChain()
+{
+    using namespace ARMstrongKDL;
+    Chain chain;
+    RigidBodyInertia I(1.5,Vector(0.1,-0.05,0.2),RotationalInertia(0.1,0.2,0.15,0.01,-0.02,0.005));
+    chain.addSegment(Segment(Joint(Joint::RotZ),Frame(Rotation::RPY(0.1,0.2,0.3),Vector(0.1,0.0,0.3)),I));
+    chain.addSegment(Segment(Joint(Vector(0.05,0.1,0.0),Vector(1.0,1.0,0.5),Joint::RotAxis,2.0,0.3),
+                             Frame(Vector(0.0,0.4,0.0)),2.0*I));
+    chain.addSegment(Segment(Joint(Joint::TransX,1.0,0.1),Frame(Rotation::RotX(0.5),Vector(0.2,0.0,0.0)),I));
+    chain.addSegment(Segment(Joint(Joint::RotY,-1.0,0.0,0.2),Frame(Vector(0.0,0.0,0.25))));
+    chain.addSegment(Segment(Joint(Joint::Fixed),Frame(Rotation::RotZ(0.7),Vector(0.0,0.1,0.0)),0.5*I));
+    chain.addSegment(Segment(Joint(Vector(0.0,0.1,0.2),Vector(0.3,-1.0,0.2),Joint::TransAxis,0.5,-0.2),
+                             Frame(Rotation::RPY(-0.3,0.1,0.4),Vector(0.1,0.1,0.1)),I));
+    chain.addSegment(Segment(Joint(Joint::TransY),Frame::Identity(),I));
+    chain.addSegment(Segment(Joint(Joint::TransZ),Frame(Rotation::RotY(0.2)),I));
+    chain.addSegment(Segment(Joint(Joint::RotX,1.0,0.0,0.05),Frame(Vector(0.0,0.0,0.1)),0.3*I));
+    return chain;
+}
+
+#endif
@@ -0,0 +1,30 @@
+// Writes the headers used by chaincodegentest to the directory argv[1].
+
+#include <chaincodegenerator.hpp>
+#include <models.hpp>
+#include "chaincodegentest_chains.hpp"
+#include <fstream>
+#include <iostream>
+
+using namespace ARMstrongKDL;
+
+static bool Generate(const Chain& chain,const std::string& dir,const std::string& name)
+{
+    std::ofstream os((dir+"/"+name+".hpp").c_str());
+    ChainCodeGenerator(chain).generate(os,name);
+    return static_cast<bool>(os);
+}
+
+int main(int argc,char** argv)
+{
+    if (argc!=2) {
+        std::cerr << "usage: " << argv[0] << " <output directory>" << std::endl;
+        return 1;
+    }
+    std::string dir(argv[1]);
+    if (!Generate(Puma560(),dir,"puma560_generated") ||
+        !Generate(KukaLWR_DHnew(),dir,"kukalwr_dhnew_generated") ||
+        !Generate(AllJointTypesChain(),dir,"alljointtypes_generated"))
+        return 1;
+    return 0;
+}
@@ -1,6 +1,7 @@
 #include "framestest.hpp"
 #include <frames_io.hpp>
 #include <utilities/utility.h>
+#include <cmath>
 
 CPPUNIT_TEST_SUITE_REGISTRATION( FramesTest );
 
@@ -785,3 +786,229 @@ void FramesTest::TestJntArrayWhenEmpty()
 }
 
 
+
+void FramesTest::TestFramePack() {
+    const int n = DoublePack::size;
+    std::vector<Frame> F1(n),F2(n);
+    std::vector<Vector> v(n);
+    std::vector<Twist> t(n);
+    std::vector<Wrench> w(n);
+    FramePack P1,P2;
+    VectorPack pv;
+    TwistPack pt;
+    WrenchPack pw;
+    for (int i=0;i<n;++i) {
+        random(F1[i]);
+        random(F2[i]);
+        random(v[i]);
+        random(t[i]);
+        random(w[i]);
+        P1.Set(i,F1[i]);
+        P2.Set(i,F2[i]);
+        pv.Set(i,v[i]);
+        pt.Set(i,t[i]);
+        pw.Set(i,w[i]);
+    }
+    FramePack P12 = P1*P2;
+    FramePack P1inv = P1.Inverse();
+    VectorPack pv1 = P1*pv;
+    VectorPack pv1inv = P1.Inverse(pv);
+    VectorPack pcross = pv*P1.p;
+    DoublePack pdot = dot(pv,P1.p);
+    DoublePack pnorm = pv.Norm();
+    TwistPack pt1 = P1*pt;
+    TwistPack pt1inv = P1.Inverse(pt);
+    TwistPack ptref = pt.RefPoint(pv);
+    WrenchPack pw1 = P1*pw;
+    WrenchPack pw1inv = P1.Inverse(pw);
+    WrenchPack pwref = pw.RefPoint(pv);
+    TwistPack pdiff = diff(P1,P2,0.5);
+    for (int i=0;i<n;++i) {
+        CPPUNIT_ASSERT(Equal(F1[i]*F2[i],P12.Get(i)));
+        CPPUNIT_ASSERT(Equal(F1[i].Inverse(),P1inv.Get(i)));
+        CPPUNIT_ASSERT(Equal(F1[i]*v[i],pv1.Get(i)));
+        CPPUNIT_ASSERT(Equal(F1[i].Inverse(v[i]),pv1inv.Get(i)));
+        CPPUNIT_ASSERT(Equal(v[i]*F1[i].p,pcross.Get(i)));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(dot(v[i],F1[i].p),pdot.Get(i),epsilon);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(v[i].Norm(),pnorm.Get(i),epsilon);
+        CPPUNIT_ASSERT(Equal(F1[i]*t[i],pt1.Get(i)));
+        CPPUNIT_ASSERT(Equal(F1[i].Inverse(t[i]),pt1inv.Get(i)));
+        CPPUNIT_ASSERT(Equal(t[i].RefPoint(v[i]),ptref.Get(i)));
+        CPPUNIT_ASSERT(Equal(F1[i]*w[i],pw1.Get(i)));
+        CPPUNIT_ASSERT(Equal(F1[i].Inverse(w[i]),pw1inv.Get(i)));
+        CPPUNIT_ASSERT(Equal(w[i].RefPoint(v[i]),pwref.Get(i)));
+        CPPUNIT_ASSERT(Equal(diff(F1[i],F2[i],0.5),pdiff.Get(i)));
+    }
+    CPPUNIT_ASSERT(Equal(P1*P1inv,FramePack::Identity()));
+    CPPUNIT_ASSERT(Equal(FramePack(F1[0]).Get(n-1),F1[0]));
+}
+
+void FramesTest::TestFrameQuat() {
+    for (int k=0;k<20;++k) {
+        Frame F1,F2;
+        Vector v;
+        random(F1);
+        random(F2);
+        random(v);
+        FrameQuat Q1(F1),Q2(F2);
+
+        // conversions
+        CPPUNIT_ASSERT(Equal(Q1.GetFrame(),F1,1e-12));
+        CPPUNIT_ASSERT(Equal(Quaternion(Q1.M.GetRotation()),Q1.M,1e-12));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0,Q1.M.Norm(),1e-12);
+
+        // compose, apply and inverse
+        CPPUNIT_ASSERT(Equal((Q1*Q2).GetFrame(),F1*F2,1e-12));
+        CPPUNIT_ASSERT(Equal(Q1*v,F1*v,1e-12));
+        CPPUNIT_ASSERT(Equal(Q1.M*v,F1.M*v,1e-12));
+        CPPUNIT_ASSERT(Equal(Q1.Inverse().GetFrame(),F1.Inverse(),1e-12));
+        CPPUNIT_ASSERT(Equal(Q1.Inverse(v),F1.Inverse(v),1e-12));
+        CPPUNIT_ASSERT(Equal(Q1.M.Inverse(v),F1.M.Inverse(v),1e-12));
+        CPPUNIT_ASSERT(Equal(Q1*Q1.Inverse(),FrameQuat::Identity(),1e-12));
+
+        // elementary rotations
+        double a;
+        random(a);
+        CPPUNIT_ASSERT(Equal(Quaternion::RotX(a).GetRotation(),Rotation::RotX(a),1e-12));
+        CPPUNIT_ASSERT(Equal(Quaternion::RotY(a).GetRotation(),Rotation::RotY(a),1e-12));
+        CPPUNIT_ASSERT(Equal(Quaternion::RotZ(a).GetRotation(),Rotation::RotZ(a),1e-12));
+        Vector axis = v/v.Norm();
+        CPPUNIT_ASSERT(Equal(Quaternion::Rot2(axis,a).GetRotation(),Rotation::Rot2(axis,a),1e-12));
+    }
+    // q and -q are the same rotation
+    Quaternion q(Rotation::RPY(0.1,0.2,0.3));
+    CPPUNIT_ASSERT(Equal(q,Quaternion(-q.x,-q.y,-q.z,-q.w)));
+    CPPUNIT_ASSERT(!Equal(q,Quaternion::Identity()));
+}
+
+// error of a in units in the last place of the reference ref
+static double UlpError(double a,long double ref) {
+    double r = static_cast<double>(ref);
+    double ulp = std::nextafter(std::fabs(r),HUGE_VAL)-std::fabs(r);
+    return static_cast<double>(std::fabs(a-ref)/ulp);
+}
+
+void FramesTest::TestSinCosPack() {
+    // scalar version
+    double sn,cs;
+    SinCos(0.3,sn,cs);
+    CPPUNIT_ASSERT_EQUAL(sin(0.3),sn);
+    CPPUNIT_ASSERT_EQUAL(cos(0.3),cs);
+
+    // documented accuracy of the pack version
+    const double ranges[] = {PI,100.0,1e4,1e8};
+    const int n = 1003;    // not a multiple of DoublePack::size
+    std::vector<double> angle(n),s(n),c(n);
+    for (int r=0;r<4;++r) {
+        for (int i=0;i<n;++i)
+            angle[i] = ranges[r]*(2.0*rand()/RAND_MAX-1.0);
+        angle[0] = 0.0;
+        angle[1] = ranges[r];
+        SinCos(&angle[0],&s[0],&c[0],n);
+        for (int i=0;i<n;++i) {
+            long double ref_s = sinl(static_cast<long double>(angle[i]));
+            long double ref_c = cosl(static_cast<long double>(angle[i]));
+            CPPUNIT_ASSERT(UlpError(s[i],ref_s) < 2.0 || std::fabs(s[i]-ref_s) < 1e-24*std::fabs(angle[i]));
+            CPPUNIT_ASSERT(UlpError(c[i],ref_c) < 2.0 || std::fabs(c[i]-ref_c) < 1e-24*std::fabs(angle[i]));
+        }
+        CPPUNIT_ASSERT_EQUAL(0.0,s[0]);
+        CPPUNIT_ASSERT_EQUAL(1.0,c[0]);
+    }
+    // exact multiples of pi/2 land on the right quadrant
+    for (int k=-8;k<=8;++k) {
+        DoublePack spack,cpack;
+        SinCos(DoublePack(k*PI/2),spack,cpack);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(sin(k*PI/2),spack.Get(0),1e-15);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(cos(k*PI/2),cpack.Get(DoublePack::size-1),1e-15);
+    }
+}
+
+// uses all functions of rall1d.h :
+template <class T>
+T RallTestFunction(const T& x,const T& y,const T& z) {
+    T r = atan2(y,x)*sin(z)+cos(y)/sqrt(x*x+T(1.0));
+    r += exp(x)*log(y+2.0)-tan(z)*sinh(x)+cosh(y)/(1.0+tanh(z));
+    r -= atan(x*y)+hypot(y,z)*asin(0.5*x)-acos(0.3*z)/sqr(y-3.0);
+    r *= pow(x+2.0,1.5);
+    r /= 2.0-x/z;
+    return r;
+}
+
+void FramesTest::TestRall1dN() {
+    typedef Rall1dN<3> doubleN;
+    double v[3] = {0.3,-0.7,1.1};
+    doubleN xN = doubleN::Variable(v[0],0);
+    doubleN yN = doubleN::Variable(v[1],1);
+    doubleN zN = doubleN::Variable(v[2],2);
+    doubleN rN = RallTestFunction(xN,yN,zN);
+    // against one evaluation with Rall1d for every direction :
+    for (int i=0;i<3;++i) {
+        Rall1d<double> x(v[0],i==0 ? 1.0 : 0.0);
+        Rall1d<double> y(v[1],i==1 ? 1.0 : 0.0);
+        Rall1d<double> z(v[2],i==2 ? 1.0 : 0.0);
+        Rall1d<double> r = RallTestFunction(x,y,z);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(r.t,rN.t,1e-14);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(r.grad,rN.grad(i),1e-13);
+    }
+
+    doubleN a = abs(-xN*yN);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-v[0]*v[1],a.t,1e-15);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-v[1],a.grad(0),1e-15);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-v[0],a.grad(1),1e-15);
+    CPPUNIT_ASSERT(Equal(xN*yN/yN,xN,1e-15));
+    CPPUNIT_ASSERT(!Equal(xN,yN,1e-15));
+    CPPUNIT_ASSERT(xN+yN==yN+xN);
+    CPPUNIT_ASSERT(doubleN::Zero()!=doubleN::Identity());
+
+    // as the scalar type of the frames :
+    FrameT<doubleN> F(RotationT<doubleN>::RotX(xN)*RotationT<doubleN>::RotY(yN),
+                      VectorT<doubleN>(xN,yN,zN));
+    VectorT<doubleN> p = F*VectorT<doubleN>(doubleN(1.0),doubleN(2.0),doubleN(3.0));
+    Frame F0(Rotation::RotX(v[0])*Rotation::RotY(v[1]),Vector(v[0],v[1],v[2]));
+    CPPUNIT_ASSERT(Equal(F0*Vector(1,2,3),Vector(p(0).t,p(1).t,p(2).t),1e-15));
+    const double h=1e-6;
+    for (int i=0;i<3;++i) {
+        double vp[3] = {v[0],v[1],v[2]};
+        double vm[3] = {v[0],v[1],v[2]};
+        vp[i]+=h;
+        vm[i]-=h;
+        Vector dp = (Frame(Rotation::RotX(vp[0])*Rotation::RotY(vp[1]),Vector(vp[0],vp[1],vp[2]))*Vector(1,2,3)
+                    -Frame(Rotation::RotX(vm[0])*Rotation::RotY(vm[1]),Vector(vm[0],vm[1],vm[2]))*Vector(1,2,3))/(2*h);
+        for (int r=0;r<3;++r)
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(dp(r),p(r).grad(i),1e-8);
+    }
+}
+
+void FramesTest::TestFrameVelAcc() {
+    // the written out operators against the generic ones
+    Rotation R1 = Rotation::RPY(0.3,-0.5,1.2);
+    Rotation R2 = Rotation::Rot(Vector(1,2,-1),0.7);
+    FrameVel a(RotationVel(R1,Vector(0.2,-1.1,0.4)),VectorVel(Vector(1,2,3),Vector(-0.3,0.8,0.5)));
+    FrameVel b(RotationVel(R2,Vector(-0.6,0.3,0.9)),VectorVel(Vector(-2,0.5,1),Vector(0.7,0.1,-0.4)));
+    Frame f(R2,Vector(0.4,-0.2,0.6));
+    VectorVel x(Vector(0.5,-1,2),Vector(1.5,0.2,-0.7));
+    CPPUNIT_ASSERT(Equal(a*b,FrameVel(a.M*b.M,a.M*b.p+a.p),1e-14));
+    CPPUNIT_ASSERT(Equal(a*f,FrameVel(a.M*f.M,a.M*f.p+a.p),1e-14));
+    CPPUNIT_ASSERT(Equal(a*x,a.M*x+a.p,1e-14));
+    CPPUNIT_ASSERT(Equal(a*x.p,a.M*x.p+a.p,1e-14));
+    CPPUNIT_ASSERT(Equal(a.Inverse(x),a.M.Inverse(x-a.p),1e-14));
+    CPPUNIT_ASSERT(Equal(a.Inverse(x.p),a.M.Inverse(x.p-a.p),1e-14));
+    CPPUNIT_ASSERT(Equal(a.Inverse(),FrameVel(a.M.Inverse(),-a.M.Inverse(a.p)),1e-14));
+    CPPUNIT_ASSERT(Equal(a*a.Inverse(),FrameVel::Identity(),1e-14));
+    TwistVel t(x,VectorVel(Vector(0.1,0.2,0.3),Vector(-0.4,0.5,0.6)));
+    CPPUNIT_ASSERT(Equal(t.RefPoint(b.p),TwistVel(t.vel+t.rot*b.p,t.rot),1e-14));
+
+    FrameAcc c(RotationAcc(R1,Vector(0.2,-1.1,0.4),Vector(0.9,0.3,-0.2)),
+               VectorAcc(Vector(1,2,3),Vector(-0.3,0.8,0.5),Vector(0.1,-0.6,1.3)));
+    FrameAcc d(RotationAcc(R2,Vector(-0.6,0.3,0.9),Vector(-0.5,1.2,0.4)),
+               VectorAcc(Vector(-2,0.5,1),Vector(0.7,0.1,-0.4),Vector(0.2,0.2,-0.9)));
+    VectorAcc y(Vector(0.5,-1,2),Vector(1.5,0.2,-0.7),Vector(-0.3,0.4,0.8));
+    CPPUNIT_ASSERT(Equal(c*d,FrameAcc(c.M*d.M,c.M*d.p+c.p),1e-14));
+    CPPUNIT_ASSERT(Equal(c*f,FrameAcc(c.M*f.M,c.M*f.p+c.p),1e-14));
+    CPPUNIT_ASSERT(Equal(c.M.Inverse(y),c.M.Inverse()*y,1e-14));
+    CPPUNIT_ASSERT(Equal(c.M.Inverse(y.p),c.M.Inverse()*y.p,1e-14));
+    CPPUNIT_ASSERT(Equal(c.Inverse(),FrameAcc(c.M.Inverse(),-c.M.Inverse(c.p)),1e-14));
+    CPPUNIT_ASSERT(Equal(c*c.Inverse(),FrameAcc::Identity(),1e-14));
+    TwistAcc u(y,VectorAcc(Vector(0.1,0.2,0.3),Vector(-0.4,0.5,0.6),Vector(0.7,-0.8,0.9)));
+    CPPUNIT_ASSERT(Equal(u.RefPoint(d.p),TwistAcc(u.vel+u.rot*d.p,u.rot),1e-14));
+}
@@ -3,7 +3,14 @@
 
 #include <cppunit/extensions/HelperMacros.h>
 #include <frames.hpp>
+#include <framepack.hpp>
+#include <framequat.hpp>
+#include <framescalar.hpp>
+#include <framevel.hpp>
+#include <frameacc.hpp>
 #include <jntarray.hpp>
+#include <utilities/rall1d.h>
+#include <utilities/rall1dN.h>
 
 using namespace ARMstrongKDL;
 
@@ -21,6 +28,11 @@ class FramesTest : public CppUnit::TestFixture
     CPPUNIT_TEST(TestRotationDiff);
     CPPUNIT_TEST(TestEuler);
     CPPUNIT_TEST(TestGetRotAngle);
+    CPPUNIT_TEST(TestFramePack);
+    CPPUNIT_TEST(TestFrameQuat);
+    CPPUNIT_TEST(TestSinCosPack);
+    CPPUNIT_TEST(TestRall1dN);
+    CPPUNIT_TEST(TestFrameVelAcc);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -39,6 +51,11 @@ public:
 	void TestRotationDiff();
 	void TestEuler();
 	void TestGetRotAngle();
+	void TestFramePack();
+	void TestFrameQuat();
+	void TestSinCosPack();
+	void TestRall1dN();
+	void TestFrameVelAcc();
 
 private:
     void TestVector2(Vector& v);
@@ -122,6 +122,27 @@ void KinFamTest::SegmentTest()
     f1=s.getJoint().pose(q)*f;
     CPPUNIT_ASSERT_EQUAL(f1,s.pose(q));
     CPPUNIT_ASSERT_EQUAL(s.getJoint().twist(qdot).RefPoint(f1.p),s.twist(q,qdot));
+
+    // applyPose composes in place, for all joint types
+    Vector axis(1,-2,3),origin(0.3,0.2,-0.1);
+    axis.Normalize();
+    Joint joints[] = {Joint(Joint::None),Joint(Joint::RotX,2.0,0.1),Joint(Joint::RotY,2.0,0.1),
+                      Joint(Joint::RotZ,2.0,0.1),Joint(Joint::TransX,2.0,0.1),Joint(Joint::TransY,2.0,0.1),
+                      Joint(Joint::TransZ,2.0,0.1),Joint(origin,axis,Joint::RotAxis,2.0,0.1),
+                      Joint(origin,axis,Joint::TransAxis,2.0,0.1)};
+    for (unsigned int i=0;i<sizeof(joints)/sizeof(joints[0]);++i) {
+        Frame parent;
+        random(parent);
+        random(f);
+        random(q);
+        s = Segment(joints[i],f);
+        f1 = parent;
+        s.getJoint().applyPose(f1,q);
+        CPPUNIT_ASSERT(Equal(parent*s.getJoint().pose(q),f1,1e-12));
+        f1 = parent;
+        s.applyPose(f1,q);
+        CPPUNIT_ASSERT(Equal(parent*s.pose(q),f1,1e-12));
+    }
 }
 
 void KinFamTest::ChainTest()
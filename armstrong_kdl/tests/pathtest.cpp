@@ -0,0 +1,347 @@
+#include "pathtest.hpp"
+#include <rotational_interpolation_sa.hpp>
+CPPUNIT_TEST_SUITE_REGISTRATION( PathTest );
+
+using namespace ARMstrongKDL;
+
+void PathTest::setUp()
+{
+}
+
+void PathTest::tearDown()
+{
+}
+
+void PathTest::TestArcLengthTable_Line()
+{
+	// rotation dominates, s is not the physical length
+	Path_Line line(Frame(Rotation::Identity(), Vector(0, 0, 0)),
+				   Frame(Rotation::RotZ(PI/2), Vector(0.5, 0, 0)),
+				   new RotationalInterpolation_SingleAxis(), 1.0);
+	ArcLengthTable table(line, 10);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(line.PathLength(), table.PathLength(), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, table.ArcLength(), epsilon);
+	for (double l = 0; l <= 0.5; l += 0.01) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(line.LengthToS(l), table.LengthToS(l), epsilon);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(l, table.SToLength(table.LengthToS(l)), epsilon);
+	}
+	// out of range is clamped
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, table.LengthToS(-1.0), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(line.PathLength(), table.LengthToS(1.0), epsilon);
+}
+
+void PathTest::TestArcLengthTable_RoundedComposite()
+{
+	const double radius = 0.1;
+	Path_RoundedComposite path(radius, 0.5, new RotationalInterpolation_SingleAxis());
+	path.Add(Frame(Rotation::Identity(), Vector(0, 0, 0)));
+	path.Add(Frame(Rotation::RotZ(0.9*PI), Vector(1, 0, 0)));
+	path.Add(Frame(Rotation::RotZ(PI/4), Vector(1, 1, 0)));
+	path.Finish();
+
+	// 2 lines of 1-radius and a quarter circle
+	double arclength = 2*(1-radius) + radius*PI/2;
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(arclength, path.SToLength(path.PathLength()), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(path.PathLength(), path.LengthToS(arclength), epsilon);
+
+	// constant speed sampling gives equally spaced positions on the lines
+	double l = 0.2;
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(l, path.Pos(path.LengthToS(l)).p.x(), epsilon);
+	l = arclength - 0.2;
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.8, path.Pos(path.LengthToS(l)).p.y(), epsilon);
+	// and on the circle
+	l = (1-radius) + radius*PI/4;
+	Vector center(1-radius, radius, 0);
+	Vector p = path.Pos(path.LengthToS(l)).p - center;
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(radius*sqrt(0.5), p.x(), 1e-5);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(-radius*sqrt(0.5), p.y(), 1e-5);
+
+	for (l = 0; l <= arclength; l += 0.01) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(l, path.SToLength(path.LengthToS(l)), epsilon);
+	}
+
+	// the clone keeps the table and the geometry, also of the circle
+	Path* clone = path.Clone();
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(path.PathLength(), clone->PathLength(), epsilon);
+	for (l = 0; l <= arclength; l += 0.05) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(path.LengthToS(l), clone->LengthToS(l), epsilon);
+	}
+	for (double s = 0; s <= path.PathLength(); s += 0.05) {
+		CPPUNIT_ASSERT(Equal(path.Pos(s), clone->Pos(s), 1e-12));
+	}
+	delete clone;
+
+	Path_Circle circle(Frame(Rotation::RotZ(0.5), Vector(0, 0, 0)), Vector(0, 1, 0), Vector(1, 0, 0),
+					   Rotation::RotZ(1.5), 0.75*PI, new RotationalInterpolation_SingleAxis(), 0.5);
+	clone = circle.Clone();
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(circle.PathLength(), clone->PathLength(), epsilon);
+	for (l = 0; l <= 0.75*PI; l += 0.05) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(circle.LengthToS(l), clone->LengthToS(l), epsilon);
+	}
+	for (double s = 0; s <= circle.PathLength(); s += 0.05) {
+		CPPUNIT_ASSERT(Equal(circle.Pos(s), clone->Pos(s), 1e-12));
+	}
+	delete clone;
+}
+
+void PathTest::TestCircle_Clone()
+{
+	// a quarter circle, the clone takes the angle in radians
+	Path_Circle circle(Frame(Rotation::Identity(), Vector(1, 0, 0)), Vector(0, 0, 0), Vector(0, 1, 0),
+					   Rotation::RotZ(PI/2), PI/2, new RotationalInterpolation_SingleAxis(), 1.0);
+	Path* clone = circle.Clone();
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(PI/2, circle.PathLength(), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(circle.PathLength(), clone->PathLength(), epsilon);
+	for (double s = 0; s <= circle.PathLength(); s += 0.1) {
+		CPPUNIT_ASSERT(Equal(circle.Pos(s), clone->Pos(s), 1e-12));
+	}
+	CPPUNIT_ASSERT(Equal(circle.Pos(circle.PathLength()), clone->Pos(clone->PathLength()), 1e-12));
+	delete clone;
+}
+
+void PathTest::TestRoundedComposite_Streaming()
+{
+	const int n = 20;
+	std::vector<Frame> points;
+	for (int i = 0; i < n; ++i) {
+		points.push_back(Frame(Rotation::RPY(0.1*i, 0, 0.2*i), Vector(i, (i%2)*0.5, 0.1*(i%3))));
+	}
+	Path_RoundedComposite reference(0.1, 0.5, new RotationalInterpolation_SingleAxis());
+	for (int i = 0; i < n; ++i) {
+		reference.Add(points[i]);
+	}
+	reference.Finish();
+
+	const int maxnrofsegments = 6;
+	Path_RoundedComposite stream(0.1, 0.5, new RotationalInterpolation_SingleAxis());
+	stream.SetMaxNrOfSegments(maxnrofsegments);
+	double s = 0;
+	for (int i = 0; i < n; ++i) {
+		stream.Add(points[i]);
+		if (i == n-1)
+			stream.Finish();
+		CPPUNIT_ASSERT(stream.GetNrOfSegments() <= maxnrofsegments+1);
+		if (stream.GetNrOfSegments() == 0)
+			continue;
+		// execute the part of the path that is known
+		for (; s <= stream.PathLength(); s += 0.05) {
+			CPPUNIT_ASSERT(Equal(reference.Pos(s), stream.Pos(s), 1e-12));
+			CPPUNIT_ASSERT(Equal(reference.Vel(s, 1.0), stream.Vel(s, 1.0), 1e-12));
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(reference.SToLength(s), stream.SToLength(s), epsilon);
+		}
+		// and discard it
+		stream.RemoveSegmentsBefore(s);
+		if (stream.GetNrOfSegments() > 0)
+			CPPUNIT_ASSERT(stream.GetLengthToStartOfSegment(0) <= s);
+	}
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(reference.PathLength(), stream.PathLength(), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(reference.SToLength(reference.PathLength()),
+								 stream.SToLength(stream.PathLength()), epsilon);
+
+	// the window alone bounds the number of segments
+	Path_RoundedComposite window(0.1, 0.5, new RotationalInterpolation_SingleAxis());
+	window.SetMaxNrOfSegments(maxnrofsegments);
+	for (int i = 0; i < n; ++i) {
+		window.Add(points[i]);
+		CPPUNIT_ASSERT(window.GetNrOfSegments() <= maxnrofsegments);
+	}
+	window.Finish();
+	s = window.GetLengthToStartOfSegment(0);
+	CPPUNIT_ASSERT(s > 0);
+	CPPUNIT_ASSERT(Equal(reference.Pos(s), window.Pos(s), 1e-12));
+	s = window.PathLength();
+	CPPUNIT_ASSERT(Equal(reference.Pos(s), window.Pos(s), 1e-12));
+}
+
+void PathTest::TestSpline()
+{
+	std::vector<Frame> points;
+	points.push_back(Frame(Rotation::Identity(), Vector(0, 0, 0)));
+	points.push_back(Frame(Rotation::RPY(0.3, -0.2, 2.5), Vector(1, 0, 0)));
+	points.push_back(Frame(Rotation::RPY(0.1, 0.4, -2.9), Vector(1, 1, 0.2)));
+	points.push_back(Frame(Rotation::RotX(1.0), Vector(0, 1, 0)));
+	points.push_back(Frame(Rotation::RotX(1.0), Vector(0, 1, 1)));
+	Path_Spline path(points, 0.5);
+
+	// passes through the way-points
+	CPPUNIT_ASSERT_EQUAL(5, path.GetNrOfPoints());
+	for (int i = 0; i < path.GetNrOfPoints(); ++i) {
+		CPPUNIT_ASSERT(Equal(points[i], path.Pos(path.GetLengthToPoint(i)), 1e-9));
+	}
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(path.GetLengthToPoint(4), path.PathLength(), epsilon);
+
+	// velocity and acceleration are the derivatives of the position and velocity,
+	// (diff() neglects rotations below epsilon, h can not be too small)
+	const double h = 1e-4;
+	const double sd = 0.7, sdd = -0.3;
+	for (double s = h; s < path.PathLength() - h; s += 0.05) {
+		Twist vel = diff(path.Pos(s - h*sd), path.Pos(s + h*sd), 2*h);
+		CPPUNIT_ASSERT(Equal(vel, path.Vel(s, sd), 1e-6));
+		// d/dt Vel(s(t),sd(t)) with sd(t) = sd + sdd*t
+		Twist acc = (path.Vel(s + h*sd, sd + h*sdd) - path.Vel(s - h*sd, sd - h*sdd))/(2*h);
+		CPPUNIT_ASSERT(Equal(acc, path.Acc(s, sd, sdd), 1e-5));
+	}
+
+	// velocity and acceleration are continuous at the way-points
+	for (int i = 1; i < path.GetNrOfPoints() - 1; ++i) {
+		double s = path.GetLengthToPoint(i);
+		CPPUNIT_ASSERT(Equal(path.Vel(s - 1e-9, sd), path.Vel(s + 1e-9, sd), 1e-7));
+		CPPUNIT_ASSERT(Equal(path.Acc(s - 1e-9, sd, sdd), path.Acc(s + 1e-9, sd, sdd), 1e-7));
+	}
+
+	// arc length lookup
+	double arclength = 0;
+	const int nrofsamples = 10000;
+	for (int i = 0; i < nrofsamples; ++i) {
+		double ds = path.PathLength()/nrofsamples;
+		arclength += (path.Pos((i+1)*ds).p - path.Pos(i*ds).p).Norm();
+	}
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(path.PathLength(), path.LengthToS(arclength), 1e-4);
+
+	// write and read back
+	std::stringstream ss;
+	path.Write(ss);
+	Path* read = Path::Read(ss);
+	CPPUNIT_ASSERT_EQUAL(Path::ID_SPLINE, read->getIdentifier());
+	for (double s = 0; s < path.PathLength(); s += 0.1) {
+		CPPUNIT_ASSERT(Equal(path.Pos(s), read->Pos(s), 1e-5));
+	}
+	delete read;
+
+	// consecutive equal way-points are not allowed
+	Path_Spline invalid(0.5);
+	invalid.Add(points[0]);
+	invalid.Add(points[0]);
+	bool thrown = false;
+	try {
+		invalid.Finish();
+	} catch (Error_MotionPlanning_Not_Feasible& e) {
+		thrown = (e.GetType() == 3108);
+	}
+	CPPUNIT_ASSERT(thrown);
+}
+
+void PathTest::TestBinaryIO()
+{
+	Trajectory_Composite traj;
+	// rounded composite with a trapezoidal profile, streamed with a limited number of segments
+	Path_RoundedComposite* rounded = new Path_RoundedComposite(0.1, 0.5, new RotationalInterpolation_SingleAxis());
+	rounded->SetMaxNrOfSegments(4);
+	for (int i = 0; i < 6; ++i) {
+		rounded->Add(Frame(Rotation::RPY(0.1*i, 0, 0.3*i), Vector(i, (i%2)*0.5, 0)));
+	}
+	rounded->Finish();
+	VelocityProfile_Trap* trap = new VelocityProfile_Trap(0.5, 0.2);
+	trap->SetProfile(rounded->GetLengthToStartOfSegment(0), rounded->PathLength());
+	traj.Add(new Trajectory_Segment(rounded, trap));
+	// spline with a jerk limited profile, planned online
+	std::vector<Frame> points;
+	points.push_back(Frame(Rotation::RPY(0.5, 0, 1.5), Vector(5, 0.5, 0)));
+	points.push_back(Frame(Rotation::RotX(1.0), Vector(6, 1, 0)));
+	points.push_back(Frame(Rotation::RotY(0.5), Vector(6, 2, 1)));
+	Path_Spline* spline = new Path_Spline(points, 0.5);
+	VelocityProfile_JerkLimited* jerk = new VelocityProfile_JerkLimited(0.5, 0.2, 0.4);
+	jerk->SetProfile(0, 0.1, 0.05, spline->PathLength());
+	traj.Add(new Trajectory_Segment(spline, jerk));
+	// line and circle with a spline profile
+	Path_Composite* comp = new Path_Composite();
+	comp->Add(new Path_Line(Frame(Rotation::RotY(0.5), Vector(6, 2, 1)), Frame(Rotation::RotZ(0.5), Vector(6, 3, 1)),
+							new RotationalInterpolation_SingleAxis(), 0.5));
+	comp->Add(new Path_Circle(Frame(Rotation::RotZ(0.5), Vector(6, 3, 1)), Vector(6, 3.5, 1), Vector(7, 3, 1),
+							  Rotation::RotZ(1.0), PI/2, new RotationalInterpolation_SingleAxis(), 0.5));
+	comp->LengthToS(0.1);
+	VelocityProfile_Spline* splineprof = new VelocityProfile_Spline();
+	splineprof->SetProfileDuration(0, 0.1, 0, comp->PathLength(), 0, 0, 4.0);
+	traj.Add(new Trajectory_Segment(comp, splineprof));
+	traj.Add(new Trajectory_Stationary(1.0, traj.Pos(traj.Duration())));
+
+	std::stringstream ss;
+	{
+		BinaryWriter w(ss);
+		traj.WriteBinary(w);
+	}
+	std::string buffer = ss.str();
+	BinaryReader r(buffer.data(), buffer.size());
+	Trajectory* read = Trajectory::ReadBinary(r);
+	CPPUNIT_ASSERT(r.AtEnd());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(traj.Duration(), read->Duration(), epsilon);
+	for (double t = 0; t <= traj.Duration(); t += 0.1) {
+		CPPUNIT_ASSERT(Equal(traj.Pos(t), read->Pos(t), 1e-12));
+		CPPUNIT_ASSERT(Equal(traj.Vel(t), read->Vel(t), 1e-12));
+		CPPUNIT_ASSERT(Equal(traj.Acc(t), read->Acc(t), 1e-12));
+	}
+	delete read;
+
+	// the state of a streamed path is kept
+	std::stringstream ss2;
+	{
+		BinaryWriter w(ss2);
+		rounded->WriteBinary(w);
+	}
+	buffer = ss2.str();
+	BinaryReader r2(buffer.data(), buffer.size());
+	Path* path = Path::ReadBinary(r2);
+	CPPUNIT_ASSERT_EQUAL(Path::ID_ROUNDED_COMPOSITE, path->getIdentifier());
+	Path_RoundedComposite* readrounded = static_cast<Path_RoundedComposite*>(path);
+	CPPUNIT_ASSERT_EQUAL(rounded->GetNrOfSegments(), readrounded->GetNrOfSegments());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(rounded->SToLength(rounded->PathLength()), readrounded->SToLength(path->PathLength()), epsilon);
+	readrounded->Add(Frame(Rotation::Identity(), Vector(7, 0, 0)));
+	rounded->Add(Frame(Rotation::Identity(), Vector(7, 0, 0)));
+	CPPUNIT_ASSERT(Equal(rounded->Pos(rounded->PathLength()), path->Pos(path->PathLength()), 1e-12));
+	delete path;
+
+	// wrong header and truncated data
+	int errortype = 0;
+	try {
+		BinaryReader wrong("KDLA", 4);
+	} catch (Error_MotionIO_Binary& e) {
+		errortype = e.GetType();
+	}
+	CPPUNIT_ASSERT_EQUAL(2011, errortype);
+	errortype = 0;
+	try {
+		BinaryReader truncated(buffer.data(), buffer.size()/2);
+		delete Path::ReadBinary(truncated);
+	} catch (Error_MotionIO_Binary& e) {
+		errortype = e.GetType();
+	}
+	CPPUNIT_ASSERT_EQUAL(2013, errortype);
+
+	// corrupt sizes of a spline are rejected before anything is allocated
+	for (int corruption = 0; corruption < 3; ++corruption) {
+		std::stringstream ss3;
+		{
+			BinaryWriter w(ss3);
+			w.WriteUInt(BIN_PATH_SPLINE);
+			w.WriteDouble(0.5);
+			if (corruption == 0) {
+				w.WriteUInt(0xFFFFFFFF);
+			} else if (corruption == 1) {
+				w.WriteUInt(1);
+				w.WriteFrame(points[0]);
+				w.WriteUInt(1);
+				w.WriteDouble(0);
+			} else {
+				w.WriteUInt(2);
+				w.WriteFrame(points[0]);
+				w.WriteFrame(points[1]);
+				w.WriteUInt(3);
+				for (int i = 0; i < 3; ++i) {
+					w.WriteDouble(i);
+				}
+			}
+			for (int i = 0; i < 64; ++i) {
+				w.WriteDouble(0);
+			}
+		}
+		buffer = ss3.str();
+		errortype = 0;
+		try {
+			BinaryReader corrupt(buffer.data(), buffer.size());
+			delete Path::ReadBinary(corrupt);
+		} catch (Error_MotionIO_Binary& e) {
+			errortype = e.GetType();
+		}
+		CPPUNIT_ASSERT_EQUAL(2013, errortype);
+	}
+}
@@ -0,0 +1,44 @@
+#ifndef PATHTEST_HPP
+#define PATHTEST_HPP
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <path_line.hpp>
+#include <path_circle.hpp>
+#include <path_composite.hpp>
+#include <path_roundedcomposite.hpp>
+#include <path_spline.hpp>
+#include <arclengthtable.hpp>
+#include <binary_io.hpp>
+#include <trajectory_segment.hpp>
+#include <trajectory_composite.hpp>
+#include <trajectory_stationary.hpp>
+#include <velocityprofile_trap.hpp>
+#include <velocityprofile_jerklimited.hpp>
+#include <velocityprofile_spline.hpp>
+#include <utilities/error.h>
+#include <sstream>
+
+class PathTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(PathTest);
+    CPPUNIT_TEST(TestArcLengthTable_Line);
+    CPPUNIT_TEST(TestArcLengthTable_RoundedComposite);
+    CPPUNIT_TEST(TestCircle_Clone);
+    CPPUNIT_TEST(TestRoundedComposite_Streaming);
+    CPPUNIT_TEST(TestSpline);
+    CPPUNIT_TEST(TestBinaryIO);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+    void TestArcLengthTable_Line();
+    void TestArcLengthTable_RoundedComposite();
+    void TestCircle_Clone();
+    void TestRoundedComposite_Streaming();
+    void TestSpline();
+    void TestBinaryIO();
+};
+
+#endif
@@ -515,6 +515,222 @@ void SolverTest::FkPosAndIkPosTest()
     FkPosAndIkPosLocal(chain4,fksolver4,iksolver4_givens);
 }
 
+void SolverTest::PieperIkTest()
+{
+    std::cout<<"KDL Pieper IK test"<<std::endl;
+    // Puma560, the first two axes intersect
+    Chain puma;
+    puma.addSegment(Segment(Joint(Joint::RotZ),Frame::DH(0.0,PI_2,0.0,0.0)));
+    puma.addSegment(Segment(Joint(Joint::RotZ),Frame::DH(0.4318,0.0,0.0,0.0)));
+    puma.addSegment(Segment(Joint(Joint::RotZ),Frame::DH(0.0203,-PI_2,0.15005,0.0)));
+    puma.addSegment(Segment(Joint(Joint::RotZ),Frame::DH(0.0,PI_2,0.4318,0.0)));
+    puma.addSegment(Segment(Joint(Joint::RotZ),Frame::DH(0.0,-PI_2,0.0,0.0)));
+    puma.addSegment(Segment(Joint(Joint::RotZ),Frame::DH(0.0,0.0,0.0,0.0)));
+    puma.addSegment(Segment(Joint(Joint::None),Frame(Vector(0.0,0.0,0.1))));
+
+    // general first three axes, a wrist with non orthogonal axes, fixed
+    // segments and joints with scale and offset
+    Chain general;
+    Rotation R;
+    Vector p;
+    random(R);random(p);
+    general.addSegment(Segment(Joint(Joint::None),Frame(R,p)));
+    for (int i=0;i<3;++i) {
+        random(R);random(p);
+        general.addSegment(Segment(Joint(Joint::RotZ,2.0,0.3),Frame(R,p)));
+    }
+    random(R);
+    general.addSegment(Segment(Joint(Vector(0.1,0.2,0.3),Vector(1.0,2.0,0.5),Joint::RotAxis),Frame(R,Vector(0.3,0.6,0.4))));
+    random(R);
+    general.addSegment(Segment(Joint(Joint::RotX),Frame(R)));
+    random(R);random(p);
+    general.addSegment(Segment(Joint(Joint::RotY,-1.0,0.1),Frame(R,p)));
+
+    Chain* chains[2] = {&puma,&general};
+    for (int c=0;c<2;++c) {
+        Chain& chain = *chains[c];
+        ChainFkSolverPos_recursive fksolver(chain);
+        ChainIkSolverPos_Pieper iksolver(chain);
+        CPPUNIT_ASSERT(iksolver.isSupported());
+        JntArray q(6),q_sol(6);
+        Frame F,F_sol;
+        std::vector<JntArray> solutions;
+        unsigned int total = 0;
+        for (int n=0;n<100;++n) {
+            for (unsigned int j=0;j<6;++j) {
+                random(q(j));
+                q(j) *= PI;
+            }
+            fksolver.JntToCart(q,F);
+            CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.CartToJnt(q,F,solutions));
+            CPPUNIT_ASSERT(solutions.size()>=1 && solutions.size()<=8);
+            total += solutions.size();
+            // the configuration itself is the nearest solution
+            CPPUNIT_ASSERT(Equal(q,solutions[0],1e-6));
+            double previous = 0.0;
+            for (unsigned int i=0;i<solutions.size();++i) {
+                fksolver.JntToCart(solutions[i],F_sol);
+                CPPUNIT_ASSERT(Equal(F,F_sol,1e-6));
+                double distance = (solutions[i].data-q.data).norm();
+                CPPUNIT_ASSERT(distance>=previous);
+                previous = distance;
+            }
+            CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.CartToJnt(q,F,q_sol));
+            CPPUNIT_ASSERT(Equal(q,q_sol,1e-6));
+        }
+        std::cout<<"average number of solutions: "<<total/100.0<<std::endl;
+    }
+
+    // all eight solutions of the Puma560
+    ChainFkSolverPos_recursive fksolver(puma);
+    ChainIkSolverPos_Pieper iksolver(puma);
+    JntArray q(6);
+    q(0) = 0.3; q(1) = -0.8; q(2) = 0.5; q(3) = 0.2; q(4) = 0.7; q(5) = -0.4;
+    Frame F;
+    fksolver.JntToCart(q,F);
+    std::vector<JntArray> solutions;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.CartToJnt(q,F,solutions));
+    CPPUNIT_ASSERT_EQUAL((size_t)8,solutions.size());
+
+    // out of reach
+    F.p = Vector(2.0,0.0,0.0);
+    CPPUNIT_ASSERT_EQUAL((int)ChainIkSolverPos_Pieper::E_NO_SOLUTION,iksolver.CartToJnt(q,F,solutions));
+    CPPUNIT_ASSERT(solutions.empty());
+    JntArray q_wrong(5);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,iksolver.CartToJnt(q_wrong,F,solutions));
+
+    // no spherical wrist
+    Chain no_wrist;
+    for (unsigned int i=0;i<puma.getNrOfSegments();++i) {
+        const Segment& segment = puma.getSegment(i);
+        no_wrist.addSegment(Segment(segment.getJoint(),segment.getFrameToTipZero()*Frame(Vector(0.0,0.05,0.0))));
+    }
+    ChainIkSolverPos_Pieper iksolver_no_wrist(no_wrist);
+    CPPUNIT_ASSERT(!iksolver_no_wrist.isSupported());
+    CPPUNIT_ASSERT_EQUAL((int)ChainIkSolverPos_Pieper::E_NOT_SPHERICAL_WRIST,iksolver_no_wrist.CartToJnt(q,F,solutions));
+    Chain prismatic;
+    prismatic.addSegment(Segment(Joint(Joint::TransZ)));
+    for (unsigned int i=1;i<puma.getNrOfSegments();++i)
+        prismatic.addSegment(puma.getSegment(i));
+    ChainIkSolverPos_Pieper iksolver_prismatic(prismatic);
+    CPPUNIT_ASSERT(!iksolver_prismatic.isSupported());
+
+    // the chain changed
+    puma.addSegment(Segment(Joint(Joint::RotZ)));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOT_UP_TO_DATE,iksolver.CartToJnt(q,F,solutions));
+    iksolver.updateInternalDataStructures();
+    CPPUNIT_ASSERT(!iksolver.isSupported());
+}
+
+static bool EqualAngles(const JntArray& a,const JntArray& b,double eps)
+{
+    for (unsigned int j=0;j<a.rows();++j)
+        if (fabs(atan2(sin(a(j)-b(j)),cos(a(j)-b(j))))>eps)
+            return false;
+    return true;
+}
+
+void SolverTest::SRSIkTest()
+{
+    std::cout<<"KDL SRS IK test"<<std::endl;
+    ChainFkSolverPos_recursive fksolver(kukaLWR);
+    ChainIkSolverPos_SRS iksolver(kukaLWR);
+    CPPUNIT_ASSERT(iksolver.isSupported());
+
+    JntArray q(7),q_sol(7);
+    Frame F,F_sol;
+    std::vector<JntArray> solutions;
+    std::vector<unsigned int> branches;
+    double psi,psi_sol;
+    unsigned int branch,branch_sol;
+    for (int n=0;n<100;++n) {
+        for (unsigned int j=0;j<7;++j) {
+            random(q(j));
+            q(j) *= 2.0;
+        }
+        fksolver.JntToCart(q,F);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.getArmAngle(q,psi,branch));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.CartToJnt(F,psi,solutions,&branches));
+        CPPUNIT_ASSERT_EQUAL(solutions.size(),branches.size());
+        CPPUNIT_ASSERT(solutions.size()<=8);
+        bool found = false;
+        for (unsigned int i=0;i<solutions.size();++i) {
+            fksolver.JntToCart(solutions[i],F_sol);
+            CPPUNIT_ASSERT(Equal(F,F_sol,1e-6));
+            CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.getArmAngle(solutions[i],psi_sol,branch_sol));
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0,atan2(sin(psi_sol-psi),cos(psi_sol-psi)),1e-6);
+            CPPUNIT_ASSERT_EQUAL(branches[i],branch_sol);
+            if (branches[i]==branch) {
+                CPPUNIT_ASSERT(EqualAngles(q,solutions[i],1e-6));
+                found = true;
+            }
+        }
+        CPPUNIT_ASSERT(found);
+        // the arm angle and branch of the initial configuration
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.CartToJnt(q,F,q_sol));
+        CPPUNIT_ASSERT(Equal(q,q_sol,1e-6));
+        // self motion
+        for (int i=0;i<8;++i) {
+            double psi_i = psi+i*PI/4;
+            if (iksolver.CartToJnt(F,psi_i,branch,q_sol)!=SolverI::E_NOERROR)
+                continue;
+            fksolver.JntToCart(q_sol,F_sol);
+            CPPUNIT_ASSERT(Equal(F,F_sol,1e-6));
+            iksolver.getArmAngle(q_sol,psi_sol,branch_sol);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0,atan2(sin(psi_sol-psi_i),cos(psi_sol-psi_i)),1e-6);
+        }
+    }
+
+    // feasible arm angles compared with a fine sampling
+    JntArray q_min(7),q_max(7);
+    for (unsigned int j=0;j<7;++j) {
+        q_max(j) = j%2 ? 120*deg2rad : 170*deg2rad;
+        q_min(j) = -q_max(j);
+    }
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.setJointLimits(q_min,q_max));
+    std::vector<ChainIkSolverPos_SRS::ArmAngleInterval> intervals;
+    for (int n=0;n<20;++n) {
+        for (unsigned int j=0;j<7;++j) {
+            random(q(j));
+            q(j) *= q_max(j);
+        }
+        fksolver.JntToCart(q,F);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.getFeasibleArmAngles(F,intervals));
+        iksolver.getArmAngle(q,psi,branch);
+        for (int i=0;i<720;++i) {
+            double psi_i = -PI+i*PI/360;
+            iksolver.CartToJnt(F,psi_i,solutions,&branches);
+            for (unsigned int b=0;b<8;++b) {
+                bool inside = false,near = false;
+                for (unsigned int k=0;k<intervals.size();++k) {
+                    if (intervals[k].branch!=b)
+                        continue;
+                    CPPUNIT_ASSERT(intervals[k].lower>=-PI && intervals[k].lower<PI);
+                    CPPUNIT_ASSERT(intervals[k].upper>intervals[k].lower);
+                    for (int w=-1;w<=1;++w) {
+                        double x = psi_i+w*2*PI;
+                        inside = inside || (x>intervals[k].lower && x<intervals[k].upper);
+                        near = near || fabs(x-intervals[k].lower)<1e-6 || fabs(x-intervals[k].upper)<1e-6;
+                    }
+                }
+                if (near)
+                    continue;
+                bool feasible = std::find(branches.begin(),branches.end(),b)!=branches.end();
+                CPPUNIT_ASSERT_EQUAL(feasible,inside);
+            }
+        }
+    }
+
+    // singular and unsupported cases
+    SetToZero(q);
+    CPPUNIT_ASSERT_EQUAL((int)ChainIkSolverPos_SRS::E_ARM_SINGULAR,iksolver.getArmAngle(q,psi,branch));
+    F = Frame(Vector(2.0,0.0,0.0));
+    CPPUNIT_ASSERT_EQUAL((int)ChainIkSolverPos_SRS::E_NO_SOLUTION,iksolver.CartToJnt(F,0.0,solutions));
+    ChainIkSolverPos_SRS iksolver_chain1(chain1);
+    CPPUNIT_ASSERT(!iksolver_chain1.isSupported());
+    CPPUNIT_ASSERT_EQUAL((int)ChainIkSolverPos_SRS::E_NOT_SRS,iksolver_chain1.CartToJnt(F,0.0,solutions));
+}
+
 void SolverTest::IkSingularValueTest()
 {
 	unsigned int maxiter = 30;
@@ -1093,6 +1309,884 @@ void SolverTest::VereshchaginTest()
     }
 }
 
+void SolverTest::IkVelWarmStartTest()
+{
+    std::cout<<"KDL-IK Vel Solver Tests with warm started SVD"<<std::endl;
+
+    // the decomposition itself, from scratch and against svd_eigen_HH
+    unsigned int nj = kukaLWR.getNrOfJoints();
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(6,nj);
+    Eigen::MatrixXd U(6,nj),V(Eigen::MatrixXd::Identity(nj,nj)),B(6,nj);
+    Eigen::VectorXd S(nj);
+    CPPUNIT_ASSERT(svd_eigen_Jacobi(A,U,S,V,B,1e-24,20)>0);
+    Eigen::MatrixXd U_hh(6,nj),V_hh(nj,nj);
+    Eigen::VectorXd S_hh(nj),tmp(nj);
+    CPPUNIT_ASSERT_EQUAL(0,svd_eigen_HH(A,U_hh,S_hh,V_hh,tmp));
+    CPPUNIT_ASSERT((S-S_hh).norm()<1e-12);
+    CPPUNIT_ASSERT((U*S.asDiagonal()*V.transpose()-A).norm()<1e-12);
+    CPPUNIT_ASSERT((V.transpose()*V-Eigen::MatrixXd::Identity(nj,nj)).norm()<1e-12);
+    Eigen::MatrixXd V0 = Eigen::MatrixXd::Identity(nj,nj);
+    CPPUNIT_ASSERT_EQUAL(-1,svd_eigen_Jacobi(A,U,S,V0,B,1e-24,1));
+
+    // the solvers along a trajectory, against the ones without warm start
+    ChainIkSolverVel_wdls wdls(kukaLWR),wdls_warm(kukaLWR);
+    JntArray opt_pos(nj),weights(nj);
+    for (unsigned int i=0;i<nj;i++)
+        weights(i) = 1.0;
+    ChainIkSolverVel_pinv_nso nso(kukaLWR,opt_pos,weights),nso_warm(kukaLWR,opt_pos,weights);
+    wdls_warm.setWarmStart(true);
+    nso_warm.setWarmStart(true);
+    JntArray q(nj),qdot(nj),qdot_warm(nj);
+    for (unsigned int i=0;i<nj;i++)
+        q(i) = 0.3+0.1*i;
+    Twist v(Vector(0.1,-0.2,0.05),Vector(0.02,0.1,-0.3));
+    const unsigned int ticks = 200;
+    for (unsigned int t=0;t<ticks;t++) {
+        CPPUNIT_ASSERT_EQUAL(wdls.CartToJnt(q,v,qdot),wdls_warm.CartToJnt(q,v,qdot_warm));
+        CPPUNIT_ASSERT(Equal(qdot,qdot_warm,1e-9));
+        CPPUNIT_ASSERT_EQUAL(nso.CartToJnt(q,v,qdot),nso_warm.CartToJnt(q,v,qdot_warm));
+        CPPUNIT_ASSERT(Equal(qdot,qdot_warm,1e-9));
+        Eigen::VectorXd S1(nj),S2(nj);
+        wdls.getSigma(S1);
+        wdls_warm.getSigma(S2);
+        CPPUNIT_ASSERT((S1-S2).norm()<1e-9);
+        // 1 kHz ticks
+        for (unsigned int i=0;i<nj;i++)
+            q(i) += 0.001*qdot(i);
+    }
+    const SVDWarmStartStats& stats = wdls_warm.getSVDStats();
+    CPPUNIT_ASSERT_EQUAL(ticks,stats.decompositions);
+    CPPUNIT_ASSERT_EQUAL(ticks-1,stats.warm);
+    CPPUNIT_ASSERT_EQUAL(0u,stats.fallbacks);
+    CPPUNIT_ASSERT(stats.sweeps<=3*stats.warm);
+    CPPUNIT_ASSERT_EQUAL(ticks-1,nso_warm.getSVDStats().warm);
+    CPPUNIT_ASSERT_EQUAL(0u,wdls.getSVDStats().warm);
+
+    // no sweeps allowed : every warm start falls back
+    wdls_warm.setWarmStart(true,0);
+    CPPUNIT_ASSERT_EQUAL(wdls.CartToJnt(q,v,qdot),wdls_warm.CartToJnt(q,v,qdot_warm));
+    CPPUNIT_ASSERT(Equal(qdot,qdot_warm,1e-9));
+    CPPUNIT_ASSERT_EQUAL(1u,wdls_warm.getSVDStats().fallbacks);
+    CPPUNIT_ASSERT_EQUAL(0u,wdls_warm.getSVDStats().last_sweeps);
+}
+
+void SolverTest::IkVelPriorityTest()
+{
+    std::cout<<"KDL-IK Vel Solver Tests for a stack of tasks"<<std::endl;
+
+    unsigned int nj = kukaLWR.getNrOfJoints();
+    ChainJntToJacSolver jacsolver(kukaLWR);
+    IkSolverVel_priority iksolver(nj);
+    JntArray q(nj),qdot(nj),qdot_ref(nj);
+    for (unsigned int i=0;i<nj;i++)
+        q(i) = 0.3+0.1*i;
+    Jacobian jac(nj);
+    jacsolver.JntToJac(q,jac);
+
+    // one Cartesian task is the pseudo inverse
+    Twist v(Vector(0.1,-0.2,0.05),Vector(0.02,0.1,-0.3));
+    ChainIkSolverVel_pinv pinv(kukaLWR);
+    pinv.CartToJnt(q,v,qdot_ref);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,
+                         iksolver.CartToJnt(std::vector<Jacobian>(1,jac),std::vector<Twist>(1,v),qdot));
+    CPPUNIT_ASSERT(Equal(qdot,qdot_ref,1e-9));
+    CPPUNIT_ASSERT_EQUAL(1u,iksolver.getNullSpaceDimension());
+
+    // position, orientation and a posture task
+    Eigen::MatrixXd J = jac.data;
+    Eigen::VectorXd x(6);
+    for (unsigned int i=0;i<6;i++)
+        x(i) = v(i);
+    std::vector<Eigen::MatrixXd> jacobians(3);
+    std::vector<Eigen::VectorXd> targets(3);
+    jacobians[0] = J.topRows(3);
+    targets[0] = x.head(3);
+    jacobians[1] = J.bottomRows(3);
+    targets[1] = x.tail(3);
+    jacobians[2] = Eigen::MatrixXd::Identity(nj,nj);
+    targets[2] = -0.5*q.data;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_DEGRADED,iksolver.CartToJnt(jacobians,targets,qdot));
+    CPPUNIT_ASSERT_EQUAL(3u,iksolver.getTaskRank(0));
+    CPPUNIT_ASSERT_EQUAL(3u,iksolver.getTaskRank(1));
+    CPPUNIT_ASSERT_EQUAL(1u,iksolver.getTaskRank(2));
+    CPPUNIT_ASSERT((J*qdot.data-x).norm()<1e-9);
+    // the posture in the null space of the jacobian
+    Eigen::MatrixXd Jpinv = J.completeOrthogonalDecomposition().pseudoInverse();
+    Eigen::VectorXd qdot_posture = Jpinv*x+(Eigen::MatrixXd::Identity(nj,nj)-Jpinv*J)*targets[2];
+    CPPUNIT_ASSERT((qdot.data-qdot_posture).norm()<1e-9);
+
+    // conflicting tasks : the second one is only solved as far as possible
+    jacobians.resize(2);
+    targets.resize(2);
+    jacobians[0] = J.topRows(3);
+    targets[0] = x.head(3);
+    jacobians[1] = J.topRows(2);
+    targets[1] = Eigen::VectorXd::Ones(2);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_DEGRADED,iksolver.CartToJnt(jacobians,targets,qdot));
+    CPPUNIT_ASSERT_EQUAL(0u,iksolver.getTaskRank(1));
+    CPPUNIT_ASSERT((J.topRows(3)*qdot.data-x.head(3)).norm()<1e-9);
+
+    // sizes
+    targets[1] = Eigen::VectorXd::Ones(3);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,iksolver.CartToJnt(jacobians,targets,qdot));
+    JntArray qdot_wrong(nj+1);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,
+                         iksolver.CartToJnt(std::vector<Jacobian>(1,jac),std::vector<Twist>(1,v),qdot_wrong));
+}
+
+void SolverTest::IkVelQPTest()
+{
+    std::cout<<"KDL-IK Vel Solver Tests with joint limits as constraints"<<std::endl;
+
+    unsigned int nj = kukaLWR.getNrOfJoints();
+    JntArray q(nj),q_min(nj),q_max(nj),v_max(nj),qdot(nj);
+    for (unsigned int i=0;i<nj;i++) {
+        q(i) = 0.3+0.1*i;
+        q_min(i) = -2.9;
+        q_max(i) = 2.9;
+        v_max(i) = 10.0;
+    }
+    const double dt = 0.001;
+    const double lambda = 0.01;
+    ChainIkSolverVel_qp iksolver(kukaLWR,q_min,q_max,v_max,dt,lambda);
+    Twist v(Vector(0.1,-0.2,0.05),Vector(0.02,0.1,-0.3));
+
+    // no limit active : the damped least squares solution
+    ChainJntToJacSolver jacsolver(kukaLWR);
+    Jacobian jac(nj);
+    jacsolver.JntToJac(q,jac);
+    Eigen::MatrixXd H = jac.data.transpose()*jac.data+lambda*lambda*Eigen::MatrixXd::Identity(nj,nj);
+    Eigen::VectorXd x(6);
+    for (unsigned int i=0;i<6;i++)
+        x(i) = v(i);
+    Eigen::VectorXd g = -jac.data.transpose()*x;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.CartToJnt(q,v,qdot));
+    CPPUNIT_ASSERT((qdot.data+H.ldlt().solve(g)).norm()<1e-9);
+    CPPUNIT_ASSERT_EQUAL(0u,iksolver.getNrActiveConstraints());
+
+    // velocity limits and a joint near its position limit
+    v = Twist(Vector(1.0,-2.0,0.5),Vector(0.2,1.0,-3.0));
+    for (unsigned int i=0;i<6;i++)
+        x(i) = v(i);
+    g = -jac.data.transpose()*x;
+    for (unsigned int i=0;i<nj;i++)
+        v_max(i) = 0.8;
+    iksolver.setVelocityLimits(v_max);
+    q_max(3) = q(3)+0.0002;
+    q_min(5) = q(5)-0.0001;
+    iksolver.setJointLimits(q_min,q_max);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_DEGRADED,iksolver.CartToJnt(q,v,qdot));
+    CPPUNIT_ASSERT(iksolver.getNrActiveConstraints()>0);
+    unsigned int iterations = iksolver.getNrIterations();
+    // the optimality conditions
+    Eigen::VectorXd grad = H*qdot.data+g;
+    for (unsigned int i=0;i<nj;i++) {
+        double lower = std::max(-v_max(i),(q_min(i)-q(i))/dt);
+        double upper = std::min(v_max(i),(q_max(i)-q(i))/dt);
+        CPPUNIT_ASSERT(qdot(i)>=lower-1e-12 && qdot(i)<=upper+1e-12);
+        if (qdot(i)<=lower+1e-12)
+            CPPUNIT_ASSERT(grad(i)>=-1e-9);
+        else if (qdot(i)>=upper-1e-12)
+            CPPUNIT_ASSERT(grad(i)<=1e-9);
+        else
+            CPPUNIT_ASSERT(std::abs(grad(i))<1e-9);
+    }
+    // the next call starts from this active set
+    JntArray qdot_warm(nj);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_DEGRADED,iksolver.CartToJnt(q,v,qdot_warm));
+    CPPUNIT_ASSERT(Equal(qdot,qdot_warm,1e-12));
+    CPPUNIT_ASSERT(iksolver.getNrIterations()<iterations);
+    CPPUNIT_ASSERT(iksolver.getNrIterations()<=2);
+
+    // outside the position limit : back at maximum velocity
+    q_max(3) = q(3)-0.1;
+    iksolver.setJointLimits(q_min,q_max);
+    iksolver.CartToJnt(q,v,qdot);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-v_max(3),qdot(3),1e-12);
+
+    JntArray q_wrong(nj+1);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,iksolver.CartToJnt(q_wrong,v,qdot));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,iksolver.setVelocityLimits(q_wrong));
+
+    // a long chain with little damping, cold started : the active set has
+    // to stop at the optimum and not on the rounding noise of the steps
+    Chain snake;
+    for (unsigned int i=0;i<28;i++)
+        snake.addSegment(Segment(Joint(i%3==0 ? Joint::RotZ : (i%3==1 ? Joint::RotY : Joint::RotX)),
+                                 Frame(Vector(0.0,0.01*(i%2),0.1))));
+    unsigned int ns = snake.getNrOfJoints();
+    JntArray qs(ns),qs_min(ns),qs_max(ns),vs_max(ns),qsdot(ns);
+    for (unsigned int i=0;i<ns;i++) {
+        qs_min(i) = -2.9;
+        qs_max(i) = 2.9;
+        vs_max(i) = 0.5;
+    }
+    ChainJntToJacSolver snake_jacsolver(snake);
+    Jacobian snake_jac(ns);
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> uniform(-1.0,1.0);
+    for (unsigned int trial=0;trial<50;trial++) {
+        for (unsigned int i=0;i<ns;i++)
+            qs(i) = 2.0*uniform(rng);
+        Twist vs(Vector(uniform(rng),uniform(rng),uniform(rng)),Vector(uniform(rng),uniform(rng),uniform(rng)));
+        ChainIkSolverVel_qp snake_solver(snake,qs_min,qs_max,vs_max,dt,lambda);
+        CPPUNIT_ASSERT((int)SolverI::E_NOERROR <= snake_solver.CartToJnt(qs,vs,qsdot));
+        snake_jacsolver.JntToJac(qs,snake_jac);
+        Eigen::VectorXd xs(6);
+        for (unsigned int i=0;i<6;i++)
+            xs(i) = vs(i);
+        Eigen::VectorXd grads = (snake_jac.data.transpose()*snake_jac.data+lambda*lambda*Eigen::MatrixXd::Identity(ns,ns))*qsdot.data
+            -snake_jac.data.transpose()*xs;
+        for (unsigned int i=0;i<ns;i++) {
+            if (qsdot(i)<=-vs_max(i)+1e-12)
+                CPPUNIT_ASSERT(grads(i)>=-1e-9);
+            else if (qsdot(i)>=vs_max(i)-1e-12)
+                CPPUNIT_ASSERT(grads(i)<=1e-9);
+            else
+                CPPUNIT_ASSERT(std::abs(grads(i))<1e-9);
+        }
+    }
+}
+
+void SolverTest::IkVelDlsTest()
+{
+    std::cout<<"KDL-IK Vel Solver Tests with a LDLT damped least squares"<<std::endl;
+
+    Twist v(Vector(0.1,-0.2,0.05),Vector(0.02,0.1,-0.3));
+    Eigen::VectorXd x(6);
+    for (unsigned int i=0;i<6;i++)
+        x(i) = v(i);
+    const double lambda = 0.01;
+
+    // J'*(J*J' + lambda^2*I)^-1*v, with the LDLT and with the SVD
+    Chain* chains[] = {&chain2,&motomansia10,&kukaLWR};
+    for (unsigned int c=0;c<sizeof(chains)/sizeof(chains[0]);c++) {
+        unsigned int nj = chains[c]->getNrOfJoints();
+        JntArray q(nj),qdot(nj),qdot_svd(nj);
+        for (unsigned int i=0;i<nj;i++)
+            q(i) = 0.3+0.1*i;
+        ChainJntToJacSolver jacsolver(*chains[c]);
+        Jacobian jac(nj);
+        jacsolver.JntToJac(q,jac);
+        Eigen::MatrixXd A = jac.data*jac.data.transpose()+lambda*lambda*Eigen::MatrixXd::Identity(6,6);
+        Eigen::VectorXd expected = jac.data.transpose()*A.ldlt().solve(x);
+
+        ChainIkSolverVel_dls iksolver(*chains[c],lambda);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.CartToJnt(q,v,qdot));
+        CPPUNIT_ASSERT((qdot.data-expected).norm()<1e-9);
+        CPPUNIT_ASSERT_EQUAL(-1.0,iksolver.getManipulability());
+        iksolver.setUseSVD(true);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.CartToJnt(q,v,qdot_svd));
+        CPPUNIT_ASSERT(Equal(qdot,qdot_svd,1e-9));
+    }
+
+    unsigned int nj = kukaLWR.getNrOfJoints();
+    JntArray q(nj),qdot(nj),qdot_svd(nj),qdot_pinv(nj);
+    for (unsigned int i=0;i<nj;i++)
+        q(i) = 0.3+0.1*i;
+    ChainIkSolverVel_dls iksolver(kukaLWR,0.1);
+    ChainIkSolverVel_pinv iksolver_pinv(kukaLWR);
+    iksolver_pinv.CartToJnt(q,v,qdot_pinv);
+
+    // far from singular no damping : the pseudo inverse solution
+    iksolver.setManipulabilityThreshold(1e-6);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.CartToJnt(q,v,qdot));
+    CPPUNIT_ASSERT_EQUAL(0.0,iksolver.getLastLambda());
+    CPPUNIT_ASSERT(Equal(qdot,qdot_pinv,1e-9));
+    double w = iksolver.getManipulability();
+    CPPUNIT_ASSERT(w>1e-6);
+    iksolver.setUseSVD(true);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.CartToJnt(q,v,qdot_svd));
+    CPPUNIT_ASSERT(Equal(qdot,qdot_svd,1e-9));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(w,iksolver.getManipulability(),1e-12);
+
+    // below the threshold the damping grows
+    iksolver.setManipulabilityThreshold(2*w);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_DEGRADED,iksolver.CartToJnt(q,v,qdot_svd));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.05,iksolver.getLastLambda(),1e-9);
+    iksolver.setUseSVD(false);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_DEGRADED,iksolver.CartToJnt(q,v,qdot));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.05,iksolver.getLastLambda(),1e-9);
+    CPPUNIT_ASSERT(Equal(qdot,qdot_svd,1e-9));
+
+    // stretched arm : singular without damping, bounded with damping
+    SetToZero(q);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_DEGRADED,iksolver.CartToJnt(q,v,qdot));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.1,iksolver.getLastLambda(),1e-9);
+    CPPUNIT_ASSERT(qdot.data.norm()<1e3);
+    iksolver.setManipulabilityThreshold(0.0);
+    iksolver.setLambda(0.0);
+    CPPUNIT_ASSERT_EQUAL((int)ChainIkSolverVel_dls::E_CONVERGE_PINV_SINGULAR,iksolver.CartToJnt(q,v,qdot));
+    iksolver.setUseSVD(true);
+    CPPUNIT_ASSERT_EQUAL((int)ChainIkSolverVel_dls::E_CONVERGE_PINV_SINGULAR,iksolver.CartToJnt(q,v,qdot));
+
+    JntArray q_wrong(nj+1);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,iksolver.CartToJnt(q_wrong,v,qdot));
+}
+
+void SolverTest::TreeIkPosLMATest()
+{
+    std::cout<<"KDL-IK Pos Solver Tests for a tree with several endpoints"<<std::endl;
+
+    // a torso with two arms and a head
+    Tree tree("base");
+    tree.addSegment(Segment("torso0",Joint("torso0_joint",Joint::RotZ),Frame(Vector(0.0,0.0,0.3))),"base");
+    tree.addSegment(Segment("torso1",Joint("torso1_joint",Joint::RotY),Frame(Vector(0.0,0.0,0.3))),"torso0");
+    const char* sides[] = {"left","right"};
+    for (unsigned int a=0;a<2;a++) {
+        std::string side(sides[a]);
+        double y = (a == 0 ? 0.2 : -0.2);
+        tree.addSegment(Segment(side+"0",Joint(side+"0_joint",Joint::RotY),Frame(Vector(0.0,y,0.0))),"torso1");
+        tree.addSegment(Segment(side+"1",Joint(side+"1_joint",Joint::RotX),Frame(Vector(0.0,0.0,-0.05))),side+"0");
+        tree.addSegment(Segment(side+"2",Joint(side+"2_joint",Joint::RotZ),Frame(Vector(0.0,0.0,-0.3))),side+"1");
+        tree.addSegment(Segment(side+"3",Joint(side+"3_joint",Joint::RotY),Frame(Vector(0.0,0.0,-0.3))),side+"2");
+        tree.addSegment(Segment(side+"4",Joint(side+"4_joint",Joint::RotZ),Frame(Vector(0.0,0.0,-0.05))),side+"3");
+        tree.addSegment(Segment(side+"5",Joint(side+"5_joint",Joint::RotY),Frame(Vector(0.0,0.0,-0.05))),side+"4");
+        tree.addSegment(Segment(side+"6",Joint(side+"6_joint",Joint::RotZ),Frame(Vector(0.0,0.0,-0.1))),side+"5");
+    }
+    tree.addSegment(Segment("head",Joint("head_joint",Joint::RotZ),Frame(Vector(0.0,0.0,0.2))),"torso1");
+    tree.addSegment(Segment("camera",Joint(Joint::Fixed),Frame(Rotation::RotY(0.3),Vector(0.1,0.0,0.05))),"head");
+    unsigned int nj = tree.getNrOfJoints();
+    CPPUNIT_ASSERT_EQUAL(17u,nj);
+
+    std::vector<std::string> endpoints;
+    endpoints.push_back("left6");
+    endpoints.push_back("right6");
+    endpoints.push_back("camera");
+    TreeIkSolverPos_LMA iksolver(tree,endpoints);
+    TreeFkSolverPos_recursive fksolver(tree);
+
+    // reachable goals for all endpoints
+    JntArray q(nj),q_init(nj),q_out(nj);
+    for (unsigned int i=0;i<nj;i++) {
+        q(i) = 0.5*std::sin(1.0+i);
+        q_init(i) = q(i)+0.3*std::cos(2.0*i);
+    }
+    Frames goals;
+    for (unsigned int k=0;k<endpoints.size();k++)
+        fksolver.JntToCart(q,goals[endpoints[k]],endpoints[k]);
+    double res = iksolver.CartToJnt(q_init,goals,q_out);
+    CPPUNIT_ASSERT(res>=0.0 && res<1e-5);
+    CPPUNIT_ASSERT(iksolver.getNrIterations()>0);
+    for (unsigned int k=0;k<endpoints.size();k++) {
+        Frame F;
+        fksolver.JntToCart(q_out,F,endpoints[k]);
+        CPPUNIT_ASSERT(Equal(F,goals[endpoints[k]],1e-5));
+    }
+
+    // the endpoints without a goal are free, the weights select the
+    // coordinates that matter
+    Frames hands;
+    hands["left6"] = goals["left6"];
+    hands["right6"] = Frame(goals["right6"].p+Vector(0.05,0.0,0.05));
+    Eigen::Matrix<double,6,1> L;
+    L << 1.0,1.0,1.0,0.0,0.0,0.0;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.setEndpointWeight("right6",L));
+    res = iksolver.CartToJnt(q_init,hands,q_out);
+    CPPUNIT_ASSERT(res>=0.0 && res<1e-5);
+    Frame F;
+    fksolver.JntToCart(q_out,F,"left6");
+    CPPUNIT_ASSERT(Equal(F,hands["left6"],1e-5));
+    fksolver.JntToCart(q_out,F,"right6");
+    CPPUNIT_ASSERT(Equal(F.p,hands["right6"].p,1e-5));
+
+    // joint limits
+    JntArray q_min(nj),q_max(nj);
+    for (unsigned int i=0;i<nj;i++) {
+        q_min(i) = q(i)-0.1;
+        q_max(i) = q(i)+0.1;
+    }
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.setJointLimits(q_min,q_max));
+    res = iksolver.CartToJnt(q_init,goals,q_out);
+    CPPUNIT_ASSERT(res>=0.0 && res<1e-5);
+    for (unsigned int i=0;i<nj;i++)
+        CPPUNIT_ASSERT(q_out(i)>=q_min(i) && q_out(i)<=q_max(i));
+
+    // errors
+    goals["left5"] = Frame::Identity();
+    CPPUNIT_ASSERT_EQUAL((double)TreeIkSolverPos_LMA::E_UNKNOWN_ENDPOINT,iksolver.CartToJnt(q_init,goals,q_out));
+    CPPUNIT_ASSERT_EQUAL((int)TreeIkSolverPos_LMA::E_UNKNOWN_ENDPOINT,iksolver.setEndpointWeight("left5",L));
+    JntArray q_wrong(nj+1);
+    CPPUNIT_ASSERT_EQUAL((double)SolverI::E_SIZE_MISMATCH,iksolver.CartToJnt(q_wrong,hands,q_out));
+}
+
+void SolverTest::MimicMapTest()
+{
+    std::cout<<"KDL Solver Tests in the reduced coordinates of mimic joints"<<std::endl;
+
+    // joint 2 follows joint 0, joint 5 follows joint 3
+    const Chain& chain = kukaLWR;
+    unsigned int nj = chain.getNrOfJoints();
+    unsigned int ns = chain.getNrOfSegments();
+    JntMimicMap map(nj);
+    CPPUNIT_ASSERT(map.setMimic(2,0,0.5,0.1));
+    CPPUNIT_ASSERT(map.setMimic(5,3,-1.0));
+    CPPUNIT_ASSERT(!map.setMimic(1,2));
+    CPPUNIT_ASSERT(!map.setMimic(0,1));
+    unsigned int nr = map.getNrOfIndependentJoints();
+    CPPUNIT_ASSERT_EQUAL(5u,nr);
+
+    // the same map from a description per joint
+    std::vector<JointMimic> mimic_joints(nj);
+    const unsigned int indices[] = {0,1,0,2,3,2,4};
+    for (unsigned int j=0;j<nj;j++) {
+        mimic_joints[j].reset(indices[j]);
+        mimic_joints[j].active = (j != 2 && j != 5);
+    }
+    mimic_joints[2].multiplier = 0.5;
+    mimic_joints[2].offset = 0.1;
+    mimic_joints[5].multiplier = -1.0;
+    JntMimicMap map2(mimic_joints);
+    CPPUNIT_ASSERT(map2.isValid());
+    CPPUNIT_ASSERT((map.getJacobian()-map2.getJacobian()).norm()==0.0);
+    mimic_joints[5].map_index = 6;
+    CPPUNIT_ASSERT(!JntMimicMap(mimic_joints).isValid());
+
+    JntArray q_r(nr),qdot_r(nr),qdotdot_r(nr),q(nj),qdot(nj),qdotdot(nj),q_back(nr);
+    for (unsigned int i=0;i<nr;i++) {
+        q_r(i) = 0.3+0.2*i;
+        qdot_r(i) = 0.5-0.3*i;
+        qdotdot_r(i) = 0.1*i-0.2;
+    }
+    CPPUNIT_ASSERT(map.toFull(q_r,q));
+    CPPUNIT_ASSERT(map.velocityToFull(qdot_r,qdot));
+    CPPUNIT_ASSERT(map.velocityToFull(qdotdot_r,qdotdot));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5*q_r(0)+0.1,q(2),1e-15);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-q_r(2),q(5),1e-15);
+    CPPUNIT_ASSERT(map.toReduced(q,q_back));
+    CPPUNIT_ASSERT(Equal(q_r,q_back,1e-15));
+    CPPUNIT_ASSERT((qdot.data-map.getJacobian()*qdot_r.data).norm()<1e-15);
+
+    // forward kinematics
+    ChainFkSolverPos_recursive fksolver(chain),fksolver_r(chain);
+    JntMimicMap wrong(nj+1);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,fksolver_r.setMimicMap(&wrong));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,fksolver_r.setMimicMap(&map));
+    Frame F,F_r;
+    fksolver.JntToCart(q,F);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,fksolver_r.JntToCart(q_r,F_r));
+    CPPUNIT_ASSERT(Equal(F,F_r,1e-15));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,fksolver_r.JntToCart(q,F_r));
+
+    // jacobian J*M
+    ChainJntToJacSolver jacsolver(chain),jacsolver_r(chain);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,jacsolver_r.setMimicMap(&map));
+    Jacobian jac(nj),jac_r(nr),jac_expected(nr);
+    jacsolver.JntToJac(q,jac);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,jacsolver_r.JntToJac(q_r,jac_r));
+    CPPUNIT_ASSERT(map.reduceJacobian(jac,jac_expected));
+    CPPUNIT_ASSERT((jac_r.data-jac_expected.data).norm()<1e-12);
+    CPPUNIT_ASSERT((jac_r.data-jac.data*map.getJacobian()).norm()<1e-12);
+
+    // inverse dynamics M'*tau
+    ChainIdSolver_RNE idsolver(chain,Vector(0.0,0.0,-9.81)),idsolver_r(chain,Vector(0.0,0.0,-9.81));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,idsolver_r.setMimicMap(&map));
+    Wrenches f_ext(ns);
+    JntArray tau(nj),tau_r(nr),tau_expected(nr);
+    idsolver.CartToJnt(q,qdot,qdotdot,f_ext,tau);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,idsolver_r.CartToJnt(q_r,qdot_r,qdotdot_r,f_ext,tau_r));
+    CPPUNIT_ASSERT(map.reduceTorques(tau,tau_expected));
+    CPPUNIT_ASSERT(Equal(tau_r,tau_expected,1e-10));
+
+    // position IK in the reduced coordinates
+    ChainIkSolverPos_LMA iksolver(chain,Eigen::Matrix<double,6,1>::Ones(),1e-6);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.setMimicMap(&map));
+    JntArray q_init(nr),q_out(nr),q_full(nj);
+    for (unsigned int i=0;i<nr;i++)
+        q_init(i) = q_r(i)+0.2;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.CartToJnt(q_init,F,q_out));
+    map.toFull(q_out,q_full);
+    fksolver.JntToCart(q_full,F_r);
+    CPPUNIT_ASSERT(Equal(F,F_r,1e-4));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,iksolver.CartToJnt(q,F,q_full));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.setMimicMap(0));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,iksolver.CartToJnt(q,F,q_full));
+}
+
+void SolverTest::ManipulabilityTest()
+{
+    std::cout<<"KDL Manipulability gradient Test"<<std::endl;
+
+    // a chain with a prismatic joint besides the revolute chains
+    Chain chain_trans;
+    chain_trans.addSegment(Segment(Joint(Joint::RotZ),Frame(Vector(0.0,0.0,0.4))));
+    chain_trans.addSegment(Segment(Joint(Joint::TransX),Frame(Vector(0.0,0.1,0.0))));
+    chain_trans.addSegment(Segment(Joint(Joint::RotY),Frame(Vector(0.0,0.0,0.3))));
+    chain_trans.addSegment(Segment(Joint(Joint::RotX),Frame(Vector(0.1,0.0,0.2))));
+    chain_trans.addSegment(Segment(Joint(Joint::TransZ),Frame(Vector(0.0,0.2,0.0))));
+    chain_trans.addSegment(Segment(Joint(Joint::RotZ),Frame(Vector(0.0,0.0,0.1))));
+    chain_trans.addSegment(Segment(Joint(Joint::RotY),Frame(Vector(0.05,0.0,0.1))));
+
+    const Chain* chains[] = {&kukaLWR,&chain2,&chain_trans};
+    const double h = 1e-6;
+    for (unsigned int c=0;c<3;c++) {
+        const Chain& chain = *chains[c];
+        unsigned int nj = chain.getNrOfJoints();
+        ChainJntToManipulabilitySolver solver(chain);
+        JntArray q(nj), dw(nj), dkappa(nj), dsigma(nj);
+        double w, kappa, sigma_min;
+        for (unsigned int trial=0;trial<5;trial++) {
+            for (unsigned int j=0;j<nj;j++)
+                q(j) = 1.3*sin(1.7*j+2.1*trial+0.3);
+            CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,
+                                 solver.JntToManipulability(q,w,dw,kappa,dkappa,sigma_min,dsigma));
+            CPPUNIT_ASSERT(w > 0.0);
+            const Eigen::VectorXd& S = solver.getSingularValues();
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(S.prod(),w,1e-12);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(S(0)/S(S.size()-1),kappa,1e-9*kappa);
+
+            // central differences of the values
+            for (unsigned int k=0;k<nj;k++) {
+                JntArray q_p(q), q_m(q);
+                q_p(k) += h;
+                q_m(k) -= h;
+                double w_p, w_m, kappa_p, kappa_m, sigma_p, sigma_m;
+                solver.JntToManipulability(q_p,w_p,kappa_p,sigma_p);
+                solver.JntToManipulability(q_m,w_m,kappa_m,sigma_m);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL((w_p-w_m)/(2*h),dw(k),1e-6*(1+std::abs(dw(k))));
+                CPPUNIT_ASSERT_DOUBLES_EQUAL((kappa_p-kappa_m)/(2*h),dkappa(k),1e-6*(1+std::abs(dkappa(k))));
+                CPPUNIT_ASSERT_DOUBLES_EQUAL((sigma_p-sigma_m)/(2*h),dsigma(k),1e-6*(1+std::abs(dsigma(k))));
+            }
+        }
+    }
+
+    // at the stretched singularity of the LWR sigma_min is zero
+    ChainJntToManipulabilitySolver solver(kukaLWR);
+    unsigned int nj = kukaLWR.getNrOfJoints();
+    JntArray q(nj), dw(nj), dkappa(nj), dsigma(nj), wrong(nj+1);
+    double w, kappa, sigma_min;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_DEGRADED,
+                         solver.JntToManipulability(q,w,dw,kappa,dkappa,sigma_min,dsigma));
+    CPPUNIT_ASSERT(std::isinf(kappa));
+    CPPUNIT_ASSERT_EQUAL(0.0,dkappa.data.norm());
+    // stretched but not in the zero configuration, sigma_min is only
+    // rounding errors
+    for (unsigned int j=0;j<nj;j++)
+        q(j) = 0.7*sin(1.3*j+0.4);
+    q(3) = 0.0;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_DEGRADED,
+                         solver.JntToManipulability(q,w,dw,kappa,dkappa,sigma_min,dsigma));
+    CPPUNIT_ASSERT(std::isinf(kappa));
+    CPPUNIT_ASSERT_EQUAL(0.0,dkappa.data.norm());
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,
+                         solver.JntToManipulability(q,w,wrong,kappa,dkappa,sigma_min,dsigma));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,
+                         solver.JntToManipulability(wrong,w,kappa,sigma_min));
+}
+
+void SolverTest::NullSpaceObjectiveTest()
+{
+    std::cout<<"KDL Null space objectives Test"<<std::endl;
+
+    const Chain& chain = kukaLWR;
+    unsigned int nj = chain.getNrOfJoints();
+    unsigned int ns = chain.getNrOfSegments();
+    JntArray q(nj), qdot(nj), q_min(nj), q_max(nj);
+    for (unsigned int j=0;j<nj;j++) {
+        q(j) = 0.8*sin(1.3*j+0.5);
+        q_min(j) = -2.0;
+        q_max(j) = 2.0;
+    }
+    q(1) = 1.5;
+    Jacobian jac(nj);
+    ChainJntToJacSolver jacsolver(chain);
+    ChainFkSolverPos_recursive fksolver(chain);
+
+    // the point jacobian against finite differences of the frames
+    NullSpaceState state;
+    jacsolver.JntToJac(q,jac);
+    state.jac = &jac;
+    state.updateFrames(chain,q);
+    Frame T;
+    fksolver.JntToCart(q,T,4);
+    CPPUNIT_ASSERT(Equal(T,state.frames[3],1e-12));
+    Vector p_local(0.05,-0.02,0.1);
+    Eigen::MatrixXd jac_p;
+    state.pointJacobian(3,T*p_local,jac_p);
+    for (unsigned int j=0;j<nj;j++) {
+        JntArray q_h(q);
+        q_h(j) += 1e-7;
+        Frame T_h;
+        fksolver.JntToCart(q_h,T_h,4);
+        Vector dp = (T_h*p_local-T*p_local)/1e-7;
+        for (unsigned int r=0;r<3;r++)
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(dp(r),jac_p(r,j),1e-5);
+    }
+
+    // every objective decreases its cost in the null space only
+    JointLimitObjective limits(q_min,q_max);
+    ManipulabilityObjective manipulability;
+    ObstacleObjective obstacles(0.2);
+    // at the elbow, the tip of segment 3 is the wrist which the self motion does not move
+    obstacles.addControlPoint(2,Vector::Zero(),0.05);
+    obstacles.addObstacle(state.frames[2].p+Vector(0.1,0.0,0.0),0.02);
+    NullSpaceObjective* objectives[] = {&limits,&manipulability,&obstacles};
+    ChainJntToManipulabilitySolver manipsolver(chain);
+    for (unsigned int o=0;o<3;o++) {
+        ChainIkSolverVel_pinv_nso solver(chain,0.00001,150,0.05);
+        solver.addObjective(*objectives[o]);
+        JntArray q_i(q);
+        Frame T_start, T_end;
+        fksolver.JntToCart(q_i,T_start);
+        double w_start, kappa, sigma_min;
+        manipsolver.JntToManipulability(q_i,w_start,kappa,sigma_min);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,solver.CartToJnt(q_i,Twist::Zero(),qdot));
+        double cost_start = objectives[o]->getCost();
+        double distance_start = obstacles.getMinimumDistance();
+        for (unsigned int i=0;i<50;i++) {
+            CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,solver.CartToJnt(q_i,Twist::Zero(),qdot));
+            jacsolver.JntToJac(q_i,jac);
+            CPPUNIT_ASSERT((jac.data*qdot.data).norm() < 1e-9);
+            Add(q_i,qdot,q_i);
+        }
+        solver.CartToJnt(q_i,Twist::Zero(),qdot);
+        CPPUNIT_ASSERT(objectives[o]->getCost() < cost_start);
+        fksolver.JntToCart(q_i,T_end);
+        CPPUNIT_ASSERT(Equal(T_start,T_end,1e-3));
+        if (objectives[o] == &manipulability) {
+            double w_end;
+            manipsolver.JntToManipulability(q_i,w_end,kappa,sigma_min);
+            CPPUNIT_ASSERT(w_end > w_start);
+        }
+        if (objectives[o] == &obstacles)
+            CPPUNIT_ASSERT(obstacles.getMinimumDistance() > distance_start);
+    }
+
+    // all objectives together, on top of the quadratic criterion
+    JntArray weights(nj), opt_pos(nj);
+    SetToZero(opt_pos);
+    for (unsigned int j=0;j<nj;j++)
+        weights(j) = 1.0;
+    ChainIkSolverVel_pinv_nso solver(chain,opt_pos,weights);
+    ChainIkSolverVel_pinv_nso plain(chain,opt_pos,weights);
+    solver.addObjective(limits);
+    solver.addObjective(manipulability);
+    solver.addObjective(obstacles);
+    JntArray qdot_plain(nj);
+    Twist v(Vector(0.1,-0.05,0.02),Vector(0.0,0.1,0.0));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,solver.CartToJnt(q,v,qdot));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,plain.CartToJnt(q,v,qdot_plain));
+    jacsolver.JntToJac(q,jac);
+    Eigen::Matrix<double,6,1> v_eigen;
+    for (unsigned int r=0;r<6;r++)
+        v_eigen(r) = v(r);
+    CPPUNIT_ASSERT((jac.data*qdot.data-v_eigen).norm() < 1e-9);
+    CPPUNIT_ASSERT((qdot.data-qdot_plain.data).norm() > 1e-6);
+
+    // a zero gain disables an objective
+    limits.setGain(0.0);
+    manipulability.setGain(0.0);
+    obstacles.setGain(0.0);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,solver.CartToJnt(q,v,qdot));
+    CPPUNIT_ASSERT((qdot.data-qdot_plain.data).norm() < 1e-12);
+    limits.setGain(1.0);
+    obstacles.setGain(1.0);
+
+    // at and beyond a limit the joint limit gradient is saturated
+    ChainIkSolverVel_pinv_nso limited(chain);
+    limited.addObjective(limits);
+    JntArray q_limit(q);
+    for (double excess=0.0;excess<=0.1;excess+=0.05) {
+        q_limit(1) = q_max(1)+excess;
+        q_limit(3) = q_min(3)-excess;
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,limited.CartToJnt(q_limit,Twist::Zero(),qdot));
+        CPPUNIT_ASSERT(qdot.data.norm() <= limited.getAlpha()*limits.getMaxGradient()*sqrt(nj)+1e-12);
+        CPPUNIT_ASSERT(qdot.data.norm() > 0.0);
+    }
+
+    ObstacleObjective wrong_segment(0.1);
+    wrong_segment.addControlPoint(ns,Vector::Zero());
+    solver.addObjective(wrong_segment);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_OUT_OF_RANGE,solver.CartToJnt(q,v,qdot));
+    solver.clearObjectives();
+    JointLimitObjective wrong_limits(JntArray(nj-1),JntArray(nj-1));
+    solver.addObjective(wrong_limits);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,solver.CartToJnt(q,v,qdot));
+
+    // objectives do without opt_pos and weights
+    ChainIkSolverVel_pinv_nso objectives_only(chain);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,objectives_only.CartToJnt(q,v,qdot));
+    objectives_only.addObjective(limits);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,objectives_only.CartToJnt(q,v,qdot));
+}
+
+void SolverTest::IkPosBudgetTest()
+{
+    std::cout<<"KDL-IK Pos Solver Tests with a time budget"<<std::endl;
+
+    const Chain& chain = kukaLWR;
+    unsigned int nj = chain.getNrOfJoints();
+    ChainFkSolverPos_recursive fksolver(chain);
+    ChainIkSolverVel_pinv iksolver_vel(chain);
+    JntArray q_init(nj), q_sol(nj), q_out(nj), q_min(nj), q_max(nj);
+    for (unsigned int j=0;j<nj;j++) {
+        q_init(j) = 0.3*sin(1.1*j+0.2);
+        q_sol(j) = q_init(j)+0.4;
+        q_min(j) = -2.9;
+        q_max(j) = 2.9;
+    }
+    Frame reachable, unreachable;
+    fksolver.JntToCart(q_sol,reachable);
+    unreachable = Frame(reachable.M,Vector(3.0,0.0,0.5));
+
+    ChainIkSolverPos_NR nr(chain,fksolver,iksolver_vel,1000000);
+    ChainIkSolverPos_NR_JL nr_jl(chain,q_min,q_max,fksolver,iksolver_vel,1000000);
+    ChainIkSolverPos_LMA lma(chain,1e-5,1000000,0.0);
+    ChainIkSolverPos* solvers[] = {&nr,&nr_jl,&lma};
+    Frame T_init, T_out;
+    fksolver.JntToCart(q_init,T_init);
+    for (unsigned int s=0;s<3;s++) {
+        ChainIkSolverPos& solver = *solvers[s];
+        CPPUNIT_ASSERT_EQUAL(ChainIkSolverPos::NOT_STARTED,solver.getTerminationReason());
+
+        // converges well within the budget
+        solver.setTimeBudget(0.5,4);
+        CPPUNIT_ASSERT((int)SolverI::E_NOERROR <= solver.CartToJnt(q_init,reachable,q_out));
+        CPPUNIT_ASSERT_EQUAL(ChainIkSolverPos::CONVERGED,solver.getTerminationReason());
+        CPPUNIT_ASSERT(solver.getResidual() < 1e-5);
+
+        // the unreachable goal stops on the budget with the best iterate
+        solver.setTimeBudget(50e-6);
+        timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC,&start);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_TIME_BUDGET_EXCEEDED,solver.CartToJnt(q_init,unreachable,q_out));
+        clock_gettime(CLOCK_MONOTONIC,&end);
+        double elapsed = (end.tv_sec-start.tv_sec)+1e-9*(end.tv_nsec-start.tv_nsec);
+        std::cout<<"  "<<solver.getNrOfIterations()<<" iterations in "<<1e6*elapsed<<" us"<<std::endl;
+        CPPUNIT_ASSERT_EQUAL(ChainIkSolverPos::TIME_BUDGET,solver.getTerminationReason());
+        CPPUNIT_ASSERT(solver.getNrOfIterations() < 1000000);
+        // generous, the test machine may be loaded
+        CPPUNIT_ASSERT(elapsed < 0.05);
+        fksolver.JntToCart(q_out,T_out);
+        if (&solver != &lma) {
+            Twist d = diff(T_out,unreachable);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(std::sqrt(dot(d.vel,d.vel)+dot(d.rot,d.rot)),solver.getResidual(),1e-12);
+            d = diff(T_init,unreachable);
+            CPPUNIT_ASSERT(solver.getResidual() <= std::sqrt(dot(d.vel,d.vel)+dot(d.rot,d.rot)));
+        }
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_TIME_BUDGET_EXCEEDED,solver.getError());
+        CPPUNIT_ASSERT(std::string("The time budget is exceeded") == solver.strError(solver.getError()));
+
+        // without a budget the iteration limit applies
+        solver.setTimeBudget(0.0);
+        CPPUNIT_ASSERT_EQUAL(0.0,solver.getTimeBudget());
+        JntArray wrong(nj+1);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,solver.CartToJnt(wrong,unreachable,q_out));
+        CPPUNIT_ASSERT_EQUAL(ChainIkSolverPos::FAILED,solver.getTerminationReason());
+    }
+
+    // convergence is tested before the budget, an exhausted budget does
+    // not hide a converged initial guess
+    for (unsigned int s=0;s<2;s++) {
+        ChainIkSolverPos& solver = *solvers[s];
+        solver.setTimeBudget(1e-12);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,solver.CartToJnt(q_sol,reachable,q_out));
+        CPPUNIT_ASSERT_EQUAL(ChainIkSolverPos::CONVERGED,solver.getTerminationReason());
+        CPPUNIT_ASSERT_EQUAL(0u,solver.getNrOfIterations());
+        solver.setTimeBudget(0.0);
+    }
+    // away from the joint limits NR and NR_JL take the same steps, the
+    // residual is the one of the returned iterate
+    JntArray q_near(nj), q_jl(nj);
+    Frame near;
+    for (unsigned int j=0;j<nj;j++)
+        q_near(j) = q_init(j)+0.1;
+    fksolver.JntToCart(q_near,near);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,nr.CartToJnt(q_init,near,q_out));
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,nr_jl.CartToJnt(q_init,near,q_jl));
+    CPPUNIT_ASSERT(nr.getNrOfIterations() > 0);
+    CPPUNIT_ASSERT_EQUAL(nr.getNrOfIterations(),nr_jl.getNrOfIterations());
+    CPPUNIT_ASSERT(Equal(q_out,q_jl,1e-12));
+    fksolver.JntToCart(q_out,T_out);
+    Twist d = diff(T_out,near);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::sqrt(dot(d.vel,d.vel)+dot(d.rot,d.rot)),nr.getResidual(),1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(nr.getResidual(),nr_jl.getResidual(),1e-12);
+
+    // the iteration limit returns the best iterate too
+    ChainIkSolverPos_NR nr_short(chain,fksolver,iksolver_vel,20);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_MAX_ITERATIONS_EXCEEDED,nr_short.CartToJnt(q_init,unreachable,q_out));
+    CPPUNIT_ASSERT_EQUAL(ChainIkSolverPos::MAX_ITERATIONS,nr_short.getTerminationReason());
+    CPPUNIT_ASSERT_EQUAL(20u,nr_short.getNrOfIterations());
+    fksolver.JntToCart(q_out,T_out);
+    d = diff(T_out,unreachable);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::sqrt(dot(d.vel,d.vel)+dot(d.rot,d.rot)),nr_short.getResidual(),1e-12);
+}
+
+void SolverTest::IkPosDampingTest()
+{
+    std::cout<<"KDL-IK Pos Solver Tests with the damping modes of WDLS"<<std::endl;
+
+    // counts the Newton-Raphson iterations
+    class CountingIkSolverVel : public ChainIkSolverVel
+    {
+    public:
+        explicit CountingIkSolverVel(ChainIkSolverVel& _solver):solver(_solver),calls(0) {}
+        virtual int CartToJnt(const JntArray& q_in, const Twist& v_in, JntArray& qdot_out)
+        {
+            calls++;
+            return solver.CartToJnt(q_in,v_in,qdot_out);
+        }
+        virtual int CartToJnt(const JntArray&, const FrameVel&, JntArrayVel&) {return E_NOT_IMPLEMENTED;}
+        virtual void updateInternalDataStructures() {}
+        ChainIkSolverVel& solver;
+        unsigned int calls;
+    };
+
+    const char* names[] = {"scaled","adaptive","selective"};
+    const ChainIkSolverVel_wdls::DampingMode modes[] = {ChainIkSolverVel_wdls::SCALED_DAMPING,
+                                                        ChainIkSolverVel_wdls::ADAPTIVE_DAMPING,
+                                                        ChainIkSolverVel_wdls::SELECTIVE_DAMPING};
+    Chain* chains[] = {&chain2,&chain4,&motomansia10,&kukaLWR};
+    const unsigned int nr_targets = 100;
+    // fixed targets, such that the comparison of the modes is repeatable
+    std::mt19937 rng(44);
+    std::uniform_real_distribution<double> uniform(-0.99,0.99);
+    for (unsigned int c=0;c<sizeof(chains)/sizeof(chains[0]);c++) {
+        const Chain& chain = *chains[c];
+        unsigned int nj = chain.getNrOfJoints();
+        std::vector<JntArray> q(nr_targets,JntArray(nj)),q_init(nr_targets,JntArray(nj));
+        for (unsigned int t=0;t<nr_targets;t++) {
+            for (unsigned int i=0;i<nj;i++) {
+                q[t](i) = uniform(rng);
+                q_init[t](i) = q[t](i)+uniform(rng);
+            }
+        }
+        ChainFkSolverPos_recursive fksolver(chain);
+        unsigned int converged[3],iterations[3];
+        for (unsigned int m=0;m<3;m++) {
+            ChainIkSolverVel_wdls iksolverv(chain,0.1);
+            iksolverv.setLambda(0.1);
+            iksolverv.setDampingMode(modes[m]);
+            CountingIkSolverVel counter(iksolverv);
+            ChainIkSolverPos_NR iksolver(chain,fksolver,counter,500,1e-6);
+            converged[m] = 0;
+            iterations[m] = 0;
+            for (unsigned int t=0;t<nr_targets;t++) {
+                Frame F1,F2;
+                JntArray q_solved(nj);
+                fksolver.JntToCart(q[t],F1);
+                counter.calls = 0;
+                if (iksolver.CartToJnt(q_init[t],F1,q_solved) >= 0) {
+                    fksolver.JntToCart(q_solved,F2);
+                    CPPUNIT_ASSERT(Equal(F1,F2,1e-5));
+                    converged[m]++;
+                    iterations[m] += counter.calls;
+                }
+            }
+            std::cout<<"  chain with "<<nj<<" joints, "<<names[m]<<" damping : "<<converged[m]<<"/"<<nr_targets
+                     <<" converged, "<<(converged[m] ? double(iterations[m])/converged[m] : 0.0)
+                     <<" iterations on average"<<std::endl;
+        }
+        // adaptive damping damps the directions that are not the most
+        // singular one less than scaled damping, it converges about as often
+        CPPUNIT_ASSERT(converged[1]+nr_targets/20>=converged[0]);
+        CPPUNIT_ASSERT(converged[1]>=4*nr_targets/5);
+        // selective damping does not oscillate near singularities
+        CPPUNIT_ASSERT(converged[2]>=converged[0]);
+        CPPUNIT_ASSERT(converged[2]>=converged[1]);
+    }
+}
+
 void SolverTest::FkPosVectTest()
 {
     ChainFkSolverPos_recursive fksolver1(chain1);
@@ -1113,6 +2207,272 @@ void SolverTest::FkPosVectTest()
     CPPUNIT_ASSERT(Equal(v_out[chain1.getNrOfSegments()-1],f_out,1e-5));
 }
 
+void SolverTest::FkPosRepresentationTest()
+{
+    // long chain with all joint types
+    Chain chain_long;
+    for (unsigned int i=0;i<40;i++) {
+        Vector axis,origin,tip;
+        random(axis);
+        random(origin);
+        random(tip);
+        axis.Normalize();
+        const Joint::JointType types[] = {Joint::RotAxis,Joint::RotX,Joint::RotY,Joint::RotZ,
+            Joint::TransAxis,Joint::TransX,Joint::TransY,Joint::TransZ,Joint::Fixed};
+        Joint::JointType type = types[i%9];
+        Joint joint = (type==Joint::RotAxis || type==Joint::TransAxis) ?
+            Joint(origin,axis,type,1.5,0.1) : Joint(type,1.5,0.1);
+        chain_long.addSegment(Segment(joint,Frame(Rotation::RPY(0.1*i,0.2,-0.3),tip)));
+    }
+
+    Chain* chains[] = {&chain1,&chain2,&chain3,&kukaLWR,&chain_long};
+    for (unsigned int c=0;c<5;c++) {
+        Chain& chain = *chains[c];
+        ChainFkSolverPos_recursive fksolver(chain);
+        ChainFkSolverPos_matrix fksolver_matrix(chain);
+        ChainFkSolverPos_quaternion fksolver_quat(chain);
+
+        JntArray q(chain.getNrOfJoints());
+        for (unsigned int i=0;i<q.rows();i++)
+            random(q(i));
+
+        Frame f,f_matrix,f_quat;
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,fksolver.JntToCart(q,f));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,fksolver_matrix.JntToCart(q,f_matrix));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,fksolver_quat.JntToCart(q,f_quat));
+        CPPUNIT_ASSERT(Equal(f,f_matrix,1e-10));
+        CPPUNIT_ASSERT(Equal(f,f_quat,1e-10));
+
+        std::vector<Frame> v(chain.getNrOfSegments()),v_quat(chain.getNrOfSegments());
+        fksolver.JntToCart(q,v);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,fksolver_quat.JntToCart(q,v_quat));
+        for (unsigned int i=0;i<v.size();i++)
+            CPPUNIT_ASSERT(Equal(v[i],v_quat[i],1e-10));
+
+        FrameQuat f_rep;
+        fksolver_quat.JntToCartRep(q,f_rep,2);
+        CPPUNIT_ASSERT(Equal(f_rep.GetFrame(),v[1],1e-10));
+
+        JntArray q_wrong(chain.getNrOfJoints()+1);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,fksolver_quat.JntToCart(q_wrong,f_quat));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_OUT_OF_RANGE,fksolver_quat.JntToCart(q,f_quat,chain.getNrOfSegments()+1));
+    }
+
+    // the cached tip frames follow the chain
+    Chain chain = chain2;
+    ChainFkSolverPos_quaternion fksolver_quat(chain);
+    chain.addSegment(Segment(Joint(Joint::RotY),Frame(Vector(0.1,0.2,0.3))));
+    JntArray q(chain.getNrOfJoints());
+    Frame f,f_quat;
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOT_UP_TO_DATE,fksolver_quat.JntToCart(q,f_quat));
+    fksolver_quat.updateInternalDataStructures();
+    ChainFkSolverPos_recursive(chain).JntToCart(q,f);
+    CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,fksolver_quat.JntToCart(q,f_quat));
+    CPPUNIT_ASSERT(Equal(f,f_quat,1e-10));
+}
+
+void SolverTest::ScalarTypeTest()
+{
+    Chain* chains[] = {&chain1,&chain2,&chain3,&chain4,&kukaLWR,&motomansia10};
+    for (unsigned int c=0;c<6;c++) {
+        Chain& chain = *chains[c];
+        unsigned int nj = chain.getNrOfJoints();
+        ChainFkSolverPos_recursive fksolver(chain);
+        ChainJntToJacSolver jacsolver(chain);
+        ChainFkSolverPosT<double> fksolver_d(chain);
+        ChainJntToJacSolverT<double> jacsolver_d(chain);
+        ChainFkSolverPosf fksolver_f(chain);
+        ChainJntToJacSolverf jacsolver_f(chain);
+
+        JntArray q(nj);
+        for (unsigned int i=0;i<nj;i++)
+            random(q(i));
+        JntArrayT<double> q_d = q.data;
+        JntArrayf q_f = q.data.cast<float>();
+
+        Frame f;
+        FrameT<double> f_d;
+        Framef f_f;
+        fksolver.JntToCart(q,f);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,fksolver_d.JntToCart(q_d,f_d));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,fksolver_f.JntToCart(q_f,f_f));
+        CPPUNIT_ASSERT(Equal(f,f_d.GetFrame(),1e-12));
+        CPPUNIT_ASSERT(Equal(f,f_f.GetFrame(),1e-5));
+
+        std::vector<Framef> v_f(chain.getNrOfSegments());
+        std::vector<Frame> v(chain.getNrOfSegments());
+        fksolver.JntToCart(q,v);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,fksolver_f.JntToCart(q_f,v_f));
+        for (unsigned int i=0;i<v.size();i++)
+            CPPUNIT_ASSERT(Equal(v[i],v_f[i].GetFrame(),1e-5));
+
+        Jacobian jac(nj);
+        JacobianT<double> jac_d(6,nj);
+        Jacobianf jac_f(6,nj);
+        jacsolver.JntToJac(q,jac);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,jacsolver_d.JntToJac(q_d,jac_d));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,jacsolver_f.JntToJac(q_f,jac_f));
+        CPPUNIT_ASSERT((jac.data-jac_d).cwiseAbs().maxCoeff() < 1e-12);
+        CPPUNIT_ASSERT((jac.data-jac_f.cast<double>()).cwiseAbs().maxCoeff() < 1e-5);
+
+        // partial chain
+        jacsolver.JntToJac(q,jac,2);
+        jacsolver_f.JntToJac(q_f,jac_f,2);
+        CPPUNIT_ASSERT((jac.data-jac_f.cast<double>()).cwiseAbs().maxCoeff() < 1e-5);
+
+        JntArrayf q_wrong(nj+1);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,fksolver_f.JntToCart(q_wrong,f_f));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,jacsolver_f.JntToJac(q_wrong,jac_f));
+    }
+
+    // the double types convert exactly
+    Frame F;
+    Twist t;
+    Wrench w;
+    random(F);
+    random(t);
+    random(w);
+    FrameT<double> F_d(F);
+    TwistT<double> t_d(t);
+    WrenchT<double> w_d(w);
+    CPPUNIT_ASSERT_EQUAL(F,F_d.GetFrame());
+    CPPUNIT_ASSERT(Equal(F*t,(F_d*t_d).GetTwist(),1e-14));
+    CPPUNIT_ASSERT(Equal(F*w,(F_d*w_d).GetWrench(),1e-14));
+    CPPUNIT_ASSERT(Equal(F.Inverse(t),F_d.Inverse(t_d).GetTwist(),1e-14));
+    CPPUNIT_ASSERT(Equal(F.Inverse(w),F_d.Inverse(w_d).GetWrench(),1e-14));
+    CPPUNIT_ASSERT(Equal(F.Inverse(),F_d.Inverse().GetFrame(),1e-14));
+    CPPUNIT_ASSERT(Equal(t.RefPoint(F.p),t_d.RefPoint(F_d.p).GetTwist(),1e-14));
+    CPPUNIT_ASSERT(Equal(w.RefPoint(F.p),w_d.RefPoint(F_d.p).GetWrench(),1e-14));
+}
+
+void SolverTest::DualNumberTest()
+{
+    typedef Rall1d<double> doubled;
+    Vector grav(0.0,0.0,-9.81);
+    Chain* chains[] = {&chain2,&kukaLWR,&motomansia10};
+    for (unsigned int c=0;c<3;c++) {
+        Chain& chain = *chains[c];
+        unsigned int nj = chain.getNrOfJoints();
+        unsigned int ns = chain.getNrOfSegments();
+        ChainFkSolverPos_recursive fksolver(chain);
+        ChainJntToJacSolver jacsolver(chain);
+        ChainJntToJacDotSolver jacdotsolver(chain);
+        ChainIdSolver_RNE idsolver(chain,grav);
+        ChainDynParam dynparam(chain,grav);
+        ChainFkSolverPosT<doubled> fksolver_r(chain);
+        ChainJntToJacSolverT<doubled> jacsolver_r(chain);
+        ChainIdSolver_RNE_T<doubled> idsolver_r(chain,grav);
+
+        JntArray q(nj),qdot(nj),qdotdot(nj);
+        for (unsigned int i=0;i<nj;i++) {
+            random(q(i));
+            random(qdot(i));
+            random(qdotdot(i));
+        }
+        // seeding the gradient of q with qdot gives the time derivatives
+        JntArrayT<doubled> q_r(nj),qdot_r(nj),qdotdot_r(nj);
+        for (unsigned int i=0;i<nj;i++) {
+            q_r(i) = doubled(q(i),qdot(i));
+            qdot_r(i) = doubled(qdot(i));
+            qdotdot_r(i) = doubled(qdotdot(i));
+        }
+
+        Frame f;
+        Jacobian jac(nj);
+        fksolver.JntToCart(q,f);
+        jacsolver.JntToJac(q,jac);
+        Twist t;
+        MultiplyJacobian(jac,qdot,t);
+        FrameT<doubled> f_r;
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,fksolver_r.JntToCart(q_r,f_r));
+        for (int i=0;i<3;i++) {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(f.p(i),f_r.p(i).t,1e-12);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(t.vel(i),f_r.p(i).grad,1e-12);
+            // d/dt M = [w] M
+            Vector dcol = t.rot*Vector(f.M(0,i),f.M(1,i),f.M(2,i));
+            for (int r=0;r<3;r++) {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(f.M(r,i),f_r.M(r,i).t,1e-12);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(dcol(r),f_r.M(r,i).grad,1e-12);
+            }
+        }
+
+        Jacobian jdot(nj);
+        jacdotsolver.JntToJacDot(JntArrayVel(q,qdot),jdot);
+        JacobianT<doubled> jac_r(6,nj);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,jacsolver_r.JntToJac(q_r,jac_r));
+        for (unsigned int k=0;k<nj;k++)
+            for (int r=0;r<6;r++) {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(jac(r,k),jac_r(r,k).t,1e-12);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(jdot(r,k),jac_r(r,k).grad,1e-10);
+            }
+
+        // seeding the gradient of q_dotdot(k) gives column k of the mass matrix
+        JntArray torques(nj);
+        Wrenches f_ext(ns);
+        idsolver.CartToJnt(q,qdot,qdotdot,f_ext,torques);
+        JntSpaceInertiaMatrix H(nj);
+        dynparam.JntToMass(q,H);
+        ChainIdSolver_RNE_T<doubled>::WrenchesT f_ext_r(ns);
+        JntArrayT<doubled> torques_r(nj);
+        for (unsigned int i=0;i<nj;i++)
+            q_r(i) = doubled(q(i));
+        for (unsigned int k=0;k<nj;k++) {
+            qdotdot_r(k).grad = 1.0;
+            CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,idsolver_r.CartToJnt(q_r,qdot_r,qdotdot_r,f_ext_r,torques_r));
+            qdotdot_r(k).grad = 0.0;
+            for (unsigned int i=0;i<nj;i++) {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(torques(i),torques_r(i).t,1e-10);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(H(i,k),torques_r(i).grad,1e-10);
+            }
+        }
+
+        // derivative with respect to a position, against central differences
+        const double h = 1e-6;
+        JntArray q_h(q),torques_p(nj),torques_m(nj);
+        unsigned int k = nj/2;
+        q_h(k) = q(k)+h;
+        idsolver.CartToJnt(q_h,qdot,qdotdot,f_ext,torques_p);
+        q_h(k) = q(k)-h;
+        idsolver.CartToJnt(q_h,qdot,qdotdot,f_ext,torques_m);
+        q_r(k).grad = 1.0;
+        idsolver_r.CartToJnt(q_r,qdot_r,qdotdot_r,f_ext_r,torques_r);
+        for (unsigned int i=0;i<nj;i++)
+            CPPUNIT_ASSERT_DOUBLES_EQUAL((torques_p(i)-torques_m(i))/(2*h),torques_r(i).grad,1e-5*(1+std::abs(torques_r(i).grad)));
+
+        JntArrayT<doubled> torques_wrong(nj+1);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,idsolver_r.CartToJnt(q_r,qdot_r,qdotdot_r,f_ext_r,torques_wrong));
+
+        // all joints in one pass : the jacobian from the FK solver and the
+        // mass matrix from RNE
+        typedef Rall1dN<7> doubleN;
+        CPPUNIT_ASSERT(nj<=7);
+        ChainFkSolverPosT<doubleN> fksolver_n(chain);
+        ChainIdSolver_RNE_T<doubleN> idsolver_n(chain,grav);
+        JntArrayT<doubleN> q_n(nj),qdot_n(nj),qdotdot_n(nj),torques_n(nj);
+        for (unsigned int i=0;i<nj;i++) {
+            q_n(i) = doubleN::Variable(q(i),i);
+            qdot_n(i) = doubleN(qdot(i));
+            qdotdot_n(i) = doubleN(qdotdot(i));
+        }
+        FrameT<doubleN> f_n;
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,fksolver_n.JntToCart(q_n,f_n));
+        for (unsigned int k=0;k<nj;k++)
+            for (int r=0;r<3;r++)
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(jac(r,k),f_n.p(r).grad(k),1e-12);
+        for (unsigned int i=0;i<nj;i++) {
+            q_n(i) = doubleN(q(i));
+            qdotdot_n(i) = doubleN::Variable(qdotdot(i),i);
+        }
+        ChainIdSolver_RNE_T<doubleN>::WrenchesT f_ext_n(ns);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,idsolver_n.CartToJnt(q_n,qdot_n,qdotdot_n,f_ext_n,torques_n));
+        for (unsigned int i=0;i<nj;i++) {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(torques(i),torques_n(i).t,1e-10);
+            for (unsigned int k=0;k<nj;k++)
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(H(i,k),torques_n(i).grad(k),1e-10);
+        }
+    }
+}
+
 void SolverTest::FkVelVectTest()
 {
     ChainFkSolverVel_recursive fksolver1(chain1);
@@ -1134,6 +2494,69 @@ void SolverTest::FkVelVectTest()
     CPPUNIT_ASSERT(Equal(v_out[chain1.getNrOfSegments()-1],f_out,1e-5));
 }
 
+void SolverTest::FkAccTest()
+{
+    Chain* chains[] = {&chain1,&chain2,&chain3,&chain4,&motomansia10,&kukaLWR};
+    const double h = 1e-5;
+    for (unsigned int c=0;c<sizeof(chains)/sizeof(chains[0]);c++) {
+        const Chain& chain = *chains[c];
+        unsigned int nj = chain.getNrOfJoints();
+        unsigned int ns = chain.getNrOfSegments();
+        ChainFkSolverVel_recursive fksolvervel(chain);
+        ChainFkSolverAcc_recursive fksolveracc(chain);
+        JntArrayAcc qacc(nj);
+        for (unsigned int i=0;i<nj;i++) {
+            random(qacc.q(i));
+            random(qacc.qdot(i));
+            random(qacc.qdotdot(i));
+        }
+        JntArrayVel qvel(qacc.q,qacc.qdot);
+
+        std::vector<FrameVel> v_out(ns);
+        std::vector<FrameAcc> a_out(ns);
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,fksolvervel.JntToCart(qvel,v_out));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_NOERROR,fksolveracc.JntToCart(qacc,a_out));
+
+        // the velocities against the composition of the segments
+        FrameVel F = FrameVel::Identity();
+        for (unsigned int i=0,j=0;i<ns;i++) {
+            const Segment& segment = chain.getSegment(i);
+            if (segment.getJoint().getType()!=Joint::Fixed) {
+                F = F*FrameVel(segment.pose(qacc.q(j)),segment.twist(qacc.q(j),qacc.qdot(j)));
+                j++;
+            } else {
+                F = F*segment.pose(0.0);
+            }
+            CPPUNIT_ASSERT(Equal(F,v_out[i],1e-10));
+            CPPUNIT_ASSERT(Equal(a_out[i].GetFrame(),F.GetFrame(),1e-10));
+            CPPUNIT_ASSERT(Equal(a_out[i].GetTwist(),F.GetTwist(),1e-10));
+        }
+
+        // the accelerations against finite differences along
+        // q(t) = q+qdot*t+qdotdot*t^2/2
+        JntArrayVel qp(nj),qm(nj);
+        for (unsigned int i=0;i<nj;i++) {
+            qp.q(i) = qacc.q(i)+qacc.qdot(i)*h+qacc.qdotdot(i)*h*h/2;
+            qp.qdot(i) = qacc.qdot(i)+qacc.qdotdot(i)*h;
+            qm.q(i) = qacc.q(i)-qacc.qdot(i)*h+qacc.qdotdot(i)*h*h/2;
+            qm.qdot(i) = qacc.qdot(i)-qacc.qdotdot(i)*h;
+        }
+        std::vector<FrameVel> vp(ns),vm(ns);
+        fksolvervel.JntToCart(qp,vp);
+        fksolvervel.JntToCart(qm,vm);
+        for (unsigned int i=0;i<ns;i++) {
+            Twist dt = (vp[i].GetTwist()-vm[i].GetTwist())/(2*h);
+            CPPUNIT_ASSERT(Equal(a_out[i].GetAccTwist(),dt,1e-5));
+        }
+
+        FrameAcc f_out;
+        fksolveracc.JntToCart(qacc,f_out);
+        CPPUNIT_ASSERT(Equal(a_out[ns-1],f_out,1e-12));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_SIZE_MISMATCH,fksolveracc.JntToCart(JntArrayAcc(nj+1),f_out));
+        CPPUNIT_ASSERT_EQUAL((int)SolverI::E_OUT_OF_RANGE,fksolveracc.JntToCart(qacc,f_out,ns+1));
+    }
+}
+
 void SolverTest::FdSolverDevelopmentTest()
 {
     int ret;
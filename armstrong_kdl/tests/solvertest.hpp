@@ -4,15 +4,31 @@
 #include <cppunit/extensions/HelperMacros.h>
 
 #include <chain.hpp>
+#include <algorithm>
 #include <chainfksolverpos_recursive.hpp>
+#include <chainfksolverpos_scalar.hpp>
+#include <chainjnttojacsolver_scalar.hpp>
+#include <chainidsolver_recursive_newton_euler_scalar.hpp>
+#include <utilities/rall1dN.h>
 #include <chainfksolvervel_recursive.hpp>
+#include <chainfksolveracc_recursive.hpp>
 #include <chainiksolvervel_pinv.hpp>
 #include <chainiksolvervel_pinv_givens.hpp>
 #include <chainiksolvervel_pinv_nso.hpp>
 #include <chainiksolvervel_wdls.hpp>
+#include <iksolvervel_priority.hpp>
+#include <chainiksolvervel_qp.hpp>
+#include <chainiksolvervel_dls.hpp>
 #include <chainiksolverpos_nr.hpp>
 #include <chainiksolverpos_lma.hpp>
 #include <chainiksolverpos_nr_jl.hpp>
+#include <chainiksolverpos_pieper.hpp>
+#include <chainiksolverpos_srs.hpp>
+#include <treefksolverpos_recursive.hpp>
+#include <treeiksolverpos_lma.hpp>
+#include <jntmimicmap.hpp>
+#include <chainjnttomanipulabilitysolver.hpp>
+#include <nullspaceobjective.hpp>
 #include <chainjnttojacsolver.hpp>
 #include <chainjnttojacdotsolver.hpp>
 #include <chainhdsolver_vereshchagin.hpp>
@@ -22,6 +38,8 @@
 #include <chainfdsolver_recursive_newton_euler.hpp>
 #include <chainexternalwrenchestimator.hpp>
 #include <utilities/ldl_solver_eigen.hpp>
+#include <utilities/svd_eigen_HH.hpp>
+#include <utilities/svd_eigen_Macie.hpp>
 
 
 using namespace ARMstrongKDL;
@@ -33,12 +51,28 @@ class SolverTest : public CppUnit::TestFixture
     CPPUNIT_TEST(FkVelAndJacTest );
     CPPUNIT_TEST(FkVelAndIkVelTest );
     CPPUNIT_TEST(FkPosAndIkPosTest );
+    CPPUNIT_TEST(PieperIkTest );
+    CPPUNIT_TEST(SRSIkTest );
     CPPUNIT_TEST(VereshchaginTest );
     CPPUNIT_TEST(ExternalWrenchEstimatorTest );
     CPPUNIT_TEST(IkSingularValueTest );
     CPPUNIT_TEST(IkVelSolverWDLSTest );
+    CPPUNIT_TEST(IkVelWarmStartTest );
+    CPPUNIT_TEST(IkVelPriorityTest );
+    CPPUNIT_TEST(IkVelQPTest );
+    CPPUNIT_TEST(IkVelDlsTest );
+    CPPUNIT_TEST(TreeIkPosLMATest );
+    CPPUNIT_TEST(MimicMapTest );
+    CPPUNIT_TEST(ManipulabilityTest );
+    CPPUNIT_TEST(NullSpaceObjectiveTest );
+    CPPUNIT_TEST(IkPosBudgetTest );
+    CPPUNIT_TEST(IkPosDampingTest );
     CPPUNIT_TEST(FkPosVectTest );
+    CPPUNIT_TEST(FkPosRepresentationTest );
+    CPPUNIT_TEST(ScalarTypeTest );
+    CPPUNIT_TEST(DualNumberTest );
     CPPUNIT_TEST(FkVelVectTest );
+    CPPUNIT_TEST(FkAccTest );
     CPPUNIT_TEST(FdSolverDevelopmentTest );
     CPPUNIT_TEST(FdSolverConsistencyTest );
     CPPUNIT_TEST(LDLdecompTest);
@@ -54,12 +88,28 @@ public:
     void FkVelAndJacTest();
     void FkVelAndIkVelTest();
     void FkPosAndIkPosTest();
+    void PieperIkTest();
+    void SRSIkTest();
     void VereshchaginTest();
     void ExternalWrenchEstimatorTest();
     void IkSingularValueTest() ;
     void IkVelSolverWDLSTest();
+    void IkVelWarmStartTest();
+    void IkVelPriorityTest();
+    void IkVelQPTest();
+    void IkVelDlsTest();
+    void TreeIkPosLMATest();
+    void MimicMapTest();
+    void ManipulabilityTest();
+    void NullSpaceObjectiveTest();
+    void IkPosBudgetTest();
+    void IkPosDampingTest();
     void FkPosVectTest();
+    void FkPosRepresentationTest();
+    void ScalarTypeTest();
+    void DualNumberTest();
     void FkVelVectTest();
+    void FkAccTest();
     void FdSolverDevelopmentTest();
     void FdSolverConsistencyTest();
     void LDLdecompTest();
@@ -1,5 +1,6 @@
 #include "velocityprofiletest.hpp"
 #include <frames_io.hpp>
+#include <sstream>
 CPPUNIT_TEST_SUITE_REGISTRATION( VelocityProfileTest );
 
 using namespace ARMstrongKDL;
@@ -376,3 +377,159 @@ void VelocityProfileTest::TestDirac_SetProfileDuration()
     time = duration + 1.0;
     CPPUNIT_ASSERT_DOUBLES_EQUAL(pos2, v.Pos(time), epsilon);
 }
+
+void VelocityProfileTest::TestJerkLimited_SetProfile()
+{
+	// 1 second jerk, 1 second constant acceleration, 1 second jerk (cover 3 distance),
+	// 2 second flat velocity (cover 4 distance)
+	// 1 second jerk, 1 second constant deceleration, 1 second jerk (cover 3 distance),
+	VelocityProfile_JerkLimited	v(2, 1, 1);
+	double						time;
+	v.SetProfile(2, 12);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(8.0, v.Duration(),epsilon);
+
+	// start
+	time = 0;
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, v.Pos(time),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, v.Vel(time),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, v.Acc(time),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, v.Jerk(time),epsilon);
+
+	// end of first jerk
+	time = 1;
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0+1.0/6.0, v.Pos(time),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, v.Vel(time),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, v.Acc(time),epsilon);
+
+	// end of acceleration
+	time = 3;
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(5.0, v.Pos(time),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, v.Vel(time),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, v.Acc(time),epsilon);
+
+	// middle of flat velocity
+	time = 4;
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(7.0, v.Pos(time),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, v.Vel(time),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, v.Acc(time),epsilon);
+
+	// middle of deceleration
+	time = 6.5;
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, v.Vel(time),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(-1.0, v.Acc(time),epsilon);
+
+	// end
+	time = 8;
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(12.0, v.Pos(time),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, v.Vel(time),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, v.Acc(time),epsilon);
+
+	// fenceposts - before and after
+	time = -1;
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, v.Pos(time),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, v.Vel(time),epsilon);
+	time = 11;
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(12.0, v.Pos(time),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, v.Vel(time),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, v.Acc(time),epsilon);
+
+	// short motion, velocity and acceleration limits are not reached
+	v.SetProfile(0, -0.25);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, v.Duration(),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(-0.25, v.Vel(1.0),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(-0.25, v.Pos(2.0),epsilon);
+}
+
+void VelocityProfileTest::TestJerkLimited_SetProfileDuration()
+{
+	// same as the first jerk limited test, but twice as long
+	VelocityProfile_JerkLimited	v(2, 1, 1);
+	v.SetProfileDuration(2, 12, 16.0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(16.0, v.Duration(),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.25, v.Acc(2.0),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(5.0, v.Pos(6.0),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, v.Vel(6.0),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(12.0, v.Pos(16.0),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, v.Vel(16.0),epsilon);
+
+	// shorter than possible : time optimal profile
+	v.SetProfileDuration(2, 12, 4.0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(8.0, v.Duration(),epsilon);
+
+	// from a moving state
+	v.SetProfileDuration(0, 1.5, -0.5, 4, 10.0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, v.Duration(),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, v.Vel(0.0),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0, v.Pos(10.0),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, v.Vel(10.0),epsilon);
+}
+
+void VelocityProfileTest::TestJerkLimited_Online()
+{
+	const double maxvel = 2, maxacc = 1, maxjerk = 3;
+	const double dt = 1e-3;
+	VelocityProfile_JerkLimited	v(maxvel, maxacc, maxjerk);
+
+	// moving away from the target, with an acceleration that exceeds the limit
+	v.SetProfile(0, 2.5, 1.5, -1);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, v.Pos(0.0),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.5, v.Vel(0.0),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, v.Acc(0.0),epsilon);
+	for (double time=dt; time<=v.Duration(); time+=dt) {
+		// continuity
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(v.Pos(time-dt), v.Pos(time), 3*dt);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(v.Vel(time-dt), v.Vel(time), 2*dt);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(v.Acc(time-dt), v.Acc(time), maxjerk*dt+epsilon);
+		CPPUNIT_ASSERT(fabs(v.Jerk(time)) <= maxjerk+epsilon);
+	}
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(-1.0, v.Pos(v.Duration()),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, v.Vel(v.Duration()),epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, v.Acc(v.Duration()),epsilon);
+
+	// re-planning from an intermediate state of a time optimal
+	// profile gives the remainder of that profile
+	v.SetProfile(1, 9);
+	const double switchtime = 2.5;
+	VelocityProfile_JerkLimited w(maxvel, maxacc, maxjerk);
+	w.SetProfile(v.Pos(switchtime), v.Vel(switchtime), v.Acc(switchtime), 9);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(v.Duration()-switchtime, w.Duration(), epsilon);
+	for (double time=0; time<=w.Duration(); time+=0.1) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(v.Pos(time+switchtime), w.Pos(time), epsilon);
+		CPPUNIT_ASSERT(fabs(w.Vel(time)) <= maxvel+epsilon);
+		CPPUNIT_ASSERT(fabs(w.Acc(time)) <= maxacc+epsilon);
+	}
+
+	// changing the target while moving
+	w.SetProfile(v.Pos(switchtime), v.Vel(switchtime), v.Acc(switchtime), 0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(v.Vel(switchtime), w.Vel(0.0), epsilon);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, w.Pos(w.Duration()), epsilon);
+
+	// Read back what was written
+	std::stringstream ss;
+	v.Write(ss);
+	VelocityProfile* r = VelocityProfile::Read(ss);
+	r->SetProfile(1, 9);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(v.Duration(), r->Duration(), epsilon);
+	delete r;
+}
+
+void VelocityProfileTest::TestJerkLimited_Sync()
+{
+	std::vector<double> maxvel(3, 2.0), maxacc(3, 1.0), maxjerk(3, 3.0);
+	maxvel[1] = 0.5;
+	VelocityProfile_JerkLimitedSync v(maxvel, maxacc, maxjerk);
+	std::vector<double> pos1(3), vel1(3), acc1(3), pos2(3), q(3);
+	pos1[0] = 0;  vel1[0] = 0;   acc1[0] = 0;   pos2[0] = 1;
+	pos1[1] = 0;  vel1[1] = 0.2; acc1[1] = 0;   pos2[1] = 3;
+	pos1[2] = 1;  vel1[2] = -1;  acc1[2] = 0.5; pos2[2] = 1.5;
+	v.SetProfile(pos1, vel1, acc1, pos2);
+	CPPUNIT_ASSERT_EQUAL(3u, v.size());
+	for (unsigned int i=0; i<v.size(); ++i)
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(v.Duration(), v.Profile(i).Duration(), epsilon);
+	v.Vel(0.0, q);
+	for (unsigned int i=0; i<v.size(); ++i)
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(vel1[i], q[i], epsilon);
+	v.Pos(v.Duration(), q);
+	for (unsigned int i=0; i<v.size(); ++i)
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(pos2[i], q[i], epsilon);
+}
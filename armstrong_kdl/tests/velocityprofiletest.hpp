@@ -5,6 +5,7 @@
 #include <velocityprofile_trap.hpp>
 #include <velocityprofile_traphalf.hpp>
 #include <velocityprofile_dirac.hpp>
+#include <velocityprofile_jerklimited.hpp>
 
 class VelocityProfileTest : public CppUnit::TestFixture
 {
@@ -22,6 +23,11 @@ class VelocityProfileTest : public CppUnit::TestFixture
     CPPUNIT_TEST(TestDirac_SetProfile);
     CPPUNIT_TEST(TestDirac_SetProfileDuration);
 
+    CPPUNIT_TEST(TestJerkLimited_SetProfile);
+    CPPUNIT_TEST(TestJerkLimited_SetProfileDuration);
+    CPPUNIT_TEST(TestJerkLimited_Online);
+    CPPUNIT_TEST(TestJerkLimited_Sync);
+
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -40,6 +46,11 @@ public:
 
     void TestDirac_SetProfile();
     void TestDirac_SetProfileDuration();
+
+    void TestJerkLimited_SetProfile();
+    void TestJerkLimited_SetProfileDuration();
+    void TestJerkLimited_Online();
+    void TestJerkLimited_Sync();
 };
 
 #endif